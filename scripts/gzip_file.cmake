@@ -0,0 +1,4 @@
+# Gzips one file: cmake -DINPUT=<file> -DOUTPUT=<file.gz> -P gzip_file.cmake
+get_filename_component(output_dir "${OUTPUT}" DIRECTORY)
+file(MAKE_DIRECTORY "${output_dir}")
+file(ARCHIVE_CREATE OUTPUT "${OUTPUT}" PATHS "${INPUT}" FORMAT raw COMPRESSION GZip)
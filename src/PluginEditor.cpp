@@ -1,6 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "BinaryData.h"
+#include "WebResources.h"
 
 GuillotineEditor::GuillotineEditor(GuillotineProcessor& p)
     : AudioProcessorEditor(&p),
@@ -23,11 +23,10 @@ GuillotineEditor::GuillotineEditor(GuillotineProcessor& p)
               .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
               .withWinWebView2Options(
                   juce::WebBrowserComponent::Options::WinWebView2{}
-                      .withUserDataFolder(juce::File::getSpecialLocation(
-                          juce::File::SpecialLocationType::tempDirectory)))
+                      .withUserDataFolder(web::getUserDataFolder()))
               .withNativeIntegrationEnabled()
               .withResourceProvider(
-                  [this](const auto& url) { return getResource(url); })
+                  [](const auto& url) { return web::getResource(url); })
               .withOptionsFrom(inputGainRelay)
               .withOptionsFrom(outputGainRelay)
               .withOptionsFrom(ceilingRelay)
@@ -89,13 +88,16 @@ GuillotineEditor::GuillotineEditor(GuillotineProcessor& p)
             safeThis->webView.goToURL(juce::WebBrowserComponent::getResourceProviderRoot());
     });
 
-    // Start timer to push envelope data at 60Hz
-    startTimerHz(60);
+    // Frames queued while no editor was open are stale
+    audioProcessor.getEnvelopeFifo().discardReady();
+
+    // Push envelope data on the shared 60Hz tick
+    refreshScheduler->add(*this, *this);
 }
 
 GuillotineEditor::~GuillotineEditor()
 {
-    stopTimer();
+    refreshScheduler->remove(*this);
 }
 
 void GuillotineEditor::paint(juce::Graphics& g)
@@ -108,10 +110,19 @@ void GuillotineEditor::resized()
     webView.setBounds(getLocalBounds());
 }
 
-void GuillotineEditor::timerCallback()
+void GuillotineEditor::refresh()
 {
     pushVersionOnce();
     pushEnvelopeData();
+
+    if constexpr (dsp::StageProfiler::enabled)
+        pushProcessTimings();
+}
+
+void GuillotineEditor::refreshSkipped()
+{
+    // Hidden or minimized: no JS work at all, and drop frames the display will never show
+    audioProcessor.getEnvelopeFifo().discardReady();
 }
 
 void GuillotineEditor::pushVersionOnce()
@@ -131,176 +142,53 @@ void GuillotineEditor::pushVersionOnce()
 
 void GuillotineEditor::pushEnvelopeData()
 {
-    const auto& preClip = audioProcessor.getEnvelopePreClip();
-    const auto& postClip = audioProcessor.getEnvelopePostClip();
-    const auto& thresholds = audioProcessor.getEnvelopeClipThresholds();
-    const int writePos = audioProcessor.getEnvelopeWritePosition().load();
-
-    // Build JSON arrays for envelope data
-    juce::String preClipJson = "[";
-    juce::String postClipJson = "[";
-    juce::String thresholdsJson = "[";
-
-    for (int i = 0; i < GuillotineProcessor::envelopeBufferSize; ++i)
-    {
-        if (i > 0)
-        {
-            preClipJson += ",";
-            postClipJson += ",";
-            thresholdsJson += ",";
-        }
-        preClipJson += juce::String(preClip[i], 6);
-        postClipJson += juce::String(postClip[i], 6);
-        thresholdsJson += juce::String(thresholds[i], 6);
-    }
-
-    preClipJson += "]";
-    postClipJson += "]";
-    thresholdsJson += "]";
-
-    // Call JavaScript function to update the waveform
-    // preClip = after input gain, before clipping (RED - what gets clipped off)
-    // postClip = after clipping, before output gain (WHITE - what you hear)
-    juce::String js = "if (window.updateEnvelope) { window.updateEnvelope({ "
-                      "preClip: " + preClipJson + ", "
-                      "postClip: " + postClipJson + ", "
-                      "thresholds: " + thresholdsJson + ", "
-                      "writePos: " + juce::String(writePos) + " }); }";
-
-    webView.evaluateJavascript(js, nullptr);
+    // Only frames produced since the last tick; the WebView keeps the history
+    const int numFrames = audioProcessor.getEnvelopeFifo().pop(envelopeScratch.data(),
+                                                               static_cast<int>(envelopeScratch.size()));
+    if (numFrames == 0)
+        return;
+
+    // Frames are packed floats (preClip, postClip, threshold), so the bytes are
+    // already an interleaved Float32Array on the JS side
+    static_assert(sizeof(dsp::EnvelopeFrame) == 3 * sizeof(float), "EnvelopeFrame must be tightly packed");
+
+    auto* payload = new juce::DynamicObject();
+    payload->setProperty("count", numFrames);
+    payload->setProperty("frames", juce::Base64::toBase64(envelopeScratch.data(),
+                                                          static_cast<size_t>(numFrames) * sizeof(dsp::EnvelopeFrame)));
+
+    webView.emitEventIfBrowserIsVisible("envelopeFrames", juce::var(payload));
 }
 
-std::optional<juce::WebBrowserComponent::Resource> GuillotineEditor::getResource(const juce::String& url)
+void GuillotineEditor::pushProcessTimings()
 {
-    // Extract path from URL - handle both relative paths and full URLs
-    // WebView2 sends full URLs like "https://juce.backend/assets/base.png"
-    // We need to extract just "assets/base.png"
-    juce::String urlToRetrieve;
-
-    if (url == "/" || url.endsWithIgnoreCase("juce.backend/") || url.endsWithIgnoreCase("juce.backend"))
-    {
-        urlToRetrieve = "index.html";
-    }
-    else if (url.contains("juce.backend/"))
-    {
-        // Full URL: extract everything after "juce.backend/"
-        urlToRetrieve = url.fromLastOccurrenceOf("juce.backend/", false, true);
-    }
-    else if (url.startsWith("/"))
-    {
-        // Relative path like "/assets/base.png" -> "assets/base.png"
-        urlToRetrieve = url.substring(1);
-    }
-    else
+    // A few times a second is plenty for a readout; each push covers every
+    // block since the previous one
+    if (++ticksSinceTimings < RefreshScheduler::refreshRateHz / 4)
+        return;
+    ticksSinceTimings = 0;
+
+    const auto timings = audioProcessor.getStageProfiler().collect();
+    if (timings.blocks == 0)
+        return;
+
+    juce::Array<juce::var> stages;
+    for (int i = 0; i < dsp::ProcessTimings::kNumStages; ++i)
     {
-        // Already a relative path
-        urlToRetrieve = url;
+        const auto stage = static_cast<dsp::ProcessStage>(i);
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", dsp::getStageName(stage));
+        entry->setProperty("averageUs", timings.getAverageMicroseconds(timings[stage]));
+        entry->setProperty("maxUs", static_cast<double>(timings[stage].maxNanoseconds) / 1000.0);
+        stages.add(juce::var(entry));
     }
 
-    // Handle empty path (root)
-    if (urlToRetrieve.isEmpty())
-        urlToRetrieve = "index.html";
-
-    // Resource lookup table - add new web files here
-    struct ResourceEntry { const char* path; const void* data; int size; const char* mime; };
-    static const ResourceEntry resources[] = {
-        // HTML
-        { "index.html",              BinaryData::index_html,      BinaryData::index_htmlSize,      "text/html" },
-        // JavaScript - core
-        { "main.js",                 BinaryData::main_js,         BinaryData::main_jsSize,         "text/javascript" },
-        { "lib/juce-bridge.js",      BinaryData::jucebridge_js,   BinaryData::jucebridge_jsSize,   "text/javascript" },
-        { "lib/component-loader.js", BinaryData::componentloader_js, BinaryData::componentloader_jsSize, "text/javascript" },
-        { "lib/guillotine-utils.js", BinaryData::guillotineutils_js, BinaryData::guillotineutils_jsSize, "text/javascript" },
-        { "lib/svg-utils.js",        BinaryData::svgutils_js,       BinaryData::svgutils_jsSize,       "text/javascript" },
-        { "lib/theme.js",            BinaryData::theme_js,          BinaryData::theme_jsSize,          "text/javascript" },
-        { "lib/saturation-curves.js", BinaryData::saturationcurves_js, BinaryData::saturationcurves_jsSize, "text/javascript" },
-        { "lib/config.js",            BinaryData::config_js,         BinaryData::config_jsSize,         "text/javascript" },
-        { "lib/utils.js",             BinaryData::utils_js,          BinaryData::utils_jsSize,          "text/javascript" },
-        { "lib/delta-mode.css",      BinaryData::deltamode_css,     BinaryData::deltamode_cssSize,     "text/css" },
-        // JUCE frontend library
-        { "lib/juce/index.js",       BinaryData::index_js,        BinaryData::index_jsSize,        "text/javascript" },
-        { "lib/juce/check_native_interop.js", BinaryData::check_native_interop_js, BinaryData::check_native_interop_jsSize, "text/javascript" },
-        // Components - views
-        { "components/views/guillotine.js",   BinaryData::guillotine_js,   BinaryData::guillotine_jsSize,   "text/javascript" },
-        { "components/views/guillotine.css",  BinaryData::guillotine_css,  BinaryData::guillotine_cssSize,  "text/css" },
-        { "components/views/microscope.js",   BinaryData::microscope_js,   BinaryData::microscope_jsSize,   "text/javascript" },
-        { "components/views/microscope.css",  BinaryData::microscope_css,  BinaryData::microscope_cssSize,  "text/css" },
-        // Components - controls
-        { "components/controls/knob.js",   BinaryData::knob_js,   BinaryData::knob_jsSize,   "text/javascript" },
-        { "components/controls/knob.css",  BinaryData::knob_css,  BinaryData::knob_cssSize,  "text/css" },
-        { "components/controls/lever.js",  BinaryData::lever_js,  BinaryData::lever_jsSize,  "text/javascript" },
-        { "components/controls/lever.css", BinaryData::lever_css, BinaryData::lever_cssSize, "text/css" },
-        { "components/controls/toggle.js", BinaryData::toggle_js, BinaryData::toggle_jsSize, "text/javascript" },
-        // Components - display
-        { "components/display/waveform.js",   BinaryData::waveform_js,   BinaryData::waveform_jsSize,   "text/javascript" },
-        { "components/display/waveform.css",  BinaryData::waveform_css,  BinaryData::waveform_cssSize,  "text/css" },
-        { "components/display/digits.js",   BinaryData::digits_js,   BinaryData::digits_jsSize,   "text/javascript" },
-        { "components/display/digits.css",  BinaryData::digits_css,  BinaryData::digits_cssSize,  "text/css" },
-        { "components/display/blood-pool.js",   BinaryData::bloodpool_js,   BinaryData::bloodpool_jsSize,   "text/javascript" },
-        { "components/display/blood-pool.css",  BinaryData::bloodpool_css,  BinaryData::bloodpool_cssSize,  "text/css" },
-        // CSS - global
-        { "main.css",                BinaryData::main_css,        BinaryData::main_cssSize,        "text/css" },
-        // Assets
-        { "assets/base.png",         BinaryData::base_png,        BinaryData::base_pngSize,        "image/png" },
-        { "assets/blade.png",        BinaryData::blade_png,       BinaryData::blade_pngSize,       "image/png" },
-        { "assets/rope.png",         BinaryData::rope_png,        BinaryData::rope_pngSize,        "image/png" },
-        { "assets/side.png",         BinaryData::side_png,        BinaryData::side_pngSize,        "image/png" },
-        { "assets/switch.png",       BinaryData::switch_png,      BinaryData::switch_pngSize,      "image/png" },
-        { "assets/guillotine-logo.png", BinaryData::guillotinelogo_png, BinaryData::guillotinelogo_pngSize, "image/png" },
-        // Numeric sprites
-        { "assets/numeric/num-0.png",   BinaryData::num0_png,       BinaryData::num0_pngSize,       "image/png" },
-        { "assets/numeric/num-1.png",   BinaryData::num1_png,       BinaryData::num1_pngSize,       "image/png" },
-        { "assets/numeric/num-2.png",   BinaryData::num2_png,       BinaryData::num2_pngSize,       "image/png" },
-        { "assets/numeric/num-3.png",   BinaryData::num3_png,       BinaryData::num3_pngSize,       "image/png" },
-        { "assets/numeric/num-4.png",   BinaryData::num4_png,       BinaryData::num4_pngSize,       "image/png" },
-        { "assets/numeric/num-5.png",   BinaryData::num5_png,       BinaryData::num5_pngSize,       "image/png" },
-        { "assets/numeric/num-6.png",   BinaryData::num6_png,       BinaryData::num6_pngSize,       "image/png" },
-        { "assets/numeric/num-7.png",   BinaryData::num7_png,       BinaryData::num7_pngSize,       "image/png" },
-        { "assets/numeric/num-8.png",   BinaryData::num8_png,       BinaryData::num8_pngSize,       "image/png" },
-        { "assets/numeric/num-9.png",   BinaryData::num9_png,       BinaryData::num9_pngSize,       "image/png" },
-        { "assets/numeric/num-dot.png", BinaryData::numdot_png,     BinaryData::numdot_pngSize,     "image/png" },
-        // Text artwork for comparison
-        { "assets/text/text-1.png",     BinaryData::text1_png,      BinaryData::text1_pngSize,      "image/png" },
-        { "assets/text/text-2.png",     BinaryData::text2_png,      BinaryData::text2_pngSize,      "image/png" },
-        { "assets/text/text-lockslip.png", BinaryData::textlockslip_png, BinaryData::textlockslip_pngSize, "image/png" },
-        // Control labels (replacing font-rendered text)
-        { "assets/text/controls/andy.png",      BinaryData::andy_png,        BinaryData::andy_pngSize,        "image/png" },
-        { "assets/text/controls/blade.png",     BinaryData::blade_png2,      BinaryData::blade_png2Size,      "image/png" },
-        { "assets/text/controls/ceiling.png",   BinaryData::ceiling_png,     BinaryData::ceiling_pngSize,     "image/png" },
-        { "assets/text/controls/dB.png",        BinaryData::dB_png,          BinaryData::dB_pngSize,          "image/png" },
-        { "assets/text/controls/input.png",     BinaryData::input_png,       BinaryData::input_pngSize,       "image/png" },
-        { "assets/text/controls/output.png",    BinaryData::output_png,      BinaryData::output_pngSize,      "image/png" },
-        { "assets/text/controls/oversample.png", BinaryData::oversample_png, BinaryData::oversample_pngSize, "image/png" },
-        { "assets/text/controls/x.png",         BinaryData::x_png,           BinaryData::x_pngSize,           "image/png" },
-        // Curve type labels
-        { "assets/text/controls/blades/atan.png",  BinaryData::atan_png,   BinaryData::atan_pngSize,   "image/png" },
-        { "assets/text/controls/blades/cubic.png", BinaryData::cubic_png,  BinaryData::cubic_pngSize,  "image/png" },
-        { "assets/text/controls/blades/hard.png",  BinaryData::hard_png,   BinaryData::hard_pngSize,   "image/png" },
-        { "assets/text/controls/blades/knee.png",  BinaryData::knee_png,   BinaryData::knee_pngSize,   "image/png" },
-        { "assets/text/controls/blades/quint.png", BinaryData::quint_png,  BinaryData::quint_pngSize,  "image/png" },
-        { "assets/text/controls/blades/t2.png",    BinaryData::t2_png,     BinaryData::t2_pngSize,     "image/png" },
-        { "assets/text/controls/blades/tanh.png",  BinaryData::tanh_png,   BinaryData::tanh_pngSize,   "image/png" },
-        // Wood textures
-        { "assets/original/wood-1.png", BinaryData::wood1_png,      BinaryData::wood1_pngSize,      "image/png" },
-        { "assets/original/wood-2.png", BinaryData::wood2_png,      BinaryData::wood2_pngSize,      "image/png" },
-        { "assets/original/wood-3.png", BinaryData::wood3_png,      BinaryData::wood3_pngSize,      "image/png" },
-        // Fonts
-        { "assets/fonts/zeyada.ttf",    BinaryData::zeyada_ttf,     BinaryData::zeyada_ttfSize,     "application/x-font-ttf" },
-        { "assets/fonts/cedarville.ttf", BinaryData::cedarville_ttf, BinaryData::cedarville_ttfSize, "application/x-font-ttf" },
-        { "assets/fonts/dawning.ttf",   BinaryData::dawning_ttf,    BinaryData::dawning_ttfSize,    "application/x-font-ttf" },
-        // Textures
-        { "assets/grunge-texture.jpg",  BinaryData::grungetexture_jpg, BinaryData::grungetexture_jpgSize, "image/jpeg" },
-    };
-
-    for (const auto& res : resources)
-    {
-        if (urlToRetrieve == res.path)
-        {
-            std::vector<std::byte> bytes(res.size);
-            std::memcpy(bytes.data(), res.data, res.size);
-            return juce::WebBrowserComponent::Resource { std::move(bytes), juce::String(res.mime) };
-        }
-    }
+    auto* payload = new juce::DynamicObject();
+    payload->setProperty("load", timings.getLoadPercent());
+    payload->setProperty("maxLoad", timings.maxLoadPercent);
+    payload->setProperty("blockAverageUs", timings.getAverageMicroseconds(timings.block));
+    payload->setProperty("blockMaxUs", static_cast<double>(timings.block.maxNanoseconds) / 1000.0);
+    payload->setProperty("stages", stages);
 
-    return std::nullopt;
+    webView.emitEventIfBrowserIsVisible("processTimings", juce::var(payload));
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "PluginProcessor.h"
+#include "RefreshScheduler.h"
 
-class GuillotineEditor : public juce::AudioProcessorEditor, private juce::Timer
+class GuillotineEditor : public juce::AudioProcessorEditor, private RefreshScheduler::Client
 {
 public:
     explicit GuillotineEditor(GuillotineProcessor&);
@@ -13,13 +15,21 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
-    std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url);
+    void refresh() override;
+    void refreshSkipped() override;
     void pushEnvelopeData();
     void pushVersionOnce();
+    void pushProcessTimings();
 
     GuillotineProcessor& audioProcessor;
     bool versionPushed = false;
+    int ticksSinceTimings = 0;
+
+    // Shared 60Hz tick across every open editor
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+
+    // Frames drained from the processor's EnvelopeFifo, sent to the WebView as-is
+    std::array<dsp::EnvelopeFrame, dsp::EnvelopeFifo::defaultCapacity> envelopeScratch{};
 
     // WebView relay objects (bridge between WebView and parameters)
     juce::WebSliderRelay inputGainRelay;
@@ -14,10 +14,85 @@ GuillotineProcessor::GuillotineProcessor()
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 #endif
 {
+    parameterValues = { apvts.getRawParameterValue("inputGain"),
+                        apvts.getRawParameterValue("outputGain"),
+                        apvts.getRawParameterValue("ceiling"),
+                        apvts.getRawParameterValue("curve"),
+                        apvts.getRawParameterValue("curveExponent"),
+                        apvts.getRawParameterValue("oversampling"),
+                        apvts.getRawParameterValue("filterType"),
+                        apvts.getRawParameterValue("oversamplingEngine"),
+                        apvts.getRawParameterValue("filterQuality"),
+                        apvts.getRawParameterValue("autoOversampling"),
+                        apvts.getRawParameterValue("antialiasing"),
+                        apvts.getRawParameterValue("curveEvaluation"),
+                        apvts.getRawParameterValue("channelMode"),
+                        apvts.getRawParameterValue("stereoLink"),
+                        apvts.getRawParameterValue("deltaMonitor"),
+                        apvts.getRawParameterValue("bypassClipper"),
+                        apvts.getRawParameterValue("enforceCeiling"),
+                        apvts.getRawParameterValue("ceilingMode") };
+
+    for (auto* parameter : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            apvts.addParameterListener(ranged->getParameterID(), this);
+
+    startTimerHz(curveTableServiceHz);
 }
 
 GuillotineProcessor::~GuillotineProcessor()
 {
+    stopTimer();
+
+    for (auto* parameter : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            apvts.removeParameterListener(ranged->getParameterID(), this);
+}
+
+void GuillotineProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+    parameterVersion.fetch_add(1, std::memory_order_release);
+}
+
+void GuillotineProcessor::timerCallback()
+{
+    dsp::CurveLookup::serviceRequests();
+    clipperEngine.serviceRequests();
+    clipperEngineDouble.serviceRequests();
+}
+
+const dsp::EngineParameters& GuillotineProcessor::updateParameterSnapshot()
+{
+    // Version first: a change landing while the values are read bumps it again,
+    // so the next block picks it up
+    const std::uint32_t version = parameterVersion.load(std::memory_order_acquire);
+    if (version == parameterSnapshot.version)
+        return parameterSnapshot;
+
+    const auto& values = parameterValues;
+    auto& snapshot = parameterSnapshot;
+    snapshot.version = version;
+    snapshot.inputGain = values.inputGain->load();
+    snapshot.outputGain = values.outputGain->load();
+    snapshot.ceiling = values.ceiling->load();
+    snapshot.curve = static_cast<int>(values.curve->load());
+    snapshot.curveExponent = values.curveExponent->load();
+    // Choice index maps directly to factor index: 0=1x, 1=2x, ... 5=32x
+    snapshot.oversampling = static_cast<int>(values.oversampling->load());
+    snapshot.filterType = static_cast<int>(values.filterType->load());
+    snapshot.polyphaseAllpass = static_cast<int>(values.oversamplingEngine->load()) == 1;
+    snapshot.efficientFilters = static_cast<int>(values.filterQuality->load()) == 1;
+    snapshot.autoOversampling = values.autoOversampling->load() > 0.5f;
+    snapshot.antialiasing = static_cast<int>(values.antialiasing->load());
+    snapshot.curveTable = static_cast<int>(values.curveEvaluation->load()) == 1;
+    snapshot.midSide = static_cast<int>(values.channelMode->load()) == 1;
+    snapshot.stereoLink = values.stereoLink->load() > 0.5f;
+    snapshot.deltaMonitor = values.deltaMonitor->load() > 0.5f;
+    snapshot.bypass = values.bypassClipper->load() > 0.5f;
+    snapshot.enforceCeiling = values.enforceCeiling->load() > 0.5f;
+    snapshot.truePeak = static_cast<int>(values.ceilingMode->load()) == 1;
+    return snapshot;
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout GuillotineProcessor::createParameterLayout()
@@ -67,13 +142,47 @@ juce::AudioProcessorValueTreeState::ParameterLayout GuillotineProcessor::createP
         0.0f,
         juce::AudioParameterFloatAttributes().withLabel("dB")));
 
-    // Filter type: 0=Minimum Phase, 1=Linear Phase
+    // Filter type: 0=Minimum Phase, 1=Linear Phase, 2=Low Latency
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID{"filterType", 1},
         "Filter Type",
-        juce::StringArray{"Minimum Phase", "Linear Phase"},
+        juce::StringArray{"Minimum Phase", "Linear Phase", "Low Latency"},
+        0));
+
+    // Oversampling engine: 0=JUCE, 1=Polyphase Allpass (minimum phase only)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"oversamplingEngine", 1},
+        "Oversampling Engine",
+        juce::StringArray{"JUCE", "Polyphase Allpass"},
+        0));
+
+    // Filter quality: 0=High, 1=Efficient (JUCE stages past 2x get cheaper designs)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"filterQuality", 1},
+        "Filter Quality",
+        juce::StringArray{"High", "Efficient"},
+        0));
+
+    // Anti-aliasing: 0=Off, 1=ADAA 1st Order, 2=ADAA 2nd Order (clean soft curves at 1x-2x)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"antialiasing", 1},
+        "Anti-Aliasing",
+        juce::StringArray{"Off", "ADAA 1st Order", "ADAA 2nd Order"},
+        0));
+
+    // Curve evaluation: 0=Approximation, 1=Lookup Table (Tanh/Arctan/T2 from an interpolated table)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"curveEvaluation", 1},
+        "Curve Evaluation",
+        juce::StringArray{"Approximation", "Lookup Table"},
         0));
 
+    // Auto oversampling: quiet blocks skip the oversampler (same latency either way)
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"autoOversampling", 1},
+        "Auto Oversampling",
+        false));
+
     // Channel mode: 0=L/R, 1=M/S
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID{"channelMode", 1},
@@ -105,6 +214,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout GuillotineProcessor::createP
         "True Clip",
         true));  // Default to enforced (true peak safe)
 
+    // Ceiling mode: 0=Sample Peak (hard clamp), 1=True Peak (lookahead ISP limiter, adds latency)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"ceilingMode", 1},
+        "Ceiling Mode",
+        juce::StringArray{"Sample Peak", "True Peak"},
+        0));
+
     return {params.begin(), params.end()};
 }
 
@@ -176,17 +292,36 @@ void GuillotineProcessor::prepareToPlay(double newSampleRate, int samplesPerBloc
     sampleRate = newSampleRate;
     testOscPhase = 0.0;
 
-    clipperEngine.prepare(newSampleRate, samplesPerBlock, getTotalNumInputChannels());
+    // The host sets the precision before preparing
+    if (isUsingDoublePrecision())
+        prepareEngine(clipperEngineDouble, samplesPerBlock);
+    else
+        prepareEngine(clipperEngine, samplesPerBlock);
+}
 
-    // Read and apply oversampling settings so latency is correct from the start
-    // (Some hosts cache latency at load time and don't update when it changes)
-    int oversamplingChoice = static_cast<int>(apvts.getRawParameterValue("oversampling")->load());
-    int filterType = static_cast<int>(apvts.getRawParameterValue("filterType")->load());
-    clipperEngine.setOversamplingFactor(oversamplingChoice);
-    clipperEngine.setFilterType(filterType == 1);
+template <typename SampleType>
+void GuillotineProcessor::prepareEngine(dsp::BasicClipperEngine<SampleType>& engine, int samplesPerBlock)
+{
+    // Offline bounces split the oversampling filters across spare cores, live
+    // playback stays on the host's audio thread. The threads exist either way
+    // (parked while live), as hosts may switch modes without preparing again
+    const int numChannels = getTotalNumInputChannels();
+    const int spareCores = juce::SystemStats::getNumCpus() - 1;
+    engine.setWorkerThreads(std::max(0, std::min(spareCores, numChannels - 1)));
+    nonRealtimeRequested.store(isNonRealtime(), std::memory_order_relaxed);
+    engine.setWorkerThreadsActive(isNonRealtime());
+    engine.setOversamplerBuildsDeferred(false);
+
+    engine.prepare(sampleRate, samplesPerBlock, numChannels);
+    engine.setChannelLayout(dsp::ChannelLayout::fromChannelSet(getChannelLayoutOfBus(true, 0)));
+
+    // Apply every parameter so latency is correct from the start (oversampling,
+    // true peak lookahead and ADAA all add to it). Some hosts cache latency at
+    // load time and don't update when it changes
+    engine.setParameters(updateParameterSnapshot());
 
     // Report initial latency
-    int initialLatency = clipperEngine.getLatencyInSamples();
+    int initialLatency = engine.getLatencyInSamples();
     setLatencySamples(initialLatency);
     lastReportedLatency = initialLatency;
 }
@@ -195,6 +330,12 @@ void GuillotineProcessor::releaseResources()
 {
 }
 
+void GuillotineProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    nonRealtimeRequested.store(isNonRealtime, std::memory_order_relaxed);
+}
+
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool GuillotineProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
@@ -202,8 +343,10 @@ bool GuillotineProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
     juce::ignoreUnused(layouts);
     return true;
 #else
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() &&
-        layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Mono, stereo and surround up to 9.1.6 - the engine takes any channel count,
+    // ChannelLayout maps M/S pairs and link groups from the speaker types
+    const auto& mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput.isDisabled() || mainOutput.size() > maxBusChannels)
         return false;
 
 #if ! JucePlugin_IsSynth
@@ -219,6 +362,19 @@ bool GuillotineProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 void GuillotineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ignoreUnused(midiMessages);
+    processWithEngine(clipperEngine, buffer);
+}
+
+void GuillotineProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    processWithEngine(clipperEngineDouble, buffer);
+}
+
+template <typename SampleType>
+void GuillotineProcessor::processWithEngine(dsp::BasicClipperEngine<SampleType>& engine,
+                                            juce::AudioBuffer<SampleType>& buffer)
+{
     juce::ScopedNoDenormals noDenormals;
 
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -228,38 +384,18 @@ void GuillotineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Get parameter values from APVTS
-    float inputGainDb = apvts.getRawParameterValue("inputGain")->load();
-    float outputGainDb = apvts.getRawParameterValue("outputGain")->load();
-    int curveType = static_cast<int>(apvts.getRawParameterValue("curve")->load());
-    float curveExponent = apvts.getRawParameterValue("curveExponent")->load();
-    float ceilingDb = apvts.getRawParameterValue("ceiling")->load();
-    int oversamplingChoice = static_cast<int>(apvts.getRawParameterValue("oversampling")->load());
-    int filterType = static_cast<int>(apvts.getRawParameterValue("filterType")->load());
-    int channelMode = static_cast<int>(apvts.getRawParameterValue("channelMode")->load());
-    bool stereoLink = apvts.getRawParameterValue("stereoLink")->load() > 0.5f;
-    bool deltaMonitor = apvts.getRawParameterValue("deltaMonitor")->load() > 0.5f;
-    bool bypassClipper = apvts.getRawParameterValue("bypassClipper")->load() > 0.5f;
-    bool enforceCeiling = apvts.getRawParameterValue("enforceCeiling")->load() > 0.5f;
-
-    // Choice index now directly maps to factor index: 0=1x, 1=2x, ... 5=32x
-    int oversamplingFactor = oversamplingChoice;
-
-    // Update clipper engine parameters
-    clipperEngine.setInputGain(inputGainDb);
-    clipperEngine.setOutputGain(outputGainDb);
-    clipperEngine.setCurve(curveType);
-    clipperEngine.setCurveExponent(curveExponent);
-    clipperEngine.setCeiling(ceilingDb);
-    clipperEngine.setOversamplingFactor(oversamplingFactor);
-    clipperEngine.setFilterType(filterType == 1);  // 1 = linear phase
-    clipperEngine.setChannelMode(channelMode == 1);  // 1 = M/S
-    clipperEngine.setStereoLink(stereoLink);
-    clipperEngine.setDeltaMonitor(deltaMonitor);
-    clipperEngine.setEnforceCeiling(enforceCeiling);
+    // Parameters only reach the engine when one of them changed. Live, a new
+    // oversampling configuration is built off the audio thread (timerCallback)
+    // and switched to a block or two later; offline it's built right here
+    const bool nonRealtime = nonRealtimeRequested.load(std::memory_order_relaxed);
+    const auto& parameters = updateParameterSnapshot();
+    engine.setOversamplerBuildsDeferred(! nonRealtime);
+    engine.setParameters(parameters);
+    engine.setWorkerThreadsActive(nonRealtime);
+    engine.setClipMetering(clipMeterRequested.load(std::memory_order_relaxed));
 
     // Update latency if changed
-    int currentLatency = clipperEngine.getLatencyInSamples();
+    int currentLatency = engine.getLatencyInSamples();
     if (currentLatency != lastReportedLatency)
     {
         setLatencySamples(currentLatency);
@@ -272,7 +408,7 @@ void GuillotineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     {
         const double testOscFreq = 1.0;
         const double phaseIncrement = testOscFreq / sampleRate;
-        float inputGainLinear = juce::Decibels::decibelsToGain(inputGainDb);
+        float inputGainLinear = juce::Decibels::decibelsToGain(parameters.inputGain);
 
         for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
         {
@@ -293,36 +429,15 @@ void GuillotineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // Engine captures synchronized peaks internally:
     // - preClipPeak: after input gain, before clipping (RED - what gets clipped off)
     // - postClipPeak: after clipping, before output gain (WHITE - what you hear)
-    clipperEngine.setBypass(bypassClipper);
-    clipperEngine.process(buffer);
-
-    // Get peaks from engine (both captured in the same process() call, synchronized)
-    float enginePreClipPeak = clipperEngine.getLastPreClipPeak();
-    float enginePostClipPeak = clipperEngine.getLastPostClipPeak();
-
-    // Accumulate peaks across blocks
-    if (enginePreClipPeak > preClipPeak)
-        preClipPeak = enginePreClipPeak;
-    if (enginePostClipPeak > postClipPeak)
-        postClipPeak = enginePostClipPeak;
-
-    // Track samples and write to ring buffer at intervals
-    // Use 'if' not 'while' - only write one point per block to avoid writing
-    // zeros when multiple envelope points would be written from one block
-    samplesSincePeak += buffer.getNumSamples();
+    engine.process(buffer);
 
-    if (samplesSincePeak >= samplesPerEnvelopePoint)
+    // Envelope bins completed by this block (both peaks captured in the same
+    // process() call, synchronized) go to the editor as whole frames
+    const float threshold = -parameters.ceiling / displayDbRange;
+    for (int i = 0; i < engine.getNumEnvelopeBins(); ++i)
     {
-        int writePos = envelopeWritePos.load();
-        envelopePreClip[writePos] = preClipPeak;
-        envelopePostClip[writePos] = postClipPeak;
-        envelopeClipThresholds[writePos] = -ceilingDb / displayDbRange;
-        writePos = (writePos + 1) % envelopeBufferSize;
-        envelopeWritePos.store(writePos);
-
-        preClipPeak = 0.0f;
-        postClipPeak = 0.0f;
-        samplesSincePeak = 0;  // Reset fully instead of subtracting
+        const auto& bin = engine.getEnvelopeBin(i);
+        envelopeFifo.push({ bin.preClip, bin.postClip, threshold });
     }
 }
 
@@ -1,26 +1,33 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <array>
-#include <atomic>
 #include "dsp/ClipperEngine.h"
+#include "dsp/EnvelopeFifo.h"
 
-class GuillotineProcessor : public juce::AudioProcessor
+class GuillotineProcessor : public juce::AudioProcessor,
+                            private juce::AudioProcessorValueTreeState::Listener,
+                            private juce::Timer
 {
 public:
     // Display dB range for threshold visualization (-60 to 0 dB)
     static constexpr float displayDbRange = 60.0f;
 
-    // Envelope buffer for waveform display
-    // ~400 points at 5ms intervals = 2 seconds of history
+    // Envelope history shown by the waveform display
+    // ~400 points at 5ms intervals (dsp::EnvelopeBins, any sample rate) = 2 seconds of history
     static constexpr int envelopeBufferSize = 400;
-    static constexpr int samplesPerEnvelopePoint = 220;  // ~5ms at 44.1kHz
+
+    // Widest main bus accepted (9.1.6)
+    static constexpr int maxBusChannels = 16;
+
     GuillotineProcessor();
     ~GuillotineProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -47,13 +54,24 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // Envelope buffer access for GUI
+    // Envelope frames for the GUI (audio thread pushes, editor drains)
     // PreClip = after input gain, before clipping (RED in display - what gets clipped off)
     // PostClip = after input gain AND clipping, before output gain (WHITE in display - what you hear)
-    const std::array<float, envelopeBufferSize>& getEnvelopePreClip() const { return envelopePreClip; }
-    const std::array<float, envelopeBufferSize>& getEnvelopePostClip() const { return envelopePostClip; }
-    const std::array<float, envelopeBufferSize>& getEnvelopeClipThresholds() const { return envelopeClipThresholds; }
-    const std::atomic<int>& getEnvelopeWritePosition() const { return envelopeWritePos; }
+    dsp::EnvelopeFifo& getEnvelopeFifo() { return envelopeFifo; }
+
+    // Gain-reduction statistics accumulated since the last collect (lock-free).
+    // Metering is off until the first call - the next block turns it on
+    dsp::ClipMeter& getClipMeter()
+    {
+        clipMeterRequested.store(true, std::memory_order_relaxed);
+        return isUsingDoublePrecision() ? clipperEngineDouble.getClipMeter() : clipperEngine.getClipMeter();
+    }
+
+    // Per-stage timing and DSP load since the last collect (lock-free), see dsp::StageProfiler
+    dsp::StageProfiler& getStageProfiler()
+    {
+        return isUsingDoublePrecision() ? clipperEngineDouble.getStageProfiler() : clipperEngine.getStageProfiler();
+    }
 
     // Test oscillator for UI development (1Hz ramp)
     void setTestOscEnabled(bool enabled) { testOscEnabled = enabled; }
@@ -62,14 +80,46 @@ public:
 private:
     juce::AudioProcessorValueTreeState apvts;
 
-    // Ring buffer for envelope visualization (peak detection)
-    std::array<float, envelopeBufferSize> envelopePreClip{};     // After input gain, before clipping (RED)
-    std::array<float, envelopeBufferSize> envelopePostClip{};    // After clipping, before output gain (WHITE)
-    std::array<float, envelopeBufferSize> envelopeClipThresholds{};  // Store threshold used for each envelope point
-    std::atomic<int> envelopeWritePos{0};
-    float preClipPeak = 0.0f;
-    float postClipPeak = 0.0f;
-    int samplesSincePeak = 0;
+    // Raw parameter values, looked up by ID once at construction
+    struct ParameterValues
+    {
+        std::atomic<float>* inputGain;
+        std::atomic<float>* outputGain;
+        std::atomic<float>* ceiling;
+        std::atomic<float>* curve;
+        std::atomic<float>* curveExponent;
+        std::atomic<float>* oversampling;
+        std::atomic<float>* filterType;
+        std::atomic<float>* oversamplingEngine;
+        std::atomic<float>* filterQuality;
+        std::atomic<float>* autoOversampling;
+        std::atomic<float>* antialiasing;
+        std::atomic<float>* curveEvaluation;
+        std::atomic<float>* channelMode;
+        std::atomic<float>* stereoLink;
+        std::atomic<float>* deltaMonitor;
+        std::atomic<float>* bypassClipper;
+        std::atomic<float>* enforceCeiling;
+        std::atomic<float>* ceilingMode;
+    };
+    ParameterValues parameterValues;
+
+    // Bumped by parameterChanged() (any thread) after the value is stored. The
+    // audio thread re-reads parameterValues into the snapshot only when it moved
+    std::atomic<std::uint32_t> parameterVersion { 1 };
+    dsp::EngineParameters parameterSnapshot;
+
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    const dsp::EngineParameters& updateParameterSnapshot();
+
+    // Passes curve table and oversampling configuration requests from the
+    // audio thread on to their builders (dsp::CurveLookup::serviceRequests,
+    // BasicClipperEngine::serviceRequests), which the audio thread can't wake
+    static constexpr int curveTableServiceHz = 30;
+    void timerCallback() override;
+
+    // Lock-free envelope transport to the editor (peak detection)
+    dsp::EnvelopeFifo envelopeFifo;
 
     // Test oscillator (1Hz ramp for UI development)
 #if defined(JUCE_DEBUG) && JucePlugin_Build_Standalone
@@ -80,10 +130,25 @@ private:
     double testOscPhase = 0.0;
     double sampleRate = 44100.0;
 
-    // DSP engine
+    // DSP engine, one per processing precision - only the one the host asked
+    // for is prepared
     dsp::ClipperEngine clipperEngine;
+    dsp::ClipperEngineDouble clipperEngineDouble;
     int lastReportedLatency = 0;
 
+    // Set by setNonRealtime() (any thread), applied to the engine's worker
+    // threads at the next block
+    std::atomic<bool> nonRealtimeRequested { false };
+
+    // Set once a reader asks for the clip meter, see getClipMeter()
+    std::atomic<bool> clipMeterRequested { false };
+
+    template <typename SampleType>
+    void prepareEngine(dsp::BasicClipperEngine<SampleType>& engine, int samplesPerBlock);
+
+    template <typename SampleType>
+    void processWithEngine(dsp::BasicClipperEngine<SampleType>& engine, juce::AudioBuffer<SampleType>& buffer);
+
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GuillotineProcessor)
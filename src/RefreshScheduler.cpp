@@ -0,0 +1,41 @@
+#include "RefreshScheduler.h"
+
+#include <algorithm>
+
+RefreshScheduler::~RefreshScheduler()
+{
+    stopTimer();
+}
+
+void RefreshScheduler::add(juce::Component& component, Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    entries.push_back({ &component, &client });
+
+    if (!isTimerRunning())
+        startTimerHz(refreshRateHz);
+}
+
+void RefreshScheduler::remove(Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&client](const Entry& e) { return e.client == &client; }),
+                  entries.end());
+
+    if (entries.empty())
+        stopTimer();
+}
+
+void RefreshScheduler::timerCallback()
+{
+    // Index loop: a client may remove itself from inside its callback
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const auto entry = entries[i];
+        if (entry.component->isShowing())
+            entry.client->refresh();
+        else
+            entry.client->refreshSkipped();
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+// One 60Hz timer for every open editor in the process, instead of one Timer
+// per editor. Hold it through a juce::SharedResourcePointer: the first editor
+// creates it, the last one to close destroys it, and the timer only runs while
+// at least one client is registered.
+//
+// Each tick, clients whose component is showing get refresh(); hidden or
+// minimized ones get refreshSkipped() so they can drop work they will never
+// display, without touching their WebView.
+//
+// Message thread only.
+class RefreshScheduler : private juce::Timer
+{
+public:
+    static constexpr int refreshRateHz = 60;
+
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        virtual void refresh() = 0;
+        virtual void refreshSkipped() {}
+    };
+
+    RefreshScheduler() = default;
+    ~RefreshScheduler() override;
+
+    // component decides visibility; client is ticked until remove()
+    void add(juce::Component& component, Client& client);
+    void remove(Client& client);
+
+private:
+    void timerCallback() override;
+
+    struct Entry
+    {
+        juce::Component* component;
+        Client* client;
+    };
+
+    std::vector<Entry> entries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};
@@ -0,0 +1,214 @@
+#include "WebResources.h"
+#include "BinaryData.h"
+
+#include <array>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace web {
+
+namespace {
+
+struct ResourceEntry
+{
+    const char* path;
+    const char* data;
+    int size;
+    const char* mime;
+    bool gzipped;
+};
+
+// Text files are embedded as <file>.gz (BinaryData::<name>_gz) in gzipped builds
+#if GUILLOTINE_GZIPPED_WEB
+ #define GUILLOTINE_WEB_TEXT(path, name, mime) { path, BinaryData::name##_gz, BinaryData::name##_gzSize, mime, true }
+#else
+ #define GUILLOTINE_WEB_TEXT(path, name, mime) { path, BinaryData::name, BinaryData::name##Size, mime, false }
+#endif
+#define GUILLOTINE_WEB_FILE(path, name, mime) { path, BinaryData::name, BinaryData::name##Size, mime, false }
+
+// Resource table - add new web files here
+const ResourceEntry resources[] = {
+    // HTML
+    GUILLOTINE_WEB_TEXT("index.html", index_html, "text/html"),
+    // JavaScript - core
+    GUILLOTINE_WEB_TEXT("main.js", main_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/juce-bridge.js", jucebridge_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/component-loader.js", componentloader_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/guillotine-utils.js", guillotineutils_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/svg-utils.js", svgutils_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/theme.js", theme_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/saturation-curves.js", saturationcurves_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/config.js", config_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/utils.js", utils_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/delta-mode.css", deltamode_css, "text/css"),
+    // JUCE frontend library
+    GUILLOTINE_WEB_TEXT("lib/juce/index.js", index_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("lib/juce/check_native_interop.js", check_native_interop_js, "text/javascript"),
+    // Components - views
+    GUILLOTINE_WEB_TEXT("components/views/guillotine.js", guillotine_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/views/guillotine.css", guillotine_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/views/microscope.js", microscope_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/views/microscope.css", microscope_css, "text/css"),
+    // Components - controls
+    GUILLOTINE_WEB_TEXT("components/controls/knob.js", knob_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/controls/knob.css", knob_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/controls/lever.js", lever_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/controls/lever.css", lever_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/controls/toggle.js", toggle_js, "text/javascript"),
+    // Components - display
+    GUILLOTINE_WEB_TEXT("components/display/waveform.js", waveform_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/display/waveform.css", waveform_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/display/digits.js", digits_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/display/digits.css", digits_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/display/blood-pool.js", bloodpool_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/display/blood-pool.css", bloodpool_css, "text/css"),
+    GUILLOTINE_WEB_TEXT("components/display/timing-overlay.js", timingoverlay_js, "text/javascript"),
+    GUILLOTINE_WEB_TEXT("components/display/timing-overlay.css", timingoverlay_css, "text/css"),
+    // CSS - global
+    GUILLOTINE_WEB_TEXT("main.css", main_css, "text/css"),
+    // Assets
+    GUILLOTINE_WEB_FILE("assets/base.png", base_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/blade.png", blade_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/rope.png", rope_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/side.png", side_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/switch.png", switch_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/guillotine-logo.png", guillotinelogo_png, "image/png"),
+    // Numeric sprites
+    GUILLOTINE_WEB_FILE("assets/numeric/num-0.png", num0_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-1.png", num1_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-2.png", num2_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-3.png", num3_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-4.png", num4_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-5.png", num5_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-6.png", num6_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-7.png", num7_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-8.png", num8_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-9.png", num9_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/numeric/num-dot.png", numdot_png, "image/png"),
+    // Text artwork for comparison
+    GUILLOTINE_WEB_FILE("assets/text/text-1.png", text1_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/text-2.png", text2_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/text-lockslip.png", textlockslip_png, "image/png"),
+    // Control labels (replacing font-rendered text)
+    GUILLOTINE_WEB_FILE("assets/text/controls/andy.png", andy_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blade.png", blade_png2, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/ceiling.png", ceiling_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/dB.png", dB_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/input.png", input_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/output.png", output_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/oversample.png", oversample_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/x.png", x_png, "image/png"),
+    // Curve type labels
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/atan.png", atan_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/cubic.png", cubic_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/hard.png", hard_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/knee.png", knee_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/quint.png", quint_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/t2.png", t2_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/text/controls/blades/tanh.png", tanh_png, "image/png"),
+    // Wood textures
+    GUILLOTINE_WEB_FILE("assets/original/wood-1.png", wood1_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/original/wood-2.png", wood2_png, "image/png"),
+    GUILLOTINE_WEB_FILE("assets/original/wood-3.png", wood3_png, "image/png"),
+    // Fonts
+    GUILLOTINE_WEB_FILE("assets/fonts/zeyada.ttf", zeyada_ttf, "application/x-font-ttf"),
+    GUILLOTINE_WEB_FILE("assets/fonts/cedarville.ttf", cedarville_ttf, "application/x-font-ttf"),
+    GUILLOTINE_WEB_FILE("assets/fonts/dawning.ttf", dawning_ttf, "application/x-font-ttf"),
+    // Textures
+    GUILLOTINE_WEB_FILE("assets/grunge-texture.jpg", grungetexture_jpg, "image/jpeg"),
+
+};
+
+#undef GUILLOTINE_WEB_TEXT
+#undef GUILLOTINE_WEB_FILE
+
+constexpr size_t numResources = std::size(resources);
+
+// Path -> index into resources, built on first use
+const std::unordered_map<std::string_view, size_t>& pathIndex()
+{
+    static const auto index = []
+    {
+        std::unordered_map<std::string_view, size_t> map;
+        map.reserve(numResources);
+        for (size_t i = 0; i < numResources; ++i)
+            map.emplace(resources[i].path, i);
+        return map;
+    }();
+    return index;
+}
+
+// Inflated text files, filled in on first request and kept for the process
+struct InflatedResource
+{
+    std::once_flag inflated;
+    std::vector<std::byte> bytes;
+};
+
+const std::vector<std::byte>& inflate(size_t index)
+{
+    static std::array<InflatedResource, numResources> cache;
+
+    auto& cached = cache[index];
+    std::call_once(cached.inflated, [&cached, &entry = resources[index]]
+    {
+        juce::MemoryInputStream compressed(entry.data, static_cast<size_t>(entry.size), false);
+        juce::GZIPDecompressorInputStream decompressor(compressed, juce::GZIPDecompressorInputStream::gzipFormat);
+
+        juce::MemoryBlock block;
+        decompressor.readIntoMemoryBlock(block);
+
+        const auto* begin = static_cast<const std::byte*>(block.getData());
+        cached.bytes.assign(begin, begin + block.getSize());
+    });
+    return cached.bytes;
+}
+
+} // namespace
+
+juce::String resourcePathFromUrl(const juce::String& url)
+{
+    // WebView2 sends full URLs like "https://juce.backend/assets/base.png"
+    juce::String path;
+
+    if (url == "/" || url.endsWithIgnoreCase("juce.backend/") || url.endsWithIgnoreCase("juce.backend"))
+        path = "index.html";
+    else if (url.contains("juce.backend/"))
+        path = url.fromLastOccurrenceOf("juce.backend/", false, true);
+    else if (url.startsWith("/"))
+        path = url.substring(1);
+    else
+        path = url;
+
+    return path.isEmpty() ? juce::String("index.html") : path;
+}
+
+std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url)
+{
+    const auto path = resourcePathFromUrl(url).toStdString();
+    const auto& index = pathIndex();
+    const auto found = index.find(path);
+    if (found == index.end())
+        return std::nullopt;
+
+    // Resource owns its bytes, so each request still copies once
+    const auto& entry = resources[found->second];
+    if (entry.gzipped)
+        return juce::WebBrowserComponent::Resource { inflate(found->second), juce::String(entry.mime) };
+
+    const auto* begin = reinterpret_cast<const std::byte*>(entry.data);
+    return juce::WebBrowserComponent::Resource { std::vector<std::byte>(begin, begin + entry.size),
+                                                 juce::String(entry.mime) };
+}
+
+juce::File getUserDataFolder()
+{
+    static const auto folder = juce::File::getSpecialLocation(juce::File::SpecialLocationType::tempDirectory)
+                                   .getChildFile("Guillotine-WebView2");
+    return folder;
+}
+
+} // namespace web
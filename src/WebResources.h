@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <optional>
+
+// Editor web assets out of BinaryData, shared by every editor in the process.
+//
+// The path index is built once, on first use, and looked up by hash. Text
+// files (HTML/JS/CSS) are embedded gzipped when the build sets
+// GUILLOTINE_GZIPPED_WEB (CMake option GUILLOTINE_COMPRESS_WEB); each one is
+// inflated on its first request and kept for the life of the process, so
+// later editors only copy the bytes into the Resource JUCE takes ownership of.
+// Images and fonts are already compressed and are served straight from
+// BinaryData.
+//
+// Safe to call from any thread.
+namespace web {
+
+// "https://juce.backend/assets/base.png", "/assets/base.png" -> "assets/base.png",
+// and the root -> "index.html"
+juce::String resourcePathFromUrl(const juce::String& url);
+
+std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url);
+
+// WebView2 user data folder shared by every editor. One stable folder (rather
+// than the bare temp directory) lets all instances attach to the same browser
+// environment, and keeps its code/HTTP cache warm between sessions.
+juce::File getUserDataFolder();
+
+} // namespace web
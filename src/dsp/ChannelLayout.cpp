@@ -0,0 +1,54 @@
+#include "ChannelLayout.h"
+
+namespace dsp {
+
+ChannelLayout ChannelLayout::fromChannelSet(const juce::AudioChannelSet& channelSet)
+{
+    using Type = juce::AudioChannelSet::ChannelType;
+
+    // Left/right counterparts, front to back, then height
+    static constexpr std::pair<Type, Type> speakerPairs[] = {
+        { juce::AudioChannelSet::left, juce::AudioChannelSet::right },
+        { juce::AudioChannelSet::leftCentre, juce::AudioChannelSet::rightCentre },
+        { juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight },
+        { juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround },
+        { juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide },
+        { juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear },
+        { juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight },
+        { juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight },
+        { juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight },
+    };
+
+    ChannelLayout layout;
+    const int numChannels = channelSet.size();
+
+    // Mono and unnamed (discrete) channels keep the plain stereo behaviour
+    if (numChannels <= 2 || channelSet.isDiscreteLayout())
+        return layout;
+
+    layout.midSidePairs.clear();
+    for (const auto& [leftType, rightType] : speakerPairs)
+    {
+        const int left = channelSet.getChannelIndexForType(leftType);
+        const int right = channelSet.getChannelIndexForType(rightType);
+        if (left >= 0 && right >= 0)
+            layout.midSidePairs.emplace_back(left, right);
+    }
+
+    layout.linkGroups.assign(static_cast<size_t>(numChannels), 0);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto type = channelSet.getTypeOfChannel(ch);
+        if (type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2)
+            layout.linkGroups[static_cast<size_t>(ch)] = -1;
+    }
+
+    return layout;
+}
+
+ChannelLayout ChannelLayout::forChannelCount(int numChannels)
+{
+    return fromChannelSet(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+}
+
+} // namespace dsp
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <utility>
+#include <vector>
+
+namespace dsp {
+
+// How the engine treats the channels of a bus: which (left, right) pairs M/S
+// mode encodes, and which channels stereo link ties together.
+//
+// Speaker pairs come from the channel types, so the order a host uses (film or
+// SMPTE) doesn't matter. LFE channels are never linked: their content has
+// nothing to do with the mains, and ducking the mains under a sub hit (or the
+// sub under a vocal) is audible.
+struct ChannelLayout
+{
+    std::vector<std::pair<int, int>> midSidePairs { { 0, 1 } };
+
+    // Per channel, as for Clipper::setLinkGroups. Empty links every channel
+    std::vector<int> linkGroups;
+
+    static ChannelLayout fromChannelSet(const juce::AudioChannelSet& channelSet);
+
+    // The layout a host would most likely use for this many channels
+    static ChannelLayout forChannelCount(int numChannels);
+};
+
+} // namespace dsp
@@ -0,0 +1,115 @@
+#include "ClipMeter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+
+namespace {
+
+// Linear ratios for the 1 dB histogram edge and the clip threshold
+const float kOneDbRatio = std::pow(10.0f, -1.0f / 20.0f);
+const float kClipThresholdRatio = std::pow(10.0f, -ClipStats::kClipThresholdDb / 20.0f);
+const float kMinRatio = std::pow(10.0f, -ClipStats::kMaxGainReductionDb / 20.0f);
+
+} // namespace
+
+void ClipStats::addFrame(float ratio)
+{
+    ++totalFrames;
+
+    // Most frames are untouched or barely touched - no log needed for them
+    if (ratio >= kOneDbRatio)
+    {
+        ++histogram[0];
+        if (ratio < kClipThresholdRatio)
+        {
+            ++clippedFrames;
+            maxGainReductionDb = std::max(maxGainReductionDb, -20.0f * std::log10(ratio));
+        }
+        return;
+    }
+
+    const float reductionDb = -20.0f * std::log10(std::max(ratio, kMinRatio));
+    const int bin = std::min(static_cast<int>(reductionDb), kNumHistogramBins - 1);
+
+    ++histogram[static_cast<size_t>(bin)];
+    ++clippedFrames;
+    maxGainReductionDb = std::max(maxGainReductionDb, reductionDb);
+}
+
+void ClipStats::merge(const ClipStats& other)
+{
+    maxGainReductionDb = std::max(maxGainReductionDb, other.maxGainReductionDb);
+    clippedFrames += other.clippedFrames;
+    totalFrames += other.totalFrames;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        histogram[i] += other.histogram[i];
+
+    blocks += other.blocks;
+    skippedBlocks += other.skippedBlocks;
+}
+
+float ClipStats::getClipPercentage() const
+{
+    if (totalFrames == 0)
+        return 0.0f;
+    return 100.0f * static_cast<float>(static_cast<double>(clippedFrames) / static_cast<double>(totalFrames));
+}
+
+ClipMeter::ClipMeter()
+{
+    reset();
+}
+
+void ClipMeter::publish(const ClipStats& blockStats)
+{
+    // CAS so a collect() resetting the max in between can't hide this block's peak
+    float currentMax = maxGainReductionDb.load(std::memory_order_relaxed);
+    while (blockStats.maxGainReductionDb > currentMax
+           && !maxGainReductionDb.compare_exchange_weak(currentMax, blockStats.maxGainReductionDb,
+                                                        std::memory_order_relaxed))
+    {
+    }
+
+    clippedFrames.fetch_add(blockStats.clippedFrames, std::memory_order_relaxed);
+    totalFrames.fetch_add(blockStats.totalFrames, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        if (blockStats.histogram[i] != 0)
+            histogram[i].fetch_add(blockStats.histogram[i], std::memory_order_relaxed);
+
+    blocks.fetch_add(blockStats.blocks, std::memory_order_relaxed);
+    skippedBlocks.fetch_add(blockStats.skippedBlocks, std::memory_order_relaxed);
+}
+
+ClipStats ClipMeter::collect()
+{
+    ClipStats stats;
+    stats.maxGainReductionDb = maxGainReductionDb.exchange(0.0f, std::memory_order_relaxed);
+    stats.clippedFrames = clippedFrames.exchange(0, std::memory_order_relaxed);
+    stats.totalFrames = totalFrames.exchange(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        stats.histogram[i] = histogram[i].exchange(0, std::memory_order_relaxed);
+
+    stats.blocks = blocks.exchange(0, std::memory_order_relaxed);
+    stats.skippedBlocks = skippedBlocks.exchange(0, std::memory_order_relaxed);
+
+    return stats;
+}
+
+void ClipMeter::reset()
+{
+    maxGainReductionDb.store(0.0f, std::memory_order_relaxed);
+    clippedFrames.store(0, std::memory_order_relaxed);
+    totalFrames.store(0, std::memory_order_relaxed);
+
+    for (auto& bin : histogram)
+        bin.store(0, std::memory_order_relaxed);
+
+    blocks.store(0, std::memory_order_relaxed);
+    skippedBlocks.store(0, std::memory_order_relaxed);
+}
+
+} // namespace dsp
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace dsp {
+
+// Gain-reduction statistics for one or more blocks, counted per frame at the
+// clip (oversampled) rate. A frame is metered by the ratio |out| / |in| of its
+// most reduced channel (gain reduction = -20 log10 of it), so stereo-linked and
+// independent clipping meter the same way.
+struct ClipStats
+{
+    static constexpr int kNumHistogramBins = 24;        // 1 dB wide, the last bin collects 23 dB and up
+    static constexpr float kClipThresholdDb = 0.1f;     // Reduction that counts a frame as clipped
+    static constexpr float kMaxGainReductionDb = 120.0f;
+
+    float maxGainReductionDb = 0.0f;
+    std::uint64_t clippedFrames = 0;
+    std::uint64_t totalFrames = 0;
+    std::array<std::uint64_t, kNumHistogramBins> histogram {};
+
+    // Processed blocks, and those that never reached the oversampler (digital
+    // silence, or auto oversampling asleep)
+    std::uint64_t blocks = 0;
+    std::uint64_t skippedBlocks = 0;
+
+    void clear() { *this = ClipStats {}; }
+
+    // ratio = |out| / |in| for one frame (1 = untouched)
+    void addFrame(float ratio);
+
+    // Frames that skipped the clipper entirely (auto oversampling asleep)
+    void addUntouchedFrames(std::uint64_t count)
+    {
+        totalFrames += count;
+        histogram[0] += count;
+    }
+
+    void addBlock(bool skipped)
+    {
+        ++blocks;
+        skippedBlocks += skipped ? 1 : 0;
+    }
+
+    void merge(const ClipStats& other);
+
+    // Share of frames in clip, 0-100
+    float getClipPercentage() const;
+};
+
+// Lock-free accumulator for reading ClipStats on another thread (GUI, analysis).
+// The audio thread publishes each block; a single reader collects everything
+// published since its last collect. Fields are independent atomics, so a
+// collect racing a publish can split one block between two reads - totals
+// still add up.
+class ClipMeter
+{
+public:
+    ClipMeter();
+
+    // Audio thread
+    void publish(const ClipStats& blockStats);
+
+    // Reader: returns and clears the accumulated statistics
+    ClipStats collect();
+
+    // Only while neither side is active
+    void reset();
+
+private:
+    std::atomic<float> maxGainReductionDb;
+    std::atomic<std::uint64_t> clippedFrames;
+    std::atomic<std::uint64_t> totalFrames;
+    std::array<std::atomic<std::uint64_t>, ClipStats::kNumHistogramBins> histogram;
+    std::atomic<std::uint64_t> blocks;
+    std::atomic<std::uint64_t> skippedBlocks;
+};
+
+} // namespace dsp
@@ -1,90 +1,730 @@
 #include "Clipper.h"
+#include "RealtimeScope.h"
+#include "SaturatorKernels.h"
+#include <algorithm>
 #include <cmath>
-#include <vector>
+#include <type_traits>
 
 namespace dsp {
 
-void Clipper::setCeiling(float linearAmplitude)
+namespace {
+
+constexpr int kMeterChunkSize = 64;
+constexpr float kMeterFloor = 1e-6f;  // -120 dB: quieter inputs count as untouched
+
+// Input steps below this use the midpoint fallback instead of dividing
+// antiderivative differences (ill-conditioned, and 0/0 for a constant input)
+constexpr double kAdaaEpsilon = 1e-5;
+
+// What ADAA outputs where the curve is linear: the half-sample average (first
+// order) or the three-sample average (second order). x1/x2 are the inputs
+// before in[0] and are advanced past the block; out may alias in
+template <typename SampleType>
+void adaaLinearResponse(const SampleType* in, SampleType* out, int numSamples,
+                        typename BasicClipper<SampleType>::Antialiasing mode, double& x1, double& x2)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // A NaN kept in the history would never leave it
+        const double x0 = std::isfinite(in[i]) ? static_cast<double>(in[i]) : 0.0;
+        const double y = (mode == BasicClipper<SampleType>::Antialiasing::Adaa1) ? 0.5 * (x0 + x1) : (x0 + x1 + x2) / 3.0;
+        x2 = x1;
+        x1 = x0;
+        out[i] = static_cast<SampleType>(y);
+    }
+}
+
+// Normalized ADAA input. A NaN kept in the history would never leave it
+template <typename SampleType>
+double adaaInput(SampleType in, double invCeiling)
+{
+    return std::isfinite(in) ? static_cast<double>(in) * invCeiling : 0.0;
+}
+
+// One ADAA stream, the curve averaged over each step of its input. Keeps the
+// stream's history in locals while a block runs and stores it back after
+template <typename SampleType, CurveType Curve, int Order>
+class AdaaStream
+{
+public:
+    template <typename State>
+    AdaaStream(const State& state, float curveExponent)
+        : exponent(curveExponent), x1(state.x1), x2(state.x2),
+          previousAntiderivative(state.antiderivative), previousDifference(state.difference)
+    {
+    }
+
+    template <typename State>
+    void store(State& state) const
+    {
+        state.x1 = x1;
+        state.x2 = x2;
+        state.antiderivative = previousAntiderivative;
+        state.difference = previousDifference;
+    }
+
+    // What next(x0) returns where the curve is linear
+    double linear(double x0) const { return (Order == 1) ? 0.5 * (x0 + x1) : (x0 + x1 + x2) / 3.0; }
+
+    double next(double x0)
+    {
+        double y;
+
+        if constexpr (Order == 1)
+        {
+            // Mean of the curve over [x1, x0]
+            const double ad = antiderivative1(x0);
+            const double step = x0 - x1;
+            y = (std::abs(step) < kAdaaEpsilon) ? curve(0.5 * (x0 + x1)) : (ad - previousAntiderivative) / step;
+            previousAntiderivative = ad;
+        }
+        else
+        {
+            // Divided difference of the first-order means over [x2, x1, x0]
+            const double ad = antiderivative2(x0);
+            const double step = x0 - x1;
+            const double difference = (std::abs(step) < kAdaaEpsilon) ? antiderivative1(0.5 * (x0 + x1))
+                                                                      : (ad - previousAntiderivative) / step;
+            const double span = x0 - x2;
+
+            if (std::abs(span) >= kAdaaEpsilon)
+            {
+                y = 2.0 * (difference - previousDifference) / span;
+            }
+            else
+            {
+                // x0 ~ x2: expand around their midpoint instead
+                const double mid = 0.5 * (x0 + x2);
+                const double delta = mid - x1;
+                y = (std::abs(delta) < kAdaaEpsilon)
+                    ? curve(0.5 * (mid + x1))
+                    : (2.0 / delta) * (antiderivative1(mid) + (previousAntiderivative - antiderivative2(mid)) / delta);
+            }
+
+            x2 = x1;
+            previousAntiderivative = ad;
+            previousDifference = difference;
+        }
+
+        x1 = x0;
+        return y;
+    }
+
+private:
+    double curve(double x) const
+    {
+        return static_cast<double>(curves::apply(Curve, static_cast<SampleType>(x), exponent));
+    }
+    double antiderivative1(double x) const { return curves::antiderivative1(Curve, x, exponent); }
+    double antiderivative2(double x) const { return curves::antiderivative2(Curve, x, exponent); }
+
+    float exponent;
+    double x1;
+    double x2;
+    double previousAntiderivative;
+    double previousDifference;
+};
+
+} // namespace
+
+template <typename SampleType>
+BasicClipper<SampleType>::BasicClipper()
+{
+    updateBlockLoops();
+    prepare(2);
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::prepare(int maxNumChannels)
+{
+    const auto numChannels = static_cast<size_t>(std::max(maxNumChannels, 0));
+    channelPtrs.assign(numChannels, nullptr);
+    chunkPtrs.assign(numChannels, nullptr);
+    meterInput.assign(numChannels * kMeterChunkSize, 0.0f);
+    allChannels.resize(numChannels);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        allChannels[ch] = static_cast<int>(ch);
+    prepareHistory(ownHistory);
+
+    // Only a clipper using tables keeps the builder thread around
+    if (curveTableEnabled)
+    {
+        curveLookup.prepare();
+        if (CurveTable::isTabulated(curveType))
+            curveLookup.build(curveType, curveExponent);
+    }
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::prepareHistory(AdaaHistory& history) const
+{
+    history.prepare(static_cast<int>(allChannels.size()));
+    history.curveVersion = curveVersion - 1;  // Cached antiderivatives are refreshed on first use
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::setCeiling(float linearAmplitude)
 {
     ceiling = linearAmplitude;
 }
 
-void Clipper::setCurve(CurveType newCurve)
+template <typename SampleType>
+void BasicClipper<SampleType>::setCurve(CurveType newCurve)
 {
+    // Setters run every block - cached ADAA antiderivatives only go stale on a change
+    if (newCurve != curveType)
+        ++curveVersion;
+
     curveType = newCurve;
+    updateBlockLoops();
 }
 
-void Clipper::setCurveExponent(float exponent)
+template <typename SampleType>
+void BasicClipper<SampleType>::setCurveExponent(float exponent)
 {
+    // Setters run every block - the kernels' knee constants only change with it
+    if (exponent != curveExponent)
+    {
+        ++curveVersion;
+        curveParams = curves::makeCurveParams(exponent);
+    }
+
     curveExponent = exponent;
 }
 
-void Clipper::setStereoLink(bool enabled)
+template <typename SampleType>
+void BasicClipper<SampleType>::setStereoLink(bool enabled)
 {
+    // Linked ADAA runs on peak streams the histories only track while linked
+    if (enabled != stereoLinkEnabled)
+        ++curveVersion;
+
     stereoLinkEnabled = enabled;
 }
 
-float Clipper::processSample(float sample) const
+template <typename SampleType>
+void BasicClipper<SampleType>::setLinkGroups(const std::vector<int>& groupOfChannel)
+{
+    linkGroupOfChannel = groupOfChannel;
+    groupChannels.clear();
+    groupStarts.clear();
+
+    const int numGroups = groupOfChannel.empty() ? 0 : *std::max_element(groupOfChannel.begin(), groupOfChannel.end()) + 1;
+    for (int group = 0; group < numGroups; ++group)
+    {
+        groupStarts.push_back(static_cast<int>(groupChannels.size()));
+        for (int ch = 0; ch < static_cast<int>(groupOfChannel.size()); ++ch)
+            if (groupOfChannel[static_cast<size_t>(ch)] == group)
+                groupChannels.push_back(ch);
+    }
+    groupStarts.push_back(static_cast<int>(groupChannels.size()));
+
+    groupPtrs.assign(groupChannels.size(), nullptr);
+    ++curveVersion;  // Regroups the linked ADAA peak streams
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::setAntialiasing(Antialiasing mode)
 {
-    return curves::applyWithCeiling(curveType, sample, ceiling, curveExponent);
+    // Switching order changes what the history caches
+    if (mode != antialiasing)
+        ownHistory.reset();
+
+    antialiasing = mode;
+    updateBlockLoops();
 }
 
-float Clipper::calculateGainReduction(float peakLevel) const
+template <typename SampleType>
+void BasicClipper<SampleType>::setCurveTable(bool enabled)
 {
-    // Only check for zero to avoid division by zero
-    // Don't skip based on ceiling - soft curves shape signal at all levels
-    if (peakLevel <= 0.0f)
-        return 1.0f;
+    curveTableEnabled = enabled;
+    if (enabled)
+        curveLookup.prepare();
+}
 
-    float targetPeak = std::abs(processSample(peakLevel));
-    return targetPeak / peakLevel;
+template <typename SampleType>
+void BasicClipper<SampleType>::setCurveTablePrecision(CurveTable::Precision precision)
+{
+    curveLookup.setPrecision(precision);
 }
 
-void Clipper::processInternal(float* const* channelData, int numChannels, int numSamples)
+template <typename SampleType>
+float BasicClipper<SampleType>::getAntialiasingDelay() const
 {
-    if (stereoLinkEnabled && numChannels >= 2)
+    switch (antialiasing)
     {
-        // Stereo link: find max peak across channels, apply same gain reduction
+        case Antialiasing::Adaa1: return 0.5f;
+        case Antialiasing::Adaa2: return 1.0f;
+        case Antialiasing::Off:
+        default:                  return 0.0f;
+    }
+}
+
+// =============================================================================
+// Specialized inner loops
+// =============================================================================
+
+template <typename SampleType>
+template <CurveType Curve, bool Linked>
+void BasicClipper<SampleType>::processBlock(SampleType* const* channelData, int numChannels, int numSamples) const
+{
+    const auto blockCeiling = static_cast<SampleType>(ceiling);
+
+    if constexpr (Linked)
+    {
+        // Stereo link: one gain per frame from the max peak across channels
         // Always process - soft curves shape signal at all levels, not just above ceiling
-        for (int i = 0; i < numSamples; ++i)
+        curves::applyLinkedBlock<Curve>(channelData, numChannels, numSamples, blockCeiling, curveParams, activeTable);
+    }
+    else
+    {
+        // Independent channel processing - whole-block SIMD kernel per channel
+        for (int ch = 0; ch < numChannels; ++ch)
+            curves::applyBlock<Curve>(channelData[ch], numSamples, blockCeiling, curveParams, activeTable);
+    }
+}
+
+template <typename SampleType>
+typename BasicClipper<SampleType>::BlockLoop BasicClipper<SampleType>::selectBlockLoop(CurveType curve, bool linked)
+{
+    auto loopFor = [linked](auto curveConstant) -> BlockLoop
+    {
+        constexpr CurveType c = decltype(curveConstant)::value;
+        return linked ? &BasicClipper::template processBlock<c, true> : &BasicClipper::template processBlock<c, false>;
+    };
+
+    switch (curve)
+    {
+        case CurveType::Quintic: return loopFor(std::integral_constant<CurveType, CurveType::Quintic>{});
+        case CurveType::Cubic:   return loopFor(std::integral_constant<CurveType, CurveType::Cubic>{});
+        case CurveType::Tanh:    return loopFor(std::integral_constant<CurveType, CurveType::Tanh>{});
+        case CurveType::Arctan:  return loopFor(std::integral_constant<CurveType, CurveType::Arctan>{});
+        case CurveType::Knee:    return loopFor(std::integral_constant<CurveType, CurveType::Knee>{});
+        case CurveType::T2:      return loopFor(std::integral_constant<CurveType, CurveType::T2>{});
+        case CurveType::Hard:
+        default:                 return loopFor(std::integral_constant<CurveType, CurveType::Hard>{});
+    }
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::updateBlockLoops()
+{
+    linkedLoop = selectBlockLoop(curveType, true);
+    independentLoop = selectBlockLoop(curveType, false);
+    adaaLoop = selectAdaaLoop(curveType, antialiasing, false);
+    linkedAdaaLoop = selectAdaaLoop(curveType, antialiasing, true);
+}
+
+// =============================================================================
+// Antiderivative anti-aliasing
+// =============================================================================
+
+template <typename SampleType>
+template <CurveType Curve, int Order, bool Linked>
+void BasicClipper<SampleType>::processAdaa(SampleType* const* channelData, int numChannels, int numSamples,
+                                           AdaaHistory& history) const
+{
+    if (history.curveVersion != curveVersion)
+        refreshHistory(history);
+
+    // prepareHistory() sizes histories for every channel prepare() allowed for.
+    // Channels past one prepared for fewer (before a larger prepare) still
+    // clip, just without ADAA - never pass through unclipped
+    jassert(static_cast<size_t>(numChannels) <= history.channels.size());
+    const int adaaChannels = std::min(numChannels, static_cast<int>(history.channels.size()));
+    if (adaaChannels < numChannels)
+        (this->*independentLoop)(channelData + adaaChannels, numChannels - adaaChannels, numSamples);
+    numChannels = adaaChannels;
+
+    if constexpr (!Linked)
+    {
+        processAdaaChannels<Curve, Order>(channelData, allChannels.data(), numChannels, numSamples, history, nullptr);
+    }
+    else if (linkGroupOfChannel.empty())
+    {
+        processAdaaChannels<Curve, Order>(channelData, allChannels.data(), numChannels, numSamples, history,
+                                          history.links.empty() ? nullptr : &history.links.front());
+    }
+    else
+    {
+        const int numGroups = static_cast<int>(groupStarts.size()) - 1;
+        jassert(static_cast<size_t>(numGroups) <= history.links.size());
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            // Group channel lists are ascending, so the ones in this block come first
+            const int* channels = groupChannels.data() + groupStarts[static_cast<size_t>(group)];
+            const int groupEnd = groupStarts[static_cast<size_t>(group + 1)] - groupStarts[static_cast<size_t>(group)];
+            int groupSize = 0;
+            while (groupSize < groupEnd && channels[groupSize] < numChannels)
+                ++groupSize;
+
+            auto* link = (groupSize >= 2 && group < static_cast<int>(history.links.size()))
+                             ? &history.links[static_cast<size_t>(group)] : nullptr;
+            processAdaaChannels<Curve, Order>(channelData, channels, groupSize, numSamples, history, link);
+        }
+
+        // Unlinked channels, and channels past the end of the group list
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const bool grouped = ch < static_cast<int>(linkGroupOfChannel.size())
+                                 && linkGroupOfChannel[static_cast<size_t>(ch)] >= 0;
+            if (!grouped)
+                processAdaaChannels<Curve, Order>(channelData, &allChannels[static_cast<size_t>(ch)], 1, numSamples,
+                                                  history, nullptr);
+        }
+    }
+}
+
+template <typename SampleType>
+template <CurveType Curve, int Order>
+void BasicClipper<SampleType>::processAdaaChannels(SampleType* const* channelData, const int* channels, int count,
+                                                   int numSamples, AdaaHistory& history,
+                                                   typename AdaaHistory::Channel* link) const
+{
+    using Stream = AdaaStream<SampleType, Curve, Order>;
+
+    const double blockCeiling = ceiling;
+    const double invCeiling = 1.0 / blockCeiling;
+
+    if (link == nullptr)
+    {
+        for (int k = 0; k < count; ++k)
         {
-            float maxPeak = 0.0f;
-            for (int ch = 0; ch < numChannels; ++ch)
-                maxPeak = std::max(maxPeak, std::abs(channelData[ch][i]));
+            auto& state = history.channels[static_cast<size_t>(channels[k])];
+            SampleType* data = channelData[channels[k]];
+            Stream stream(state, curveExponent);
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = static_cast<SampleType>(stream.next(adaaInput(data[i], invCeiling)) * blockCeiling);
 
-            float gainReduction = calculateGainReduction(maxPeak);
-            for (int ch = 0; ch < numChannels; ++ch)
-                channelData[ch][i] *= gainReduction;
+            stream.store(state);
         }
+        return;
+    }
+
+    // Stereo link: the ADAA stream runs on the frame peak, and its output over
+    // what it would be unclipped is one gain for every channel's unclipped
+    // (delayed, smoothed) response. Where the curve is linear that gain is 1,
+    // and no channel's response exceeds the peak's, so the ceiling holds
+    Stream peakStream(*link, curveExponent);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double peak = 0.0;
+        for (int k = 0; k < count; ++k)
+            peak = std::max(peak, std::abs(adaaInput(channelData[channels[k]][i], invCeiling)));
+
+        const double linearPeak = peakStream.linear(peak);
+        const double shapedPeak = peakStream.next(peak);
+        const double gain = (linearPeak > kAdaaEpsilon) ? shapedPeak / linearPeak : 1.0;
+
+        for (int k = 0; k < count; ++k)
+        {
+            auto& state = history.channels[static_cast<size_t>(channels[k])];
+            SampleType& sample = channelData[channels[k]][i];
+            const double x0 = adaaInput(sample, invCeiling);
+            const double linear = (Order == 1) ? 0.5 * (x0 + state.x1) : (x0 + state.x1 + state.x2) / 3.0;
+            state.x2 = state.x1;
+            state.x1 = x0;
+            sample = static_cast<SampleType>(linear * gain * blockCeiling);
+        }
+    }
+
+    peakStream.store(*link);
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::refreshHistory(AdaaHistory& history) const
+{
+    auto refresh = [this](typename AdaaHistory::Channel& state)
+    {
+        if (antialiasing == Antialiasing::Adaa2)
+        {
+            state.antiderivative = curves::antiderivative2(curveType, state.x1, curveExponent);
+            const double step = state.x1 - state.x2;
+            state.difference = (std::abs(step) < kAdaaEpsilon)
+                ? curves::antiderivative1(curveType, 0.5 * (state.x1 + state.x2), curveExponent)
+                : (state.antiderivative - curves::antiderivative2(curveType, state.x2, curveExponent)) / step;
+        }
+        else
+        {
+            state.antiderivative = curves::antiderivative1(curveType, state.x1, curveExponent);
+        }
+    };
+
+    for (auto& state : history.channels)
+        refresh(state);
+
+    // Linked peak streams pick up from their channels' last inputs, which the
+    // channels keep whether or not they were linked
+    auto refreshLink = [&](typename AdaaHistory::Channel& link, const int* channels, int count)
+    {
+        link = {};
+        for (int k = 0; k < count; ++k)
+        {
+            if (channels[k] >= static_cast<int>(history.channels.size()))
+                break;
+
+            const auto& state = history.channels[static_cast<size_t>(channels[k])];
+            link.x1 = std::max(link.x1, std::abs(state.x1));
+            link.x2 = std::max(link.x2, std::abs(state.x2));
+        }
+        refresh(link);
+    };
+
+    if (linkGroupOfChannel.empty())
+    {
+        if (!history.links.empty())
+            refreshLink(history.links.front(), allChannels.data(),
+                        static_cast<int>(std::min(allChannels.size(), history.channels.size())));
     }
     else
     {
-        // Independent channel processing
+        const int numGroups = std::min(static_cast<int>(groupStarts.size()) - 1, static_cast<int>(history.links.size()));
+        for (int group = 0; group < numGroups; ++group)
+            refreshLink(history.links[static_cast<size_t>(group)],
+                        groupChannels.data() + groupStarts[static_cast<size_t>(group)],
+                        groupStarts[static_cast<size_t>(group + 1)] - groupStarts[static_cast<size_t>(group)]);
+    }
+
+    history.curveVersion = curveVersion;
+}
+
+template <typename SampleType>
+typename BasicClipper<SampleType>::AdaaLoop BasicClipper<SampleType>::selectAdaaLoop(CurveType curve, Antialiasing mode,
+                                                                                     bool linked)
+{
+    if (mode == Antialiasing::Off)
+        return nullptr;
+
+    auto loopFor = [mode, linked](auto curveConstant) -> AdaaLoop
+    {
+        constexpr CurveType c = decltype(curveConstant)::value;
+        if (linked)
+            return (mode == Antialiasing::Adaa1) ? &BasicClipper::template processAdaa<c, 1, true>
+                                                 : &BasicClipper::template processAdaa<c, 2, true>;
+        return (mode == Antialiasing::Adaa1) ? &BasicClipper::template processAdaa<c, 1, false>
+                                             : &BasicClipper::template processAdaa<c, 2, false>;
+    };
+
+    switch (curve)
+    {
+        case CurveType::Quintic: return loopFor(std::integral_constant<CurveType, CurveType::Quintic>{});
+        case CurveType::Cubic:   return loopFor(std::integral_constant<CurveType, CurveType::Cubic>{});
+        case CurveType::Tanh:    return loopFor(std::integral_constant<CurveType, CurveType::Tanh>{});
+        case CurveType::Arctan:  return loopFor(std::integral_constant<CurveType, CurveType::Arctan>{});
+        case CurveType::Knee:    return loopFor(std::integral_constant<CurveType, CurveType::Knee>{});
+        case CurveType::T2:      return loopFor(std::integral_constant<CurveType, CurveType::T2>{});
+        case CurveType::Hard:
+        default:                 return loopFor(std::integral_constant<CurveType, CurveType::Hard>{});
+    }
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::matchLinearResponse(SampleType* const* channelData, int numChannels, int numSamples,
+                                                   AdaaHistory& history) const
+{
+    if (antialiasing == Antialiasing::Off)
+        return;
+
+    // Sized by prepareHistory() - see processAdaa
+    jassert(static_cast<size_t>(numChannels) <= history.channels.size());
+    numChannels = std::min(numChannels, static_cast<int>(history.channels.size()));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& state = history.channels[static_cast<size_t>(ch)];
+        adaaLinearResponse(channelData[ch], channelData[ch], numSamples, antialiasing, state.x1, state.x2);
+    }
+}
+
+// =============================================================================
+// Processing
+// =============================================================================
+
+template <typename SampleType>
+template <typename Loop>
+void BasicClipper<SampleType>::processMetered(Loop&& loop, const AdaaHistory* history, SampleType* const* channelData,
+                                              int numChannels, int numSamples, ClipStats& stats)
+{
+    // More channels than prepare() allowed for would need a reallocation
+    jassert(static_cast<size_t>(numChannels) <= chunkPtrs.size());
+    numChannels = std::min(numChannels, static_cast<int>(chunkPtrs.size()));
+
+    float ratios[kMeterChunkSize];
+
+    for (int start = 0, n = 0; start < numSamples; start += n)
+    {
+        n = std::min(kMeterChunkSize, numSamples - start);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            chunkPtrs[static_cast<size_t>(ch)] = channelData[ch] + start;
+            SampleType* input = meterInput.data() + ch * kMeterChunkSize;
+
+            // ADAA delays and smooths the signal, so compare against what it would
+            // output unclipped - the raw input is half a sample off
+            if (history != nullptr)
+            {
+                const auto& state = history->channels[static_cast<size_t>(ch)];
+                double x1 = state.x1 * ceiling;
+                double x2 = state.x2 * ceiling;
+                adaaLinearResponse(channelData[ch] + start, input, n, antialiasing, x1, x2);
+            }
+            else
+            {
+                std::copy(channelData[ch] + start, channelData[ch] + start + n, input);
+            }
+
+            for (int i = 0; i < n; ++i)
+                input[i] = std::abs(input[i]);
+        }
+
+        loop(chunkPtrs.data(), numChannels, n);
+
+        // Per frame: the most reduced channel
+        std::fill(ratios, ratios + n, 1.0f);
         for (int ch = 0; ch < numChannels; ++ch)
         {
+            const SampleType* input = meterInput.data() + ch * kMeterChunkSize;
+            const SampleType* output = chunkPtrs[static_cast<size_t>(ch)];
+            for (int i = 0; i < n; ++i)
+            {
+                const float ratio = (input[i] > kMeterFloor) ? static_cast<float>(std::abs(output[i]) / input[i])
+                                                             : 1.0f;
+                ratios[i] = std::min(ratios[i], ratio);
+            }
+        }
+
+        for (int i = 0; i < n; ++i)
+            stats.addFrame(ratios[i]);
+    }
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::processLinkGroups(SampleType* const* channelData, int numChannels, int numSamples)
+{
+    const int numGroups = static_cast<int>(groupStarts.size()) - 1;
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        // Gather the group's channels that exist in this block
+        int groupSize = 0;
+        for (int i = groupStarts[static_cast<size_t>(group)]; i < groupStarts[static_cast<size_t>(group + 1)]; ++i)
+        {
+            const int ch = groupChannels[static_cast<size_t>(i)];
+            if (ch < numChannels)
+                groupPtrs[static_cast<size_t>(groupSize++)] = channelData[ch];
+        }
+
+        if (groupSize > 0)
+            (this->*(groupSize >= 2 ? linkedLoop : independentLoop))(groupPtrs.data(), groupSize, numSamples);
+    }
+
+    // Unlinked channels, and channels past the end of the group list
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const bool grouped = ch < static_cast<int>(linkGroupOfChannel.size())
+                             && linkGroupOfChannel[static_cast<size_t>(ch)] >= 0;
+        if (!grouped)
+            (this->*independentLoop)(channelData + ch, 1, numSamples);
+    }
+}
+
+template <typename SampleType>
+void BasicClipper<SampleType>::processInternal(SampleType* const* channelData, int numChannels, int numSamples,
+                                               ClipStats* stats, AdaaHistory* history)
+{
+    // A rebuilt table is picked up (or a new one requested) once per call
+    activeTable = (curveTableEnabled && adaaLoop == nullptr && CurveTable::isTabulated(curveType))
+                      ? curveLookup.acquire(curveType, curveExponent) : nullptr;
+
+    if (ceiling <= 0.0f)
+    {
+        // Every curve maps to silence at a zero ceiling
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::fill(channelData[ch], channelData[ch] + numSamples, SampleType(0));
+
+        if (stats != nullptr)
             for (int i = 0; i < numSamples; ++i)
-                channelData[ch][i] = processSample(channelData[ch][i]);
+                stats->addFrame(0.0f);
+
+        // The ADAA streams restart from the silence they just output, so the
+        // ceiling's return doesn't step from a stale input
+        if (adaaLoop != nullptr)
+        {
+            AdaaHistory& adaaHistory = (history != nullptr) ? *history : ownHistory;
+            adaaHistory.reset();
+            refreshHistory(adaaHistory);
         }
+        return;
+    }
+
+    const bool linked = stereoLinkEnabled && numChannels >= 2;
+
+    if (adaaLoop != nullptr)
+    {
+        AdaaHistory& adaaHistory = (history != nullptr) ? *history : ownHistory;
+        const AdaaLoop loopFn = linked ? linkedAdaaLoop : adaaLoop;
+        auto loop = [this, &adaaHistory, loopFn](SampleType* const* data, int channels, int n)
+        {
+            (this->*loopFn)(data, channels, n, adaaHistory);
+        };
+
+        if (stats != nullptr)
+            processMetered(loop, &adaaHistory, channelData, numChannels, numSamples, *stats);
+        else
+            loop(channelData, numChannels, numSamples);
+        return;
     }
+
+    if (linked && !linkGroupOfChannel.empty())
+    {
+        auto loop = [this](SampleType* const* data, int channels, int n) { processLinkGroups(data, channels, n); };
+
+        if (stats != nullptr)
+            processMetered(loop, nullptr, channelData, numChannels, numSamples, *stats);
+        else
+            loop(channelData, numChannels, numSamples);
+        return;
+    }
+
+    const BlockLoop blockLoop = linked ? linkedLoop : independentLoop;
+    auto loop = [this, blockLoop](SampleType* const* data, int channels, int n) { (this->*blockLoop)(data, channels, n); };
+
+    if (stats != nullptr)
+        processMetered(loop, nullptr, channelData, numChannels, numSamples, *stats);
+    else
+        loop(channelData, numChannels, numSamples);
 }
 
-void Clipper::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void BasicClipper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer)
 {
+    RealtimeScope realtime;
     processInternal(buffer.getArrayOfWritePointers(),
                     buffer.getNumChannels(),
                     buffer.getNumSamples());
 }
 
-void Clipper::process(juce::dsp::AudioBlock<float>& block)
+template <typename SampleType>
+void BasicClipper<SampleType>::process(juce::dsp::AudioBlock<SampleType>& block)
 {
-    const int numChannels = static_cast<int>(block.getNumChannels());
+    RealtimeScope realtime;
+
+    // More channels than prepare() allowed for would need a reallocation
+    jassert(block.getNumChannels() <= channelPtrs.size());
+    const int numChannels = static_cast<int>(std::min(block.getNumChannels(), channelPtrs.size()));
     const int numSamples = static_cast<int>(block.getNumSamples());
 
-    std::vector<float*> channelPtrs(static_cast<size_t>(numChannels));
     for (int ch = 0; ch < numChannels; ++ch)
         channelPtrs[static_cast<size_t>(ch)] = block.getChannelPointer(static_cast<size_t>(ch));
 
     processInternal(channelPtrs.data(), numChannels, numSamples);
 }
 
+template class BasicClipper<float>;
+template class BasicClipper<double>;
+
 } // namespace dsp
@@ -3,32 +3,190 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ClipMeter.h"
+#include "CurveTable.h"
 #include "SaturatorCurves.h"
+#include "SaturatorKernels.h"
 
 namespace dsp {
 
-class Clipper
+// SampleType is float or double. Ceiling, exponent and metering stay float.
+template <typename SampleType>
+class BasicClipper
 {
 public:
-    Clipper() = default;
+    // Antiderivative anti-aliasing: the output is the curve averaged over the
+    // step between input samples instead of sampled at each one, which
+    // suppresses aliasing enough to run at 1x-2x. First order adds half a
+    // sample of delay (at the clip rate), second order one sample.
+    // With stereo link the averaging runs on the linked peak, giving one gain
+    // per frame for every channel of the group
+    enum class Antialiasing { Off, Adaa1, Adaa2 };
+
+    // ADAA input history, one per signal stream fed through the clipper. Sized
+    // by the clipper (prepareHistory) so it always covers its channels
+    struct AdaaHistory
+    {
+        struct Channel
+        {
+            double x1 = 0.0;            // Previous normalized input
+            double x2 = 0.0;            // The one before (second order)
+            double antiderivative = 0.0; // F1(x1) or F2(x1), per order
+            double difference = 0.0;    // Second order: (F2(x1) - F2(x2)) / (x1 - x2)
+        };
+
+        std::vector<Channel> channels;
+        std::vector<Channel> links;      // Stereo link: peak stream per link group
+        std::uint32_t curveVersion = 0;  // Cached antiderivatives belong to this curve and linking
+
+        void reset()
+        {
+            std::fill(channels.begin(), channels.end(), Channel {});
+            std::fill(links.begin(), links.end(), Channel {});
+        }
+
+    private:
+        friend class BasicClipper;
+
+        void prepare(int numChannels)
+        {
+            channels.assign(static_cast<size_t>(std::max(numChannels, 0)), {});
+            links.assign(static_cast<size_t>(std::max(numChannels, 1)), {});
+        }
+    };
+
+    BasicClipper();
+
+    // Sizes the channel-pointer storage used by the AudioBlock overload and
+    // metering. With curve tables enabled, also joins the table builder and
+    // builds the current curve's table (see setCurveTable)
+    void prepare(int maxNumChannels);
 
-    void process(juce::AudioBuffer<float>& buffer);
-    void process(juce::dsp::AudioBlock<float>& block);
-    void processInternal(float* const* channelData, int numChannels, int numSamples);
+    // Sizes (and clears) a history for the channels prepare() allowed for.
+    // Allocates - call after prepare, not on the audio thread
+    void prepareHistory(AdaaHistory& history) const;
+
+    void process(juce::AudioBuffer<SampleType>& buffer);
+    void process(juce::dsp::AudioBlock<SampleType>& block);
+
+    // With stats, gain reduction is metered per frame as the block is clipped.
+    // With ADAA on, history carries the stream's past input (the clipper's own
+    // history when null)
+    void processInternal(SampleType* const* channelData, int numChannels, int numSamples,
+                         ClipStats* stats = nullptr, AdaaHistory* history = nullptr);
+
+    // Gives an unclipped copy of the stream the delay and smoothing ADAA applies
+    // in the curve's linear region ((x0 + x1) / 2, second order (x0 + x1 + x2) / 3),
+    // so dry - clipped is zero where nothing clips. Use a history of its own
+    void matchLinearResponse(SampleType* const* channelData, int numChannels, int numSamples,
+                             AdaaHistory& history) const;
 
     void setCeiling(float linearAmplitude);
     void setCurve(CurveType curve);
     void setCurveExponent(float exponent);
     void setStereoLink(bool enabled);
 
+    // Which channels stereo link ties together: groupOfChannel[ch] is a group
+    // index, negative for a channel that is always clipped on its own (LFE).
+    // Channels past the end are unlinked. Empty (the default) links every channel.
+    // Allocates - call from prepare, not the audio thread
+    void setLinkGroups(const std::vector<int>& groupOfChannel);
+    void setAntialiasing(Antialiasing mode);
+    Antialiasing getAntialiasing() const { return antialiasing; }
+
+    // Tanh, Arctan and T2 from an interpolated lookup table (CurveTable)
+    // instead of the approximation kernels. Tables are built on a background
+    // thread after prepare() - until the one for the current curve and exponent
+    // is ready the approximation runs. A curve change made while processing is
+    // built once CurveLookup::serviceRequests() runs on some non-realtime
+    // thread. ADAA keeps its exact antiderivatives.
+    // The first enable joins the builder thread (a lock, and starting the
+    // thread if no other clipper has), so enable before playback where possible
+    void setCurveTable(bool enabled);
+    bool isCurveTableActive() const { return activeTable != nullptr; }
+
+    // Table size and interpolation. Rebuilds the table - not on the audio thread
+    void setCurveTablePrecision(CurveTable::Precision precision);
+
+    // Delay ADAA adds, in clip-rate samples
+    float getAntialiasingDelay() const;
+
 private:
-    float processSample(float sample) const;
-    float calculateGainReduction(float peakLevel) const;
+    // One specialized block loop per (curve, stereo link) combination, selected
+    // in the setters. Each hands its curve to the kernels at compile time, so
+    // nothing switches on the curve per block
+    using BlockLoop = void (BasicClipper::*)(SampleType* const*, int, int) const;
+
+    template <CurveType Curve, bool Linked>
+    void processBlock(SampleType* const* channelData, int numChannels, int numSamples) const;
+
+    static BlockLoop selectBlockLoop(CurveType curve, bool linked);
+    void updateBlockLoops();
+
+    // Linked loop per link group, independent loop for everything else
+    void processLinkGroups(SampleType* const* channelData, int numChannels, int numSamples);
+
+    // ADAA loops, one per (curve, order, stereo link), selected like the block
+    // loops. The linked loop handles link groups itself
+    using AdaaLoop = void (BasicClipper::*)(SampleType* const*, int, int, AdaaHistory&) const;
+
+    template <CurveType Curve, int Order, bool Linked>
+    void processAdaa(SampleType* const* channelData, int numChannels, int numSamples, AdaaHistory& history) const;
+
+    // The listed channels, each on its own or (with a link stream) linked
+    template <CurveType Curve, int Order>
+    void processAdaaChannels(SampleType* const* channelData, const int* channels, int count, int numSamples,
+                             AdaaHistory& history, typename AdaaHistory::Channel* link) const;
+
+    static AdaaLoop selectAdaaLoop(CurveType curve, Antialiasing mode, bool linked);
+
+    // Recomputes a history's cached antiderivatives after a curve change
+    void refreshHistory(AdaaHistory& history) const;
+
+    // Runs a loop in short chunks, comparing each chunk against a copy of
+    // its input while both are still in L1
+    // history is set for the ADAA loops
+    template <typename Loop>
+    void processMetered(Loop&& loop, const AdaaHistory* history, SampleType* const* channelData,
+                        int numChannels, int numSamples, ClipStats& stats);
 
     float ceiling = 1.0f;
     float curveExponent = 2.0f;
+    curves::CurveParams curveParams = curves::makeCurveParams(2.0f);  // Rebuilt when the exponent changes
     CurveType curveType = CurveType::Hard;
     bool stereoLinkEnabled = false;
+
+    BlockLoop linkedLoop = nullptr;
+    BlockLoop independentLoop = nullptr;
+
+    // Link groups as channel lists: group g is groupChannels[groupStarts[g]..groupStarts[g + 1])
+    std::vector<int> linkGroupOfChannel;
+    std::vector<int> groupChannels;
+    std::vector<int> groupStarts;
+    std::vector<SampleType*> groupPtrs;
+    std::vector<int> allChannels;  // 0, 1, 2... sized in prepare()
+
+    Antialiasing antialiasing = Antialiasing::Off;
+    AdaaLoop adaaLoop = nullptr;
+    AdaaLoop linkedAdaaLoop = nullptr;
+    std::uint32_t curveVersion = 0;  // Bumped when the curve, exponent or linking changes
+    AdaaHistory ownHistory;
+
+    bool curveTableEnabled = false;
+    CurveLookup curveLookup;
+    const CurveTable* activeTable = nullptr;  // Picked up once per processInternal
+
+    // Channel pointers for process(AudioBlock) and metering, plus the metering
+    // input copy, fixed after prepare() - never resized on the audio thread
+    std::vector<SampleType*> channelPtrs;
+    std::vector<SampleType*> chunkPtrs;
+    std::vector<SampleType> meterInput;
 };
 
+using Clipper = BasicClipper<float>;
+
 } // namespace dsp
@@ -1,251 +1,1276 @@
 #include "ClipperEngine.h"
+#include "RealtimeScope.h"
+#include <algorithm>
 #include <cmath>
 
 namespace dsp {
 
-ClipperEngine::ClipperEngine()
+namespace {
+
+// Block size for the fused passes - small enough that a chunk of every channel
+// stays in L1 between the per-feature steps
+constexpr int kFusedChunkSize = 64;
+constexpr double kGainRampSeconds = 0.002;  // 2ms smoothing
+constexpr double kCrossfadeSeconds = 0.005; // 5ms oversampling switch fade
+
+// Oversampled blocks shorter than this (clip-rate samples) aren't worth
+// handing to the worker pool
+constexpr int kMinParallelSamples = 2048;
+
+// Auto oversampling
+constexpr double kAutoHoldSeconds = 0.1;    // Clip path stays on this long after a loud block
+constexpr int kAutoWarmupSamples = 256;     // Input replayed on wake-up, covers the longest filter
+constexpr float kAutoHeadroom = 0.5f;       // -6dB margin for intersample peaks when upsampled
+constexpr int kAutoMaxTaps = 3;             // Matched delay taps, second-order ADAA
+constexpr float kLinearTolerance = 1e-4f;   // Curve error (relative) treated as linear, -80dB
+
+// Normalized level up to which the curve passes the signal through (within
+// kLinearTolerance), 0 when it shapes every level (Arctan, T2 above 1)
+float findLinearLimit(CurveType curve, float exponent)
+{
+    const float stepUp = std::pow(10.0f, 0.5f / 20.0f);  // 0.5dB
+
+    // Up from -60dB - every level below the limit has to pass, not just the limit
+    float limit = 0.0f;
+    float x = 0.001f;
+    for (int i = 0; i <= 120; ++i, x *= stepUp)
+    {
+        if (std::abs(curves::apply(curve, x, exponent) - x) > kLinearTolerance * x)
+            break;
+        limit = std::min(x, 1.0f);
+    }
+
+    return limit;
+}
+
+void fillGainChunk(juce::SmoothedValue<float>& gain, float* gains, int numSamples)
+{
+    if (gain.isSmoothing())
+    {
+        for (int i = 0; i < numSamples; ++i)
+            gains[i] = gain.getNextValue();
+    }
+    else
+    {
+        std::fill(gains, gains + numSamples, gain.getTargetValue());
+    }
+}
+
+// Oversampler settings from their parameter values
+template <typename OversamplerType>
+typename OversamplerType::FilterType toFilterType(int filterTypeIndex)
+{
+    return static_cast<typename OversamplerType::FilterType>(std::clamp(filterTypeIndex, 0, 2));
+}
+
+template <typename OversamplerType>
+typename OversamplerType::Backend toBackend(bool usePolyphaseAllpass)
 {
-    inputGain.setGainDecibels(0.0f);
-    outputGain.setGainDecibels(0.0f);
+    return usePolyphaseAllpass ? OversamplerType::Backend::PolyphaseAllpass : OversamplerType::Backend::Juce;
 }
 
-void ClipperEngine::prepare(double sampleRate, int maxBlockSize, int numChannels)
+template <typename OversamplerType>
+typename OversamplerType::FilterQuality toFilterQuality(bool efficient)
+{
+    return efficient ? OversamplerType::FilterQuality::Efficient : OversamplerType::FilterQuality::High;
+}
+
+} // namespace
+
+template <typename SampleType>
+BasicClipperEngine<SampleType>::BasicClipperEngine() = default;
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::prepare(double sampleRate, int maxBlockSize, int numChannels)
 {
     currentSampleRate = sampleRate;
     currentNumChannels = numChannels;
+    hasAppliedParameters = false;
+
+    inputGain.reset(sampleRate, kGainRampSeconds);
+    outputGain.reset(sampleRate, kGainRampSeconds);
+    oversampler.prepare(sampleRate, maxBlockSize, numChannels, numWorkerThreads + 1);
+    clipper.prepare(numChannels);
+    for (auto* histories : { clipHistories, dryHistories })
+        for (int slot = 0; slot < 2; ++slot)
+            clipper.prepareHistory(histories[slot]);
+    envelopeBins.prepare(sampleRate, maxBlockSize);
+    stageProfiler.prepare(sampleRate);
+    truePeakLimiter.prepare(sampleRate, numChannels);
+    truePeakLimiter.setCeiling(ceilingLinear);
+
+    crossfadeBuffer.setSize(numChannels, maxBlockSize);
+    crossfadeLength = std::max(1, static_cast<int>(std::round(sampleRate * kCrossfadeSeconds)));
+    crossfadeRemaining = 0;
 
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize);
-    spec.numChannels = static_cast<juce::uint32>(numChannels);
+    // History holds this block plus the warm-up, which also covers every latency
+    autoHistory.setSize(numChannels, maxBlockSize + kAutoWarmupSamples);
+    autoDelayed.setSize(numChannels, maxBlockSize);
+    autoTapStates.assign(static_cast<size_t>(numChannels * kAutoMaxTaps * 2), SampleType(0));
+    autoHoldLength = static_cast<int>(std::round(sampleRate * kAutoHoldSeconds));
+    resetAutoOversampling();
 
-    inputGain.prepare(spec);
-    inputGain.setRampDurationSeconds(0.002);  // 2ms smoothing
-    outputGain.prepare(spec);
-    outputGain.setRampDurationSeconds(0.002);  // 2ms smoothing
-    oversampler.prepare(sampleRate, maxBlockSize, numChannels);
+    // Dry copy for delta monitoring lives at the oversampled rate - size for the max factor
+    const int maxFactor = 1 << (OversamplerType::NumFactors - 1);
+    dryBuffer.setSize(numChannels, maxBlockSize * maxFactor);
 
-    // Prepare dry buffer and oversampler for delta monitoring
-    dryBuffer.setSize(numChannels, maxBlockSize);
-    dryOversampler.prepare(sampleRate, maxBlockSize, numChannels);
+    // Ceiling ramps, base rate and clip rate
+    ceilingSmoothed.reset(sampleRate, kGainRampSeconds);
+    ceilingSmoothed.setCurrentAndTargetValue(ceilingLinear);
+    ceilingRamp.assign(static_cast<size_t>(maxBlockSize + 1), ceilingLinear);
+    clipCeilings.assign(static_cast<size_t>(maxBlockSize * maxFactor), SampleType(1));
+    clipInverses.assign(static_cast<size_t>(maxBlockSize * maxFactor), SampleType(1));
+    ceilingRamping = false;
+    streamStarted = false;
+    numParameterEvents = 0;
+    silentSamples = 0;
+    silenceSkipping = false;
 }
 
-void ClipperEngine::reset()
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::reset()
 {
-    inputGain.reset();
-    outputGain.reset();
+    inputGain.setCurrentAndTargetValue(inputGain.getTargetValue());
+    outputGain.setCurrentAndTargetValue(outputGain.getTargetValue());
+    ceilingSmoothed.setCurrentAndTargetValue(ceilingLinear);
+    ceilingRamping = false;
+    streamStarted = false;
     oversampler.reset();
-    dryOversampler.reset();
+    truePeakLimiter.reset();
+    envelopeBins.reset();
+    crossfadeRemaining = 0;
+    resetAutoOversampling();
+    resetAdaaHistories();
+    silentSamples = 0;
+    silenceSkipping = false;
 }
 
-void ClipperEngine::setInputGain(float dB)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::resetAdaaHistories()
 {
-    inputGain.setGainDecibels(dB);
+    for (auto* histories : { clipHistories, dryHistories })
+        for (int slot = 0; slot < 2; ++slot)
+            histories[slot].reset();
 }
 
-void ClipperEngine::setOutputGain(float dB)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::resetAutoOversampling()
 {
-    outputGain.setGainDecibels(dB);
+    // Start awake, the hold decides once the input is known
+    autoHistory.clear();
+    std::fill(autoTapStates.begin(), autoTapStates.end(), SampleType(0));
+    autoHistoryPos = 0;
+    autoHoldRemaining = autoHoldLength;
+    autoFadeRemaining = 0;
+    autoFadeGain = 1.0f;
+    oversamplingPathActive = true;
 }
 
-void ClipperEngine::setCeiling(float dB)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setParameters(const EngineParameters& parameters)
+{
+    if (hasAppliedParameters && parameters.version == appliedParameters.version)
+        return;
+
+    // First snapshot after prepare applies every field
+    const bool all = !hasAppliedParameters;
+    const auto& last = appliedParameters;
+
+    if (all || parameters.inputGain != last.inputGain)
+        setInputGain(parameters.inputGain);
+    if (all || parameters.outputGain != last.outputGain)
+        setOutputGain(parameters.outputGain);
+    if (all || parameters.ceiling != last.ceiling)
+        setCeiling(parameters.ceiling);
+    if (all || parameters.curve != last.curve)
+        setCurve(parameters.curve);
+    if (all || parameters.curveExponent != last.curveExponent)
+        setCurveExponent(parameters.curveExponent);
+    if (all || parameters.oversampling != last.oversampling || parameters.filterType != last.filterType
+        || parameters.polyphaseAllpass != last.polyphaseAllpass || parameters.efficientFilters != last.efficientFilters)
+    {
+        setOversamplerConfiguration(parameters.oversampling, toFilterType<OversamplerType>(parameters.filterType),
+                                    toBackend<OversamplerType>(parameters.polyphaseAllpass),
+                                    toFilterQuality<OversamplerType>(parameters.efficientFilters));
+    }
+    if (all || parameters.autoOversampling != last.autoOversampling)
+        setAutoOversampling(parameters.autoOversampling);
+    if (all || parameters.antialiasing != last.antialiasing)
+        setAntialiasing(parameters.antialiasing);
+    if (all || parameters.curveTable != last.curveTable)
+        setCurveTable(parameters.curveTable);
+    if (all || parameters.midSide != last.midSide)
+        setChannelMode(parameters.midSide);
+    if (all || parameters.stereoLink != last.stereoLink)
+        setStereoLink(parameters.stereoLink);
+    if (all || parameters.deltaMonitor != last.deltaMonitor)
+        setDeltaMonitor(parameters.deltaMonitor);
+    if (all || parameters.bypass != last.bypass)
+        setBypass(parameters.bypass);
+    if (all || parameters.enforceCeiling != last.enforceCeiling)
+        setEnforceCeiling(parameters.enforceCeiling);
+    if (all || parameters.truePeak != last.truePeak)
+        setTruePeakMode(parameters.truePeak);
+
+    appliedParameters = parameters;
+    hasAppliedParameters = true;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setInputGain(float dB)
+{
+    inputGain.setTargetValue(juce::Decibels::decibelsToGain(dB));
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setOutputGain(float dB)
+{
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(dB));
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setCeiling(float dB)
 {
     ceilingLinear = juce::Decibels::decibelsToGain(dB);
     clipper.setCeiling(ceilingLinear);
+    truePeakLimiter.setCeiling(ceilingLinear);
+
+    // Before the first block there is nothing to ramp from
+    if (streamStarted)
+        ceilingSmoothed.setTargetValue(ceilingLinear);
+    else
+        ceilingSmoothed.setCurrentAndTargetValue(ceilingLinear);
 }
 
-void ClipperEngine::setCurve(int curveIndex)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::advanceCeilingRamp(int numSamples)
 {
-    clipper.setCurve(static_cast<CurveType>(curveIndex));
+    ceilingRamping = ceilingSmoothed.isSmoothing();
+    if (!ceilingRamping)
+        return;
+
+    ceilingRamp[0] = ceilingSmoothed.getCurrentValue();
+    for (int i = 1; i <= numSamples; ++i)
+        ceilingRamp[static_cast<size_t>(i)] = ceilingSmoothed.getNextValue();
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::applyCeilingRamp(SampleType* const* data, int numChannels, int numSamples,
+                                                      int factor, bool normalize)
+{
+    const int numClipSamples = numSamples * factor;
+
+    // The clip-rate ramp interpolates the base-rate one, computed on the way in
+    if (normalize)
+    {
+        const float step = 1.0f / static_cast<float>(factor);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float from = ceilingRamp[static_cast<size_t>(i)];
+            const float delta = ceilingRamp[static_cast<size_t>(i + 1)] - from;
+            for (int p = 0; p < factor; ++p)
+            {
+                const auto c = static_cast<SampleType>(from + delta * static_cast<float>(p + 1) * step);
+                clipCeilings[static_cast<size_t>(i * factor + p)] = c;
+                clipInverses[static_cast<size_t>(i * factor + p)] = SampleType(1) / c;
+            }
+        }
+    }
+
+    const SampleType* gains = normalize ? clipInverses.data() : clipCeilings.data();
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        SampleType* channel = data[ch];
+        for (int i = 0; i < numClipSamples; ++i)
+            channel[i] *= gains[i];
+    }
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setCurve(int index)
+{
+    clipper.setCurve(static_cast<CurveType>(index));
+
+    // Setters run every block - only rescan the curve when it changes
+    if (index != curveIndex)
+    {
+        curveIndex = index;
+        linearLimit = findLinearLimit(static_cast<CurveType>(curveIndex), curveExponent);
+    }
 }
 
-void ClipperEngine::setCurveExponent(float exponent)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setCurveExponent(float exponent)
 {
     clipper.setCurveExponent(exponent);
+
+    if (exponent != curveExponent)
+    {
+        curveExponent = exponent;
+        linearLimit = findLinearLimit(static_cast<CurveType>(curveIndex), curveExponent);
+    }
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setOversamplingFactor(int factorIndex)
+{
+    setOversamplerConfiguration(factorIndex, oversampler.getCurrentFilterType(), oversampler.getCurrentBackend(),
+                                oversampler.getCurrentFilterQuality());
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setFilterType(int filterTypeIndex)
+{
+    setOversamplerConfiguration(oversampler.getCurrentFactorIndex(), toFilterType<OversamplerType>(filterTypeIndex),
+                                oversampler.getCurrentBackend(), oversampler.getCurrentFilterQuality());
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setOversamplingEngine(bool usePolyphaseAllpass)
+{
+    setOversamplerConfiguration(oversampler.getCurrentFactorIndex(), oversampler.getCurrentFilterType(),
+                                toBackend<OversamplerType>(usePolyphaseAllpass), oversampler.getCurrentFilterQuality());
 }
 
-void ClipperEngine::setOversamplingFactor(int factorIndex)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setEfficientFilters(bool enabled)
 {
-    oversampler.setOversamplingFactor(factorIndex);
-    dryOversampler.setOversamplingFactor(factorIndex);
+    setOversamplerConfiguration(oversampler.getCurrentFactorIndex(), oversampler.getCurrentFilterType(),
+                                oversampler.getCurrentBackend(), toFilterQuality<OversamplerType>(enabled));
 }
 
-void ClipperEngine::setFilterType(bool isLinearPhase)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setOversamplerConfiguration(int factorIndex,
+                                                                 typename OversamplerType::FilterType filterType,
+                                                                 typename OversamplerType::Backend backend,
+                                                                 typename OversamplerType::FilterQuality quality)
 {
-    auto filterType = isLinearPhase ? Oversampler::FilterType::LinearPhase
-                                    : Oversampler::FilterType::MinimumPhase;
+    beginCrossfade(oversampler.setConfiguration(factorIndex, filterType, backend, quality));
+}
 
-    // Both oversamplers use the same filter type for phase-matched delta monitoring
-    oversampler.setFilterType(filterType);
-    dryOversampler.setFilterType(filterType);
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setAutoOversampling(bool enabled)
+{
+    autoOversamplingEnabled = enabled;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setAntialiasing(int modeIndex)
+{
+    const auto mode = static_cast<typename ClipperType::Antialiasing>(std::clamp(modeIndex, 0, 2));
+    if (mode != clipper.getAntialiasing())
+        resetAdaaHistories();
+
+    clipper.setAntialiasing(mode);
+    oversampler.setClipDelay(clipper.getAntialiasingDelay());
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setCurveTable(bool enabled)
+{
+    clipper.setCurveTable(enabled);
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setCurveTablePrecision(CurveTable::Precision precision)
+{
+    clipper.setCurveTablePrecision(precision);
 }
 
-void ClipperEngine::setChannelMode(bool isMidSide)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::beginCrossfade(Switch change)
+{
+    if (change == Switch::None)
+        return;
+
+    // The slots traded places, and so do their ADAA histories
+    const int active = static_cast<int>(Slot::Active);
+    const int outgoing = static_cast<int>(Slot::Outgoing);
+    for (auto* histories : { clipHistories, dryHistories })
+        std::swap(histories[active], histories[outgoing]);
+
+    // Before the first block there is nothing to fade from
+    if (!streamStarted)
+    {
+        crossfadeRemaining = 0;
+        oversampler.releaseOutgoing();
+        return;
+    }
+
+    if (change == Switch::Reversed)
+    {
+        // Back to the configuration being faded out, state intact: the fade
+        // turns around from where it is, so the mix carries on without a step
+        crossfadeRemaining = crossfadeLength - crossfadeRemaining;
+        if (crossfadeRemaining == 0)
+            oversampler.releaseOutgoing();
+        return;
+    }
+
+    // Switching to another configuration mid-fade restarts it from the one
+    // that was active. The incoming configuration starts a fresh stream
+    crossfadeRemaining = crossfadeLength;
+    for (auto* histories : { clipHistories, dryHistories })
+        histories[active].reset();
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setChannelLayout(const ChannelLayout& layout)
+{
+    stereoProcessor.setChannelPairs(layout.midSidePairs);
+    clipper.setLinkGroups(layout.linkGroups);
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setWorkerThreads(int numThreads)
+{
+    numThreads = std::max(0, numThreads);
+    if (numThreads == numWorkerThreads)
+        return;
+
+    workerPool = (numThreads > 0) ? std::make_unique<WorkerPool>(numThreads) : nullptr;
+    numWorkerThreads = numThreads;
+}
+
+template <typename SampleType>
+template <typename Task>
+void BasicClipperEngine<SampleType>::forEachPartition(Slot slot, int numClipSamples, Task& task)
+{
+    const int numPartitions = oversampler.getNumPartitions();
+
+    if (workerPool != nullptr && workerThreadsActive && numPartitions > 1 && oversampler.isOversampling(slot)
+        && numClipSamples >= kMinParallelSamples)
+    {
+        workerPool->run(numPartitions, task);
+        return;
+    }
+
+    for (int partition = 0; partition < numPartitions; ++partition)
+        task(partition);
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setChannelMode(bool isMidSide)
 {
     stereoProcessor.setMidSideMode(isMidSide);
 }
 
-void ClipperEngine::setStereoLink(bool enabled)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setStereoLink(bool enabled)
 {
     clipper.setStereoLink(enabled);
 }
 
-void ClipperEngine::setDeltaMonitor(bool enabled)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setDeltaMonitor(bool enabled)
 {
     deltaMonitorEnabled = enabled;
 }
 
-void ClipperEngine::setEnforceCeiling(bool enabled)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setEnforceCeiling(bool enabled)
 {
     enforceCeilingEnabled = enabled;
 }
 
-void ClipperEngine::setBypass(bool enabled)
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setTruePeakMode(bool enabled)
+{
+    // Start from an empty delay line rather than audio from the last time it ran
+    if (enabled && !truePeakModeEnabled)
+        truePeakLimiter.reset();
+
+    truePeakModeEnabled = enabled;
+}
+
+template <typename SampleType>
+typename BasicClipperEngine<SampleType>::CeilingMode BasicClipperEngine<SampleType>::getCeilingMode() const
+{
+    if (!enforceCeilingEnabled)
+        return CeilingMode::Off;
+    return truePeakModeEnabled ? CeilingMode::TruePeak : CeilingMode::SamplePeak;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::setBypass(bool enabled)
 {
     bypassed = enabled;
 }
 
-int ClipperEngine::getLatencyInSamples() const
+template <typename SampleType>
+int BasicClipperEngine<SampleType>::getClipPathLatency() const
 {
-    return oversampler.getLatencyInSamples();
+    // Low latency compensates the ADAA delay along with its filters'
+    if (oversampler.compensatesClipDelay())
+        return oversampler.getLatencyInSamples();
+
+    // ADAA delays by a fraction of a sample at the clip rate
+    const float adaaDelay = clipper.getAntialiasingDelay() / static_cast<float>(oversampler.getOversamplingFactor());
+    return oversampler.getLatencyInSamples() + static_cast<int>(std::lround(adaaDelay));
 }
 
-void ClipperEngine::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+int BasicClipperEngine<SampleType>::getLatencyInSamples() const
 {
-    int numSamples = buffer.getNumSamples();
-    int numChannels = buffer.getNumChannels();
+    const int limiterLatency = (getCeilingMode() == CeilingMode::TruePeak)
+        ? truePeakLimiter.getLatencyInSamples() : 0;
 
-    // 1. Input gain (always applied, even when bypassed)
-    juce::dsp::AudioBlock<float> block(buffer);
-    inputGain.process(juce::dsp::ProcessContextReplacing<float>(block));
+    return getClipPathLatency() + limiterLatency;
+}
 
-    // Capture pre-clip peak (after input gain, before clipping)
-    lastPreClipPeak = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch)
+template <typename SampleType>
+template <bool Sanitize>
+void BasicClipperEngine<SampleType>::applyInputGain(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    SampleType* const* channels = buffer.getArrayOfWritePointers();
+    float gains[kFusedChunkSize];
+    float peak = 0.0f;
+
+    // Chunks end at envelope bin boundaries so each chunk peak belongs to one bin
+    for (int start = 0, n = 0; start < numSamples; start += n)
     {
-        const float* data = buffer.getReadPointer(ch);
-        for (int i = 0; i < numSamples; ++i)
+        n = std::min({ kFusedChunkSize, numSamples - start, envelopeBins.samplesToBoundary(start) });
+        fillGainChunk(inputGain, gains, n);
+        SampleType chunkPeak = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            float absVal = std::abs(data[i]);
-            if (absVal > lastPreClipPeak)
-                lastPreClipPeak = absVal;
+            SampleType* data = channels[ch] + start;
+            for (int i = 0; i < n; ++i)
+            {
+                SampleType sample = data[i] * gains[i];
+                // std::max keeps the running peak when sample is NaN
+                chunkPeak = std::max(chunkPeak, std::abs(sample));
+
+                if constexpr (Sanitize)
+                    sample = std::isfinite(sample) ? sample : SampleType(0);
+
+                data[i] = sample;
+            }
         }
+
+        envelopeBins.addPreClip(start, static_cast<float>(chunkPeak));
+        peak = std::max(peak, static_cast<float>(chunkPeak));
     }
 
-    // Skip clipping and makeup gain when bypassed
-    // Input gain still applies so users can hear pre-clip level
-    if (bypassed)
+    lastPreClipPeak = peak;
+}
+
+template <typename SampleType>
+float BasicClipperEngine<SampleType>::subtractFromDry(SampleType* const* clipped, int numChannels, int numSamples,
+                                                      int factor, bool midSide, bool measure)
+{
+    SampleType* const* dry = dryBuffer.getArrayOfWritePointers();
+    float peak = 0.0f;
+
+    // One segment per envelope bin, in base-rate samples (factor clip samples each)
+    for (int start = 0, n = 0; start < numSamples; start += n)
     {
-        // When bypassed, post-clip = pre-clip (no clipping)
-        lastPostClipPeak = lastPreClipPeak;
+        n = std::min(numSamples - start, envelopeBins.samplesToBoundary(start));
+        const int clipStart = start * factor;
+        const int clipEnd = (start + n) * factor;
+        SampleType segmentPeak = 0;
+
+        // Clipped peak as it will be heard: for an M/S pair max(|m + s|, |m - s|) = |m| + |s|
+        if (midSide)
+        {
+            for (const auto& [mid, side] : stereoProcessor.getChannelPairs())
+            {
+                if (std::max(mid, side) >= numChannels)
+                    continue;
+
+                for (int i = clipStart; i < clipEnd; ++i)
+                    segmentPeak = std::max(segmentPeak, std::abs(clipped[mid][i]) + std::abs(clipped[side][i]));
+            }
+        }
 
-        // Still sanitize NaN/Inf even when bypassed
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            float* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
+            SampleType* wet = clipped[ch];
+            const SampleType* dryIn = dry[ch];
+            const bool measureChannel = !midSide || !stereoProcessor.isPairedChannel(ch, numChannels);
+
+            for (int i = clipStart; i < clipEnd; ++i)
             {
-                if (!std::isfinite(data[i]))
-                    data[i] = 0.0f;
+                if (measureChannel)
+                    segmentPeak = std::max(segmentPeak, std::abs(wet[i]));
+                wet[i] = dryIn[i] - wet[i];
             }
         }
-        return;
+
+        if (measure)
+            envelopeBins.addPostClip(start, static_cast<float>(segmentPeak));
+        peak = std::max(peak, static_cast<float>(segmentPeak));
     }
 
-    // Store dry signal for delta monitoring (after input gain)
-    if (deltaMonitorEnabled)
+    return peak;
+}
+
+template <typename SampleType>
+template <bool MidSide, bool MeasurePeak, typename BasicClipperEngine<SampleType>::CeilingMode Mode>
+void BasicClipperEngine<SampleType>::processEpilogue(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    SampleType* const* wet = buffer.getArrayOfWritePointers();
+    float gains[kFusedChunkSize];
+    float ceilings[kFusedChunkSize];
+    float peak = 0.0f;
+
+    for (int start = 0, n = 0; start < numSamples; start += n)
     {
+        // Split at envelope bin boundaries only when metering
+        n = std::min(kFusedChunkSize, numSamples - start);
+        if constexpr (MeasurePeak)
+            n = std::min(n, envelopeBins.samplesToBoundary(start));
+
+        fillGainChunk(outputGain, gains, n);
+        SampleType chunkPeak = 0;
+
+        // The clamp follows a ramping ceiling sample by sample, like the clip
+        if constexpr (Mode != CeilingMode::Off)
+        {
+            if (ceilingRamping)
+                std::copy_n(ceilingRamp.data() + start + 1, n, ceilings);
+            else
+                std::fill_n(ceilings, n, ceilingLinear);
+        }
+
+        // M/S decode (if enabled), every pair the bus has
+        if constexpr (MidSide)
+            for (const auto& [mid, side] : stereoProcessor.getChannelPairs())
+                if (std::max(mid, side) < numChannels)
+                    StereoProcessor::decodeFromMidSide(wet[mid] + start, wet[side] + start, n);
+
+        // True peak: lookahead limiter on the decoded L/R signal, following the
+        // same ramp as the clamp
+        if constexpr (Mode == CeilingMode::TruePeak)
+            truePeakLimiter.process(juce::dsp::AudioBlock<SampleType>(buffer).getSubBlock(static_cast<size_t>(start),
+                                                                                  static_cast<size_t>(n)),
+                                    ceilingRamping ? ceilings : nullptr);
+
         for (int ch = 0; ch < numChannels; ++ch)
-            dryBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        {
+            SampleType* out = wet[ch] + start;
+
+            for (int i = 0; i < n; ++i)
+            {
+                SampleType sample = out[i];
+
+                // Post-clip peak (after clipping, before output gain)
+                if constexpr (MeasurePeak)
+                    chunkPeak = std::max(chunkPeak, std::abs(sample));
+
+                // Enforce ceiling (final hard limiter) - applies to both normal and delta output
+                if constexpr (Mode != CeilingMode::Off)
+                {
+                    const auto ceiling = static_cast<SampleType>(ceilings[i]);
+                    sample = std::clamp(sample, -ceiling, ceiling);
+                }
+
+                sample *= gains[i];
+
+                // Sanitize output - replace NaN/Inf with 0 (defensive against oversimple bugs)
+                out[i] = std::isfinite(sample) ? sample : SampleType(0);
+            }
+        }
+
+        if constexpr (MeasurePeak)
+        {
+            envelopeBins.addPostClip(start, static_cast<float>(chunkPeak));
+            peak = std::max(peak, static_cast<float>(chunkPeak));
+        }
     }
 
-    // 2. M/S encode (if enabled)
-    stereoProcessor.encodeToMidSide(buffer);
-    if (deltaMonitorEnabled)
-        stereoProcessor.encodeToMidSide(dryBuffer);
+    if constexpr (MeasurePeak)
+        lastPostClipPeak = peak;
+}
 
-    // 3. Upsample
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::clipOversampled(juce::AudioBuffer<SampleType>& buffer, Slot slot, bool midSide)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    StageProfiler::Scope timing(stageProfiler, ProcessStage::Upsample);
+
+    // Upsample (1x clips the original buffer directly). Every partition
+    // returns the same pointers and count, partition 0 keeps them
+    const int expectedClipSamples = numSamples * oversampler.getOversamplingFactor();
     int numOversampledSamples = 0;
-    float* const* oversampledData = oversampler.processSamplesUp(buffer, numOversampledSamples);
+    SampleType* const* oversampledData = nullptr;
+    auto upsample = [&](int partition)
+    {
+        int partitionSamples = 0;
+        SampleType* const* data = oversampler.processSamplesUp(buffer, partitionSamples, slot, partition);
+        if (partition == 0)
+        {
+            oversampledData = data;
+            numOversampledSamples = partitionSamples;
+        }
+    };
+    forEachPartition(slot, expectedClipSamples, upsample);
+    timing.enter(ProcessStage::Clip);
 
-    // Process dry through same filter chain (for phase matching)
-    int dryOversampledSamples = 0;
+    SampleType* const* clipData = (oversampledData != nullptr) ? oversampledData : buffer.getArrayOfWritePointers();
+    const int numClipSamples = (oversampledData != nullptr) ? numOversampledSamples : numSamples;
+
+    // Delta monitor: keep the unclipped signal at the clip rate. dry - wet is
+    // formed before downsampling, so one downsampler yields the phase-aligned delta
+    // With ADAA the dry copy gets the same delay as the clipped signal
+    const int slotIndex = static_cast<int>(slot);
     if (deltaMonitorEnabled)
-        dryOversampler.processSamplesUp(dryBuffer, dryOversampledSamples);
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::copy(clipData[ch], clipData[ch] + numClipSamples, dryBuffer.getWritePointer(ch));
 
-    // 4. Clip wet signal only (dry passes through unclipped)
-    if (oversampledData != nullptr)
+        clipper.matchLinearResponse(dryBuffer.getArrayOfWritePointers(), numChannels, numClipSamples,
+                                    dryHistories[slotIndex]);
+    }
+
+    // Clip, metering gain reduction for the configuration that is heard. A
+    // ramping ceiling is divided out and back in around a unity-ceiling clip -
+    // what every curve does internally (and ADAA keeps its history normalized)
+    const int factor = (numSamples > 0) ? numClipSamples / numSamples : 1;
+    if (ceilingRamping)
     {
-        clipper.processInternal(oversampledData, numChannels, numOversampledSamples);
+        applyCeilingRamp(clipData, numChannels, numSamples, factor, true);
+        clipper.setCeiling(1.0f);
     }
-    else
+
+    clipper.processInternal(clipData, numChannels, numClipSamples,
+                            (slot == Slot::Active && clipMeteringEnabled) ? &lastClipStats : nullptr,
+                            &clipHistories[slotIndex]);
+
+    if (ceilingRamping)
     {
-        // 1x oversampling - process original buffer directly
-        clipper.process(buffer);
+        clipper.setCeiling(ceilingLinear);
+        applyCeilingRamp(clipData, numChannels, numSamples, factor, false);
     }
 
-    // 5. Downsample
-    oversampler.processSamplesDown(buffer, numSamples);
+    // Output = dry - wet (what was clipped off); meter the clipped signal on the way.
+    // Only the active configuration feeds the display
     if (deltaMonitorEnabled)
-        dryOversampler.processSamplesDown(dryBuffer, numSamples);
+    {
+        const bool measure = slot == Slot::Active;
+        const float peak = subtractFromDry(clipData, numChannels, numSamples, factor, midSide, measure);
+        if (measure)
+            lastPostClipPeak = peak;
+    }
 
-    // 6. M/S decode (if enabled)
-    stereoProcessor.decodeFromMidSide(buffer);
-    if (deltaMonitorEnabled)
-        stereoProcessor.decodeFromMidSide(dryBuffer);
+    // Downsample
+    timing.enter(ProcessStage::Downsample);
+    auto downsample = [&](int partition) { oversampler.processSamplesDown(buffer, numSamples, slot, partition); };
+    forEachPartition(slot, numClipSamples, downsample);
+}
 
-    // 7. Capture post-clip peak (after clipping, before output gain)
-    lastPostClipPeak = 0.0f;
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::applyCrossfade(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int fadeSamples = std::min(numSamples, crossfadeRemaining);
+    const float step = 1.0f / static_cast<float>(crossfadeLength);
+    const float startGain = 1.0f - static_cast<float>(crossfadeRemaining) * step;
+
+    // Only the faded part needs mixing - the active output is already in place after it
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        const float* data = buffer.getReadPointer(ch);
-        for (int i = 0; i < numSamples; ++i)
+        SampleType* active = buffer.getWritePointer(ch);
+        const SampleType* outgoing = crossfadeBuffer.getReadPointer(ch);
+
+        for (int i = 0; i < fadeSamples; ++i)
         {
-            float absVal = std::abs(data[i]);
-            if (absVal > lastPostClipPeak)
-                lastPostClipPeak = absVal;
+            const float fadeIn = startGain + static_cast<float>(i + 1) * step;
+            active[i] = outgoing[i] + fadeIn * (active[i] - outgoing[i]);
         }
     }
 
-    // 8. Delta monitor: output = dry - wet (what was clipped off)
-    // Both signals have been through the same filter chain, so they're phase-aligned
-    if (deltaMonitorEnabled)
+    crossfadeRemaining -= fadeSamples;
+    if (crossfadeRemaining == 0)
+        oversampler.releaseOutgoing();
+}
+
+template <typename SampleType>
+bool BasicClipperEngine<SampleType>::updateAutoOversampling(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    // Nothing to record once the path is awake with auto off
+    if (!autoOversamplingEnabled && oversamplingPathActive && autoFadeRemaining == 0)
+        return true;
+
+    const int numChannels = buffer.getNumChannels();
+    const int historyLength = autoHistory.getNumSamples();
+
+    // Record this block, then read it back through the matched delay
+    const int blockStart = autoHistoryPos;
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        for (int ch = 0; ch < numChannels; ++ch)
+        const SampleType* in = buffer.getReadPointer(ch);
+        SampleType* history = autoHistory.getWritePointer(ch);
+
+        for (int i = 0, pos = blockStart; i < numSamples; ++i)
         {
-            float* wet = buffer.getWritePointer(ch);
-            const float* dry = dryBuffer.getReadPointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-                wet[i] = dry[i] - wet[i];
+            history[pos] = in[i];
+            pos = (pos + 1 == historyLength) ? 0 : pos + 1;
         }
     }
+    autoHistoryPos = (blockStart + numSamples) % historyLength;
+    readAutoDelay(numChannels, numSamples, blockStart);
+
+    // The delay only stands in for the clip path while the curve passes the
+    // signal through untouched. Delta output is what was clipped off, so it
+    // always runs. A NaN peak counts as loud
+    const bool canSleep = autoOversamplingEnabled && !deltaMonitorEnabled
+                          && oversampler.isOversampling();
+
+    // A falling ceiling ramp is judged by where it ends, a rising one where it starts
+    const float ceiling = ceilingRamping ? std::min(ceilingRamp[0], ceilingLinear) : ceilingLinear;
+    const float quietLimit = ceiling * linearLimit * kAutoHeadroom;
+    const bool loud = !canSleep || !(lastPreClipPeak <= quietLimit);
+
+    autoHoldRemaining = loud ? autoHoldLength : std::max(0, autoHoldRemaining - numSamples);
+
+    // Fading in, the delay carries only input from before this block, which is
+    // quiet. Any longer and a transient would leave through it unclipped
+    const int fadeInLength = std::min(crossfadeLength, autoLookahead);
 
-    // 9. Enforce ceiling (final hard limiter) - applies to both normal and delta output
-    // This ensures true peak limiting regardless of mode, pre-output-gain
-    if (enforceCeilingEnabled)
+    if (loud && !oversamplingPathActive)
     {
+        // Wake up warm; the fade covers the transition, so a pending
+        // configuration fade has nothing left to do
+        crossfadeRemaining = 0;
+        oversampler.releaseOutgoing();
+        warmOversampler(numChannels, numSamples);
+        oversamplingPathActive = true;
+        startAutoFade(true, fadeInLength);
+    }
+    else if (loud && autoFadeRemaining > 0 && !autoFadingIn)
+    {
+        // Loud again mid fade-out: turn around from the current mix
+        startAutoFade(true, fadeInLength);
+    }
+    else if (oversamplingPathActive && autoHoldRemaining == 0 && autoFadeRemaining == 0)
+    {
+        startAutoFade(false, crossfadeLength);
+    }
+
+    return oversamplingPathActive;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::readAutoDelay(int numChannels, int numSamples, int blockStart)
+{
+    // ADAA's linear region averages the last two or three clip-rate samples
+    // (matchLinearResponse), delaying by half or a whole one. At the base rate
+    // that is the average of taps 1/factor apart, each a whole-sample read plus
+    // a first-order Thiran allpass for the fraction. Low latency folds the ADAA
+    // delay into its own, so the taps start that much earlier
+    const double factor = static_cast<double>(oversampler.getOversamplingFactor());
+    const double clipDelay = static_cast<double>(clipper.getAntialiasingDelay());
+    const int numTaps = 1 + static_cast<int>(std::lround(2.0 * clipDelay));
+    const double firstDelay = oversampler.getExactLatency()
+                              - (oversampler.compensatesClipDelay() ? clipDelay / factor : 0.0);
+
+    int delays[kAutoMaxTaps];
+    SampleType coefficients[kAutoMaxTaps];
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        // The Thiran is accurate for a fraction from 0.5 to 1.5. Under half a
+        // sample only happens at 1x, which never sleeps
+        const double delay = firstDelay + tap / factor;
+        delays[tap] = std::max(0, static_cast<int>(std::floor(delay - 0.5)));
+        const double fraction = std::max(0.5, delay - delays[tap]);
+        coefficients[tap] = static_cast<SampleType>((1.0 - fraction) / (1.0 + fraction));
+    }
+
+    autoLookahead = delays[0];
+    jassert(delays[numTaps - 1] <= kAutoWarmupSamples);
+
+    const int historyLength = autoHistory.getNumSamples();
+    const SampleType tapGain = SampleType(1) / static_cast<SampleType>(numTaps);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const SampleType* history = autoHistory.getReadPointer(ch);
+        SampleType* delayed = autoDelayed.getWritePointer(ch);
+        std::fill(delayed, delayed + numSamples, SampleType(0));
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            // H(z) = (a + z^-1) / (1 + a z^-1)
+            const SampleType a = coefficients[tap];
+            SampleType& previousIn = autoTapStates[static_cast<size_t>((ch * kAutoMaxTaps + tap) * 2)];
+            SampleType& previousOut = autoTapStates[static_cast<size_t>((ch * kAutoMaxTaps + tap) * 2 + 1)];
+
+            for (int i = 0, pos = (blockStart - delays[tap] + historyLength) % historyLength; i < numSamples; ++i)
+            {
+                const SampleType x = history[pos];
+                const SampleType y = a * (x - previousOut) + previousIn;
+                previousIn = x;
+                previousOut = y;
+                delayed[i] += tapGain * y;
+                pos = (pos + 1 == historyLength) ? 0 : pos + 1;
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::warmOversampler(int numChannels, int numSamples)
+{
+    const int historyLength = autoHistory.getNumSamples();
+    const int chunkCapacity = crossfadeBuffer.getNumSamples();
+    int pos = (autoHistoryPos - numSamples - kAutoWarmupSamples + 2 * historyLength) % historyLength;
+
+    // Output is discarded - only the filter state matters
+    for (int remaining = kAutoWarmupSamples; remaining > 0;)
+    {
+        const int n = std::min(remaining, chunkCapacity);
+
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            float* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-                data[i] = std::clamp(data[i], -ceilingLinear, ceilingLinear);
+            const SampleType* history = autoHistory.getReadPointer(ch);
+            SampleType* out = crossfadeBuffer.getWritePointer(ch);
+            for (int i = 0, p = pos; i < n; ++i)
+            {
+                out[i] = history[p];
+                p = (p + 1 == historyLength) ? 0 : p + 1;
+            }
         }
+
+        juce::AudioBuffer<SampleType> chunk(crossfadeBuffer.getArrayOfWritePointers(), numChannels, n);
+        auto replay = [&](int partition)
+        {
+            int numOversampledSamples = 0;
+            oversampler.processSamplesUp(chunk, numOversampledSamples, Slot::Active, partition);
+            oversampler.processSamplesDown(chunk, n, Slot::Active, partition);
+        };
+        forEachPartition(Slot::Active, n * oversampler.getOversamplingFactor(), replay);
+
+        pos = (pos + n) % historyLength;
+        remaining -= n;
     }
+}
 
-    // 10. Output gain
-    juce::dsp::AudioBlock<float> outputBlock(buffer);
-    outputGain.process(juce::dsp::ProcessContextReplacing<float>(outputBlock));
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::startAutoFade(bool fadeIn, int length)
+{
+    autoFadingIn = fadeIn;
+
+    // No lookahead to fade in over: cut straight over to the clip path
+    if (length == 0)
+    {
+        autoFadeGain = fadeIn ? 1.0f : 0.0f;
+        autoFadeRemaining = 0;
+        oversamplingPathActive = fadeIn;
+        return;
+    }
+
+    autoFadeStep = ((fadeIn ? 1.0f : 0.0f) - autoFadeGain) / static_cast<float>(length);
+    autoFadeRemaining = length;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::applyAutoFade(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int fadeSamples = std::min(numSamples, autoFadeRemaining);
 
-    // 11. Sanitize output - replace NaN/Inf with 0 (defensive against oversimple bugs)
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        float* data = buffer.getWritePointer(ch);
+        SampleType* active = buffer.getWritePointer(ch);
+        const SampleType* delayed = autoDelayed.getReadPointer(ch);
+
+        for (int i = 0; i < fadeSamples; ++i)
+        {
+            const float gain = autoFadeGain + static_cast<float>(i + 1) * autoFadeStep;
+            active[i] = delayed[i] + gain * (active[i] - delayed[i]);
+        }
+
+        // Faded out before the end of the block - the delay takes the rest
+        if (!autoFadingIn)
+            std::copy(delayed + fadeSamples, delayed + numSamples, active + fadeSamples);
+    }
+
+    autoFadeRemaining -= fadeSamples;
+    if (autoFadeRemaining > 0)
+        autoFadeGain += static_cast<float>(fadeSamples) * autoFadeStep;
+    else
+        autoFadeGain = autoFadingIn ? 1.0f : 0.0f;
+
+    if (autoFadeRemaining == 0 && !autoFadingIn)
+        oversamplingPathActive = false;
+}
+
+template <typename SampleType>
+bool BasicClipperEngine<SampleType>::updateSilenceSkip(const juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    // Exact zeros only: anything else, however quiet, is left to auto oversampling.
+    // Music rarely gets past the first sample here
+    bool silent = true;
+    for (int ch = 0; ch < buffer.getNumChannels() && silent; ++ch)
+    {
+        const SampleType* in = buffer.getReadPointer(ch);
         for (int i = 0; i < numSamples; ++i)
         {
-            if (!std::isfinite(data[i]))
-                data[i] = 0.0f;
+            if (in[i] != SampleType(0))
+            {
+                silent = false;
+                break;
+            }
         }
     }
+
+    if (!silent)
+    {
+        // The clip path was left clean on the way in, nothing to catch up on
+        silentSamples = 0;
+        silenceSkipping = false;
+        return false;
+    }
+
+    // The hold only counts silence the clip path has already run through, so
+    // the last tails are out before the first skipped block
+    if (!silenceSkipping && silentSamples >= autoHoldLength)
+    {
+        oversampler.reset();
+        crossfadeRemaining = 0;
+        truePeakLimiter.reset();
+        resetAdaaHistories();
+        resetAutoOversampling();
+        silenceSkipping = true;
+    }
+
+    silentSamples = std::min(silentSamples + numSamples, autoHoldLength);
+    return silenceSkipping;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::skipSilentSegment(juce::AudioBuffer<SampleType>& buffer, int numSamples)
+{
+    // Zero in is zero out on every path, delta monitor included - clearing also
+    // turns -0 into 0 like the clip path would
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        buffer.clear(ch, 0, numSamples);
+
+    // Gains and ceiling move on as if processed; the envelope bins stay at zero
+    inputGain.skip(numSamples);
+    outputGain.skip(numSamples);
+    ceilingSmoothed.skip(numSamples);
+    ceilingRamping = false;
+
+    lastPreClipPeak = 0.0f;
+    lastPostClipPeak = 0.0f;
+    if (clipMeteringEnabled)
+        lastClipStats.addUntouchedFrames(static_cast<std::uint64_t>(numSamples)
+                                         * static_cast<std::uint64_t>(oversampler.getOversamplingFactor()));
+
+    // Parameter changes while silent land without a fade - there is nothing to fade
+    crossfadeRemaining = 0;
+    oversampler.releaseOutgoing();
 }
 
+template <typename SampleType>
+bool BasicClipperEngine<SampleType>::addParameterEvent(int sampleOffset, const EngineParameters& parameters)
+{
+    if (numParameterEvents == maxParameterEvents)
+        return false;
+
+    // An event out of order lands with the latest one queued
+    const int latest = (numParameterEvents > 0) ? parameterEvents[static_cast<size_t>(numParameterEvents - 1)].sampleOffset : 0;
+    parameterEvents[static_cast<size_t>(numParameterEvents++)] = { std::max(sampleOffset, latest), parameters };
+    return true;
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    // Real-time contract: everything below works in storage sized by prepare()
+    RealtimeScope realtime;
+
+    // A deferred oversampling switch whose configuration is now built
+    beginCrossfade(oversampler.applyPendingConfiguration());
+
+    lastClipStats.clear();
+    stageProfiler.beginBlock();
+
+    if (numParameterEvents > 0)
+    {
+        processWithEvents(buffer);
+        stageProfiler.finishBlock(buffer.getNumSamples());
+        return;
+    }
+
+    const bool metered = processSegment(buffer) && clipMeteringEnabled;
+    envelopeBins.finishBlock(buffer.getNumSamples());
+    if (metered)
+    {
+        lastClipStats.addBlock(segmentSkipped);
+        clipMeter.publish(lastClipStats);
+    }
+    stageProfiler.finishBlock(buffer.getNumSamples());
+}
+
+template <typename SampleType>
+void BasicClipperEngine<SampleType>::processWithEvents(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+    float preClipPeak = 0.0f;
+    float postClipPeak = 0.0f;
+    bool metered = false;
+    bool skipped = true;
+    int event = 0;
+
+    envelopeBins.clearCompleted();
+
+    for (int start = 0; start < numSamples;)
+    {
+        // Events at or before this sample take effect first
+        while (event < numParameterEvents && parameterEvents[static_cast<size_t>(event)].sampleOffset <= start)
+            setParameters(parameterEvents[static_cast<size_t>(event++)].parameters);
+
+        const int end = (event < numParameterEvents)
+            ? std::min(numSamples, parameterEvents[static_cast<size_t>(event)].sampleOffset) : numSamples;
+
+        // A view of the stretch up to the next event - stream state carries
+        // across exactly as between host blocks
+        juce::AudioBuffer<SampleType> segment(buffer.getArrayOfWritePointers(), numChannels, start, end - start);
+        metered = processSegment(segment) || metered;
+        skipped = skipped && segmentSkipped;
+        envelopeBins.finishSegment(end - start);
+        preClipPeak = std::max(preClipPeak, lastPreClipPeak);
+        postClipPeak = std::max(postClipPeak, lastPostClipPeak);
+        start = end;
+    }
+
+    // Offsets past the block apply after it
+    while (event < numParameterEvents)
+        setParameters(parameterEvents[static_cast<size_t>(event++)].parameters);
+    numParameterEvents = 0;
+
+    lastPreClipPeak = preClipPeak;
+    lastPostClipPeak = postClipPeak;
+    if (metered && clipMeteringEnabled)
+    {
+        lastClipStats.addBlock(skipped);
+        clipMeter.publish(lastClipStats);
+    }
+}
+
+template <typename SampleType>
+bool BasicClipperEngine<SampleType>::processSegment(juce::AudioBuffer<SampleType>& buffer)
+{
+    int numSamples = buffer.getNumSamples();
+    int numChannels = buffer.getNumChannels();
+
+    streamStarted = true;
+    segmentSkipped = false;
+
+    // Skip clipping and makeup gain when bypassed
+    // Input gain still applies so users can hear pre-clip level
+    if (bypassed)
+    {
+        // 1. Input gain + pre-clip peak, still sanitizing NaN/Inf
+        StageProfiler::Scope timing(stageProfiler, ProcessStage::InputGain);
+        applyInputGain<true>(buffer, numSamples);
+
+        // When bypassed, post-clip = pre-clip (no clipping)
+        lastPostClipPeak = lastPreClipPeak;
+        envelopeBins.copyPreClipToPostClip(numSamples);
+
+        // Nothing to fade between while the oversampler is idle, and nothing
+        // uses the ceiling
+        crossfadeRemaining = 0;
+        oversampler.releaseOutgoing();
+        ceilingSmoothed.skip(numSamples);
+        ceilingRamping = false;
+        return false;
+    }
+
+    if (updateSilenceSkip(buffer, numSamples))
+    {
+        skipSilentSegment(buffer, numSamples);
+        segmentSkipped = true;
+        return true;
+    }
+
+    advanceCeilingRamp(numSamples);
+
+    // 1. Input gain + pre-clip peak (after input gain, before clipping)
+    StageProfiler::Scope timing(stageProfiler, ProcessStage::InputGain);
+    applyInputGain<false>(buffer, numSamples);
+
+    // 2. M/S encode (if enabled)
+    timing.enter(ProcessStage::Encode);
+    stereoProcessor.encodeToMidSide(buffer);
+    const bool midSide = stereoProcessor.isMidSideActive(numChannels);
+    timing.enter(ProcessStage::Post);
+
+    // 3-5. Upsample, clip, downsample. Auto oversampling passes quiet blocks
+    // through the matched delay instead. While an oversampling switch is
+    // fading, the outgoing configuration runs on a copy of the same input
+    if (!updateAutoOversampling(buffer, numSamples))
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, autoDelayed, ch, 0, numSamples);
+
+        // Nothing was clipped, but the frames still count towards the clip rate
+        if (clipMeteringEnabled)
+            lastClipStats.addUntouchedFrames(static_cast<std::uint64_t>(numSamples)
+                                             * static_cast<std::uint64_t>(oversampler.getOversamplingFactor()));
+
+        // Asleep, the switch has nothing to fade - waking up warms the new configuration
+        crossfadeRemaining = 0;
+        oversampler.releaseOutgoing();
+        segmentSkipped = true;
+    }
+    else if (crossfadeRemaining > 0 && oversampler.hasOutgoing())
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            crossfadeBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+
+        // Block-sized view so the oversampler sees the real sample count
+        juce::AudioBuffer<SampleType> outgoing(crossfadeBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+        clipOversampled(outgoing, Slot::Outgoing, midSide);
+        clipOversampled(buffer, Slot::Active, midSide);
+        applyCrossfade(buffer, numSamples);
+    }
+    else
+    {
+        crossfadeRemaining = 0;
+        oversampler.releaseOutgoing();
+        clipOversampled(buffer, Slot::Active, midSide);
+    }
+
+    if (autoFadeRemaining > 0)
+        applyAutoFade(buffer, numSamples);
+
+    // 6. Fused epilogue: M/S decode, true-peak limit, post-clip peak, enforce
+    // ceiling, output gain and sanitize - one pass per chunk instead of one per step.
+    // In delta mode the post-clip peak was already taken before the subtraction.
+    using Epilogue = void (BasicClipperEngine::*)(juce::AudioBuffer<SampleType>&, int);
+    using Mode = CeilingMode;
+    static constexpr Epilogue epilogues[] = {
+        &BasicClipperEngine::template processEpilogue<false, false, Mode::Off>,
+        &BasicClipperEngine::template processEpilogue<false, false, Mode::SamplePeak>,
+        &BasicClipperEngine::template processEpilogue<false, false, Mode::TruePeak>,
+        &BasicClipperEngine::template processEpilogue<false, true, Mode::Off>,
+        &BasicClipperEngine::template processEpilogue<false, true, Mode::SamplePeak>,
+        &BasicClipperEngine::template processEpilogue<false, true, Mode::TruePeak>,
+        &BasicClipperEngine::template processEpilogue<true, false, Mode::Off>,
+        &BasicClipperEngine::template processEpilogue<true, false, Mode::SamplePeak>,
+        &BasicClipperEngine::template processEpilogue<true, false, Mode::TruePeak>,
+        &BasicClipperEngine::template processEpilogue<true, true, Mode::Off>,
+        &BasicClipperEngine::template processEpilogue<true, true, Mode::SamplePeak>,
+        &BasicClipperEngine::template processEpilogue<true, true, Mode::TruePeak>,
+    };
+
+    const int epilogueIndex = (midSide ? 6 : 0) + (deltaMonitorEnabled ? 0 : 3) + static_cast<int>(getCeilingMode());
+    (this->*epilogues[epilogueIndex])(buffer, numSamples);
+    return true;
+}
+
+template class BasicClipperEngine<float>;
+template class BasicClipperEngine<double>;
+
 } // namespace dsp
@@ -3,71 +3,343 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include "ChannelLayout.h"
 #include "Clipper.h"
+#include "EngineParameters.h"
+#include "EnvelopeBins.h"
 #include "Oversampler.h"
+#include "StageProfiler.h"
 #include "StereoProcessor.h"
+#include "TruePeakLimiter.h"
+#include "WorkerPool.h"
+
+#include <array>
+#include <memory>
+#include <vector>
 
 namespace dsp {
 
-class ClipperEngine
+// SampleType is float or double: the signal path runs at that width end to end,
+// parameters, gains and metering stay float
+template <typename SampleType>
+class BasicClipperEngine
 {
 public:
-    ClipperEngine();
+    BasicClipperEngine();
 
     void prepare(double sampleRate, int maxBlockSize, int numChannels);
     void reset();
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::AudioBuffer<SampleType>& buffer);
+
+    // M/S pairs and link groups for a surround bus (plain stereo by default).
+    // Allocates - call alongside prepare, not from the audio thread
+    void setChannelLayout(const ChannelLayout& layout);
+
+    // Extra threads for the oversampling filters: the channels are split into
+    // one partition per thread plus the calling thread, up- and downsampled in
+    // parallel. Blocks too small to be worth the handoff stay on the calling
+    // thread, and the output is identical either way. 0 (the default) runs
+    // everything inline. Meant for offline renders and wide buses - worker
+    // threads spin while a render is running and park between renders. Starts
+    // or stops threads and takes effect at the next prepare: never call it
+    // from the audio thread
+    void setWorkerThreads(int numThreads);
+    int getWorkerThreads() const { return numWorkerThreads; }
+
+    // Whether process() hands partitions to the worker threads (the default)
+    // or runs them all on the calling thread. Realtime-safe, takes effect at
+    // the next block: lets a host switch between live and offline without a
+    // prepare. The output is the same either way
+    void setWorkerThreadsActive(bool active) { workerThreadsActive = active; }
+
+    // Oversampling configurations are built the first time they are switched
+    // to. Off (the default), the setter builds them, allocating. On (live
+    // playback), the setter keeps the current one running and requests the
+    // new one, which serviceRequests() builds on a background thread; the
+    // switch follows at the first block after. Realtime-safe to toggle.
+    // serviceRequests() never runs on the audio thread
+    void setOversamplerBuildsDeferred(bool deferred) { oversampler.setBuildsDeferred(deferred); }
+    void serviceRequests() { oversampler.serviceRequests(); }
+    bool isOversamplingSwitchPending() const { return oversampler.hasPendingConfiguration(); }
+
+    // Size and interpolation of the curve lookup table (setCurveTable).
+    // Rebuilds the table - never call it from the audio thread
+    void setCurveTablePrecision(CurveTable::Precision precision);
+
+    // Applies a parameter snapshot: nothing if its version was applied last,
+    // otherwise only the setters for fields that changed. The comparison is
+    // against the last snapshot, so drive a given engine either through
+    // snapshots or through the individual setters. prepare() forgets the last
+    // snapshot and the next one applies in full
+    void setParameters(const EngineParameters& parameters);
+
+    // Timestamped parameter changes for the next process() call. The block is
+    // processed in pieces split at each event's sample offset, with the event's
+    // snapshot applied in between (each event needs a version of its own).
+    // Events come in offset order; offsets past the block apply after it.
+    // Returns false once maxParameterEvents are queued. Without events the
+    // block runs in one piece, as before
+    static constexpr int maxParameterEvents = 64;
+    bool addParameterEvent(int sampleOffset, const EngineParameters& parameters);
 
     // Parameter setters
     void setInputGain(float dB);
     void setOutputGain(float dB);
-    void setCeiling(float dB);
+    void setCeiling(float dB);                    // Ramps like the gains once audio has run, see ceilingSmoothed
     void setCurve(int curveIndex);                // 0=Hard, 1=Quintic, 2=Cubic, 3=Tanh, 4=Arctan, 5=Knee, 6=T2
     void setCurveExponent(float exponent);        // For Knee/T2 modes: 1.0-4.0
     void setOversamplingFactor(int factorIndex);  // 0=1x, 1=2x, ... 5=32x
-    void setFilterType(bool isLinearPhase);
+    void setFilterType(int filterTypeIndex);      // 0=Minimum Phase, 1=Linear Phase, 2=Low Latency
+    void setOversamplingEngine(bool usePolyphaseAllpass);  // Min-phase only, see Oversampler
+    void setEfficientFilters(bool enabled);       // Cheaper JUCE stages past 2x, see Oversampler
+    void setAutoOversampling(bool enabled);       // Skip the oversampler on blocks that can't clip
+    void setAntialiasing(int modeIndex);          // 0=Off, 1=ADAA 1st order, 2=ADAA 2nd order
+    void setCurveTable(bool enabled);             // Tanh/Arctan/T2 from a lookup table, see BasicClipper
     void setChannelMode(bool isMidSide);
     void setStereoLink(bool enabled);
     void setDeltaMonitor(bool enabled);
     void setEnforceCeiling(bool enabled);
+    void setTruePeakMode(bool enabled);           // Enforce ceiling on intersample peaks (adds latency)
     void setBypass(bool enabled);
 
     int getLatencyInSamples() const;
 
+    // False while auto oversampling has the clip path asleep (quiet input)
+    bool isOversamplingPathActive() const { return oversamplingPathActive; }
+
+    // True while digitally silent input is skipping the whole clip path
+    bool isSkippingSilence() const { return silenceSkipping; }
+
     // Envelope peaks for display (captured during processing)
     // PreClip = after input gain, before clipping (RED)
     // PostClip = after clipping, before output gain (WHITE)
     float getLastPreClipPeak() const { return lastPreClipPeak; }
     float getLastPostClipPeak() const { return lastPostClipPeak; }
 
+    // Fixed-interval envelope bins (EnvelopeBins::defaultIntervalSeconds at the
+    // prepared sample rate) completed by the last process call - zero or more
+    // per block depending on block size
+    int getNumEnvelopeBins() const { return envelopeBins.getNumCompletedBins(); }
+    const EnvelopeBin& getEnvelopeBin(int index) const { return envelopeBins.getCompletedBin(index); }
+
+    // Gain-reduction metering filled by the clipper as it runs (clip rate frames,
+    // bypassed blocks aren't metered), plus how many blocks skipped the
+    // oversampler - a block split by parameter events counts once, as skipped
+    // only if every piece was.
+    // getLastClipStats() is the last process call, for the processing thread or
+    // offline analysis; getClipMeter() accumulates every block for lock-free
+    // reads from other threads.
+    // Off by default - it costs a copy, abs and divide per clip-rate sample.
+    // Whoever reads the statistics turns it on; while off both stay empty.
+    // Realtime-safe, takes effect at the next block
+    void setClipMetering(bool enabled) { clipMeteringEnabled = enabled; }
+    const ClipStats& getLastClipStats() const { return lastClipStats; }
+    ClipMeter& getClipMeter() { return clipMeter; }
+
+    // Per-stage timing and DSP load, accumulated every block for lock-free
+    // reads. Empty unless built with GUILLOTINE_PROFILE_STAGES (StageProfiler::enabled)
+    StageProfiler& getStageProfiler() { return stageProfiler; }
+
 private:
-    // DSP blocks
-    juce::dsp::Gain<float> inputGain;
-    juce::dsp::Gain<float> outputGain;
+    using OversamplerType = BasicOversampler<SampleType>;
+    using ClipperType = BasicClipper<SampleType>;
+    using Slot = typename OversamplerType::Slot;
+    using Switch = typename OversamplerType::Switch;
+
+    // One uninterrupted stretch of process(): everything but the envelope bin
+    // publish and the meter. Returns false when bypassed (nothing metered),
+    // leaves segmentSkipped set when the oversampler didn't run
+    bool processSegment(juce::AudioBuffer<SampleType>& buffer);
+    void processWithEvents(juce::AudioBuffer<SampleType>& buffer);
+
+    // Fills ceilingRamp for the next numSamples while the ceiling is moving
+    void advanceCeilingRamp(int numSamples);
+
+    // Divides (normalize) or multiplies the clip-rate signal by the ramping
+    // ceiling, so the clipper runs at unity around a per-sample ceiling
+    void applyCeilingRamp(SampleType* const* data, int numChannels, int numSamples, int factor, bool normalize);
+
+    // Input gain fused with the pre-clip peak scan (and NaN/Inf sanitize when bypassed)
+    template <bool Sanitize>
+    void applyInputGain(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+
+    // Upsample, clip (and form the delta) and downsample through one oversampler slot
+    void clipOversampled(juce::AudioBuffer<SampleType>& buffer, Slot slot, bool midSide);
+
+    // Linear fade from the outgoing oversampler configuration (in crossfadeBuffer)
+    // to the active one (in buffer); releases the outgoing one when done
+    void applyCrossfade(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+    void beginCrossfade(Switch change);
+
+    // Every oversampler setting in one switch, so a snapshot changing several
+    // fades once from the configuration that was playing
+    void setOversamplerConfiguration(int factorIndex, typename OversamplerType::FilterType filterType,
+                                     typename OversamplerType::Backend backend,
+                                     typename OversamplerType::FilterQuality quality);
+
+    // Auto oversampling: records the clip-path input, fills autoDelayed and
+    // decides whether the clip path runs for this block
+    void resetAutoOversampling();
+    void resetAdaaHistories();
+    bool updateAutoOversampling(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+
+    // Replays the input preceding this block through the active configuration
+    // so its filters resume from the state they would have had
+    void warmOversampler(int numChannels, int numSamples);
+
+    // Fills autoDelayed from the history: the clip path's exact delay, split
+    // into taps one clip-rate sample apart that average like ADAA's linear region
+    void readAutoDelay(int numChannels, int numSamples, int blockStart);
+
+    // Linear fade between the delayed input (autoDelayed) and the clip path
+    // output, from the current mix to fully in or out over length samples
+    void startAutoFade(bool fadeIn, int length);
+    void applyAutoFade(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+
+    // Silence skip: counts the zero input seen so far and decides whether this
+    // block skips the clip path. Entering the skip clears every filter, ADAA
+    // and limiter state, which the flushed tails have already brought to zero
+    bool updateSilenceSkip(const juce::AudioBuffer<SampleType>& buffer, int numSamples);
+    void skipSilentSegment(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+
+    // Delta monitor at the clip rate: clipped = dry - clipped. Meters the clipped
+    // signal per envelope bin when measure is set, returns its peak
+    float subtractFromDry(SampleType* const* clipped, int numChannels, int numSamples, int factor,
+                          bool midSide, bool measure);
+
+    // Runs task(partition) for every oversampler partition - on the worker
+    // pool when the slot oversamples at least kMinParallelSamples, inline otherwise
+    template <typename Task>
+    void forEachPartition(Slot slot, int numClipSamples, Task& task);
+
+    // Oversampler plus ADAA delay, rounded to base-rate samples
+    int getClipPathLatency() const;
+
+    // How the ceiling is enforced after downsampling
+    enum class CeilingMode { Off, SamplePeak, TruePeak };
+    CeilingMode getCeilingMode() const;
+
+    // Fused post-clip epilogue: M/S decode, true-peak limiting, post-clip peak,
+    // ceiling clamp, output gain and sanitize in one chunked sweep, specialized
+    // per enabled feature
+    template <bool MidSide, bool MeasurePeak, CeilingMode Mode>
+    void processEpilogue(juce::AudioBuffer<SampleType>& buffer, int numSamples);
+
+    // DSP blocks - gains ramp linearly over 2ms
+    juce::SmoothedValue<float> inputGain { 1.0f };
+    juce::SmoothedValue<float> outputGain { 1.0f };
     StereoProcessor stereoProcessor;
-    Oversampler oversampler;
-    Clipper clipper;
+    OversamplerType oversampler;
+    ClipperType clipper;
 
-    // Delta monitoring - requires separate oversampler for dry path
-    // Both oversamplers use the same filter type for phase-matched cancellation
-    juce::AudioBuffer<float> dryBuffer;
-    Oversampler dryOversampler;
+    // Oversampling switches fade between the old and new configuration over
+    // a few ms, running both in parallel until the fade is done
+    juce::AudioBuffer<SampleType> crossfadeBuffer;
+    int crossfadeLength = 0;
+    int crossfadeRemaining = 0;
+
+    // ADAA history per oversampler slot, for the clipped signal and the delta
+    // monitor's dry copy. On a switch the outgoing configuration carries on the
+    // stream the active one was clipping, so the histories move with it
+    typename ClipperType::AdaaHistory clipHistories[2];
+    typename ClipperType::AdaaHistory dryHistories[2];
+
+    // Auto oversampling - blocks whose peak stays in the curve's linear region
+    // (with headroom for intersample peaks) skip upsample/clip/downsample and
+    // pass through a delay matched to the clip path's linear response. The clip
+    // path stays on for a hold time after the last loud block. It fades out over
+    // the crossfade length, and back in within the delay's lookahead, so a loud
+    // block is clipped before any of it reaches the output
+    juce::AudioBuffer<SampleType> autoHistory;   // Ring of recent clip-path input
+    juce::AudioBuffer<SampleType> autoDelayed;   // This block through the matched delay
+    std::vector<SampleType> autoTapStates;       // Thiran input and output per channel and tap
+    int autoHistoryPos = 0;
+    int autoLookahead = 0;                       // Whole samples before the input reaches autoDelayed
+    int autoHoldLength = 0;
+    int autoHoldRemaining = 0;
+    int autoFadeRemaining = 0;
+    float autoFadeGain = 1.0f;                   // Clip path share of the output
+    float autoFadeStep = 0.0f;
+    bool autoFadingIn = false;
+    bool autoOversamplingEnabled = false;
+    bool oversamplingPathActive = true;
+
+    // Digital silence - every curve maps zero to zero, so once the input has
+    // been exactly zero for the hold time (longer than any oversampler, ADAA or
+    // limiter tail in the clip path) the output is zero too. Blocks after that
+    // skip everything but their smoothers until a non-zero sample arrives, and
+    // the clip path picks up from clean state, as after reset()
+    int silentSamples = 0;
+    bool silenceSkipping = false;
+    bool segmentSkipped = false;
+
+    // Input level (relative to the ceiling) below which the curve is linear,
+    // recomputed when the curve or exponent changes
+    float linearLimit = 1.0f;
+    int curveIndex = 0;
+    float curveExponent = 2.0f;
+
+    // Delta monitoring - unclipped copy of the signal at the clip (oversampled) rate.
+    // The difference is downsampled by the main oversampler, so it is phase-matched
+    // by construction and costs no extra filter chain
+    juce::AudioBuffer<SampleType> dryBuffer;
     bool deltaMonitorEnabled = false;
 
     // Envelope peaks for display (updated each process call)
     float lastPreClipPeak = 0.0f;
     float lastPostClipPeak = 0.0f;
+    EnvelopeBins envelopeBins;
+    ClipStats lastClipStats;
+    ClipMeter clipMeter;
+    bool clipMeteringEnabled = false;
+    StageProfiler stageProfiler;
 
-    // Enforce ceiling (final hard limiter after downsampling)
+    // Enforce ceiling (final hard limiter after downsampling). True peak mode runs
+    // the lookahead limiter first so reconstructed peaks stay under the ceiling too
+    BasicTruePeakLimiter<SampleType> truePeakLimiter;
     bool enforceCeilingEnabled = true;
+    bool truePeakModeEnabled = false;
     float ceilingLinear = 1.0f;
 
+    // Ceiling automation: changes after the first processed block ramp linearly
+    // over 2ms instead of stepping. While ramping, ceilingRamp holds the segment's
+    // base-rate ceilings ([0] = the value before it, [i] = after sample i - 1)
+    // and clipCeilings/clipInverses the clip-rate ramp and its reciprocal. The
+    // fixed-ceiling path never touches them
+    juce::SmoothedValue<float> ceilingSmoothed { 1.0f };
+    std::vector<float> ceilingRamp;
+    std::vector<SampleType> clipCeilings;
+    std::vector<SampleType> clipInverses;
+    bool ceilingRamping = false;
+    bool streamStarted = false;  // Audio processed since prepare() or reset()
+
+    // Queued by addParameterEvent(), consumed by the next process()
+    struct ParameterEvent
+    {
+        int sampleOffset = 0;
+        EngineParameters parameters;
+    };
+    std::array<ParameterEvent, maxParameterEvents> parameterEvents;
+    int numParameterEvents = 0;
+
+    // Oversampling stages split across threads, see setWorkerThreads()
+    std::unique_ptr<WorkerPool> workerPool;
+    int numWorkerThreads = 0;
+    bool workerThreadsActive = true;
+
     // Bypass clipper (still applies input/output gain)
     bool bypassed = false;
 
+    // Last snapshot given to setParameters()
+    EngineParameters appliedParameters;
+    bool hasAppliedParameters = false;
+
     // State
     double currentSampleRate = 44100.0;
     int currentNumChannels = 2;
 };
 
+using ClipperEngine = BasicClipperEngine<float>;
+using ClipperEngineDouble = BasicClipperEngine<double>;
+
 } // namespace dsp
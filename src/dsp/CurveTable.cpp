@@ -0,0 +1,344 @@
+#include "CurveTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace dsp {
+
+namespace {
+
+constexpr double kTwoOverPi = 2.0 / 3.14159265358979323846;
+
+// Where each curve is close enough to its limit to stop tabulating:
+// tanh(8) is 1 - 2e-7, Arctan's tail series is within 1e-10 past 64
+double tableRange(CurveType type)
+{
+    switch (type)
+    {
+        case CurveType::Tanh:   return 8.0;
+        case CurveType::Arctan: return 64.0;
+        case CurveType::T2:
+        default:                return 1.0;
+    }
+}
+
+// Derivative of the unit curve for x > 0, taken from below where the curve has
+// a corner (T2 at its clip point)
+double curveSlope(CurveType type, double x, float exponent)
+{
+    switch (type)
+    {
+        case CurveType::Tanh:
+        {
+            const double t = std::tanh(x);
+            return 1.0 - t * t;
+        }
+        case CurveType::Arctan:
+            return kTwoOverPi / (1.0 + x * x);
+        case CurveType::T2:
+        default:
+            return exponent * std::pow(x, static_cast<double>(exponent) - 1.0);
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// CurveTable
+// =============================================================================
+
+bool CurveTable::isTabulated(CurveType type)
+{
+    return type == CurveType::Tanh || type == CurveType::Arctan || type == CurveType::T2;
+}
+
+CurveTable::CurveTable(CurveType type, float exponentToUse, Precision precisionToUse)
+    : curve(type), exponent(exponentToUse), precision(precisionToUse)
+{
+    precision.size = std::clamp(precision.size, 16, 65536);
+
+    const int size = precision.size;
+    range = static_cast<float>(tableRange(curve));
+    scale = static_cast<float>(size) / range;
+
+    const double step = static_cast<double>(range) / size;
+    auto value = [this](double x) { return curves::apply(curve, x, exponent); };
+
+    nodes.resize(static_cast<size_t>(size) + 1);
+    for (int i = 0; i < size; ++i)
+    {
+        const double x0 = i * step;
+        const double x1 = (i + 1) * step;
+        const double y0 = value(x0);
+        const double y1 = value(x1);
+
+        double c1 = y1 - y0;
+        double c2 = 0.0;
+        double c3 = 0.0;
+
+        if (precision.interpolation == Interpolation::Hermite)
+        {
+            // Slopes scaled to the segment. At 0 an exponent below 1 has an
+            // infinite slope - the chord is the best a cubic can do there
+            double m0 = curveSlope(curve, x0, exponent) * step;
+            if (!std::isfinite(m0))
+                m0 = c1;
+            const double m1 = curveSlope(curve, x1, exponent) * step;
+
+            c1 = m0;
+            c2 = 3.0 * (y1 - y0) - 2.0 * m0 - m1;
+            c3 = 2.0 * (y0 - y1) + m0 + m1;
+        }
+
+        nodes[static_cast<size_t>(i)] = { static_cast<float>(y0), static_cast<float>(c1),
+                                          static_cast<float>(c2), static_cast<float>(c3) };
+    }
+
+    nodes[static_cast<size_t>(size)] = { static_cast<float>(value(range)), 0.0f, 0.0f, 0.0f };
+}
+
+bool CurveTable::matches(CurveType type, float exponentToMatch) const
+{
+    return type == curve && (curve != CurveType::T2 || exponentToMatch == exponent);
+}
+
+double CurveTable::evaluate(double x) const
+{
+    if (std::isnan(x))
+        return x;
+
+    const double t = std::abs(x);
+    double y = 0.0;
+
+    if (t > range && hasAsymptoticTail())
+    {
+        const double u = 1.0 / t;
+        y = 1.0 - kTwoOverPi * u * (1.0 - u * u / 3.0);
+    }
+    else
+    {
+        const double position = std::min(t * scale, static_cast<double>(precision.size));
+        const int index = static_cast<int>(position);
+        const double f = position - index;
+        const Node& node = nodes[static_cast<size_t>(index)];
+        y = node.c0 + f * (node.c1 + f * (node.c2 + f * node.c3));
+    }
+
+    return std::copysign(y, x);
+}
+
+// =============================================================================
+// CurveLookup
+// =============================================================================
+
+// One thread for every lookup in the process, asleep until woken with a
+// request pending. It lives as long as some lookup holds it
+class CurveLookup::Builder
+{
+public:
+    Builder() : thread([this]() { run(); }) {}
+
+    ~Builder()
+    {
+        {
+            const std::lock_guard<std::mutex> guard(wakeLock);
+            quit.store(true, std::memory_order_relaxed);
+        }
+        wakeup.notify_one();
+        thread.join();
+    }
+
+    // The running builder, started first if create is set (nullptr otherwise)
+    static std::shared_ptr<Builder> getShared(bool create)
+    {
+        static std::mutex instanceLock;
+        static std::weak_ptr<Builder> instance;
+
+        const std::lock_guard<std::mutex> guard(instanceLock);
+        auto shared = instance.lock();
+        if (shared == nullptr && create)
+        {
+            shared = std::make_shared<Builder>();
+            instance = shared;
+        }
+        return shared;
+    }
+
+    void add(CurveLookup* lookup)
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        lookups.push_back(lookup);
+    }
+
+    void remove(CurveLookup* lookup)
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        lookups.erase(std::remove(lookups.begin(), lookups.end(), lookup), lookups.end());
+    }
+
+    // Audio thread: a flag, no syscall. Passed on by wakeIfRequested()
+    void request()
+    {
+        pending.store(true, std::memory_order_release);
+    }
+
+    // Not on the audio thread. Under wakeLock, so the builder is either
+    // before its check (and sees the flag) or waiting (and gets the notify)
+    void wake()
+    {
+        {
+            const std::lock_guard<std::mutex> guard(wakeLock);
+            pending.store(true, std::memory_order_relaxed);
+        }
+        wakeup.notify_one();
+    }
+
+    void wakeIfRequested()
+    {
+        if (pending.load(std::memory_order_acquire))
+            wake();
+    }
+
+    // Held while a table is built, so a lookup is never built into from two threads
+    std::mutex lock;
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> wakeGuard(wakeLock);
+        while (!quit.load(std::memory_order_relaxed))
+        {
+            wakeup.wait(wakeGuard, [this]()
+            {
+                return pending.load(std::memory_order_acquire) || quit.load(std::memory_order_relaxed);
+            });
+
+            if (quit.load(std::memory_order_relaxed))
+                break;
+
+            // Cleared first: a request flagged mid-build is seen by the next
+            // check, without waiting for a wake
+            pending.store(false, std::memory_order_relaxed);
+            wakeGuard.unlock();
+            {
+                const std::lock_guard<std::mutex> guard(lock);
+                for (auto* lookup : lookups)
+                    lookup->rebuild(false);
+            }
+            wakeGuard.lock();
+        }
+    }
+
+    std::vector<CurveLookup*> lookups;
+    std::mutex wakeLock;
+    std::condition_variable wakeup;
+    std::atomic<bool> pending { false };
+    std::atomic<bool> quit { false };
+    std::thread thread;
+};
+
+CurveLookup::~CurveLookup()
+{
+    if (builder != nullptr)
+        builder->remove(this);
+}
+
+void CurveLookup::prepare()
+{
+    if (builder != nullptr)
+        return;
+
+    builder = Builder::getShared(true);
+    builder->add(this);
+    builder->wake();
+}
+
+void CurveLookup::build(CurveType type, float exponent)
+{
+    prepare();
+    requested.store(makeKey(type, exponent), std::memory_order_relaxed);
+
+    const std::lock_guard<std::mutex> guard(builder->lock);
+    rebuild(true);
+}
+
+void CurveLookup::setPrecision(CurveTable::Precision newPrecision)
+{
+    // Not joined yet: no thread builds into this lookup
+    if (builder == nullptr)
+    {
+        precision = newPrecision;
+        return;
+    }
+
+    {
+        const std::lock_guard<std::mutex> guard(builder->lock);
+        if (newPrecision == precision)
+            return;
+
+        precision = newPrecision;
+        precisionChanged = true;
+    }
+    builder->wake();
+}
+
+std::uint64_t CurveLookup::makeKey(CurveType type, float exponent)
+{
+    // Only T2 depends on the exponent - the others keep their table across changes
+    const float keyExponent = (type == CurveType::T2) ? exponent : 0.0f;
+    std::uint32_t exponentBits = 0;
+    std::memcpy(&exponentBits, &keyExponent, sizeof(exponentBits));
+    return (static_cast<std::uint64_t>(type) + 1) << 32 | exponentBits;
+}
+
+void CurveLookup::rebuild(bool force)
+{
+    const std::uint64_t key = requested.load(std::memory_order_acquire);
+    if (key == 0 || (!force && key == builtKey && !precisionChanged))
+        return;
+
+    builtKey = key;
+    precisionChanged = false;
+
+    const auto type = static_cast<CurveType>((key >> 32) - 1);
+    if (!CurveTable::isTabulated(type))
+        return;
+
+    const auto exponentBits = static_cast<std::uint32_t>(key);
+    float exponent = 0.0f;
+    std::memcpy(&exponent, &exponentBits, sizeof(exponent));
+
+    // The back slot is the builder's alone - whatever it held was handed back
+    // by the audio thread
+    slots[back] = std::make_unique<CurveTable>(type, exponent, precision);
+    slotKeys[back] = key;
+    back = middle.exchange(back | kFresh, std::memory_order_acq_rel) & kSlotMask;
+}
+
+const CurveTable* CurveLookup::acquire(CurveType type, float exponent)
+{
+    if ((middle.load(std::memory_order_relaxed) & kFresh) != 0)
+        front = middle.exchange(front, std::memory_order_acq_rel) & kSlotMask;
+
+    const std::uint64_t key = makeKey(type, exponent);
+    if (requested.load(std::memory_order_relaxed) != key)
+    {
+        requested.store(key, std::memory_order_release);
+        if (builder != nullptr)
+            builder->request();
+    }
+
+    return (slots[front] != nullptr && slotKeys[front] == key) ? slots[front].get() : nullptr;
+}
+
+void CurveLookup::serviceRequests()
+{
+    if (auto shared = Builder::getShared(false))
+        shared->wakeIfRequested();
+}
+
+} // namespace dsp
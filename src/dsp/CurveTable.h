@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SaturatorCurves.h"
+
+namespace dsp {
+
+// Interpolated lookup table of one unit curve (Tanh, Arctan, or T2 at one
+// exponent) over |x| in [0, range], odd symmetric. Each segment stores the
+// coefficients of its interpolating polynomial, so an evaluation is one 16-byte
+// node load and three multiply-adds - the default 2048 segments take 32 KB.
+// Node values and slopes come from the exact curves in SaturatorCurves.h.
+// Beyond the range Tanh and T2 sit at +-1 and Arctan follows its asymptotic
+// series 1 - (2/pi)(1/x - 1/(3x^3)).
+class CurveTable
+{
+public:
+    enum class Interpolation { Linear, Hermite };
+
+    struct Precision
+    {
+        int size = 2048;  // Segments over the range, clamped to [16, 65536]
+        Interpolation interpolation = Interpolation::Hermite;
+
+        bool operator==(const Precision& other) const { return size == other.size && interpolation == other.interpolation; }
+        bool operator!=(const Precision& other) const { return !(*this == other); }
+    };
+
+    // c0 + c1 t + c2 t^2 + c3 t^3 for t in [0, 1) across the segment
+    struct alignas(16) Node
+    {
+        float c0, c1, c2, c3;
+    };
+
+    // The curves worth a table - the others are a few multiplies already
+    static bool isTabulated(CurveType type);
+
+    // Samples the curve at every node - allocates, keep it off the audio thread
+    CurveTable(CurveType type, float exponent, Precision precision);
+
+    // Exponent only counts for the curve that uses it (T2)
+    bool matches(CurveType type, float exponent) const;
+
+    // Unit curve at x, one sample at a time (tests use it against the kernels)
+    double evaluate(double x) const;
+
+    CurveType getCurve() const { return curve; }
+    const Precision& getPrecision() const { return precision; }
+
+    // For the block kernels: node i covers |x| in [i, i + 1) / scale, and
+    // node[size] holds the value at the range's end
+    const Node* getNodes() const { return nodes.data(); }
+    int getSize() const { return precision.size; }
+    float getScale() const { return scale; }
+    float getRange() const { return range; }
+    bool hasAsymptoticTail() const { return curve == CurveType::Arctan; }
+
+private:
+    CurveType curve;
+    float exponent;
+    Precision precision;
+    float range = 1.0f;
+    float scale = 1.0f;
+    std::vector<Node> nodes;
+};
+
+// Hands tables to the audio thread without it ever building one. acquire()
+// returns the table for the clipper's current curve, or nullptr - the caller
+// falls back to the approximation kernels - while a shared builder thread
+// makes the one it asked for. Finished tables come back through a lock-free
+// triple buffer, so neither thread waits on the other.
+//
+// The audio thread only flags its requests. Waking the builder is a syscall,
+// so a non-realtime thread passes them on with serviceRequests() - the plugin
+// from a message thread timer, offline tools between blocks.
+class CurveLookup
+{
+public:
+    CurveLookup() = default;
+    ~CurveLookup();
+
+    CurveLookup(const CurveLookup&) = delete;
+    CurveLookup& operator=(const CurveLookup&) = delete;
+
+    // Joins the shared builder thread, once. Not on the audio thread
+    void prepare();
+
+    // Makes the table for (type, exponent) right away, so the next block
+    // already has it. Not on the audio thread
+    void build(CurveType type, float exponent);
+
+    // Rebuilds the current table at the new precision. Doesn't join the
+    // builder on its own. Not on the audio thread
+    void setPrecision(CurveTable::Precision newPrecision);
+
+    // Audio thread: no locks, allocations or syscalls - a new request is only
+    // flagged for serviceRequests()
+    const CurveTable* acquire(CurveType type, float exponent);
+
+    // Wakes the builder if any lookup flagged a request since the last call.
+    // Cheap when nothing did. Not on the audio thread
+    static void serviceRequests();
+
+private:
+    class Builder;
+
+    static std::uint64_t makeKey(CurveType type, float exponent);
+
+    // Builder side, under the builder's lock
+    void rebuild(bool force);
+
+    static constexpr int kFresh = 4;  // Set on middle once a new table is in it
+    static constexpr int kSlotMask = 3;
+
+    std::unique_ptr<CurveTable> slots[3];
+    std::uint64_t slotKeys[3] = {};
+    int front = 0;                 // Audio thread's slot
+    int back = 1;                  // Builder's slot
+    std::atomic<int> middle { 2 }; // Handoff slot
+    std::atomic<std::uint64_t> requested { 0 };
+
+    std::uint64_t builtKey = 0;
+    CurveTable::Precision precision;
+    bool precisionChanged = false;
+
+    std::shared_ptr<Builder> builder;
+};
+
+} // namespace dsp
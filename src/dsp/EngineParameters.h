@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dsp {
+
+// Every user-facing engine parameter in one value, as the plugin's APVTS holds
+// them (dB, choice indices, switches). The producer bumps version whenever any
+// field may have changed; BasicClipperEngine::setParameters skips a snapshot
+// whose version it has already applied and otherwise only runs the setters
+// whose fields differ, so an unchanged block costs one compare.
+struct EngineParameters
+{
+    std::uint32_t version = 0;
+
+    float inputGain = 0.0f;        // dB
+    float outputGain = 0.0f;       // dB
+    float ceiling = 0.0f;          // dB
+    int curve = 0;                 // 0=Hard ... 6=T2
+    float curveExponent = 4.0f;
+    int oversampling = 2;          // 0=1x ... 5=32x
+    int filterType = 0;            // 0=Minimum Phase, 1=Linear Phase, 2=Low Latency
+    bool polyphaseAllpass = false;
+    bool efficientFilters = false; // Cheaper JUCE oversampling stages past 2x
+    bool autoOversampling = false;
+    int antialiasing = 0;          // 0=Off, 1=ADAA 1st order, 2=ADAA 2nd order
+    bool curveTable = false;       // Lookup-table curve evaluation
+    bool midSide = false;
+    bool stereoLink = true;
+    bool deltaMonitor = false;
+    bool bypass = false;
+    bool enforceCeiling = true;
+    bool truePeak = false;
+};
+
+} // namespace dsp
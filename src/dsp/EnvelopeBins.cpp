@@ -0,0 +1,61 @@
+#include "EnvelopeBins.h"
+#include <cmath>
+
+namespace dsp {
+
+void EnvelopeBins::prepare(double sampleRate, int maxBlockSize, double intervalSeconds)
+{
+    binLength = std::max(1, static_cast<int>(std::round(sampleRate * intervalSeconds)));
+
+    // A block can touch every bin it completes plus the one left open
+    const size_t maxBins = static_cast<size_t>(maxBlockSize / binLength + 2);
+    pending.assign(maxBins, EnvelopeBin {});
+    completed.assign(maxBins, EnvelopeBin {});
+
+    reset();
+}
+
+void EnvelopeBins::reset()
+{
+    std::fill(pending.begin(), pending.end(), EnvelopeBin {});
+    binPhase = 0;
+    numCompleted = 0;
+}
+
+void EnvelopeBins::copyPreClipToPostClip(int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    const int lastBin = binIndex(numSamples - 1);
+    for (int i = 0; i <= lastBin; ++i)
+    {
+        auto& bin = pending[static_cast<size_t>(i)];
+        bin.postClip = std::max(bin.postClip, bin.preClip);
+    }
+}
+
+void EnvelopeBins::finishBlock(int numSamples)
+{
+    numCompleted = 0;
+    finishSegment(numSamples);
+}
+
+void EnvelopeBins::finishSegment(int numSamples)
+{
+    const int newlyCompleted = (binPhase + numSamples) / binLength;
+
+    // The segments of one block complete no more bins than the whole block
+    // would, so this only clips a block longer than prepared for
+    const int published = std::min(newlyCompleted, static_cast<int>(completed.size()) - numCompleted);
+    std::copy_n(pending.begin(), published, completed.begin() + numCompleted);
+    numCompleted += published;
+
+    // The bin still filling moves to the front, everything after it is empty
+    pending[0] = pending[static_cast<size_t>(newlyCompleted)];
+    std::fill(pending.begin() + 1, pending.begin() + newlyCompleted + 1, EnvelopeBin {});
+
+    binPhase = (binPhase + numSamples) % binLength;
+}
+
+} // namespace dsp
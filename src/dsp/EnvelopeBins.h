@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace dsp {
+
+// One display bin: peaks in linear amplitude over a fixed stretch of time
+struct EnvelopeBin
+{
+    float preClip = 0.0f;   // After input gain, before clipping (RED)
+    float postClip = 0.0f;  // After clipping, before output gain (WHITE)
+};
+
+// Splits the sample stream into bins of a fixed wall-clock length, independent
+// of host block size. The engine's existing passes cut their chunks at bin
+// boundaries (samplesToBoundary) and report one peak per chunk, so binning
+// costs no extra walk over the buffer. A bin can span several blocks, and one
+// block can finish several bins.
+//
+// Offsets are in samples from the start of the current block.
+class EnvelopeBins
+{
+public:
+    static constexpr double defaultIntervalSeconds = 0.005;  // 5ms per bin
+
+    void prepare(double sampleRate, int maxBlockSize, double intervalSeconds = defaultIntervalSeconds);
+    void reset();
+
+    int getBinLength() const { return binLength; }
+
+    // Samples from blockOffset until the current bin is full
+    int samplesToBoundary(int blockOffset) const
+    {
+        return binLength - (binPhase + blockOffset) % binLength;
+    }
+
+    // Peak of a chunk that lies inside one bin
+    void addPreClip(int blockOffset, float peak)
+    {
+        auto& bin = pending[static_cast<size_t>(binIndex(blockOffset))];
+        bin.preClip = std::max(bin.preClip, peak);
+    }
+
+    void addPostClip(int blockOffset, float peak)
+    {
+        auto& bin = pending[static_cast<size_t>(binIndex(blockOffset))];
+        bin.postClip = std::max(bin.postClip, peak);
+    }
+
+    // Bypass: nothing is clipped, so post-clip follows pre-clip
+    void copyPreClipToPostClip(int numSamples);
+
+    // Publishes the bins completed by this block; the partial one carries over
+    void finishBlock(int numSamples);
+
+    // A block processed in pieces: each piece is a block of its own for the
+    // offsets above and finishes with finishSegment(), which adds its bins to
+    // the ones the earlier pieces completed. clearCompleted() starts the block
+    void clearCompleted() { numCompleted = 0; }
+    void finishSegment(int numSamples);
+
+    // Bins completed by the last finishBlock() (or the segments since
+    // clearCompleted()), valid until the next one
+    int getNumCompletedBins() const { return numCompleted; }
+    const EnvelopeBin& getCompletedBin(int index) const { return completed[static_cast<size_t>(index)]; }
+
+private:
+    int binIndex(int blockOffset) const { return (binPhase + blockOffset) / binLength; }
+
+    int binLength = 220;
+    int binPhase = 0;  // Samples already in the current bin at the start of the block
+
+    // Open bins touched by the current block (index 0 = the carried partial bin)
+    std::vector<EnvelopeBin> pending;
+    std::vector<EnvelopeBin> completed;
+    int numCompleted = 0;
+};
+
+} // namespace dsp
@@ -0,0 +1,51 @@
+#include "EnvelopeFifo.h"
+#include <algorithm>
+
+namespace dsp {
+
+EnvelopeFifo::EnvelopeFifo(int capacity)
+    : fifo(capacity),
+      frames(static_cast<size_t>(capacity))
+{
+}
+
+bool EnvelopeFifo::push(const EnvelopeFrame& frame)
+{
+    const auto scope = fifo.write(1);
+
+    if (scope.blockSize1 > 0)
+        frames[static_cast<size_t>(scope.startIndex1)] = frame;
+    else if (scope.blockSize2 > 0)
+        frames[static_cast<size_t>(scope.startIndex2)] = frame;
+    else
+    {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+int EnvelopeFifo::pop(EnvelopeFrame* dest, int maxFrames)
+{
+    const auto scope = fifo.read(maxFrames);
+
+    std::copy_n(frames.begin() + scope.startIndex1, scope.blockSize1, dest);
+    std::copy_n(frames.begin() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+void EnvelopeFifo::discardReady()
+{
+    // finishedRead only moves the read index, so this stays consumer-side
+    fifo.finishedRead(fifo.getNumReady());
+}
+
+void EnvelopeFifo::reset()
+{
+    fifo.reset();
+    numDropped.store(0, std::memory_order_relaxed);
+}
+
+} // namespace dsp
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <vector>
+
+namespace dsp {
+
+// One display point: peaks in linear amplitude, threshold as a 0-1 display fraction
+struct EnvelopeFrame
+{
+    float preClip = 0.0f;    // After input gain, before clipping (RED)
+    float postClip = 0.0f;   // After clipping, before output gain (WHITE)
+    float threshold = 0.0f;  // Ceiling used for this point
+};
+
+// Lock-free single-producer/single-consumer queue of envelope frames.
+//
+// The audio thread pushes whole frames (one per ClipperEngine envelope bin),
+// so the GUI can never see a half-written point. The message thread drains
+// whatever is ready with pop(). If the GUI stops draining (editor closed or
+// stalled), new frames are dropped rather than blocking the audio thread, so
+// the producer cost stays fixed no matter how the GUI is refreshing.
+class EnvelopeFifo
+{
+public:
+    static constexpr int defaultCapacity = 1024;
+
+    explicit EnvelopeFifo(int capacity = defaultCapacity);
+
+    // --- Producer (audio thread) ---
+
+    // Returns false (and counts the drop) if the consumer has fallen behind
+    bool push(const EnvelopeFrame& frame);
+
+    // --- Consumer (message thread) ---
+
+    // Copies up to maxFrames of the oldest ready frames into dest, returns the count
+    int pop(EnvelopeFrame* dest, int maxFrames);
+
+    // Discards everything ready, e.g. stale frames when an editor opens
+    void discardReady();
+
+    int getNumReady() const { return fifo.getNumReady(); }
+    int getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+
+    // Clears the queue; only while neither side is active
+    void reset();
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<EnvelopeFrame> frames;
+    std::atomic<int> numDropped { 0 };
+};
+
+} // namespace dsp
@@ -1,154 +1,657 @@
 #include "Oversampler.h"
+#include "RealtimeScope.h"
+#include <cmath>
+#include <utility>
 
 namespace dsp {
 
-Oversampler::Oversampler()
+namespace {
+
+// Low latency: the first stage's transition is as wide as two coefficients per
+// direction can hold these rejections (0.18 of the 2x rate, passband to 14kHz
+// at 44.1kHz); later stages widen it towards 0.5 like the polyphase backend
+constexpr double kLowLatencyTransition = 0.18;
+constexpr double kLowLatencyAttenuationUp = 45.0;
+constexpr double kLowLatencyAttenuationDown = 40.0;
+
+// JUCE stage designs, [stage] for stages 0 (base rate -> 2x) to 4 (16x -> 32x).
+// A stage's design doesn't depend on how many follow it. High uses one spec
+// for every stage past the first. Efficient keeps stage 0 and lets later
+// stages widen their transition to just protect the band stage 0 passes (see
+// buildPolyphaseStages), taking 6 dB less attenuation per stage - clip
+// harmonics that far up are at least that much quieter
+struct StageDesign
 {
-    // Oversampler created in prepare()
+    float transition;       // Normalized to the stage's high rate, up and down
+    float attenuationUp;    // dB
+    float attenuationDown;  // dB
+};
+
+constexpr int kMaxStages = 5;
+
+// IIR: stage 0 passes 0.2 of its high rate (0.4 of the base rate)
+constexpr StageDesign kIirHigh[kMaxStages] = {
+    { 0.10f, -70.0f, -60.0f }, { 0.10f, -70.0f, -60.0f }, { 0.10f, -70.0f, -60.0f },
+    { 0.10f, -70.0f, -60.0f }, { 0.10f, -70.0f, -60.0f },
+};
+constexpr StageDesign kIirEfficient[kMaxStages] = {
+    { 0.10f, -70.0f, -60.0f }, { 0.30f, -64.0f, -54.0f }, { 0.40f, -58.0f, -48.0f },
+    { 0.45f, -52.0f, -42.0f }, { 0.47f, -46.0f, -36.0f },
+};
+
+// FIR: stage 0 passes 0.225 of its high rate (0.45 of the base rate)
+constexpr StageDesign kFirHigh[kMaxStages] = {
+    { 0.05f, -90.0f, -80.0f }, { 0.08f, -90.0f, -80.0f }, { 0.08f, -90.0f, -80.0f },
+    { 0.08f, -90.0f, -80.0f }, { 0.08f, -90.0f, -80.0f },
+};
+constexpr StageDesign kFirEfficient[kMaxStages] = {
+    { 0.05f, -90.0f, -80.0f }, { 0.27f, -84.0f, -74.0f }, { 0.38f, -78.0f, -68.0f },
+    { 0.44f, -72.0f, -62.0f }, { 0.47f, -66.0f, -56.0f },
+};
+
+} // namespace
+
+template <typename SampleType>
+BasicOversampler<SampleType>::BasicOversampler()
+{
+    // Configurations built on first use, see prepare()
 }
 
-void Oversampler::rebuildOversampler()
+template <typename SampleType>
+BasicOversampler<SampleType>::~BasicOversampler()
 {
-    if (currentFactorIndex == 0)
     {
-        // 1x = no oversampling needed
-        oversampler.reset();
-        return;
+        const std::lock_guard<std::mutex> lock(builderLock);
+        builderQuit = true;
     }
+    builderWakeup.notify_one();
+
+    if (builder.joinable())
+        builder.join();
+}
+
+template <typename SampleType>
+int BasicOversampler<SampleType>::configurationIndex(int factorIndex, FilterType type, Backend backend,
+                                                     FilterQuality quality)
+{
+    // 1x runs nothing, whatever the filter or backend
+    if (factorIndex == 0)
+        return 0;
+
+    // Linear phase always uses the JUCE FIR stages, low latency its own polyphase
+    // ones. Quality only picks between JUCE designs - the polyphase cascades
+    // are already at two coefficients per stage past the first
+    const bool efficient = (quality == FilterQuality::Efficient);
+    int variant = efficient ? 4 : 0;
+    if (type == FilterType::LinearPhase)
+        variant = efficient ? 5 : 1;
+    else if (type == FilterType::LowLatency)
+        variant = 3;
+    else if (backend == Backend::PolyphaseAllpass)
+        variant = 2;
+
+    return variant * NumFactors + factorIndex;
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::Configuration::reset()
+{
+    for (auto& partition : partitions)
+    {
+        if (partition.juceStages)
+            partition.juceStages->reset();
+
+        for (auto& stage : partition.polyphaseUp)
+            stage.reset();
+        for (auto& stage : partition.polyphaseDown)
+            stage.reset();
 
-    // Create oversampler with manual stage configuration for 32x support
-    // JUCE's constructor only supports up to 16x (factor=4), so we build manually
-    oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-        static_cast<size_t>(numChannels_));
+        std::fill(partition.compensationStates.begin(), partition.compensationStates.end(), SampleType(0));
+    }
+}
 
-    oversampler->clearOversamplingStages();
+template <typename SampleType>
+void BasicOversampler<SampleType>::Configuration::release()
+{
+    built.store(false, std::memory_order_relaxed);
+    std::vector<Partition>().swap(partitions);
+    std::vector<juce::AudioBuffer<SampleType>>().swap(stageBuffers);
+    latency = 0.0;
+    filterLatency = 0.0;
+    compensated = false;
+}
 
-    auto juceFilterType = (currentFilterType == FilterType::LinearPhase)
-        ? juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple
-        : juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+template <typename SampleType>
+void BasicOversampler<SampleType>::buildPolyphaseStages(Configuration& config, int numStages, FilterType type)
+{
+    const bool lowLatency = (type == FilterType::LowLatency);
 
-    // Add stages based on factor index (1=2x, 2=4x, 3=8x, 4=16x, 5=32x)
-    int numStages = currentFactorIndex;
+    config.partitions.clear();
+    config.partitions.resize(static_cast<size_t>(getNumPartitions()));
+    config.stageBuffers.clear();
+    config.stageBuffers.reserve(static_cast<size_t>(numStages));
+    config.latency = 0.0;
 
     for (int n = 0; n < numStages; ++n)
     {
-        // IIR (min-phase) filters have inherent transient ringing at low OS rates
-        // that cannot be tuned away - this is a fundamental limitation of polyphase IIR.
-        // Use 8x+ for best min-phase results, or use linear phase for lower rates.
-        // enforce_ceiling=true provides a safety net regardless of filter choice.
-        bool isIIR = (currentFilterType == FilterType::MinimumPhase);
-        float twUp, twDown, gaindBUp, gaindBDown;
-
-        if (isIIR)
+        // First stage matches the JUCE IIR spec. Stage n only has to protect the
+        // band the first stage passes (0.2 of its high rate), which shrinks by 2x
+        // per stage - so the transition widens towards 0.5 and 2 coefficients do.
+        const double firstTransition = lowLatency ? kLowLatencyTransition : 0.1;
+        const double transition = 0.5 - (0.5 - firstTransition) / static_cast<double>(1 << n);
+
+        const auto upCoefficients = BasicPolyphaseHalfband<SampleType>::designCoefficients(
+            lowLatency ? kLowLatencyAttenuationUp : 70.0, transition);
+        const auto downCoefficients = BasicPolyphaseHalfband<SampleType>::designCoefficients(
+            lowLatency ? kLowLatencyAttenuationDown : 60.0, transition);
+
+        for (int p = 0; p < getNumPartitions(); ++p)
         {
-            // IIR: moderate settings - can't avoid ringing at low rates
-            twUp   = 0.10f;
-            twDown = 0.10f;
-            gaindBUp   = -70.0f;
-            gaindBDown = -60.0f;
+            auto& partition = config.partitions[static_cast<size_t>(p)];
+            const int partitionChannels = getPartitionSize(p);
+            partition.polyphaseUp.emplace_back();
+            partition.polyphaseDown.emplace_back();
+            partition.polyphaseUp.back().prepare(upCoefficients, partitionChannels);
+            partition.polyphaseDown.back().prepare(downCoefficients, partitionChannels);
         }
-        else
+
+        config.stageBuffers.emplace_back(numChannels_, maxBlockSize_ << (n + 1));
+
+        // Group delay is per lower rate of the stage -> scale to the base rate
+        const auto& first = config.partitions.front();
+        config.latency += (first.polyphaseUp.back().getGroupDelay() + first.polyphaseDown.back().getGroupDelay())
+                          / static_cast<double>(1 << n);
+    }
+
+    // The compensation itself follows the clip delay, which belongs to the
+    // audio thread - switchConfiguration() sets it
+    config.compensated = lowLatency;
+    config.filterLatency = config.latency;
+    if (lowLatency)
+        for (int p = 0; p < getNumPartitions(); ++p)
+            config.partitions[static_cast<size_t>(p)].compensationStates.assign(
+                static_cast<size_t>(2 * getPartitionSize(p)), SampleType(0));
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::updateCompensation(Configuration& config, int numStages)
+{
+    // Pad to the next whole sample at least half a sample away: a first-order
+    // Thiran allpass is accurate for delays between 0.5 and 1.5 samples
+    const double delay = config.filterLatency + clipDelay / static_cast<double>(1 << numStages);
+    const double padding = std::ceil(delay + 0.5) - delay;
+
+    config.latency = delay + padding;
+    config.compensationCoefficient = static_cast<SampleType>((1.0 - padding) / (1.0 + padding));
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::applyCompensation(Configuration& config, int partition,
+                                                     juce::AudioBuffer<SampleType>& outputBuffer, int numSamples)
+{
+    auto& filters = config.partitions[static_cast<size_t>(partition)];
+    const int firstChannel = partitionStarts[static_cast<size_t>(partition)];
+    const SampleType a = config.compensationCoefficient;
+
+    // H(z) = (a + z^-1) / (1 + a z^-1), DC group delay (1 - a) / (1 + a)
+    for (int ch = 0; ch < getPartitionSize(partition); ++ch)
+    {
+        SampleType* data = outputBuffer.getWritePointer(firstChannel + ch);
+        SampleType& input = filters.compensationStates[static_cast<size_t>(2 * ch)];
+        SampleType& output = filters.compensationStates[static_cast<size_t>(2 * ch + 1)];
+
+        for (int i = 0; i < numSamples; ++i)
         {
-            // FIR: tight transitions, high attenuation (no ringing)
-            twUp   = (n == 0) ? 0.05f : 0.08f;
-            twDown = (n == 0) ? 0.05f : 0.08f;
-            gaindBUp   = -90.0f;
-            gaindBDown = -80.0f;
+            const SampleType x = data[i];
+            output = a * (x - output) + input;
+            input = x;
+            data[i] = output;
         }
+    }
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::buildJuceStages(Configuration& config, int numStages, FilterType type,
+                                                   FilterQuality quality)
+{
+    // IIR (min-phase) filters have inherent transient ringing at low OS rates
+    // that cannot be tuned away - this is a fundamental limitation of polyphase IIR.
+    // Use 8x+ for best min-phase results, or use linear phase for lower rates.
+    // enforce_ceiling=true provides a safety net regardless of filter choice.
+    const bool isIIR = (type == FilterType::MinimumPhase);
+    const bool efficient = (quality == FilterQuality::Efficient);
+    const auto juceFilterType = isIIR ? juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                      : juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple;
+    const StageDesign* stageDesigns = isIIR ? (efficient ? kIirEfficient : kIirHigh)
+                                            : (efficient ? kFirEfficient : kFirHigh);
+    jassert(numStages <= kMaxStages);
+
+    config.partitions.clear();
+    config.partitions.resize(static_cast<size_t>(getNumPartitions()));
+    for (int p = 0; p < getNumPartitions(); ++p)
+    {
+        // Create oversampler with manual stage configuration for 32x support
+        // JUCE's constructor only supports up to 16x (factor=4), so we build manually
+        const int partitionChannels = getPartitionSize(p);
+        auto& partition = config.partitions[static_cast<size_t>(p)];
+        partition.juceStages = std::make_unique<juce::dsp::Oversampling<SampleType>>(
+            static_cast<size_t>(partitionChannels));
 
-        oversampler->addOversamplingStage(juceFilterType, twUp, gaindBUp, twDown, gaindBDown);
+        auto& stages = *partition.juceStages;
+        stages.clearOversamplingStages();
+
+        for (int n = 0; n < numStages; ++n)
+        {
+            const auto& design = stageDesigns[n];
+            stages.addOversamplingStage(juceFilterType, design.transition, design.attenuationUp,
+                                        design.transition, design.attenuationDown);
+        }
+
+        stages.initProcessing(static_cast<size_t>(maxBlockSize_));
+        stages.reset();
     }
 
-    oversampler->initProcessing(static_cast<size_t>(maxBlockSize_));
-    oversampler->reset();
+    config.latency = static_cast<double>(config.partitions.front().juceStages->getLatencyInSamples());
 }
 
-void Oversampler::prepare(double /*sampleRate*/, int maxBlock, int channels)
+template <typename SampleType>
+void BasicOversampler<SampleType>::prepare(double /*sampleRate*/, int maxBlock, int channels, int numPartitions)
 {
+    // A build in flight uses the old sizes - let it finish, and drop any request
+    std::unique_lock<std::mutex> lock(builderLock);
+    builderIdle.wait(lock, [this] { return builderJob < 0; });
+    buildRequest.store(-1, std::memory_order_relaxed);
+    pendingConfig = -1;
+
     numChannels_ = channels;
     maxBlockSize_ = maxBlock;
 
-    rebuildOversampler();
+    // Contiguous, as even as the channel count allows, none empty
+    const int partitions = std::clamp(numPartitions, 1, std::max(channels, 1));
+    partitionStarts.resize(static_cast<size_t>(partitions + 1));
+    for (int p = 0; p <= partitions; ++p)
+        partitionStarts[static_cast<size_t>(p)] = p * channels / partitions;
+
+    // Only the active configuration now, the others when first switched to.
+    // Index 0 (1x) has nothing to build
+    for (auto& config : configurations)
+        config.release();
+    configurations.front().built.store(true, std::memory_order_relaxed);
+
+    channelPtrs.assign(static_cast<size_t>(numChannels_), nullptr);
+
+    activeConfig = configurationIndex(currentFactorIndex, currentFilterType, currentBackend, currentQuality);
+    outgoingConfig = -1;
+    buildConfiguration(activeConfig);
+    if (configurations[static_cast<size_t>(activeConfig)].compensated)
+        updateCompensation(configurations[static_cast<size_t>(activeConfig)], currentFactorIndex);
     isPrepared = true;
 }
 
-void Oversampler::reset()
+template <typename SampleType>
+void BasicOversampler<SampleType>::buildConfiguration(int index)
 {
-    if (oversampler)
-        oversampler->reset();
+    auto& config = configurations[static_cast<size_t>(index)];
+    if (index == 0 || config.built.load(std::memory_order_acquire))
+        return;
+
+    // Inverse of configurationIndex()
+    const int factorIndex = index % NumFactors;
+    const int variant = index / NumFactors;
+    const auto quality = (variant >= 4) ? FilterQuality::Efficient : FilterQuality::High;
+
+    if (variant == 2)
+        buildPolyphaseStages(config, factorIndex, FilterType::MinimumPhase);
+    else if (variant == 3)
+        buildPolyphaseStages(config, factorIndex, FilterType::LowLatency);
+    else
+        buildJuceStages(config, factorIndex, (variant % 4 == 1) ? FilterType::LinearPhase : FilterType::MinimumPhase,
+                        quality);
+
+    config.built.store(true, std::memory_order_release);
 }
 
-void Oversampler::setOversamplingFactor(int factorIndex)
+template <typename SampleType>
+void BasicOversampler<SampleType>::runBuilder()
 {
-    int newIndex = std::clamp(factorIndex, 0, NumFactors - 1);
-    if (currentFactorIndex != newIndex)
+    std::unique_lock<std::mutex> lock(builderLock);
+    for (;;)
     {
-        currentFactorIndex = newIndex;
-        if (isPrepared)
-            rebuildOversampler();
+        builderWakeup.wait(lock, [this] { return builderQuit || builderJob >= 0; });
+        if (builderQuit)
+            return;
+
+        // The audio thread leaves unbuilt configurations alone, and prepare()
+        // waits for this one
+        const int index = builderJob;
+        lock.unlock();
+        buildConfiguration(index);
+        lock.lock();
+
+        builderJob = -1;
+        builderIdle.notify_all();
     }
 }
 
-void Oversampler::setFilterType(FilterType type)
+template <typename SampleType>
+void BasicOversampler<SampleType>::serviceRequests()
 {
-    if (currentFilterType != type)
+    const std::lock_guard<std::mutex> lock(builderLock);
+    if (builderJob >= 0 || builderQuit)
+        return;
+
+    // Only the latest request matters, earlier ones were switched away from
+    const int index = buildRequest.exchange(-1, std::memory_order_acquire);
+    if (index < 0 || configurations[static_cast<size_t>(index)].built.load(std::memory_order_acquire))
+        return;
+
+    if (!builder.joinable())
+        builder = std::thread([this] { runBuilder(); });
+
+    builderJob = index;
+    builderWakeup.notify_one();
+}
+
+template <typename SampleType>
+int BasicOversampler<SampleType>::getNumBuiltConfigurations() const
+{
+    int count = 0;
+    for (size_t i = 1; i < configurations.size(); ++i)
+        if (configurations[i].built.load(std::memory_order_acquire))
+            ++count;
+    return count;
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::reset()
+{
+    configurations[static_cast<size_t>(activeConfig)].reset();
+    releaseOutgoing();
+}
+
+template <typename SampleType>
+typename BasicOversampler<SampleType>::Switch BasicOversampler<SampleType>::switchConfiguration()
+{
+    const int next = configurationIndex(currentFactorIndex, currentFilterType, currentBackend, currentQuality);
+    if (!isPrepared)
+        return Switch::None;
+
+    if (next == activeConfig)
+    {
+        pendingConfig = -1;
+        return Switch::None;
+    }
+
+    // Back to the configuration being faded out: it is still running, so the
+    // slots trade places and both keep their state
+    if (next == outgoingConfig)
     {
-        currentFilterType = type;
-        if (isPrepared)
-            rebuildOversampler();
+        pendingConfig = -1;
+        std::swap(activeConfig, outgoingConfig);
+        return Switch::Reversed;
     }
+
+    auto& config = configurations[static_cast<size_t>(next)];
+    if (!config.built.load(std::memory_order_acquire))
+    {
+        if (buildsDeferred)
+        {
+            pendingConfig = next;
+            buildRequest.store(next, std::memory_order_release);
+            return Switch::None;
+        }
+
+        // A deferred build of the same configuration may be under way
+        std::unique_lock<std::mutex> lock(builderLock);
+        builderIdle.wait(lock, [this, next] { return builderJob != next; });
+        buildConfiguration(next);
+    }
+
+    pendingConfig = -1;
+    if (config.compensated)
+        updateCompensation(config, currentFactorIndex);
+
+    // The previous configuration keeps running until the engine's crossfade is
+    // done. The incoming one may hold state from an earlier run - start it clean
+    outgoingConfig = activeConfig;
+    config.reset();
+    activeConfig = next;
+    return Switch::Started;
 }
 
-int Oversampler::getOversamplingFactor() const
+template <typename SampleType>
+typename BasicOversampler<SampleType>::Switch BasicOversampler<SampleType>::applyPendingConfiguration()
 {
-    if (currentFactorIndex == 0)
-        return 1;
-    return 1 << currentFactorIndex;  // 2^factorIndex
+    if (pendingConfig < 0)
+        return Switch::None;
+
+    if (buildsDeferred && !configurations[static_cast<size_t>(pendingConfig)].built.load(std::memory_order_acquire))
+        return Switch::None;
+
+    return switchConfiguration();
 }
 
-int Oversampler::getLatencyInSamples() const
+template <typename SampleType>
+typename BasicOversampler<SampleType>::Switch BasicOversampler<SampleType>::setConfiguration(
+    int factorIndex, FilterType type, Backend backend, FilterQuality quality)
 {
-    if (currentFactorIndex == 0 || !oversampler)
-        return 0;
+    currentFactorIndex = std::clamp(factorIndex, 0, NumFactors - 1);
+    currentFilterType = type;
+    currentBackend = backend;
+    currentQuality = quality;
+    return switchConfiguration();
+}
 
-    return static_cast<int>(std::round(oversampler->getLatencyInSamples()));
+template <typename SampleType>
+bool BasicOversampler<SampleType>::setOversamplingFactor(int factorIndex)
+{
+    return setConfiguration(factorIndex, currentFilterType, currentBackend, currentQuality) != Switch::None;
 }
 
-float* const* Oversampler::processSamplesUp(juce::AudioBuffer<float>& inputBuffer, int& numOversampledSamples)
+template <typename SampleType>
+bool BasicOversampler<SampleType>::setFilterType(FilterType type)
 {
-    if (currentFactorIndex == 0 || !oversampler || !isPrepared)
+    return setConfiguration(currentFactorIndex, type, currentBackend, currentQuality) != Switch::None;
+}
+
+template <typename SampleType>
+bool BasicOversampler<SampleType>::setBackend(Backend backend)
+{
+    return setConfiguration(currentFactorIndex, currentFilterType, backend, currentQuality) != Switch::None;
+}
+
+template <typename SampleType>
+bool BasicOversampler<SampleType>::setFilterQuality(FilterQuality quality)
+{
+    return setConfiguration(currentFactorIndex, currentFilterType, currentBackend, quality) != Switch::None;
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::setClipDelay(double clipRateSamples)
+{
+    clipDelay = clipRateSamples;
+
+    if (!isPrepared)
+        return;
+
+    // Unbuilt ones (maybe being built) get it when switched to
+    for (int factor = 1; factor < NumFactors; ++factor)
     {
-        numOversampledSamples = inputBuffer.getNumSamples();
-        return nullptr;  // Signal to use original buffer
+        auto& config = configurations[static_cast<size_t>(configurationIndex(factor, FilterType::LowLatency, Backend::Juce))];
+        if (config.built.load(std::memory_order_acquire))
+            updateCompensation(config, factor);
     }
+}
+
+template <typename SampleType>
+bool BasicOversampler<SampleType>::compensatesClipDelay(Slot slot) const
+{
+    const auto* config = getConfiguration(slot);
+    return config != nullptr && config->compensated;
+}
 
-    // Create AudioBlock from input buffer
-    juce::dsp::AudioBlock<float> inputBlock(inputBuffer);
+template <typename SampleType>
+const typename BasicOversampler<SampleType>::Configuration* BasicOversampler<SampleType>::getConfiguration(Slot slot) const
+{
+    const int index = (slot == Slot::Active) ? activeConfig : outgoingConfig;
+    if (!isPrepared || index <= 0)
+        return nullptr;  // Not prepared, no outgoing, or 1x
 
-    // Upsample - returns AudioBlock pointing to internal storage
-    oversampledBlock = oversampler->processSamplesUp(inputBlock);
+    return &configurations[static_cast<size_t>(index)];
+}
+
+template <typename SampleType>
+typename BasicOversampler<SampleType>::Configuration* BasicOversampler<SampleType>::getConfiguration(Slot slot)
+{
+    return const_cast<Configuration*>(std::as_const(*this).getConfiguration(slot));
+}
+
+template <typename SampleType>
+int BasicOversampler<SampleType>::getOversamplingFactor() const
+{
+    return 1 << (activeConfig % NumFactors);  // 2^factorIndex, see configurationIndex()
+}
+
+template <typename SampleType>
+int BasicOversampler<SampleType>::getLatencyInSamples(Slot slot) const
+{
+    const auto* config = getConfiguration(slot);
+    return config != nullptr ? static_cast<int>(std::round(config->latency)) : 0;
+}
+
+template <typename SampleType>
+double BasicOversampler<SampleType>::getExactLatency(Slot slot) const
+{
+    const auto* config = getConfiguration(slot);
+    return config != nullptr ? config->latency : 0.0;
+}
+
+template <typename SampleType>
+SampleType* const* BasicOversampler<SampleType>::processPartitionUp(Configuration& config, int partition,
+                                                                   juce::AudioBuffer<SampleType>& inputBuffer,
+                                                                   int& numOversampledSamples)
+{
+    auto& filters = config.partitions[static_cast<size_t>(partition)];
+    const int firstChannel = partitionStarts[static_cast<size_t>(partition)];
+    const int partitionChannels = getPartitionSize(partition);
+    const int numSamples = inputBuffer.getNumSamples();
+
+    if (!filters.polyphaseUp.empty())
+    {
+        // Base rate -> stage 0 -> stage 1 ...
+        const SampleType* const* stageInput = inputBuffer.getArrayOfReadPointers() + firstChannel;
+        int stageSamples = numSamples;
+
+        for (size_t n = 0; n < filters.polyphaseUp.size(); ++n)
+        {
+            SampleType* const* stageOutput = config.stageBuffers[n].getArrayOfWritePointers() + firstChannel;
+            filters.polyphaseUp[n].processUp(stageInput, stageOutput, stageSamples);
+            stageInput = stageOutput;
+            stageSamples *= 2;
+        }
+
+        numOversampledSamples = stageSamples;
+        return config.stageBuffers.back().getArrayOfWritePointers();
+    }
 
+    // Block over this partition's channels of the input
+    juce::dsp::AudioBlock<SampleType> inputBlock(inputBuffer.getArrayOfWritePointers() + firstChannel,
+                                                 static_cast<size_t>(partitionChannels),
+                                                 static_cast<size_t>(numSamples));
+
+    // Upsample - returns AudioBlock pointing to internal storage
+    auto oversampledBlock = filters.juceStages->processSamplesUp(inputBlock);
     numOversampledSamples = static_cast<int>(oversampledBlock.getNumSamples());
 
     // Build array of channel pointers for compatibility with existing API
-    channelPtrs.resize(static_cast<size_t>(numChannels_));
-    for (int ch = 0; ch < numChannels_; ++ch)
-        channelPtrs[static_cast<size_t>(ch)] = oversampledBlock.getChannelPointer(static_cast<size_t>(ch));
+    for (int ch = 0; ch < partitionChannels; ++ch)
+        channelPtrs[static_cast<size_t>(firstChannel + ch)] = oversampledBlock.getChannelPointer(static_cast<size_t>(ch));
 
     return channelPtrs.data();
 }
 
-void Oversampler::processSamplesDown(juce::AudioBuffer<float>& outputBuffer, int numOriginalSamples)
+template <typename SampleType>
+SampleType* const* BasicOversampler<SampleType>::processSamplesUp(juce::AudioBuffer<SampleType>& inputBuffer,
+                                                                 int& numOversampledSamples, Slot slot, int partition)
 {
-    if (currentFactorIndex == 0 || !oversampler || !isPrepared)
+    RealtimeScope realtime;
+    auto* config = getConfiguration(slot);
+
+    if (config == nullptr)
+    {
+        numOversampledSamples = inputBuffer.getNumSamples();
+        return nullptr;  // Signal to use original buffer
+    }
+
+    jassert(inputBuffer.getNumSamples() <= maxBlockSize_);
+    jassert(inputBuffer.getNumChannels() >= numChannels_);
+
+    if (partition != AllPartitions)
+        return processPartitionUp(*config, partition, inputBuffer, numOversampledSamples);
+
+    SampleType* const* result = nullptr;
+    for (int p = 0; p < getNumPartitions(); ++p)
+        result = processPartitionUp(*config, p, inputBuffer, numOversampledSamples);
+    return result;
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::processPartitionDown(Configuration& config, int partition,
+                                                        juce::AudioBuffer<SampleType>& outputBuffer,
+                                                        int numOriginalSamples)
+{
+    auto& filters = config.partitions[static_cast<size_t>(partition)];
+    const int firstChannel = partitionStarts[static_cast<size_t>(partition)];
+    const int partitionChannels = getPartitionSize(partition);
+
+    if (!filters.polyphaseDown.empty())
+    {
+        // Top stage -> ... -> stage 0 -> base rate, each stage writes into the
+        // buffer below it (its up-path contents are no longer needed)
+        for (size_t n = filters.polyphaseDown.size(); n-- > 0;)
+        {
+            const int outputSamples = numOriginalSamples << n;
+            SampleType* const* stageOutput = (n == 0) ? outputBuffer.getArrayOfWritePointers()
+                                                      : config.stageBuffers[n - 1].getArrayOfWritePointers();
+            filters.polyphaseDown[n].processDown(config.stageBuffers[n].getArrayOfReadPointers() + firstChannel,
+                                                 stageOutput + firstChannel, outputSamples);
+        }
+
+        if (config.compensated)
+            applyCompensation(config, partition, outputBuffer, numOriginalSamples);
         return;
+    }
 
-    // Create AudioBlock from output buffer (only the portion we need)
-    juce::dsp::AudioBlock<float> outputBlock(outputBuffer);
-    auto subBlock = outputBlock.getSubBlock(0, static_cast<size_t>(numOriginalSamples));
+    // Block over this partition's channels (only the portion we need)
+    juce::dsp::AudioBlock<SampleType> outputBlock(outputBuffer.getArrayOfWritePointers() + firstChannel,
+                                                  static_cast<size_t>(partitionChannels),
+                                                  static_cast<size_t>(numOriginalSamples));
 
     // Downsample from internal storage back to output buffer
-    oversampler->processSamplesDown(subBlock);
+    filters.juceStages->processSamplesDown(outputBlock);
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::processSamplesDown(juce::AudioBuffer<SampleType>& outputBuffer,
+                                                      int numOriginalSamples, Slot slot, int partition)
+{
+    RealtimeScope realtime;
+    auto* config = getConfiguration(slot);
+
+    if (config == nullptr)
+        return;
+
+    if (partition != AllPartitions)
+    {
+        processPartitionDown(*config, partition, outputBuffer, numOriginalSamples);
+        return;
+    }
+
+    for (int p = 0; p < getNumPartitions(); ++p)
+        processPartitionDown(*config, p, outputBuffer, numOriginalSamples);
 }
 
+template class BasicOversampler<float>;
+template class BasicOversampler<double>;
+
 } // namespace dsp
@@ -1,60 +1,229 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
-namespace dsp {
+#include "PolyphaseHalfband.h"
 
-// NOTE: Currently using JUCE's built-in oversampling. Consider investigating
-// alternative filter implementations (e.g., direct HIIR integration) for
-// potentially better performance in the future.
+namespace dsp {
 
-class Oversampler
+// Two backends:
+// - Juce: juce::dsp::Oversampling (FIR equiripple or polyphase IIR)
+// - PolyphaseAllpass: native HIIR-style cascade (PolyphaseHalfband), minimum
+//   phase only. Later stages get progressively wider transition bands since
+//   only the base-rate band needs protecting, so high factors stay cheap.
+//   Linear phase always uses the JUCE FIR stages.
+//
+// FilterType::LowLatency runs the polyphase cascade at the smallest stage
+// order (two allpass coefficients per direction) whatever the backend, trading
+// stopband rejection for group delay. A first-order Thiran allpass at the base
+// rate pads the filters' fractional DC group delay (plus the clip stage's, see
+// setClipDelay) up to whole samples, so its reported latency is exact.
+//
+// FilterQuality::Efficient gives the JUCE stages past 2x wider transitions and
+// less attenuation (see the design tables in Oversampler.cpp): they only need
+// to reject images far above the audio band. The first stage, and so the
+// passband, is the same at both qualities.
+//
+// A factor/filter/backend/quality configuration is built the first time it is
+// switched to, and kept until the next prepare(), which builds only the active
+// one. By default the setter builds it then and there (allocating). With
+// builds deferred (live playback) the setter only requests it: serviceRequests()
+// hands it to a background thread, and the switch happens at the first
+// applyPendingConfiguration() after it is published. Until then the active
+// configuration carries on. The previous configuration stays runnable
+// (Slot::Outgoing) until releaseOutgoing(), which lets ClipperEngine crossfade
+// between the two. Switching back to the outgoing configuration swaps the
+// slots, so neither loses its filter state.
+//
+// Channels can be split into partitions (contiguous channel ranges with
+// filters of their own) that process independently, so ClipperEngine can run
+// them on separate threads. Output is the same however the channels are split.
+//
+// SampleType is float or double; the double path runs the same filter designs.
+
+template <typename SampleType>
+class BasicOversampler
 {
 public:
-    enum class FilterType { MinimumPhase, LinearPhase };
+    enum class FilterType { MinimumPhase, LinearPhase, LowLatency };
+    enum class Backend { Juce, PolyphaseAllpass };
+    enum class FilterQuality { High, Efficient };
+    enum class Slot { Active, Outgoing };
+
+    // What a configuration change did: nothing, a switch to a configuration
+    // starting from clean state, or a swap back to the outgoing one
+    enum class Switch { None, Started, Reversed };
 
     // UI indices: 0=1x, 1=2x, 2=4x, 3=8x, 4=16x, 5=32x
     static constexpr int NumFactors = 6;
 
-    Oversampler();
-    ~Oversampler() = default;
+    BasicOversampler();
+    ~BasicOversampler();
 
-    void prepare(double sampleRate, int maxBlockSize, int numChannels);
-    void reset();
+    static constexpr int AllPartitions = -1;
 
-    void setOversamplingFactor(int factorIndex);  // 0=1x, 1=2x, ... 5=32x
-    void setFilterType(FilterType type);
+    void prepare(double sampleRate, int maxBlockSize, int numChannels, int numPartitions = 1);
+    void reset();
 
+    // Applies every setting at once, switching configuration at most once.
+    // Change several settings together through here, not through the setters
+    // below - each of those switches on its own
+    Switch setConfiguration(int factorIndex, FilterType type, Backend backend, FilterQuality quality);
+
+    // Return true when the active configuration changed (the old one is now outgoing)
+    bool setOversamplingFactor(int factorIndex);  // 0=1x, 1=2x, ... 5=32x
+    bool setFilterType(FilterType type);
+    bool setBackend(Backend backend);
+    bool setFilterQuality(FilterQuality quality);
+
+    // Deferred builds never allocate in the setters, see the top of the file.
+    // applyPendingConfiguration() belongs on the audio thread with the setters,
+    // serviceRequests() on any other thread, as often as a switch may wait
+    void setBuildsDeferred(bool deferred) { buildsDeferred = deferred; }
+    Switch applyPendingConfiguration();
+    void serviceRequests();
+    bool hasPendingConfiguration() const { return pendingConfig >= 0; }
+    int getNumBuiltConfigurations() const;
+
+    // Delay the clip stage adds at the oversampled rate (ADAA). Low-latency
+    // configurations compensate it along with their own, and include it in
+    // their latency; the others leave it to the caller. Never allocates
+    void setClipDelay(double clipRateSamples);
+    bool compensatesClipDelay(Slot slot = Slot::Active) const;
+
+    bool hasOutgoing() const { return outgoingConfig >= 0; }
+    bool isOversampling(Slot slot = Slot::Active) const { return getConfiguration(slot) != nullptr; }
+    void releaseOutgoing() { outgoingConfig = -1; }
+
+    // Factor and latency are the active configuration's, the getCurrent*()
+    // settings the requested one's
     int getOversamplingFactor() const;
-    int getLatencyInSamples() const;
+    int getLatencyInSamples(Slot slot = Slot::Active) const;
+    double getExactLatency(Slot slot = Slot::Active) const;  // Unrounded DC group delay
     int getCurrentFactorIndex() const { return currentFactorIndex; }
     FilterType getCurrentFilterType() const { return currentFilterType; }
+    Backend getCurrentBackend() const { return currentBackend; }
+    FilterQuality getCurrentFilterQuality() const { return currentQuality; }
+    int getNumPartitions() const { return static_cast<int>(partitionStarts.size()) - 1; }
 
     // Process up: returns pointer to oversampled data and sets numOversampledSamples
-    // Returns nullptr if 1x (no oversampling)
-    float* const* processSamplesUp(juce::AudioBuffer<float>& inputBuffer, int& numOversampledSamples);
+    // Returns nullptr if 1x (no oversampling). With a partition index only that
+    // partition's channels are processed; different partitions may run
+    // concurrently, and the returned pointers cover every channel
+    SampleType* const* processSamplesUp(juce::AudioBuffer<SampleType>& inputBuffer, int& numOversampledSamples,
+                                        Slot slot = Slot::Active, int partition = AllPartitions);
 
     // Process down: downsamples back to original rate
-    void processSamplesDown(juce::AudioBuffer<float>& outputBuffer, int numOriginalSamples);
+    void processSamplesDown(juce::AudioBuffer<SampleType>& outputBuffer, int numOriginalSamples,
+                            Slot slot = Slot::Active, int partition = AllPartitions);
 
 private:
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
-
+    // Filters for one channel partition
+    struct Partition
+    {
+        std::unique_ptr<juce::dsp::Oversampling<SampleType>> juceStages;
+
+        // Polyphase allpass backend: one up and one down halfband per 2x stage
+        std::vector<BasicPolyphaseHalfband<SampleType>> polyphaseUp;
+        std::vector<BasicPolyphaseHalfband<SampleType>> polyphaseDown;
+
+        // Low latency: Thiran allpass state, input and output per channel
+        std::vector<SampleType> compensationStates;
+    };
+
+    struct Configuration
+    {
+        // Set once the filters exist, by whichever thread built them
+        std::atomic<bool> built { false };
+
+        std::vector<Partition> partitions;
+
+        // Polyphase backend: stageBuffers[n] holds every channel at 2^(n+1)
+        // times the base rate, each partition writing its own channels
+        std::vector<juce::AudioBuffer<SampleType>> stageBuffers;
+
+        double latency = 0.0;
+
+        // Low latency only: DC group delay of the filters alone (base rate),
+        // the Thiran coefficient padding it and the clip delay up to latency
+        double filterLatency = 0.0;
+        SampleType compensationCoefficient = 0;
+        bool compensated = false;
+
+        void reset();
+        void release();
+    };
+
+    // Variants: JUCE IIR, JUCE FIR, polyphase allpass, low latency, then the
+    // efficient JUCE IIR and FIR. Index 0 is 1x for all of them (an empty
+    // configuration), see configurationIndex()
+    static constexpr int NumVariants = 6;
+    std::array<Configuration, NumFactors * NumVariants> configurations;
+    int activeConfig = 0;
+    int outgoingConfig = -1;
+
+    // Requested settings - the active configuration may still be waiting for
+    // them (pendingConfig)
     int currentFactorIndex = 0;  // 0=1x (bypass), 1=2x, etc.
     FilterType currentFilterType = FilterType::MinimumPhase;
+    Backend currentBackend = Backend::Juce;
+    FilterQuality currentQuality = FilterQuality::High;
     int numChannels_ = 2;
     int maxBlockSize_ = 512;
+    double clipDelay = 0.0;
     bool isPrepared = false;
-
-    // Per-instance buffer for channel pointers
-    std::vector<float*> channelPtrs;
-
-    // Store the AudioBlock returned by processSamplesUp for later use
-    juce::dsp::AudioBlock<float> oversampledBlock;
-
-    void rebuildOversampler();
+    bool buildsDeferred = false;
+    int pendingConfig = -1;
+
+    // Deferred builds: the audio thread posts buildRequest, serviceRequests()
+    // moves it to builderJob and wakes the builder. prepare() waits for the
+    // builder to finish before touching the configurations
+    std::atomic<int> buildRequest { -1 };
+    std::mutex builderLock;
+    std::condition_variable builderWakeup;
+    std::condition_variable builderIdle;
+    int builderJob = -1;
+    bool builderQuit = false;
+    std::thread builder;
+
+    // Channel ranges: partition p is [partitionStarts[p], partitionStarts[p + 1])
+    std::vector<int> partitionStarts { 0, 2 };
+
+    // Per-instance buffer for channel pointers, sized in prepare(). JUCE
+    // stages fill in the oversampled channels, each partition its own range
+    std::vector<SampleType*> channelPtrs;
+
+    int getPartitionSize(int partition) const
+    {
+        return partitionStarts[static_cast<size_t>(partition + 1)] - partitionStarts[static_cast<size_t>(partition)];
+    }
+
+    static int configurationIndex(int factorIndex, FilterType type, Backend backend,
+                                  FilterQuality quality = FilterQuality::High);
+    const Configuration* getConfiguration(Slot slot) const;
+    Configuration* getConfiguration(Slot slot);
+    Switch switchConfiguration();
+    void buildConfiguration(int index);
+    void runBuilder();
+    void buildJuceStages(Configuration& config, int numStages, FilterType type, FilterQuality quality);
+    void buildPolyphaseStages(Configuration& config, int numStages, FilterType type);
+    void updateCompensation(Configuration& config, int numStages);
+    void applyCompensation(Configuration& config, int partition, juce::AudioBuffer<SampleType>& outputBuffer,
+                           int numSamples);
+
+    SampleType* const* processPartitionUp(Configuration& config, int partition,
+                                          juce::AudioBuffer<SampleType>& inputBuffer, int& numOversampledSamples);
+    void processPartitionDown(Configuration& config, int partition, juce::AudioBuffer<SampleType>& outputBuffer,
+                              int numOriginalSamples);
 };
 
+using Oversampler = BasicOversampler<float>;
+
 } // namespace dsp
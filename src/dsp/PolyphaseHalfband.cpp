@@ -0,0 +1,313 @@
+#include "PolyphaseHalfband.h"
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+
+namespace {
+
+// =============================================================================
+// Coefficient design (elliptic halfband via Jacobi theta series)
+// =============================================================================
+
+void computeTransitionParams(double transitionBandwidth, double& k, double& q)
+{
+    k = std::tan((1.0 - transitionBandwidth * 2.0) * juce::MathConstants<double>::pi / 4.0);
+    k *= k;
+
+    const double kksqrt = std::pow(1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const double e2 = e * e;
+    const double e4 = e2 * e2;
+    q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+}
+
+int computeOrder(double attenuationDb, double q)
+{
+    const double attenuationPow2 = std::pow(10.0, -attenuationDb / 10.0);
+    const double a = attenuationPow2 / (1.0 - attenuationPow2);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+
+    if ((order & 1) == 0)
+        ++order;
+    return std::max(order, 3);
+}
+
+double computeNumeratorSum(double q, int order, int c)
+{
+    double sum = 0.0;
+    double term = 0.0;
+    double sign = 1.0;
+    int i = 0;
+
+    do
+    {
+        term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * juce::MathConstants<double>::pi / order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1e-100);
+
+    return sum;
+}
+
+double computeDenominatorSum(double q, int order, int c)
+{
+    double sum = 0.0;
+    double term = 0.0;
+    double sign = -1.0;
+    int i = 1;
+
+    do
+    {
+        term = std::pow(q, i * i) * std::cos(i * 2 * c * juce::MathConstants<double>::pi / order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1e-100);
+
+    return sum;
+}
+
+double computeCoefficient(int index, double k, double q, int order)
+{
+    const int c = index + 1;
+    const double num = computeNumeratorSum(q, order, c) * std::pow(q, 0.25);
+    const double den = computeDenominatorSum(q, order, c) + 0.5;
+    const double ww = num / den;
+    const double wwsq = ww * ww;
+
+    const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+    return (1.0 - x) / (1.0 + x);
+}
+
+// One first-order allpass section per lane, H(z) = (a + z^-1) / (1 + a z^-1)
+template <typename Vec>
+inline Vec allpass(Vec input, Vec coefficient, Vec& inputState, Vec& outputState)
+{
+    const auto result = (input - outputState) * coefficient + inputState;
+    inputState = input;
+    outputState = result;
+    return result;
+}
+
+} // namespace
+
+template <typename SampleType>
+std::vector<double> BasicPolyphaseHalfband<SampleType>::designCoefficients(double attenuationDb, double transitionBandwidth)
+{
+    jassert(attenuationDb > 0.0);
+    jassert(transitionBandwidth > 0.0 && transitionBandwidth < 0.5);
+
+    double k = 0.0, q = 0.0;
+    computeTransitionParams(transitionBandwidth, k, q);
+
+    // Design order (odd) -> number of allpass coefficients, rounded up to even
+    const int order = computeOrder(attenuationDb, q);
+    int numCoefficients = (order - 1) / 2;
+    numCoefficients = std::min(maxCoefficients, numCoefficients + (numCoefficients & 1));
+
+    // Recompute for the final order so the rounded-up design uses all its sections
+    const int finalOrder = numCoefficients * 2 + 1;
+    std::vector<double> coefficients(static_cast<size_t>(numCoefficients));
+    for (int i = 0; i < numCoefficients; ++i)
+        coefficients[static_cast<size_t>(i)] = computeCoefficient(i, k, q, finalOrder);
+
+    return coefficients;
+}
+
+template <typename SampleType>
+void BasicPolyphaseHalfband<SampleType>::prepare(const std::vector<double>& coefficients, int channels)
+{
+    jassert(!coefficients.empty() && (coefficients.size() % 2) == 0);
+    jassert(coefficients.size() <= static_cast<size_t>(maxCoefficients));
+
+    numChannels = channels;
+    numRegisters = (channels + channelsPerRegister - 1) / channelsPerRegister;
+    numSections = static_cast<int>(coefficients.size()) / 2;
+
+    // Even coefficients feed path 0, odd coefficients path 1
+    coefficientRegs.assign(static_cast<size_t>(numSections), Vec::expand(SampleType(0)));
+    groupDelay = 0.0;
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        alignas(sizeof(Vec)) SampleType lanes[lanesPerRegister];
+        for (int lane = 0; lane < lanesPerRegister; ++lane)
+            lanes[lane] = static_cast<SampleType>(coefficients[static_cast<size_t>(2 * s + (lane & 1))]);
+        coefficientRegs[static_cast<size_t>(s)] = Vec::fromRawArray(lanes);
+
+        // Allpass DC group delay is (1 - a) / (1 + a); paths are averaged
+        for (int path = 0; path < 2; ++path)
+        {
+            const double a = coefficients[static_cast<size_t>(2 * s + path)];
+            groupDelay += 0.5 * (1.0 - a) / (1.0 + a);
+        }
+    }
+
+    inputStates.assign(static_cast<size_t>(numRegisters * maxSectionsPerPath), Vec::expand(SampleType(0)));
+    outputStates.assign(static_cast<size_t>(numRegisters * maxSectionsPerPath), Vec::expand(SampleType(0)));
+}
+
+template <typename SampleType>
+void BasicPolyphaseHalfband<SampleType>::reset()
+{
+    std::fill(inputStates.begin(), inputStates.end(), Vec::expand(SampleType(0)));
+    std::fill(outputStates.begin(), outputStates.end(), Vec::expand(SampleType(0)));
+}
+
+// =============================================================================
+// Processing
+// States are pulled into locals for the block so the fixed-length section loop
+// unrolls and stays in registers.
+// =============================================================================
+
+template <typename SampleType>
+template <int NumSections>
+void BasicPolyphaseHalfband<SampleType>::processUpImpl(const SampleType* const* input, SampleType* const* output,
+                                                       int numInputSamples)
+{
+    // Unused lanes (odd channel counts) stay at zero
+    alignas(sizeof(Vec)) SampleType inLanes[lanesPerRegister] = {};
+    alignas(sizeof(Vec)) SampleType outLanes[lanesPerRegister];
+
+    Vec coefs[NumSections];
+    for (int s = 0; s < NumSections; ++s)
+        coefs[s] = coefficientRegs[static_cast<size_t>(s)];
+
+    for (int reg = 0; reg < numRegisters; ++reg)
+    {
+        const int firstChannel = reg * channelsPerRegister;
+        const int channelsInReg = std::min(channelsPerRegister, numChannels - firstChannel);
+        Vec* xState = inputStates.data() + reg * maxSectionsPerPath;
+        Vec* yState = outputStates.data() + reg * maxSectionsPerPath;
+
+        Vec x[NumSections], y[NumSections];
+        for (int s = 0; s < NumSections; ++s)
+        {
+            x[s] = xState[s];
+            y[s] = yState[s];
+        }
+
+        for (int i = 0; i < numInputSamples; ++i)
+        {
+            // Both paths of a channel see the same input sample
+            for (int c = 0; c < channelsInReg; ++c)
+                inLanes[2 * c] = inLanes[2 * c + 1] = input[firstChannel + c][i];
+
+            Vec v = Vec::fromRawArray(inLanes);
+            for (int s = 0; s < NumSections; ++s)
+                v = allpass(v, coefs[s], x[s], y[s]);
+            v.copyToRawArray(outLanes);
+
+            // Path 0 -> even output sample, path 1 -> odd
+            for (int c = 0; c < channelsInReg; ++c)
+            {
+                SampleType* out = output[firstChannel + c] + 2 * i;
+                out[0] = outLanes[2 * c];
+                out[1] = outLanes[2 * c + 1];
+            }
+        }
+
+        for (int s = 0; s < NumSections; ++s)
+        {
+            xState[s] = x[s];
+            yState[s] = y[s];
+        }
+    }
+}
+
+template <typename SampleType>
+template <int NumSections>
+void BasicPolyphaseHalfband<SampleType>::processDownImpl(const SampleType* const* input, SampleType* const* output,
+                                                         int numOutputSamples)
+{
+    // Unused lanes (odd channel counts) stay at zero
+    alignas(sizeof(Vec)) SampleType inLanes[lanesPerRegister] = {};
+    alignas(sizeof(Vec)) SampleType outLanes[lanesPerRegister];
+
+    Vec coefs[NumSections];
+    for (int s = 0; s < NumSections; ++s)
+        coefs[s] = coefficientRegs[static_cast<size_t>(s)];
+
+    for (int reg = 0; reg < numRegisters; ++reg)
+    {
+        const int firstChannel = reg * channelsPerRegister;
+        const int channelsInReg = std::min(channelsPerRegister, numChannels - firstChannel);
+        Vec* xState = inputStates.data() + reg * maxSectionsPerPath;
+        Vec* yState = outputStates.data() + reg * maxSectionsPerPath;
+
+        Vec x[NumSections], y[NumSections];
+        for (int s = 0; s < NumSections; ++s)
+        {
+            x[s] = xState[s];
+            y[s] = yState[s];
+        }
+
+        for (int i = 0; i < numOutputSamples; ++i)
+        {
+            // Odd input sample -> path 0, even -> path 1
+            for (int c = 0; c < channelsInReg; ++c)
+            {
+                const SampleType* in = input[firstChannel + c] + 2 * i;
+                inLanes[2 * c] = in[1];
+                inLanes[2 * c + 1] = in[0];
+            }
+
+            Vec v = Vec::fromRawArray(inLanes);
+            for (int s = 0; s < NumSections; ++s)
+                v = allpass(v, coefs[s], x[s], y[s]);
+            v.copyToRawArray(outLanes);
+
+            for (int c = 0; c < channelsInReg; ++c)
+                output[firstChannel + c][i] = SampleType(0.5) * (outLanes[2 * c] + outLanes[2 * c + 1]);
+        }
+
+        for (int s = 0; s < NumSections; ++s)
+        {
+            xState[s] = x[s];
+            yState[s] = y[s];
+        }
+    }
+}
+
+template <typename SampleType>
+void BasicPolyphaseHalfband<SampleType>::processUp(const SampleType* const* input, SampleType* const* output,
+                                                   int numInputSamples)
+{
+    switch (numSections)
+    {
+        case 1: processUpImpl<1>(input, output, numInputSamples); break;
+        case 2: processUpImpl<2>(input, output, numInputSamples); break;
+        case 3: processUpImpl<3>(input, output, numInputSamples); break;
+        case 4: processUpImpl<4>(input, output, numInputSamples); break;
+        case 5: processUpImpl<5>(input, output, numInputSamples); break;
+        case 6: processUpImpl<6>(input, output, numInputSamples); break;
+        case 7: processUpImpl<7>(input, output, numInputSamples); break;
+        case 8: processUpImpl<8>(input, output, numInputSamples); break;
+        default: jassertfalse; break;
+    }
+}
+
+template <typename SampleType>
+void BasicPolyphaseHalfband<SampleType>::processDown(const SampleType* const* input, SampleType* const* output,
+                                                     int numOutputSamples)
+{
+    switch (numSections)
+    {
+        case 1: processDownImpl<1>(input, output, numOutputSamples); break;
+        case 2: processDownImpl<2>(input, output, numOutputSamples); break;
+        case 3: processDownImpl<3>(input, output, numOutputSamples); break;
+        case 4: processDownImpl<4>(input, output, numOutputSamples); break;
+        case 5: processDownImpl<5>(input, output, numOutputSamples); break;
+        case 6: processDownImpl<6>(input, output, numOutputSamples); break;
+        case 7: processDownImpl<7>(input, output, numOutputSamples); break;
+        case 8: processDownImpl<8>(input, output, numOutputSamples); break;
+        default: jassertfalse; break;
+    }
+}
+
+template class BasicPolyphaseHalfband<float>;
+template class BasicPolyphaseHalfband<double>;
+
+} // namespace dsp
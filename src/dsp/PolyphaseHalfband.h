@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+namespace dsp {
+
+// 2x halfband resampler built from two parallel chains of first-order allpass
+// sections (polyphase IIR, as in Laurent de Soras' HIIR). Each chain runs at the
+// lower rate, so a stage costs one multiply per coefficient per low-rate sample.
+//
+// Vectorized across channels and polyphase paths: every SIMD register holds
+// [ch0 path0, ch0 path1, ch1 path0, ch1 path1, ...], so a stereo stage fills a
+// whole SSE/NEON register (float; a double register holds one channel).
+//
+// Each instance keeps one set of filter states - use separate instances for the
+// up and down directions.
+template <typename SampleType>
+class BasicPolyphaseHalfband
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int lanesPerRegister = static_cast<int>(Vec::SIMDNumElements);
+    static constexpr int channelsPerRegister = lanesPerRegister / 2;
+    static constexpr int maxCoefficients = 16;
+    static constexpr int maxSectionsPerPath = maxCoefficients / 2;
+
+    // Elliptic halfband design. attenuationDb is the stopband rejection (positive),
+    // transitionBandwidth is normalized to the high rate (0 < tbw < 0.5), exactly
+    // like juce::dsp::FilterDesign's polyphase allpass method.
+    // Always returns an even number of coefficients so both paths are equally long.
+    static std::vector<double> designCoefficients(double attenuationDb, double transitionBandwidth);
+
+    void prepare(const std::vector<double>& coefficients, int numChannels);
+    void reset();
+
+    // numInputSamples in, 2 * numInputSamples out per channel
+    void processUp(const SampleType* const* input, SampleType* const* output, int numInputSamples);
+
+    // 2 * numOutputSamples in, numOutputSamples out per channel (in-place safe)
+    void processDown(const SampleType* const* input, SampleType* const* output, int numOutputSamples);
+
+    // Group delay at DC in samples at the lower rate. The half-sample polyphase
+    // offset of each direction is left out - it cancels across an up/down pair.
+    double getGroupDelay() const { return groupDelay; }
+
+    int getNumCoefficients() const { return 2 * numSections; }
+
+private:
+    template <int NumSections>
+    void processUpImpl(const SampleType* const* input, SampleType* const* output, int numInputSamples);
+
+    template <int NumSections>
+    void processDownImpl(const SampleType* const* input, SampleType* const* output, int numOutputSamples);
+
+    int numChannels = 0;
+    int numRegisters = 0;
+    int numSections = 0;
+    double groupDelay = 0.0;
+
+    // [register * maxSectionsPerPath + section]
+    std::vector<Vec> coefficientRegs;
+    std::vector<Vec> inputStates;
+    std::vector<Vec> outputStates;
+};
+
+using PolyphaseHalfband = BasicPolyphaseHalfband<float>;
+
+} // namespace dsp
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace dsp {
+
+// Marks audio-thread code that must not touch the heap. With
+// GUILLOTINE_TRACK_ALLOCATIONS defined (unit tests), the test harness replaces
+// the global operator new (and malloc on glibc) and fails any allocation made
+// inside a scope.
+// Otherwise it compiles to nothing.
+#if GUILLOTINE_TRACK_ALLOCATIONS
+
+namespace detail {
+inline thread_local int realtimeScopeDepth = 0;
+} // namespace detail
+
+class RealtimeScope
+{
+public:
+    RealtimeScope() noexcept { ++detail::realtimeScopeDepth; }
+    ~RealtimeScope() noexcept { --detail::realtimeScopeDepth; }
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+    static bool isActive() noexcept { return detail::realtimeScopeDepth > 0; }
+};
+
+#else
+
+class RealtimeScope
+{
+public:
+    RealtimeScope() noexcept {}
+    static constexpr bool isActive() noexcept { return false; }
+};
+
+#endif
+
+} // namespace dsp
@@ -2,8 +2,10 @@
 
 // NOTE: This file has a JS mirror at web/lib/saturation-curves.js
 // Keep both files in sync when modifying curve implementations
+// (the ADAA antiderivatives at the bottom are C++ only)
 
 #include <cmath>
+#include <type_traits>
 
 namespace dsp {
 
@@ -24,98 +26,132 @@ namespace curves {
 
 constexpr float PI = 3.14159265358979323846f;
 
+// The curves are templated on the sample type (float or double), so scalar
+// calls in double are exact. The double engine's block kernels are not: Tanh,
+// Arctan and T2 run the float approximations on double registers, ~1e-6 of
+// ceiling off (SaturatorKernels.h). Exponents stay float - they come straight
+// from a parameter.
+
 // Hard clip: just clamp to [-1, 1]
-inline float hard(float x)
+template <typename T>
+inline T hard(T x)
 {
-    if (x > 1.0f) return 1.0f;
-    if (x < -1.0f) return -1.0f;
+    if (x > T(1)) return T(1);
+    if (x < T(-1)) return T(-1);
     return x;
 }
 
 // Tanh: smooth S-curve, naturally limits to [-1, 1]
-inline float tanh(float x)
+template <typename T>
+inline T tanh(T x)
 {
     return std::tanh(x);
 }
 
 // Quintic: x - (256/3125)x^5, very transparent
 // Valid for |x| < 1.25, hard clips beyond
-inline float quintic(float x)
+template <typename T>
+inline T quintic(T x)
 {
-    float absX = std::abs(x);
-    if (absX < 1.25f)
+    T absX = std::abs(x);
+    if (absX < T(1.25))
     {
-        float x2 = x * x;
-        float x5 = x2 * x2 * x;
-        return x - (256.0f / 3125.0f) * x5;
+        T x2 = x * x;
+        T x5 = x2 * x2 * x;
+        return x - T(256.0 / 3125.0) * x5;
     }
-    return (x >= 0.0f) ? 1.0f : -1.0f;
+    return (x >= T(0)) ? T(1) : T(-1);
 }
 
 // Cubic: x - (4/27)x^3, gentle saturation
 // Valid for |x| < 1.5, hard clips beyond
-inline float cubic(float x)
+template <typename T>
+inline T cubic(T x)
 {
-    float absX = std::abs(x);
-    if (absX < 1.5f)
+    T absX = std::abs(x);
+    if (absX < T(1.5))
     {
-        float x3 = x * x * x;
-        return x - (4.0f / 27.0f) * x3;
+        T x3 = x * x * x;
+        return x - T(4.0 / 27.0) * x3;
     }
-    return (x >= 0.0f) ? 1.0f : -1.0f;
+    return (x >= T(0)) ? T(1) : T(-1);
 }
 
 // Arctan: (2/pi)atan(x), softest curve
-inline float arctan(float x)
+template <typename T>
+inline T arctan(T x)
 {
-    return (2.0f / PI) * std::atan(x);
+    return T(2.0 / 3.14159265358979323846) * std::atan(x);
 }
 
 // T-squared: sign(x) * |x|^n, weird asymmetric character
 // Exponent controls the curve: 1.0=linear, 2.0=squared, 3.0=cubed, etc.
 // Hard clips at ±1
-inline float tsquared(float x, float exponent = 2.0f)
+template <typename T>
+inline T tsquared(T x, float exponent = 2.0f)
 {
-    float absX = std::abs(x);
-    float powered = std::pow(absX, exponent);
-    if (x >= 0.0f)
-        return (powered > 1.0f) ? 1.0f : powered;
+    T absX = std::abs(x);
+    T powered = std::pow(absX, static_cast<T>(exponent));
+    if (x >= T(0))
+        return (powered > T(1)) ? T(1) : powered;
     else
-        return (powered > 1.0f) ? -1.0f : -powered;
+        return (powered > T(1)) ? T(-1) : -powered;
 }
 
-// Knee: soft knee compression with adjustable knee width
-// Linear below kneeStart, t² compression in knee region, hard clip above 1.0
-// Exponent controls knee size: 4.0=huge knee (starts at 5%), 1.0=tiny knee (near hard clip)
-inline float knee(float x, float exponent = 2.0f)
+// Knee shape derived from the exponent - precompute when the exponent is fixed
+struct KneeParams
 {
-    float absX = std::abs(x);
-    float sign = (x >= 0.0f) ? 1.0f : -1.0f;
+    float start = 1.0f;
+    float width = 0.0f;
+};
 
+inline KneeParams makeKneeParams(float exponent)
+{
     // Map exponent (1-4) to sharpness (0-1): lower exponent = sharper = smaller knee
     float sharpness = (4.0f - exponent) / 3.0f;
 
     // Knee width: 0 at sharpness=1, 0.95 at sharpness=0 (starts at 5% of ceiling!)
-    float kneeWidth = (1.0f - sharpness) * 0.95f;
-    float kneeStart = 1.0f - kneeWidth;
+    KneeParams params;
+    params.width = (1.0f - sharpness) * 0.95f;
+    params.start = 1.0f - params.width;
+    return params;
+}
+
+// Knee: soft knee compression with adjustable knee width
+// Linear below kneeStart, t² compression in knee region, hard clip above 1.0
+template <typename T>
+inline T knee(T x, const KneeParams& params)
+{
+    T absX = std::abs(x);
+    T sign = (x >= T(0)) ? T(1) : T(-1);
+    const T start = params.start;
+    const T width = params.width;
 
     // Below knee - pass through unchanged
-    if (absX <= kneeStart)
+    if (absX <= start)
         return x;
 
     // Above ceiling - hard limit
-    if (absX > 1.0f)
+    if (absX > T(1))
         return sign;
 
     // In knee region - t² compression
-    float t = (absX - kneeStart) / kneeWidth;  // 0 to 1 within knee
-    float compressed = kneeStart + kneeWidth * t * t;
+    T t = (absX - start) / width;  // 0 to 1 within knee
+    T compressed = start + width * t * t;
     return sign * compressed;
 }
 
+// Exponent controls knee size: 4.0=huge knee (starts at 5%), 1.0=tiny knee (near hard clip)
+template <typename T>
+inline T knee(T x, float exponent = 2.0f)
+{
+    return knee(x, makeKneeParams(exponent));
+}
+
 // Apply curve by type (normalized input/output)
 // exponent used for Knee and T2 curves
-inline float apply(CurveType type, float x, float exponent = 2.0f)
+template <typename T>
+inline T apply(CurveType type, T x, float exponent = 2.0f)
 {
     switch (type)
     {
@@ -131,16 +167,225 @@ inline float apply(CurveType type, float x, float exponent = 2.0f)
 }
 
 // Apply curve with ceiling (handles normalization)
-// exponent used for Knee and T2 curves
-inline float applyWithCeiling(CurveType type, float sample, float ceiling, float exponent = 2.0f)
+// exponent used for Knee and T2 curves. The sample sets the type - the ceiling
+// converts to it (common_type keeps it out of deduction)
+template <typename T>
+inline T applyWithCeiling(CurveType type, T sample, typename std::common_type<T>::type ceiling,
+                          float exponent = 2.0f)
 {
-    if (ceiling <= 0.0f)
-        return 0.0f;
+    if (ceiling <= T(0))
+        return T(0);
 
-    float normalized = sample / ceiling;
-    float curved = apply(type, normalized, exponent);
+    T normalized = sample / ceiling;
+    T curved = apply(type, normalized, exponent);
     return curved * ceiling;
 }
 
+// =============================================================================
+// Antiderivatives for antiderivative anti-aliasing (ADAA, see Clipper)
+// F1' = curve and F2' = F1, both zero at x = 0, so F1 is even and F2 odd.
+// Double precision: ADAA divides differences of these by small input steps
+// =============================================================================
+
+namespace detail {
+
+// Beyond |x| = edge the curve sits at +-1, so F1 grows linearly and F2
+// quadratically from their values at the edge
+inline double saturatedF1(double absX, double edge, double f1Edge)
+{
+    return f1Edge + (absX - edge);
+}
+
+inline double saturatedF2(double absX, double edge, double f1Edge, double f2Edge)
+{
+    const double d = absX - edge;
+    return f2Edge + f1Edge * d + 0.5 * d * d;
+}
+
+// Dilogarithm Li2(z) for z in [-1, 0], Bernoulli series in u = -ln(1 - z)
+// (|u| <= ln 2, the last term is below 1e-12)
+inline double dilogNegative(double z)
+{
+    const double u = -std::log1p(-z);
+    const double u2 = u * u;
+    return u * (1.0 + u * (-0.25 + u * (1.0 / 36.0 + u2 * (-1.0 / 3600.0 + u2 * (1.0 / 211680.0
+               + u2 * (-1.0 / 10886400.0 + u2 * (1.0 / 526901760.0)))))));
+}
+
+constexpr double kPiDouble = 3.14159265358979323846;
+constexpr double kLn2 = 0.69314718055994530942;
+
+} // namespace detail
+
+// Hard: x^2/2 inside, |x| - 1/2 beyond
+inline double hardAntiderivative1(double x)
+{
+    const double a = std::abs(x);
+    return (a <= 1.0) ? 0.5 * a * a : detail::saturatedF1(a, 1.0, 0.5);
+}
+
+inline double hardAntiderivative2(double x)
+{
+    const double a = std::abs(x);
+    const double f2 = (a <= 1.0) ? a * a * a / 6.0 : detail::saturatedF2(a, 1.0, 0.5, 1.0 / 6.0);
+    return std::copysign(f2, x);
+}
+
+// Quintic: x^2/2 - (256/18750)x^6 inside |x| < 1.25
+inline double quinticAntiderivative1(double x)
+{
+    auto inner = [](double a) { const double a2 = a * a; return 0.5 * a2 - (256.0 / 18750.0) * a2 * a2 * a2; };
+    const double a = std::abs(x);
+    return (a < 1.25) ? inner(a) : detail::saturatedF1(a, 1.25, inner(1.25));
+}
+
+inline double quinticAntiderivative2(double x)
+{
+    auto inner1 = [](double a) { const double a2 = a * a; return 0.5 * a2 - (256.0 / 18750.0) * a2 * a2 * a2; };
+    auto inner2 = [](double a) { const double a3 = a * a * a; return a3 / 6.0 - (256.0 / 131250.0) * a3 * a3 * a; };
+    const double a = std::abs(x);
+    const double f2 = (a < 1.25) ? inner2(a) : detail::saturatedF2(a, 1.25, inner1(1.25), inner2(1.25));
+    return std::copysign(f2, x);
+}
+
+// Cubic: x^2/2 - x^4/27 inside |x| < 1.5
+inline double cubicAntiderivative1(double x)
+{
+    auto inner = [](double a) { const double a2 = a * a; return 0.5 * a2 - a2 * a2 / 27.0; };
+    const double a = std::abs(x);
+    return (a < 1.5) ? inner(a) : detail::saturatedF1(a, 1.5, inner(1.5));
+}
+
+inline double cubicAntiderivative2(double x)
+{
+    auto inner1 = [](double a) { const double a2 = a * a; return 0.5 * a2 - a2 * a2 / 27.0; };
+    auto inner2 = [](double a) { const double a3 = a * a * a; return a3 / 6.0 - a3 * a * a / 135.0; };
+    const double a = std::abs(x);
+    const double f2 = (a < 1.5) ? inner2(a) : detail::saturatedF2(a, 1.5, inner1(1.5), inner2(1.5));
+    return std::copysign(f2, x);
+}
+
+// Tanh: ln cosh(x), written so it can't overflow
+inline double tanhAntiderivative1(double x)
+{
+    const double a = std::abs(x);
+    return a + std::log1p(std::exp(-2.0 * a)) - detail::kLn2;
+}
+
+// Tanh: x^2/2 - x ln2 + Li2(-e^-2x)/2 + pi^2/24 for x >= 0
+inline double tanhAntiderivative2(double x)
+{
+    const double a = std::abs(x);
+    const double f2 = 0.5 * a * a - a * detail::kLn2 + 0.5 * detail::dilogNegative(-std::exp(-2.0 * a))
+                      + detail::kPiDouble * detail::kPiDouble / 24.0;
+    return std::copysign(f2, x);
+}
+
+// Arctan: (2/pi)(x atan x - ln(1 + x^2)/2)
+inline double arctanAntiderivative1(double x)
+{
+    return (2.0 / detail::kPiDouble) * (x * std::atan(x) - 0.5 * std::log1p(x * x));
+}
+
+// Arctan: (2/pi)((x^2 - 1)/2 atan x + x/2 - (x/2) ln(1 + x^2))
+inline double arctanAntiderivative2(double x)
+{
+    return (2.0 / detail::kPiDouble) * (0.5 * (x * x - 1.0) * std::atan(x) + 0.5 * x - 0.5 * x * std::log1p(x * x));
+}
+
+// Knee: linear below start, start + width*t^2 up to 1, saturated beyond
+inline double kneeAntiderivative1(double x, const KneeParams& params)
+{
+    const double s = params.start;
+    const double w = params.width;
+    const double a = std::abs(x);
+
+    if (a <= s)
+        return 0.5 * a * a;
+
+    const double f1Edge = 0.5 * s * s + s * w + w * w / 3.0;
+    if (a > 1.0)
+        return detail::saturatedF1(a, 1.0, f1Edge);
+
+    const double t = (a - s) / w;
+    return 0.5 * s * s + s * (a - s) + w * w * t * t * t / 3.0;
+}
+
+inline double kneeAntiderivative2(double x, const KneeParams& params)
+{
+    const double s = params.start;
+    const double w = params.width;
+    const double a = std::abs(x);
+    double f2;
+
+    if (a <= s)
+    {
+        f2 = a * a * a / 6.0;
+    }
+    else if (a > 1.0)
+    {
+        const double f1Edge = 0.5 * s * s + s * w + w * w / 3.0;
+        const double f2Edge = s * s * s / 6.0 + 0.5 * s * s * w + 0.5 * s * w * w + w * w * w / 12.0;
+        f2 = detail::saturatedF2(a, 1.0, f1Edge, f2Edge);
+    }
+    else
+    {
+        const double d = a - s;
+        const double t = d / w;
+        f2 = s * s * s / 6.0 + 0.5 * s * s * d + 0.5 * s * d * d + w * w * w * t * t * t * t / 12.0;
+    }
+
+    return std::copysign(f2, x);
+}
+
+// T2: |x|^(n+1)/(n+1) inside |x| < 1
+inline double tsquaredAntiderivative1(double x, double exponent)
+{
+    const double a = std::abs(x);
+    const double n1 = exponent + 1.0;
+    return (a < 1.0) ? std::pow(a, n1) / n1 : detail::saturatedF1(a, 1.0, 1.0 / n1);
+}
+
+inline double tsquaredAntiderivative2(double x, double exponent)
+{
+    const double a = std::abs(x);
+    const double n1 = exponent + 1.0;
+    const double n2 = exponent + 2.0;
+    const double f2 = (a < 1.0) ? std::pow(a, n2) / (n1 * n2)
+                                : detail::saturatedF2(a, 1.0, 1.0 / n1, 1.0 / (n1 * n2));
+    return std::copysign(f2, x);
+}
+
+// By type (normalized input)
+inline double antiderivative1(CurveType type, double x, float exponent = 2.0f)
+{
+    switch (type)
+    {
+        case CurveType::Hard:     return hardAntiderivative1(x);
+        case CurveType::Quintic:  return quinticAntiderivative1(x);
+        case CurveType::Cubic:    return cubicAntiderivative1(x);
+        case CurveType::Tanh:     return tanhAntiderivative1(x);
+        case CurveType::Arctan:   return arctanAntiderivative1(x);
+        case CurveType::Knee:     return kneeAntiderivative1(x, makeKneeParams(exponent));
+        case CurveType::T2:       return tsquaredAntiderivative1(x, exponent);
+        default:                  return hardAntiderivative1(x);
+    }
+}
+
+inline double antiderivative2(CurveType type, double x, float exponent = 2.0f)
+{
+    switch (type)
+    {
+        case CurveType::Hard:     return hardAntiderivative2(x);
+        case CurveType::Quintic:  return quinticAntiderivative2(x);
+        case CurveType::Cubic:    return cubicAntiderivative2(x);
+        case CurveType::Tanh:     return tanhAntiderivative2(x);
+        case CurveType::Arctan:   return arctanAntiderivative2(x);
+        case CurveType::Knee:     return kneeAntiderivative2(x, makeKneeParams(exponent));
+        case CurveType::T2:       return tsquaredAntiderivative2(x, exponent);
+        default:                  return hardAntiderivative2(x);
+    }
+}
+
 } // namespace curves
 } // namespace dsp
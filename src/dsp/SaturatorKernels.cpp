@@ -0,0 +1,1037 @@
+#include "SaturatorKernels.h"
+#include "CurveTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define GUILLOTINE_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define GUILLOTINE_SIMD_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define GUILLOTINE_SIMD_NEON 1
+#endif
+
+namespace dsp {
+namespace curves {
+
+namespace {
+
+// =============================================================================
+// Vector wrappers
+// Each wrapper exposes the same small set of operations so the curve math below
+// is written once and shared by the SIMD body and the scalar tail.
+// min/max follow SSE semantics (second operand returned on NaN) so that
+// clamp(lo, hi, x) propagates NaN the same way the scalar curves do.
+// =============================================================================
+
+template <typename T>
+struct ScalarVec
+{
+    using Element = T;
+    static constexpr int size = 1;
+    T v;
+
+    static ScalarVec load(const T* p) { return { *p }; }
+    static ScalarVec splat(T f) { return { f }; }
+    void store(T* p) const { *p = v; }
+};
+
+using ScalarMask = bool;
+
+template <typename T> inline ScalarVec<T> operator+(ScalarVec<T> a, ScalarVec<T> b) { return { a.v + b.v }; }
+template <typename T> inline ScalarVec<T> operator-(ScalarVec<T> a, ScalarVec<T> b) { return { a.v - b.v }; }
+template <typename T> inline ScalarVec<T> operator*(ScalarVec<T> a, ScalarVec<T> b) { return { a.v * b.v }; }
+template <typename T> inline ScalarVec<T> operator/(ScalarVec<T> a, ScalarVec<T> b) { return { a.v / b.v }; }
+template <typename T> inline ScalarVec<T> vmin(ScalarVec<T> a, ScalarVec<T> b) { return { (a.v < b.v) ? a.v : b.v }; }
+template <typename T> inline ScalarVec<T> vmax(ScalarVec<T> a, ScalarVec<T> b) { return { (a.v > b.v) ? a.v : b.v }; }
+template <typename T> inline ScalarVec<T> vabs(ScalarVec<T> a) { return { std::abs(a.v) }; }
+template <typename T> inline ScalarMask lessThan(ScalarVec<T> a, ScalarVec<T> b) { return a.v < b.v; }
+template <typename T> inline ScalarMask lessEqual(ScalarVec<T> a, ScalarVec<T> b) { return a.v <= b.v; }
+template <typename T> inline ScalarMask greaterThan(ScalarVec<T> a, ScalarVec<T> b) { return a.v > b.v; }
+template <typename T> inline ScalarVec<T> select(ScalarMask m, ScalarVec<T> a, ScalarVec<T> b) { return m ? a : b; }
+template <typename T> inline ScalarVec<T> copySign(ScalarVec<T> mag, ScalarVec<T> sign) { return { std::copysign(mag.v, sign.v) }; }
+template <typename T> inline ScalarVec<T> truncate(ScalarVec<T> a) { return { std::trunc(a.v) }; }
+template <typename T> inline ScalarVec<T> reciprocal(ScalarVec<T> a) { return { T(1) / a.v }; }
+template <typename T> inline T horizontalMax(ScalarVec<T> a) { return a.v; }
+
+// Returns mantissa in [1, 2) and writes the unbiased exponent (x must be positive and normal)
+inline ScalarVec<float> splitExponent(ScalarVec<float> x, ScalarVec<float>& exponent)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x.v, sizeof(bits));
+    exponent.v = static_cast<float>(static_cast<int>((bits >> 23) & 0xffu) - 127);
+    bits = (bits & 0x007fffffu) | 0x3f800000u;
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+    return { mantissa };
+}
+
+inline ScalarVec<double> splitExponent(ScalarVec<double> x, ScalarVec<double>& exponent)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x.v, sizeof(bits));
+    exponent.v = static_cast<double>(static_cast<int>((bits >> 52) & 0x7ffu) - 1023);
+    bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+    double mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+    return { mantissa };
+}
+
+// x * 2^n for integral n in [-126, 127]
+inline ScalarVec<float> scaleByPow2(ScalarVec<float> x, ScalarVec<float> n)
+{
+    const uint32_t bits = static_cast<uint32_t>(static_cast<int>(n.v) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return { x.v * scale };
+}
+
+inline ScalarVec<double> scaleByPow2(ScalarVec<double> x, ScalarVec<double> n)
+{
+    const uint64_t bits = static_cast<uint64_t>(static_cast<int>(n.v) + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return { x.v * scale };
+}
+
+// Native registers: NativeVec<float> and NativeVec<double>, same operations
+template <typename T> struct NativeVec;
+template <typename T> struct NativeMask;
+
+// Doubles in [2^52, 2^53) step by exactly 1, so an integer added to 2^52 lands in the mantissa bits
+constexpr double kDoubleMagic = 4503599627370496.0;
+
+#if GUILLOTINE_SIMD_AVX2
+
+template <>
+struct NativeVec<float>
+{
+    using Element = float;
+    static constexpr int size = 8;
+    __m256 v;
+
+    static NativeVec<float> load(const float* p) { return { _mm256_loadu_ps(p) }; }
+    static NativeVec<float> splat(float f) { return { _mm256_set1_ps(f) }; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+template <> struct NativeMask<float> { __m256 m; };
+
+inline NativeVec<float> operator+(NativeVec<float> a, NativeVec<float> b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline NativeVec<float> operator-(NativeVec<float> a, NativeVec<float> b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline NativeVec<float> operator*(NativeVec<float> a, NativeVec<float> b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline NativeVec<float> operator/(NativeVec<float> a, NativeVec<float> b) { return { _mm256_div_ps(a.v, b.v) }; }
+inline NativeVec<float> vmin(NativeVec<float> a, NativeVec<float> b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline NativeVec<float> vmax(NativeVec<float> a, NativeVec<float> b) { return { _mm256_max_ps(a.v, b.v) }; }
+inline NativeVec<float> vabs(NativeVec<float> a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+inline NativeMask<float> lessThan(NativeVec<float> a, NativeVec<float> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline NativeMask<float> lessEqual(NativeVec<float> a, NativeVec<float> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline NativeMask<float> greaterThan(NativeVec<float> a, NativeVec<float> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline NativeVec<float> select(NativeMask<float> m, NativeVec<float> a, NativeVec<float> b) { return { _mm256_blendv_ps(b.v, a.v, m.m) }; }
+inline NativeVec<float> truncate(NativeVec<float> a) { return { _mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+
+// rcp estimate (12 bits) refined with one Newton-Raphson step (~22 bits)
+inline NativeVec<float> reciprocal(NativeVec<float> a)
+{
+    const __m256 estimate = _mm256_rcp_ps(a.v);
+    return { _mm256_mul_ps(estimate, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(a.v, estimate))) };
+}
+
+inline float horizontalMax(NativeVec<float> a)
+{
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+inline NativeVec<float> copySign(NativeVec<float> mag, NativeVec<float> sign)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    return { _mm256_or_ps(_mm256_andnot_ps(signMask, mag.v), _mm256_and_ps(signMask, sign.v)) };
+}
+
+inline NativeVec<float> splitExponent(NativeVec<float> x, NativeVec<float>& exponent)
+{
+    const __m256i bits = _mm256_castps_si256(x.v);
+    const __m256i biased = _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xff));
+    exponent.v = _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(127)));
+    const __m256i mantissa = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                             _mm256_set1_epi32(0x3f800000));
+    return { _mm256_castsi256_ps(mantissa) };
+}
+
+inline NativeVec<float> scaleByPow2(NativeVec<float> x, NativeVec<float> n)
+{
+    const __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n.v), _mm256_set1_epi32(127)), 23);
+    return { _mm256_mul_ps(x.v, _mm256_castsi256_ps(bits)) };
+}
+
+template <>
+struct NativeVec<double>
+{
+    using Element = double;
+    static constexpr int size = 4;
+    __m256d v;
+
+    static NativeVec<double> load(const double* p) { return { _mm256_loadu_pd(p) }; }
+    static NativeVec<double> splat(double f) { return { _mm256_set1_pd(f) }; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+};
+
+template <> struct NativeMask<double> { __m256d m; };
+
+inline NativeVec<double> operator+(NativeVec<double> a, NativeVec<double> b) { return { _mm256_add_pd(a.v, b.v) }; }
+inline NativeVec<double> operator-(NativeVec<double> a, NativeVec<double> b) { return { _mm256_sub_pd(a.v, b.v) }; }
+inline NativeVec<double> operator*(NativeVec<double> a, NativeVec<double> b) { return { _mm256_mul_pd(a.v, b.v) }; }
+inline NativeVec<double> operator/(NativeVec<double> a, NativeVec<double> b) { return { _mm256_div_pd(a.v, b.v) }; }
+inline NativeVec<double> vmin(NativeVec<double> a, NativeVec<double> b) { return { _mm256_min_pd(a.v, b.v) }; }
+inline NativeVec<double> vmax(NativeVec<double> a, NativeVec<double> b) { return { _mm256_max_pd(a.v, b.v) }; }
+inline NativeVec<double> vabs(NativeVec<double> a) { return { _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v) }; }
+inline NativeMask<double> lessThan(NativeVec<double> a, NativeVec<double> b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+inline NativeMask<double> lessEqual(NativeVec<double> a, NativeVec<double> b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+inline NativeMask<double> greaterThan(NativeVec<double> a, NativeVec<double> b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+inline NativeVec<double> select(NativeMask<double> m, NativeVec<double> a, NativeVec<double> b) { return { _mm256_blendv_pd(b.v, a.v, m.m) }; }
+inline NativeVec<double> truncate(NativeVec<double> a) { return { _mm256_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+
+// No double estimate instruction - a full divide
+inline NativeVec<double> reciprocal(NativeVec<double> a) { return { _mm256_div_pd(_mm256_set1_pd(1.0), a.v) }; }
+
+inline double horizontalMax(NativeVec<double> a)
+{
+    __m128d m = _mm_max_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+    m = _mm_max_sd(m, _mm_unpackhi_pd(m, m));
+    return _mm_cvtsd_f64(m);
+}
+
+inline NativeVec<double> copySign(NativeVec<double> mag, NativeVec<double> sign)
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    return { _mm256_or_pd(_mm256_andnot_pd(signMask, mag.v), _mm256_and_pd(signMask, sign.v)) };
+}
+
+// No 64-bit integer <-> double conversion before AVX-512: small integers go
+// through the mantissa of 2^52 (kDoubleMagic) instead
+inline NativeVec<double> splitExponent(NativeVec<double> x, NativeVec<double>& exponent)
+{
+    const __m256d magic = _mm256_set1_pd(kDoubleMagic);
+    const __m256i bits = _mm256_castpd_si256(x.v);
+    const __m256i biased = _mm256_and_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x7ff));
+    exponent.v = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_castpd_si256(magic))),
+                               _mm256_add_pd(magic, _mm256_set1_pd(1023.0)));
+    const __m256i mantissa = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffll)),
+                                             _mm256_set1_epi64x(0x3ff0000000000000ll));
+    return { _mm256_castsi256_pd(mantissa) };
+}
+
+inline NativeVec<double> scaleByPow2(NativeVec<double> x, NativeVec<double> n)
+{
+    const __m256d biased = _mm256_add_pd(n.v, _mm256_set1_pd(kDoubleMagic + 1023.0));
+    const __m256i bits = _mm256_slli_epi64(_mm256_castpd_si256(biased), 52);
+    return { _mm256_mul_pd(x.v, _mm256_castsi256_pd(bits)) };
+}
+
+#elif GUILLOTINE_SIMD_SSE2
+
+template <>
+struct NativeVec<float>
+{
+    using Element = float;
+    static constexpr int size = 4;
+    __m128 v;
+
+    static NativeVec<float> load(const float* p) { return { _mm_loadu_ps(p) }; }
+    static NativeVec<float> splat(float f) { return { _mm_set1_ps(f) }; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+template <> struct NativeMask<float> { __m128 m; };
+
+inline NativeVec<float> operator+(NativeVec<float> a, NativeVec<float> b) { return { _mm_add_ps(a.v, b.v) }; }
+inline NativeVec<float> operator-(NativeVec<float> a, NativeVec<float> b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline NativeVec<float> operator*(NativeVec<float> a, NativeVec<float> b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline NativeVec<float> operator/(NativeVec<float> a, NativeVec<float> b) { return { _mm_div_ps(a.v, b.v) }; }
+inline NativeVec<float> vmin(NativeVec<float> a, NativeVec<float> b) { return { _mm_min_ps(a.v, b.v) }; }
+inline NativeVec<float> vmax(NativeVec<float> a, NativeVec<float> b) { return { _mm_max_ps(a.v, b.v) }; }
+inline NativeVec<float> vabs(NativeVec<float> a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline NativeMask<float> lessThan(NativeVec<float> a, NativeVec<float> b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline NativeMask<float> lessEqual(NativeVec<float> a, NativeVec<float> b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline NativeMask<float> greaterThan(NativeVec<float> a, NativeVec<float> b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline NativeVec<float> select(NativeMask<float> m, NativeVec<float> a, NativeVec<float> b) { return { _mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v)) }; }
+inline NativeVec<float> truncate(NativeVec<float> a) { return { _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v)) }; }  // |a| < 2^31
+
+// rcp estimate (12 bits) refined with one Newton-Raphson step (~22 bits)
+inline NativeVec<float> reciprocal(NativeVec<float> a)
+{
+    const __m128 estimate = _mm_rcp_ps(a.v);
+    return { _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(a.v, estimate))) };
+}
+
+inline float horizontalMax(NativeVec<float> a)
+{
+    __m128 m = _mm_max_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+inline NativeVec<float> copySign(NativeVec<float> mag, NativeVec<float> sign)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    return { _mm_or_ps(_mm_andnot_ps(signMask, mag.v), _mm_and_ps(signMask, sign.v)) };
+}
+
+inline NativeVec<float> splitExponent(NativeVec<float> x, NativeVec<float>& exponent)
+{
+    const __m128i bits = _mm_castps_si128(x.v);
+    const __m128i biased = _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff));
+    exponent.v = _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(127)));
+    const __m128i mantissa = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                          _mm_set1_epi32(0x3f800000));
+    return { _mm_castsi128_ps(mantissa) };
+}
+
+inline NativeVec<float> scaleByPow2(NativeVec<float> x, NativeVec<float> n)
+{
+    const __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n.v), _mm_set1_epi32(127)), 23);
+    return { _mm_mul_ps(x.v, _mm_castsi128_ps(bits)) };
+}
+
+template <>
+struct NativeVec<double>
+{
+    using Element = double;
+    static constexpr int size = 2;
+    __m128d v;
+
+    static NativeVec<double> load(const double* p) { return { _mm_loadu_pd(p) }; }
+    static NativeVec<double> splat(double f) { return { _mm_set1_pd(f) }; }
+    void store(double* p) const { _mm_storeu_pd(p, v); }
+};
+
+template <> struct NativeMask<double> { __m128d m; };
+
+inline NativeVec<double> operator+(NativeVec<double> a, NativeVec<double> b) { return { _mm_add_pd(a.v, b.v) }; }
+inline NativeVec<double> operator-(NativeVec<double> a, NativeVec<double> b) { return { _mm_sub_pd(a.v, b.v) }; }
+inline NativeVec<double> operator*(NativeVec<double> a, NativeVec<double> b) { return { _mm_mul_pd(a.v, b.v) }; }
+inline NativeVec<double> operator/(NativeVec<double> a, NativeVec<double> b) { return { _mm_div_pd(a.v, b.v) }; }
+inline NativeVec<double> vmin(NativeVec<double> a, NativeVec<double> b) { return { _mm_min_pd(a.v, b.v) }; }
+inline NativeVec<double> vmax(NativeVec<double> a, NativeVec<double> b) { return { _mm_max_pd(a.v, b.v) }; }
+inline NativeVec<double> vabs(NativeVec<double> a) { return { _mm_andnot_pd(_mm_set1_pd(-0.0), a.v) }; }
+inline NativeMask<double> lessThan(NativeVec<double> a, NativeVec<double> b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+inline NativeMask<double> lessEqual(NativeVec<double> a, NativeVec<double> b) { return { _mm_cmple_pd(a.v, b.v) }; }
+inline NativeMask<double> greaterThan(NativeVec<double> a, NativeVec<double> b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+inline NativeVec<double> select(NativeMask<double> m, NativeVec<double> a, NativeVec<double> b) { return { _mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v)) }; }
+inline NativeVec<double> truncate(NativeVec<double> a) { return { _mm_cvtepi32_pd(_mm_cvttpd_epi32(a.v)) }; }  // |a| < 2^31
+
+// No double estimate instruction - a full divide
+inline NativeVec<double> reciprocal(NativeVec<double> a) { return { _mm_div_pd(_mm_set1_pd(1.0), a.v) }; }
+
+inline double horizontalMax(NativeVec<double> a)
+{
+    return _mm_cvtsd_f64(_mm_max_sd(a.v, _mm_unpackhi_pd(a.v, a.v)));
+}
+
+inline NativeVec<double> copySign(NativeVec<double> mag, NativeVec<double> sign)
+{
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    return { _mm_or_pd(_mm_andnot_pd(signMask, mag.v), _mm_and_pd(signMask, sign.v)) };
+}
+
+// No 64-bit integer <-> double conversion in SSE2: small integers go through
+// the mantissa of 2^52 (kDoubleMagic) instead
+inline NativeVec<double> splitExponent(NativeVec<double> x, NativeVec<double>& exponent)
+{
+    const __m128d magic = _mm_set1_pd(kDoubleMagic);
+    const __m128i bits = _mm_castpd_si128(x.v);
+    const __m128i biased = _mm_and_si128(_mm_srli_epi64(bits, 52), _mm_set1_epi64x(0x7ff));
+    exponent.v = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(biased, _mm_castpd_si128(magic))),
+                            _mm_add_pd(magic, _mm_set1_pd(1023.0)));
+    const __m128i mantissa = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000fffffffffffffll)),
+                                          _mm_set1_epi64x(0x3ff0000000000000ll));
+    return { _mm_castsi128_pd(mantissa) };
+}
+
+inline NativeVec<double> scaleByPow2(NativeVec<double> x, NativeVec<double> n)
+{
+    const __m128d biased = _mm_add_pd(n.v, _mm_set1_pd(kDoubleMagic + 1023.0));
+    const __m128i bits = _mm_slli_epi64(_mm_castpd_si128(biased), 52);
+    return { _mm_mul_pd(x.v, _mm_castsi128_pd(bits)) };
+}
+
+#elif GUILLOTINE_SIMD_NEON
+
+template <>
+struct NativeVec<float>
+{
+    using Element = float;
+    static constexpr int size = 4;
+    float32x4_t v;
+
+    static NativeVec<float> load(const float* p) { return { vld1q_f32(p) }; }
+    static NativeVec<float> splat(float f) { return { vdupq_n_f32(f) }; }
+    void store(float* p) const { vst1q_f32(p, v); }
+};
+
+template <> struct NativeMask<float> { uint32x4_t m; };
+
+inline NativeVec<float> operator+(NativeVec<float> a, NativeVec<float> b) { return { vaddq_f32(a.v, b.v) }; }
+inline NativeVec<float> operator-(NativeVec<float> a, NativeVec<float> b) { return { vsubq_f32(a.v, b.v) }; }
+inline NativeVec<float> operator*(NativeVec<float> a, NativeVec<float> b) { return { vmulq_f32(a.v, b.v) }; }
+inline NativeVec<float> operator/(NativeVec<float> a, NativeVec<float> b) { return { vdivq_f32(a.v, b.v) }; }
+inline NativeVec<float> vmin(NativeVec<float> a, NativeVec<float> b) { return { vminq_f32(a.v, b.v) }; }  // NaN-propagating
+inline NativeVec<float> vmax(NativeVec<float> a, NativeVec<float> b) { return { vmaxq_f32(a.v, b.v) }; }
+inline NativeVec<float> vabs(NativeVec<float> a) { return { vabsq_f32(a.v) }; }
+inline NativeMask<float> lessThan(NativeVec<float> a, NativeVec<float> b) { return { vcltq_f32(a.v, b.v) }; }
+inline NativeMask<float> lessEqual(NativeVec<float> a, NativeVec<float> b) { return { vcleq_f32(a.v, b.v) }; }
+inline NativeMask<float> greaterThan(NativeVec<float> a, NativeVec<float> b) { return { vcgtq_f32(a.v, b.v) }; }
+inline NativeVec<float> select(NativeMask<float> m, NativeVec<float> a, NativeVec<float> b) { return { vbslq_f32(m.m, a.v, b.v) }; }
+inline NativeVec<float> truncate(NativeVec<float> a) { return { vrndq_f32(a.v) }; }
+inline float horizontalMax(NativeVec<float> a) { return vmaxvq_f32(a.v); }
+
+// vrecpe estimate refined with two Newton-Raphson steps
+inline NativeVec<float> reciprocal(NativeVec<float> a)
+{
+    float32x4_t estimate = vrecpeq_f32(a.v);
+    estimate = vmulq_f32(vrecpsq_f32(a.v, estimate), estimate);
+    return { vmulq_f32(vrecpsq_f32(a.v, estimate), estimate) };
+}
+inline NativeVec<float> copySign(NativeVec<float> mag, NativeVec<float> sign) { return { vbslq_f32(vdupq_n_u32(0x80000000u), sign.v, mag.v) }; }
+
+inline NativeVec<float> splitExponent(NativeVec<float> x, NativeVec<float>& exponent)
+{
+    const uint32x4_t bits = vreinterpretq_u32_f32(x.v);
+    const int32x4_t biased = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(bits, 23), vdupq_n_u32(0xffu)));
+    exponent.v = vcvtq_f32_s32(vsubq_s32(biased, vdupq_n_s32(127)));
+    const uint32x4_t mantissa = vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffffu)), vdupq_n_u32(0x3f800000u));
+    return { vreinterpretq_f32_u32(mantissa) };
+}
+
+inline NativeVec<float> scaleByPow2(NativeVec<float> x, NativeVec<float> n)
+{
+    const int32x4_t bits = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127)), 23);
+    return { vmulq_f32(x.v, vreinterpretq_f32_s32(bits)) };
+}
+
+template <>
+struct NativeVec<double>
+{
+    using Element = double;
+    static constexpr int size = 2;
+    float64x2_t v;
+
+    static NativeVec<double> load(const double* p) { return { vld1q_f64(p) }; }
+    static NativeVec<double> splat(double f) { return { vdupq_n_f64(f) }; }
+    void store(double* p) const { vst1q_f64(p, v); }
+};
+
+template <> struct NativeMask<double> { uint64x2_t m; };
+
+inline NativeVec<double> operator+(NativeVec<double> a, NativeVec<double> b) { return { vaddq_f64(a.v, b.v) }; }
+inline NativeVec<double> operator-(NativeVec<double> a, NativeVec<double> b) { return { vsubq_f64(a.v, b.v) }; }
+inline NativeVec<double> operator*(NativeVec<double> a, NativeVec<double> b) { return { vmulq_f64(a.v, b.v) }; }
+inline NativeVec<double> operator/(NativeVec<double> a, NativeVec<double> b) { return { vdivq_f64(a.v, b.v) }; }
+inline NativeVec<double> vmin(NativeVec<double> a, NativeVec<double> b) { return { vminq_f64(a.v, b.v) }; }  // NaN-propagating
+inline NativeVec<double> vmax(NativeVec<double> a, NativeVec<double> b) { return { vmaxq_f64(a.v, b.v) }; }
+inline NativeVec<double> vabs(NativeVec<double> a) { return { vabsq_f64(a.v) }; }
+inline NativeMask<double> lessThan(NativeVec<double> a, NativeVec<double> b) { return { vcltq_f64(a.v, b.v) }; }
+inline NativeMask<double> lessEqual(NativeVec<double> a, NativeVec<double> b) { return { vcleq_f64(a.v, b.v) }; }
+inline NativeMask<double> greaterThan(NativeVec<double> a, NativeVec<double> b) { return { vcgtq_f64(a.v, b.v) }; }
+inline NativeVec<double> select(NativeMask<double> m, NativeVec<double> a, NativeVec<double> b) { return { vbslq_f64(m.m, a.v, b.v) }; }
+inline NativeVec<double> truncate(NativeVec<double> a) { return { vrndq_f64(a.v) }; }
+inline double horizontalMax(NativeVec<double> a) { return vmaxvq_f64(a.v); }
+inline NativeVec<double> reciprocal(NativeVec<double> a) { return { vdivq_f64(vdupq_n_f64(1.0), a.v) }; }
+inline NativeVec<double> copySign(NativeVec<double> mag, NativeVec<double> sign) { return { vbslq_f64(vdupq_n_u64(0x8000000000000000ull), sign.v, mag.v) }; }
+
+inline NativeVec<double> splitExponent(NativeVec<double> x, NativeVec<double>& exponent)
+{
+    const uint64x2_t bits = vreinterpretq_u64_f64(x.v);
+    const int64x2_t biased = vreinterpretq_s64_u64(vandq_u64(vshrq_n_u64(bits, 52), vdupq_n_u64(0x7ffu)));
+    exponent.v = vcvtq_f64_s64(vsubq_s64(biased, vdupq_n_s64(1023)));
+    const uint64x2_t mantissa = vorrq_u64(vandq_u64(bits, vdupq_n_u64(0x000fffffffffffffull)),
+                                          vdupq_n_u64(0x3ff0000000000000ull));
+    return { vreinterpretq_f64_u64(mantissa) };
+}
+
+inline NativeVec<double> scaleByPow2(NativeVec<double> x, NativeVec<double> n)
+{
+    const int64x2_t bits = vshlq_n_s64(vaddq_s64(vcvtq_s64_f64(n.v), vdupq_n_s64(1023)), 52);
+    return { vmulq_f64(x.v, vreinterpretq_f64_s64(bits)) };
+}
+
+#endif
+
+// =============================================================================
+// Curve math (shared by all vector widths)
+// =============================================================================
+
+template <typename V>
+inline V clampSymmetric(V x, double limit)
+{
+    using T = typename V::Element;
+    const V bound = V::splat(static_cast<T>(limit));
+    return vmin(bound, vmax(V::splat(static_cast<T>(-limit)), x));
+}
+
+template <typename V>
+inline V polynomialClip(V x, double limit, double coeff, int power)
+{
+    // x - c*x^n over [-limit, limit] reaches exactly +-1 at the limit, so clamping
+    // the input first reproduces the scalar curve's hard clip beyond it
+    const V xc = clampSymmetric(x, limit);
+    const V x2 = xc * xc;
+    const V xn = (power == 5) ? x2 * x2 : x2;
+    using T = typename V::Element;
+    return xc - V::splat(static_cast<T>(coeff)) * xn * xc;
+}
+
+// Rational minimax approximation of tanh (numerator degree 13, denominator 6)
+// |error| < 1e-6 over the whole float range
+template <typename V>
+inline V fastTanh(V x)
+{
+    const V xc = clampSymmetric(x, 7.90531110763549805f);
+    const V x2 = xc * xc;
+
+    V p = V::splat(-2.76076847742355e-16f);
+    p = p * x2 + V::splat(2.00018790482477e-13f);
+    p = p * x2 + V::splat(-8.60467152213735e-11f);
+    p = p * x2 + V::splat(5.12229709037114e-08f);
+    p = p * x2 + V::splat(1.48572235717979e-05f);
+    p = p * x2 + V::splat(6.37261928875436e-04f);
+    p = p * x2 + V::splat(4.89352455891786e-03f);
+    p = p * xc;
+
+    V q = V::splat(1.19825839466702e-06f);
+    q = q * x2 + V::splat(1.18534705686654e-04f);
+    q = q * x2 + V::splat(2.26843463243900e-03f);
+    q = q * x2 + V::splat(4.89352518554385e-03f);
+
+    return clampSymmetric(p / q, 1.0f);
+}
+
+// atan via reduction to [0, 1] (atan(x) = pi/2 - atan(1/x)) and the
+// Abramowitz & Stegun 4.4.49 polynomial, |error| < 2e-8 rad
+template <typename V>
+inline V fastAtan(V x)
+{
+    const V one = V::splat(1.0f);
+    const V t = vabs(x);
+    const auto inverted = greaterThan(t, one);
+    const V z = select(inverted, one / t, t);
+    const V z2 = z * z;
+
+    V p = V::splat(0.0028662257f);
+    p = p * z2 + V::splat(-0.0161657367f);
+    p = p * z2 + V::splat(0.0429096138f);
+    p = p * z2 + V::splat(-0.0752896400f);
+    p = p * z2 + V::splat(0.1065626393f);
+    p = p * z2 + V::splat(-0.1420889944f);
+    p = p * z2 + V::splat(0.1999355085f);
+    p = p * z2 + V::splat(-0.3333314528f);
+    p = (p * z2 + one) * z;
+
+    const V result = select(inverted, V::splat(PI * 0.5f) - p, p);
+    return copySign(result, x);
+}
+
+// log2 for positive normal x: mantissa reduced to [sqrt(0.5), sqrt(2)), then
+// ln(m) = 2 * atanh((m - 1) / (m + 1)) as an odd series
+template <typename V>
+inline V fastLog2(V x)
+{
+    const V one = V::splat(1.0f);
+    V exponent = one;
+    V m = splitExponent(x, exponent);
+
+    const auto upper = greaterThan(m, V::splat(1.41421356f));
+    m = select(upper, m * V::splat(0.5f), m);
+    exponent = select(upper, exponent + one, exponent);
+
+    const V s = (m - one) / (m + one);
+    const V s2 = s * s;
+    V p = V::splat(1.0f / 9.0f);
+    p = p * s2 + V::splat(1.0f / 7.0f);
+    p = p * s2 + V::splat(1.0f / 5.0f);
+    p = p * s2 + V::splat(1.0f / 3.0f);
+    p = p * s2 + one;
+
+    return exponent + p * s * V::splat(2.0f * 1.44269504f);  // 2 / ln(2)
+}
+
+// exp2 split into 2^n * 2^f with f in [-0.5, 0.5], 2^f from its Taylor series
+template <typename V>
+inline V fastExp2(V x)
+{
+    const V one = V::splat(1.0f);
+    const V xc = clampSymmetric(x, 126.0f);
+
+    const V shifted = xc + V::splat(0.5f);
+    V n = truncate(shifted);
+    n = n - select(greaterThan(n, shifted), one, V::splat(0.0f));  // floor
+
+    const V y = (xc - n) * V::splat(0.69314718f);
+    V p = V::splat(1.0f / 5040.0f);
+    p = p * y + V::splat(1.0f / 720.0f);
+    p = p * y + V::splat(1.0f / 120.0f);
+    p = p * y + V::splat(1.0f / 24.0f);
+    p = p * y + V::splat(1.0f / 6.0f);
+    p = p * y + V::splat(0.5f);
+    p = p * y + one;
+    p = p * y + one;
+
+    return scaleByPow2(p, n);
+}
+
+template <typename V>
+inline V fastTsquared(V x, float exponent)
+{
+    const V zero = V::splat(0.0f);
+    const V one = V::splat(1.0f);
+    const V t = vabs(x);
+
+    V powered = fastExp2(V::splat(exponent) * fastLog2(vmax(V::splat(1.0e-30f), t)));
+    powered = select(greaterThan(t, zero), powered, zero);
+
+    // |x|^n > 1 exactly when |x| > 1 (n > 0), so clip on the input
+    const V clipped = copySign(select(lessThan(t, one), powered, one), x);
+
+    // NaN fails every compare above and would come out as +-1 - pass it
+    // through like the scalar curve (the only lanes not <= inf)
+    return select(lessEqual(t, V::splat(std::numeric_limits<typename V::Element>::infinity())), clipped, x);
+}
+
+template <typename V>
+inline V kneeCurve(V x, double kneeStart, double invKneeWidth)
+{
+    using T = typename V::Element;
+    const V one = V::splat(1.0f);
+    const V start = V::splat(static_cast<T>(kneeStart));
+    const V t = vabs(x);
+    const V over = t - start;
+    const V compressed = start + over * over * V::splat(static_cast<T>(invKneeWidth));
+
+    const V shaped = select(greaterThan(t, one), one, compressed);
+    return copySign(select(lessEqual(t, start), t, shaped), x);
+}
+
+// The table as the block loop reads it, copied out once per block
+struct TableView
+{
+    const CurveTable::Node* nodes;
+    float size;
+    float scale;
+    float range;
+    bool asymptoticTail;
+};
+
+// Fetches the node under each lane's position as four coefficient vectors and
+// returns the fraction into the segment. SSE2 and NEON have no gather: this
+// generic version goes lane by lane, float registers load whole nodes and
+// transpose them
+template <typename V>
+inline V loadNodes(V position, const CurveTable::Node* nodes, V* c)
+{
+    using T = typename V::Element;
+    alignas(32) T indices[V::size];
+    alignas(32) T coefficients[4][V::size];
+    const V index = truncate(position);
+    index.store(indices);
+
+    for (int lane = 0; lane < V::size; ++lane)
+    {
+        const CurveTable::Node& node = nodes[static_cast<int>(indices[lane])];
+        coefficients[0][lane] = node.c0;
+        coefficients[1][lane] = node.c1;
+        coefficients[2][lane] = node.c2;
+        coefficients[3][lane] = node.c3;
+    }
+
+    for (int k = 0; k < 4; ++k)
+        c[k] = V::load(coefficients[k]);
+
+    return position - index;
+}
+
+#if GUILLOTINE_SIMD_AVX2
+
+inline NativeVec<float> loadNodes(NativeVec<float> position, const CurveTable::Node* nodes, NativeVec<float>* c)
+{
+    alignas(32) int32_t i[8];
+    const __m256i index = _mm256_cvttps_epi32(position.v);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(i), index);
+
+    // Lanes k and k + 4 share a row, so an in-lane 4x4 transpose finishes it
+    auto row = [&](int low, int high)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(&nodes[i[low]].c0)),
+                                    _mm_load_ps(&nodes[i[high]].c0), 1);
+    };
+    const __m256 r0 = row(0, 4);
+    const __m256 r1 = row(1, 5);
+    const __m256 r2 = row(2, 6);
+    const __m256 r3 = row(3, 7);
+
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    c[0].v = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    c[1].v = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c[2].v = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    c[3].v = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+    return { _mm256_sub_ps(position.v, _mm256_cvtepi32_ps(index)) };
+}
+
+#elif GUILLOTINE_SIMD_SSE2
+
+inline NativeVec<float> loadNodes(NativeVec<float> position, const CurveTable::Node* nodes, NativeVec<float>* c)
+{
+    alignas(16) int32_t i[4];
+    const __m128i index = _mm_cvttps_epi32(position.v);
+    _mm_store_si128(reinterpret_cast<__m128i*>(i), index);
+
+    __m128 r0 = _mm_load_ps(&nodes[i[0]].c0);
+    __m128 r1 = _mm_load_ps(&nodes[i[1]].c0);
+    __m128 r2 = _mm_load_ps(&nodes[i[2]].c0);
+    __m128 r3 = _mm_load_ps(&nodes[i[3]].c0);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    c[0].v = r0;
+    c[1].v = r1;
+    c[2].v = r2;
+    c[3].v = r3;
+
+    return { _mm_sub_ps(position.v, _mm_cvtepi32_ps(index)) };
+}
+
+#elif GUILLOTINE_SIMD_NEON
+
+inline NativeVec<float> loadNodes(NativeVec<float> position, const CurveTable::Node* nodes, NativeVec<float>* c)
+{
+    alignas(16) int32_t i[4];
+    const int32x4_t index = vcvtq_s32_f32(position.v);
+    vst1q_s32(i, index);
+
+    const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(&nodes[i[0]].c0), vld1q_f32(&nodes[i[1]].c0));
+    const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(&nodes[i[2]].c0), vld1q_f32(&nodes[i[3]].c0));
+    c[0].v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    c[1].v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    c[2].v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    c[3].v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+
+    return { vsubq_f32(position.v, vcvtq_f32_s32(index)) };
+}
+
+#endif
+
+// Table-driven curve (CurveTable): segment index and fraction in registers,
+// one node per lane, Horner on the segment polynomial
+template <bool Cubic, typename V>
+inline V tableCurve(V x, const TableView& table)
+{
+    using T = typename V::Element;
+    const V one = V::splat(T(1));
+    const V t = vabs(x);
+
+    // NaN and inf land on the end node (the compare fails for both)
+    const V end = V::splat(static_cast<T>(table.size));
+    const V scaled = t * V::splat(static_cast<T>(table.scale));
+    const V position = select(lessEqual(scaled, end), scaled, end);
+
+    V c[4];
+    const V f = loadNodes(position, table.nodes, c);
+    V y = Cubic ? c[0] + f * (c[1] + f * (c[2] + f * c[3])) : c[0] + f * c[1];
+
+    if (table.asymptoticTail)
+    {
+        // Capped so inf gets a zero reciprocal from the estimate too
+        const V u = reciprocal(vmin(vmax(t, one), V::splat(static_cast<T>(1.0e30))));
+        const V tail = one - V::splat(static_cast<T>(2.0 / 3.14159265358979323846)) * u
+                                 * (one - u * u * V::splat(static_cast<T>(1.0 / 3.0)));
+        y = select(greaterThan(t, V::splat(static_cast<T>(table.range))), tail, y);
+    }
+
+    // NaN passes through, as it does through the exact curves
+    return select(lessEqual(t, t), copySign(y, x), x);
+}
+
+// Runs fn(V{}, index) over native vectors, then the scalar tail
+template <typename T, typename Fn>
+void forEachVector(int numSamples, Fn&& fn)
+{
+    int i = 0;
+
+#if GUILLOTINE_SIMD_AVX2 || GUILLOTINE_SIMD_SSE2 || GUILLOTINE_SIMD_NEON
+    for (; i + NativeVec<T>::size <= numSamples; i += NativeVec<T>::size)
+        fn(NativeVec<T>::splat(T(0)), i);
+#endif
+
+    for (; i < numSamples; ++i)
+        fn(ScalarVec<T>::splat(T(0)), i);
+}
+
+template <typename T, typename Fn>
+void processBlock(T* data, int numSamples, Fn&& fn)
+{
+    forEachVector<T>(numSamples, [&](auto v, int i)
+    {
+        using V = decltype(v);
+        fn(V::load(data + i)).store(data + i);
+    });
+}
+
+// Peaks at or below this level come out of the curve unchanged (gain 1)
+template <CurveType Curve, typename T>
+T linearThreshold(T ceiling, const CurveParams& params)
+{
+    if constexpr (Curve == CurveType::Hard)
+        return ceiling;
+    else if constexpr (Curve == CurveType::Knee)
+        return ceiling * params.knee.start;
+    else if constexpr (Curve == CurveType::T2)
+        return (params.exponent == 1.0f) ? ceiling : T(0);
+    else
+        return T(0);  // only silence is left untouched
+}
+
+template <CurveType Curve, typename T>
+void applyCurveBlock(T* data, int numSamples, T ceiling, const CurveParams& params, const CurveTable* table)
+{
+    if (numSamples <= 0)
+        return;
+
+    if (ceiling <= T(0))
+    {
+        std::fill(data, data + numSamples, T(0));
+        return;
+    }
+
+    const T invCeiling = T(1) / ceiling;
+
+    // Normalize to the unit curve, shape, scale back to ceiling
+    auto withCeiling = [&](auto&& curve)
+    {
+        processBlock(data, numSamples, [&](auto x)
+        {
+            using V = decltype(x);
+            return curve(x * V::splat(invCeiling)) * V::splat(ceiling);
+        });
+    };
+
+    if (table != nullptr && table->matches(Curve, params.exponent))
+    {
+        const TableView view { table->getNodes(), static_cast<float>(table->getSize()), table->getScale(),
+                               table->getRange(), table->hasAsymptoticTail() };
+
+        if (table->getPrecision().interpolation == CurveTable::Interpolation::Hermite)
+            withCeiling([view](auto x) { return tableCurve<true>(x, view); });
+        else
+            withCeiling([view](auto x) { return tableCurve<false>(x, view); });
+        return;
+    }
+
+    if constexpr (Curve == CurveType::Quintic)
+    {
+        withCeiling([](auto x) { return polynomialClip(x, 1.25f, 256.0 / 3125.0, 5); });
+    }
+    else if constexpr (Curve == CurveType::Cubic)
+    {
+        withCeiling([](auto x) { return polynomialClip(x, 1.5f, 4.0 / 27.0, 3); });
+    }
+    else if constexpr (Curve == CurveType::Tanh)
+    {
+        withCeiling([](auto x) { return fastTanh(x); });
+    }
+    else if constexpr (Curve == CurveType::Arctan)
+    {
+        withCeiling([](auto x)
+        {
+            using V = decltype(x);
+            return fastAtan(x) * V::splat(2.0f / PI);
+        });
+    }
+    else if constexpr (Curve == CurveType::Knee)
+    {
+        const double start = params.knee.start;
+        const double invKneeWidth = params.invKneeWidth;
+        withCeiling([=](auto x) { return kneeCurve(x, start, invKneeWidth); });
+    }
+    else if constexpr (Curve == CurveType::T2)
+    {
+        const float exponent = params.exponent;
+        withCeiling([=](auto x) { return fastTsquared(x, exponent); });
+    }
+    else
+    {
+        // Clamp directly in the ceiling domain - no normalization needed
+        processBlock(data, numSamples, [=](auto x) { return clampSymmetric(x, ceiling); });
+    }
+}
+
+template <CurveType Curve, typename T>
+void applyLinkedCurveBlock(T* const* channels, int numChannels, int numSamples, T ceiling,
+                           const CurveParams& params, const CurveTable* table)
+{
+    if (numChannels <= 0 || numSamples <= 0)
+        return;
+
+    if (ceiling <= T(0))
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::fill(channels[ch], channels[ch] + numSamples, T(0));
+        return;
+    }
+
+    // Below this the reciprocal would overflow - the curve is linear there anyway
+    constexpr T kMinPeak = T(1.0e-30);
+    constexpr int kChunkSize = 64;
+
+    const T skipThreshold = linearThreshold<Curve>(ceiling, params);
+
+    alignas(32) T peaks[kChunkSize];
+    alignas(32) T gains[kChunkSize];
+
+    for (int start = 0; start < numSamples; start += kChunkSize)
+    {
+        const int n = std::min(kChunkSize, numSamples - start);
+        T chunkPeak = T(0);
+
+        // Max |x| across channels - vmax(candidate, peak) keeps peak on NaN input
+        forEachVector<T>(n, [&](auto v, int i)
+        {
+            using V = decltype(v);
+            V peak = V::splat(T(0));
+            for (int ch = 0; ch < numChannels; ++ch)
+                peak = vmax(vabs(V::load(channels[ch] + start + i)), peak);
+
+            peak.store(peaks + i);
+            chunkPeak = std::max(chunkPeak, horizontalMax(peak));
+        });
+
+        // Whole chunk sits in the curve's linear region: every gain would be 1
+        if (chunkPeak <= skipThreshold)
+            continue;
+
+        std::copy(peaks, peaks + n, gains);
+        applyCurveBlock<Curve>(gains, n, ceiling, params, table);
+
+        forEachVector<T>(n, [&](auto v, int i)
+        {
+            using V = decltype(v);
+            const V peak = V::load(peaks + i);
+            const V minPeak = V::splat(kMinPeak);
+            const V ratio = vabs(V::load(gains + i)) * reciprocal(vmax(peak, minPeak));
+            const V gain = select(greaterThan(peak, minPeak), ratio, V::splat(T(1)));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                T* data = channels[ch] + start + i;
+                (V::load(data) * gain).store(data);
+            }
+        });
+    }
+}
+
+// Runtime curve: one switch per call into the compile-time kernels
+template <typename Fn>
+void withCurve(CurveType type, Fn&& fn)
+{
+    switch (type)
+    {
+        case CurveType::Quintic: fn(std::integral_constant<CurveType, CurveType::Quintic>{}); break;
+        case CurveType::Cubic:   fn(std::integral_constant<CurveType, CurveType::Cubic>{}); break;
+        case CurveType::Tanh:    fn(std::integral_constant<CurveType, CurveType::Tanh>{}); break;
+        case CurveType::Arctan:  fn(std::integral_constant<CurveType, CurveType::Arctan>{}); break;
+        case CurveType::Knee:    fn(std::integral_constant<CurveType, CurveType::Knee>{}); break;
+        case CurveType::T2:      fn(std::integral_constant<CurveType, CurveType::T2>{}); break;
+        case CurveType::Hard:
+        default:                 fn(std::integral_constant<CurveType, CurveType::Hard>{}); break;
+    }
+}
+
+template <typename T>
+void applyBlockImpl(CurveType type, T* data, int numSamples, T ceiling, float exponent, const CurveTable* table)
+{
+    const auto params = makeCurveParams(exponent);
+    withCurve(type, [&](auto curve)
+    {
+        applyCurveBlock<decltype(curve)::value>(data, numSamples, ceiling, params, table);
+    });
+}
+
+template <typename T>
+void applyLinkedBlockImpl(CurveType type, T* const* channels, int numChannels, int numSamples,
+                          T ceiling, float exponent, const CurveTable* table)
+{
+    const auto params = makeCurveParams(exponent);
+    withCurve(type, [&](auto curve)
+    {
+        applyLinkedCurveBlock<decltype(curve)::value>(channels, numChannels, numSamples, ceiling, params, table);
+    });
+}
+
+} // namespace
+
+void applyBlock(CurveType type, float* data, int numSamples, float ceiling, float exponent, const CurveTable* table)
+{
+    applyBlockImpl(type, data, numSamples, ceiling, exponent, table);
+}
+
+void applyBlock(CurveType type, double* data, int numSamples, double ceiling, float exponent, const CurveTable* table)
+{
+    applyBlockImpl(type, data, numSamples, ceiling, exponent, table);
+}
+
+void applyLinkedBlock(CurveType type, float* const* channels, int numChannels, int numSamples,
+                      float ceiling, float exponent, const CurveTable* table)
+{
+    applyLinkedBlockImpl(type, channels, numChannels, numSamples, ceiling, exponent, table);
+}
+
+void applyLinkedBlock(CurveType type, double* const* channels, int numChannels, int numSamples,
+                      double ceiling, float exponent, const CurveTable* table)
+{
+    applyLinkedBlockImpl(type, channels, numChannels, numSamples, ceiling, exponent, table);
+}
+
+template <CurveType Curve, typename T>
+void applyBlock(T* data, int numSamples, T ceiling, const CurveParams& params, const CurveTable* table)
+{
+    applyCurveBlock<Curve>(data, numSamples, ceiling, params, table);
+}
+
+template <CurveType Curve, typename T>
+void applyLinkedBlock(T* const* channels, int numChannels, int numSamples, T ceiling, const CurveParams& params,
+                      const CurveTable* table)
+{
+    applyLinkedCurveBlock<Curve>(channels, numChannels, numSamples, ceiling, params, table);
+}
+
+#define GUILLOTINE_INSTANTIATE_CURVE_KERNELS(Curve, T)                                                          \
+    template void applyBlock<Curve, T>(T*, int, T, const CurveParams&, const CurveTable*);                       \
+    template void applyLinkedBlock<Curve, T>(T* const*, int, int, T, const CurveParams&, const CurveTable*);
+
+#define GUILLOTINE_INSTANTIATE_CURVE(Curve)                  \
+    GUILLOTINE_INSTANTIATE_CURVE_KERNELS(Curve, float)       \
+    GUILLOTINE_INSTANTIATE_CURVE_KERNELS(Curve, double)
+
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Hard)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Quintic)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Cubic)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Tanh)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Arctan)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::Knee)
+GUILLOTINE_INSTANTIATE_CURVE(CurveType::T2)
+
+#undef GUILLOTINE_INSTANTIATE_CURVE
+#undef GUILLOTINE_INSTANTIATE_CURVE_KERNELS
+
+} // namespace curves
+} // namespace dsp
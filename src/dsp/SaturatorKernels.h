@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SaturatorCurves.h"
+
+namespace dsp {
+
+class CurveTable;
+
+namespace curves {
+
+// Block-level curve evaluation, equivalent to calling applyWithCeiling() on every
+// sample. The curve is selected once per block and the inner loop runs on SIMD
+// registers (AVX2 / SSE2 / NEON, scalar for the tail).
+// Tanh, Arctan and T2 use polynomial/rational approximations instead of
+// std::tanh/std::atan/std::pow - max deviation is ~1e-6 of ceiling.
+// Double blocks run on double registers (half the lanes) with the same
+// approximations, so they share that bound; the exact curves are exact in both.
+// A table built for this curve and exponent replaces the approximation
+// (CurveTable; any other table is ignored).
+void applyBlock(CurveType type, float* data, int numSamples, float ceiling, float exponent = 2.0f,
+                const CurveTable* table = nullptr);
+void applyBlock(CurveType type, double* data, int numSamples, double ceiling, float exponent = 2.0f,
+                const CurveTable* table = nullptr);
+
+// Stereo-linked block evaluation: every sample frame gets the gain the curve would
+// apply to the loudest channel (|curve(peak)| / peak), so the image doesn't shift.
+// Runs of frames inside the curve's linear region (Hard, Knee below kneeStart)
+// are skipped without touching the data.
+void applyLinkedBlock(CurveType type, float* const* channels, int numChannels, int numSamples,
+                      float ceiling, float exponent = 2.0f, const CurveTable* table = nullptr);
+void applyLinkedBlock(CurveType type, double* const* channels, int numChannels, int numSamples,
+                      double ceiling, float exponent = 2.0f, const CurveTable* table = nullptr);
+
+// Curve settings as the kernels use them, derived from the exponent once
+// instead of on every block - keep one next to the exponent it came from
+struct CurveParams
+{
+    float exponent = 2.0f;
+    KneeParams knee = makeKneeParams(2.0f);
+    double invKneeWidth = 1.0 / makeKneeParams(2.0f).width;
+};
+
+inline CurveParams makeCurveParams(float exponent)
+{
+    CurveParams params;
+    params.exponent = exponent;
+    params.knee = makeKneeParams(exponent);
+    params.invKneeWidth = (params.knee.width > 0.0f) ? 1.0 / params.knee.width : 0.0;
+    return params;
+}
+
+// The same kernels with the curve fixed at compile time, for loops already
+// specialized per curve (BasicClipper): no curve switch or parameter setup per
+// call. Instantiated for every CurveType, float and double
+template <CurveType Curve, typename T>
+void applyBlock(T* data, int numSamples, T ceiling, const CurveParams& params, const CurveTable* table = nullptr);
+
+template <CurveType Curve, typename T>
+void applyLinkedBlock(T* const* channels, int numChannels, int numSamples, T ceiling, const CurveParams& params,
+                      const CurveTable* table = nullptr);
+
+} // namespace curves
+} // namespace dsp
@@ -0,0 +1,137 @@
+#include "StageProfiler.h"
+
+#include <algorithm>
+
+namespace dsp {
+
+const char* getStageName(ProcessStage stage)
+{
+    switch (stage)
+    {
+        case ProcessStage::InputGain:  return "input gain";
+        case ProcessStage::Encode:     return "encode";
+        case ProcessStage::Upsample:   return "upsample";
+        case ProcessStage::Clip:       return "clip";
+        case ProcessStage::Downsample: return "downsample";
+        case ProcessStage::Post:       return "post";
+        case ProcessStage::NumStages:  break;
+    }
+    return "";
+}
+
+double ProcessTimings::getAverageMicroseconds(const Stage& stage) const
+{
+    if (blocks == 0)
+        return 0.0;
+    return static_cast<double>(stage.totalNanoseconds) / (1000.0 * static_cast<double>(blocks));
+}
+
+float ProcessTimings::getLoadPercent() const
+{
+    if (budgetNanoseconds == 0)
+        return 0.0f;
+    return 100.0f * static_cast<float>(static_cast<double>(block.totalNanoseconds)
+                                       / static_cast<double>(budgetNanoseconds));
+}
+
+#if GUILLOTINE_PROFILE_STAGES
+
+namespace {
+
+// CAS so a collect() resetting the max in between can't hide this block's value
+template <typename T>
+void publishMax(std::atomic<T>& target, T value)
+{
+    T current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+void StageProfiler::StageTotals::publish(std::uint64_t nanoseconds)
+{
+    totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    publishMax(maxNanoseconds, nanoseconds);
+}
+
+ProcessTimings::Stage StageProfiler::StageTotals::collect()
+{
+    ProcessTimings::Stage stage;
+    stage.totalNanoseconds = totalNanoseconds.exchange(0, std::memory_order_relaxed);
+    stage.maxNanoseconds = maxNanoseconds.exchange(0, std::memory_order_relaxed);
+    return stage;
+}
+
+void StageProfiler::StageTotals::reset()
+{
+    totalNanoseconds.store(0, std::memory_order_relaxed);
+    maxNanoseconds.store(0, std::memory_order_relaxed);
+}
+
+StageProfiler::StageProfiler()
+{
+    reset();
+}
+
+void StageProfiler::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+}
+
+void StageProfiler::beginBlock()
+{
+    blockStages.fill(Clock::duration::zero());
+    blockStart = Clock::now();
+}
+
+void StageProfiler::finishBlock(int numSamples)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    const auto toNanoseconds = [](Clock::duration d)
+    { return static_cast<std::uint64_t>(std::max<std::int64_t>(0, duration_cast<nanoseconds>(d).count())); };
+
+    const std::uint64_t blockNanoseconds = toNanoseconds(Clock::now() - blockStart);
+    const std::uint64_t budget = static_cast<std::uint64_t>(1.0e9 * static_cast<double>(numSamples) / sampleRate);
+
+    for (size_t i = 0; i < stages.size(); ++i)
+        stages[i].publish(toNanoseconds(blockStages[i]));
+
+    block.publish(blockNanoseconds);
+    budgetNanoseconds.fetch_add(budget, std::memory_order_relaxed);
+    if (budget > 0)
+        publishMax(maxLoadPercent, 100.0f * static_cast<float>(static_cast<double>(blockNanoseconds)
+                                                               / static_cast<double>(budget)));
+    blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+ProcessTimings StageProfiler::collect()
+{
+    ProcessTimings timings;
+    for (size_t i = 0; i < stages.size(); ++i)
+        timings.stages[i] = stages[i].collect();
+
+    timings.block = block.collect();
+    timings.budgetNanoseconds = budgetNanoseconds.exchange(0, std::memory_order_relaxed);
+    timings.maxLoadPercent = maxLoadPercent.exchange(0.0f, std::memory_order_relaxed);
+    timings.blocks = blocks.exchange(0, std::memory_order_relaxed);
+    return timings;
+}
+
+void StageProfiler::reset()
+{
+    for (auto& stage : stages)
+        stage.reset();
+
+    block.reset();
+    budgetNanoseconds.store(0, std::memory_order_relaxed);
+    maxLoadPercent.store(0.0f, std::memory_order_relaxed);
+    blocks.store(0, std::memory_order_relaxed);
+}
+
+#endif
+
+} // namespace dsp
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Per-stage timing of ClipperEngine::process. Off unless the build defines
+// GUILLOTINE_PROFILE_STAGES=1 (CMake option of the same name); when off every
+// StageProfiler member is an empty inline and the engine carries no timing code.
+#ifndef GUILLOTINE_PROFILE_STAGES
+ #define GUILLOTINE_PROFILE_STAGES 0
+#endif
+
+#if GUILLOTINE_PROFILE_STAGES
+ #include <chrono>
+#endif
+
+namespace dsp {
+
+// Stages of ClipperEngine::process, in signal order
+enum class ProcessStage
+{
+    InputGain,   // Input gain and pre-clip peak
+    Encode,      // M/S encode
+    Upsample,
+    Clip,        // Clipper, ceiling ramp and delta monitor, at the clip rate
+    Downsample,
+    Post,        // Auto oversampling bypass, crossfades, M/S decode, limiter,
+                 // ceiling and output gain
+    NumStages
+};
+
+const char* getStageName(ProcessStage stage);
+
+// Timings over one or more blocks. Wall-clock time on the processing thread:
+// partitions on worker threads count once, for as long as the caller waits
+struct ProcessTimings
+{
+    static constexpr int kNumStages = static_cast<int>(ProcessStage::NumStages);
+
+    struct Stage
+    {
+        std::uint64_t totalNanoseconds = 0;
+        std::uint64_t maxNanoseconds = 0;    // Slowest single block
+    };
+
+    std::array<Stage, kNumStages> stages {};
+    Stage block;                             // The whole process() call, stages and all
+    std::uint64_t budgetNanoseconds = 0;     // Real-time length of the audio processed
+    float maxLoadPercent = 0.0f;             // Slowest block against its own length
+    std::uint64_t blocks = 0;
+
+    const Stage& operator[](ProcessStage stage) const { return stages[static_cast<size_t>(stage)]; }
+
+    // Mean per block
+    double getAverageMicroseconds(const Stage& stage) const;
+
+    // Processing time against the real-time length of the audio (DSP load)
+    float getLoadPercent() const;
+};
+
+// Times the stages of each block and publishes once per block. Reads are
+// lock-free, as with ClipMeter: a single reader collects everything published
+// since its last collect (window averages, per-block maxima), and a collect
+// racing a publish can split one block between two reads.
+class StageProfiler
+{
+public:
+    static constexpr bool enabled = GUILLOTINE_PROFILE_STAGES != 0;
+
+#if GUILLOTINE_PROFILE_STAGES
+    StageProfiler();
+
+    // Audio thread
+    void prepare(double sampleRate);
+    void beginBlock();
+    void finishBlock(int numSamples);
+
+    // Adds the time until it goes out of scope to the stage, or until enter()
+    // moves it on to the next one. A nested scope pauses the enclosing one, so
+    // each stage gets only its own time. A stage can be timed several times per
+    // block (event segments, crossfades)
+    class Scope
+    {
+    public:
+        Scope(StageProfiler& owner, ProcessStage timedStage) noexcept;
+        ~Scope() noexcept;
+
+        void enter(ProcessStage nextStage) noexcept;
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StageProfiler& profiler;
+        Scope* const parent;
+        ProcessStage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // Reader: returns and clears the accumulated timings
+    ProcessTimings collect();
+
+    // Only while neither side is active
+    void reset();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void addTime(ProcessStage stage, Clock::duration elapsed) noexcept
+    {
+        blockStages[static_cast<size_t>(stage)] += elapsed;
+    }
+
+    struct StageTotals
+    {
+        std::atomic<std::uint64_t> totalNanoseconds { 0 };
+        std::atomic<std::uint64_t> maxNanoseconds { 0 };
+
+        void publish(std::uint64_t nanoseconds);
+        ProcessTimings::Stage collect();
+        void reset();
+    };
+
+    // This block so far (audio thread only)
+    std::array<Clock::duration, ProcessTimings::kNumStages> blockStages {};
+    Clock::time_point blockStart;
+    Scope* activeScope = nullptr;
+    double sampleRate = 44100.0;
+
+    std::array<StageTotals, ProcessTimings::kNumStages> stages;
+    StageTotals block;
+    std::atomic<std::uint64_t> budgetNanoseconds { 0 };
+    std::atomic<float> maxLoadPercent { 0.0f };
+    std::atomic<std::uint64_t> blocks { 0 };
+#else
+    void prepare(double) noexcept {}
+    void beginBlock() noexcept {}
+    void finishBlock(int) noexcept {}
+
+    class Scope
+    {
+    public:
+        Scope(StageProfiler&, ProcessStage) noexcept {}
+        void enter(ProcessStage) noexcept {}
+    };
+
+    ProcessTimings collect() noexcept { return {}; }
+    void reset() noexcept {}
+#endif
+};
+
+#if GUILLOTINE_PROFILE_STAGES
+
+inline StageProfiler::Scope::Scope(StageProfiler& owner, ProcessStage timedStage) noexcept
+    : profiler(owner), parent(owner.activeScope), stage(timedStage), start(Clock::now())
+{
+    if (parent != nullptr)
+        profiler.addTime(parent->stage, start - parent->start);
+    profiler.activeScope = this;
+}
+
+inline StageProfiler::Scope::~Scope() noexcept
+{
+    const auto now = Clock::now();
+    profiler.addTime(stage, now - start);
+    profiler.activeScope = parent;
+    if (parent != nullptr)
+        parent->start = now;
+}
+
+inline void StageProfiler::Scope::enter(ProcessStage nextStage) noexcept
+{
+    const auto now = Clock::now();
+    profiler.addTime(stage, now - start);
+    stage = nextStage;
+    start = now;
+}
+
+#endif
+
+} // namespace dsp
@@ -1,44 +1,107 @@
 #include "StereoProcessor.h"
 
+#include <algorithm>
+
 namespace dsp {
 
+StereoProcessor::StereoProcessor()
+{
+    setChannelPairs({ { 0, 1 } });
+}
+
 void StereoProcessor::setMidSideMode(bool enabled)
 {
     midSideEnabled = enabled;
 }
 
-void StereoProcessor::encodeToMidSide(juce::AudioBuffer<float>& buffer)
+void StereoProcessor::setChannelPairs(const std::vector<ChannelPair>& pairs)
 {
-    if (!midSideEnabled || buffer.getNumChannels() < 2)
-        return;
+    channelPairs = pairs;
 
-    float* left = buffer.getWritePointer(0);
-    float* right = buffer.getWritePointer(1);
+    int highestChannel = -1;
+    for (const auto& [left, right] : channelPairs)
+        highestChannel = std::max({ highestChannel, left, right });
 
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    partners.assign(static_cast<size_t>(highestChannel + 1), -1);
+    for (const auto& [left, right] : channelPairs)
     {
-        float l = left[i];
-        float r = right[i];
-        left[i] = (l + r) * 0.5f;   // mid
-        right[i] = (l - r) * 0.5f;  // side
+        jassert(left >= 0 && right >= 0 && left != right);
+        jassert(partners[static_cast<size_t>(left)] < 0 && partners[static_cast<size_t>(right)] < 0);
+        partners[static_cast<size_t>(left)] = right;
+        partners[static_cast<size_t>(right)] = left;
     }
 }
 
-void StereoProcessor::decodeFromMidSide(juce::AudioBuffer<float>& buffer)
+bool StereoProcessor::isMidSideActive(int numChannels) const
 {
-    if (!midSideEnabled || buffer.getNumChannels() < 2)
+    if (!midSideEnabled)
+        return false;
+
+    return std::any_of(channelPairs.begin(), channelPairs.end(), [numChannels](const ChannelPair& pair)
+    {
+        return std::max(pair.first, pair.second) < numChannels;
+    });
+}
+
+template <typename SampleType>
+void StereoProcessor::encodeToMidSide(juce::AudioBuffer<SampleType>& buffer)
+{
+    if (!midSideEnabled)
         return;
 
-    float* mid = buffer.getWritePointer(0);
-    float* side = buffer.getWritePointer(1);
+    const int numChannels = buffer.getNumChannels();
+    for (const auto& [leftChannel, rightChannel] : channelPairs)
+    {
+        if (std::max(leftChannel, rightChannel) >= numChannels)
+            continue;
+
+        SampleType* left = buffer.getWritePointer(leftChannel);
+        SampleType* right = buffer.getWritePointer(rightChannel);
 
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            SampleType l = left[i];
+            SampleType r = right[i];
+            left[i] = (l + r) * SampleType(0.5);   // mid
+            right[i] = (l - r) * SampleType(0.5);  // side
+        }
+    }
+}
+
+template <typename SampleType>
+void StereoProcessor::decodeFromMidSide(juce::AudioBuffer<SampleType>& buffer)
+{
+    if (!midSideEnabled)
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    for (const auto& [leftChannel, rightChannel] : channelPairs)
+    {
+        if (std::max(leftChannel, rightChannel) >= numChannels)
+            continue;
+
+        decodeFromMidSide(buffer.getWritePointer(leftChannel), buffer.getWritePointer(rightChannel),
+                          buffer.getNumSamples());
+    }
+}
+
+template <typename SampleType>
+void StereoProcessor::decodeFromMidSide(SampleType* mid, SampleType* side, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
     {
-        float m = mid[i];
-        float s = side[i];
+        SampleType m = mid[i];
+        SampleType s = side[i];
         mid[i] = m + s;   // left
         side[i] = m - s;  // right
     }
 }
 
+template void StereoProcessor::encodeToMidSide(juce::AudioBuffer<float>&);
+template void StereoProcessor::encodeToMidSide(juce::AudioBuffer<double>&);
+template void StereoProcessor::decodeFromMidSide(juce::AudioBuffer<float>&);
+template void StereoProcessor::decodeFromMidSide(juce::AudioBuffer<double>&);
+template void StereoProcessor::decodeFromMidSide(float*, float*, int);
+template void StereoProcessor::decodeFromMidSide(double*, double*, int);
+
 } // namespace dsp
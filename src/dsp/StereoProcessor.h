@@ -2,24 +2,57 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 
+#include <utility>
+#include <vector>
+
 namespace dsp {
 
+// Mid/side conversion on one or more (left, right) channel pairs - the front
+// pair by default, every speaker pair for a surround layout (see ChannelLayout).
+// Channels outside every pair pass through untouched.
 class StereoProcessor
 {
 public:
-    StereoProcessor() = default;
+    using ChannelPair = std::pair<int, int>;
+
+    StereoProcessor();
 
     void setMidSideMode(bool enabled);
     bool isMidSideMode() const { return midSideEnabled; }
 
-    // Call before processing to convert L/R to M/S
-    void encodeToMidSide(juce::AudioBuffer<float>& buffer);
+    // Allocates - call from prepare, not the audio thread. Pairs must not share channels
+    void setChannelPairs(const std::vector<ChannelPair>& pairs);
+    const std::vector<ChannelPair>& getChannelPairs() const { return channelPairs; }
+
+    // Whether M/S is on and at least one pair fits in numChannels
+    bool isMidSideActive(int numChannels) const;
+
+    // Channel is the left or right of a pair that fits in numChannels
+    bool isPairedChannel(int channel, int numChannels) const
+    {
+        if (channel < 0 || channel >= numChannels || channel >= static_cast<int>(partners.size()))
+            return false;
+
+        const int partner = partners[static_cast<size_t>(channel)];
+        return partner >= 0 && partner < numChannels;
+    }
+
+    // Call before processing to convert L/R to M/S (float or double buffers)
+    template <typename SampleType>
+    void encodeToMidSide(juce::AudioBuffer<SampleType>& buffer);
 
     // Call after processing to convert M/S back to L/R
-    void decodeFromMidSide(juce::AudioBuffer<float>& buffer);
+    template <typename SampleType>
+    void decodeFromMidSide(juce::AudioBuffer<SampleType>& buffer);
+
+    // In-place M/S -> L/R on raw channel data (ignores the mode flag)
+    template <typename SampleType>
+    static void decodeFromMidSide(SampleType* mid, SampleType* side, int numSamples);
 
 private:
     bool midSideEnabled = false;
+    std::vector<ChannelPair> channelPairs;
+    std::vector<int> partners;  // Other channel of the pair, -1 if unpaired
 };
 
 } // namespace dsp
@@ -0,0 +1,217 @@
+#include "TruePeakLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+
+namespace {
+
+constexpr double kLookaheadSeconds = 0.001;  // 1ms attack ramp
+constexpr double kReleaseSeconds = 0.02;     // 20ms return to unity
+constexpr int kMinLookahead = 8;
+constexpr int kMaxLookahead = 256;
+constexpr double kKaiserBeta = 5.0;
+
+// Target between the two centre taps of the detector history
+constexpr int kDetectorDelay = TruePeakLimiter::kTapsPerPhase / 2;
+
+// Zeroth-order modified Bessel function (power series)
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = 0.5 * x;
+
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < 1e-12 * sum)
+            break;
+    }
+    return sum;
+}
+
+} // namespace
+
+template <typename SampleType>
+void BasicTruePeakLimiter<SampleType>::prepare(double sampleRate, int channels)
+{
+    numChannels = channels;
+    numRegisters = (channels + channelsPerRegister - 1) / channelsPerRegister;
+    lookahead = std::clamp(static_cast<int>(std::round(sampleRate * kLookaheadSeconds)), kMinLookahead, kMaxLookahead);
+
+    // Sample x[n - D] is output once the averaged gain covers it: D + lookahead - 1
+    latency = kDetectorDelay + lookahead - 1;
+    releaseCoefficient = static_cast<float>(1.0 - std::exp(-1.0 / (kReleaseSeconds * sampleRate)));
+
+    // Phase p estimates x at (n - D + p / 4) from x[n - j], j = 0..11
+    const double halfLength = static_cast<double>(kTapsPerPhase) / 2.0;
+    const double windowNorm = besselI0(kKaiserBeta);
+
+    for (int p = 1; p < kNumPhases; ++p)
+    {
+        auto& phase = phaseCoefficients[static_cast<size_t>(p - 1)];
+        double sum = 0.0;
+
+        for (int j = 0; j < kTapsPerPhase; ++j)
+        {
+            const double t = j - kDetectorDelay + static_cast<double>(p) / kNumPhases;
+            const double sinc = std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+            const double ratio = t / halfLength;
+            const double window = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / windowNorm;
+
+            phase[static_cast<size_t>(j)] = static_cast<SampleType>(sinc * window);
+            sum += sinc * window;
+        }
+
+        // Unity DC gain per phase
+        for (auto& c : phase)
+            c = static_cast<SampleType>(c / sum);
+    }
+
+    history.assign(static_cast<size_t>(numRegisters * 2 * kTapsPerPhase), Vec::expand(SampleType(0)));
+    delayLines.assign(static_cast<size_t>(numChannels * latency), SampleType(0));
+
+    minQueueGains.assign(static_cast<size_t>(lookahead + 2), 1.0f);
+    minQueueExpiry.assign(static_cast<size_t>(lookahead + 2), 0);
+    averageBuffer.assign(static_cast<size_t>(lookahead), 1.0f);
+
+    reset();
+}
+
+template <typename SampleType>
+void BasicTruePeakLimiter<SampleType>::reset()
+{
+    std::fill(history.begin(), history.end(), Vec::expand(SampleType(0)));
+    std::fill(delayLines.begin(), delayLines.end(), SampleType(0));
+    std::fill(averageBuffer.begin(), averageBuffer.end(), 1.0f);
+    historyPos = 0;
+    delayPos = 0;
+    minQueueHead = 0;
+    minQueueSize = 0;
+    sampleCounter = 0;
+    averageSum = static_cast<double>(lookahead);
+    averagePos = 0;
+    releaseGain = 1.0f;
+}
+
+template <typename SampleType>
+void BasicTruePeakLimiter<SampleType>::setCeiling(float linearAmplitude)
+{
+    ceiling = linearAmplitude;
+}
+
+template <typename SampleType>
+float BasicTruePeakLimiter<SampleType>::pushRequiredGain(float gain)
+{
+    // Running minimum over the last lookahead + 1 values: a peak between two
+    // samples must hold for both of them
+    const int capacity = static_cast<int>(minQueueGains.size());
+    const int holdLength = lookahead + 1;
+
+    while (minQueueSize > 0)
+    {
+        const int back = (minQueueHead + minQueueSize - 1) % capacity;
+        if (minQueueGains[static_cast<size_t>(back)] < gain)
+            break;
+        --minQueueSize;
+    }
+
+    const int slot = (minQueueHead + minQueueSize) % capacity;
+    minQueueGains[static_cast<size_t>(slot)] = gain;
+    minQueueExpiry[static_cast<size_t>(slot)] = sampleCounter + holdLength;
+    ++minQueueSize;
+
+    while (minQueueExpiry[static_cast<size_t>(minQueueHead)] <= sampleCounter)
+    {
+        minQueueHead = (minQueueHead + 1) % capacity;
+        --minQueueSize;
+    }
+
+    ++sampleCounter;
+    return minQueueGains[static_cast<size_t>(minQueueHead)];
+}
+
+template <typename SampleType>
+void BasicTruePeakLimiter<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block, const float* ceilings)
+{
+    jassert(static_cast<int>(block.getNumChannels()) == numChannels);
+
+    const int channels = std::min(numChannels, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const double invLookahead = 1.0 / static_cast<double>(lookahead);
+
+    // Unused lanes (channel counts that don't fill the last register) stay at zero
+    alignas(sizeof(Vec)) SampleType lanes[channelsPerRegister] = {};
+    alignas(sizeof(Vec)) SampleType peakLanes[channelsPerRegister];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        historyPos = (historyPos == 0) ? kTapsPerPhase - 1 : historyPos - 1;
+
+        // True-peak estimate around x[n - D], loudest channel
+        SampleType peak = 0;
+        for (int reg = 0; reg < numRegisters; ++reg)
+        {
+            const int firstChannel = reg * channelsPerRegister;
+            const int channelsInReg = std::min(channelsPerRegister, channels - firstChannel);
+
+            for (int c = 0; c < channelsInReg; ++c)
+                lanes[c] = block.getChannelPointer(static_cast<size_t>(firstChannel + c))[i];
+
+            Vec* registerHistory = history.data() + reg * 2 * kTapsPerPhase;
+            const Vec x = Vec::fromRawArray(lanes);
+            registerHistory[historyPos] = x;
+            registerHistory[historyPos + kTapsPerPhase] = x;
+
+            // Newest first: taps[j] = x[n - j]
+            const Vec* taps = registerHistory + historyPos;
+            Vec channelPeaks = Vec::abs(taps[kDetectorDelay]);
+
+            for (const auto& phase : phaseCoefficients)
+            {
+                Vec interpolated = Vec::expand(SampleType(0));
+                for (int j = 0; j < kTapsPerPhase; ++j)
+                    interpolated += taps[j] * phase[static_cast<size_t>(j)];
+                channelPeaks = Vec::max(channelPeaks, Vec::abs(interpolated));
+            }
+
+            // Horizontal max in scalar code: std::max keeps the running peak when
+            // a lane is NaN
+            channelPeaks.copyToRawArray(peakLanes);
+            for (int c = 0; c < channelsInReg; ++c)
+                peak = std::max(peak, peakLanes[c]);
+        }
+
+        const float target = (ceilings != nullptr) ? ceilings[i] : ceiling;
+        const float required = (peak > target) ? static_cast<float>(target / peak) : 1.0f;
+        const float held = pushRequiredGain(required);
+
+        // Moving average of the held gain ramps down over exactly the lookahead
+        averageSum += static_cast<double>(held) - averageBuffer[static_cast<size_t>(averagePos)];
+        averageBuffer[static_cast<size_t>(averagePos)] = held;
+        averagePos = (averagePos + 1 == lookahead) ? 0 : averagePos + 1;
+        const float averaged = std::min(1.0f, static_cast<float>(averageSum * invLookahead));
+
+        // Attack follows the average immediately, release eases back to unity
+        releaseGain = (averaged < releaseGain) ? averaged
+                                               : releaseGain + releaseCoefficient * (averaged - releaseGain);
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            SampleType* data = block.getChannelPointer(static_cast<size_t>(ch));
+            SampleType& delayed = delayLines[static_cast<size_t>(ch * latency + delayPos)];
+            const SampleType output = delayed * releaseGain;
+            delayed = data[i];
+            data[i] = output;
+        }
+
+        delayPos = (delayPos + 1 == latency) ? 0 : delayPos + 1;
+    }
+}
+
+template class BasicTruePeakLimiter<float>;
+template class BasicTruePeakLimiter<double>;
+
+} // namespace dsp
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace dsp {
+
+// Lookahead limiter that keeps the true (intersample) peak under the ceiling.
+//
+// Detector: 4x polyphase FIR peak estimator (12 taps per phase, Kaiser-windowed
+// sinc, in the spirit of ITU-R BS.1770), linked across channels. Channels run
+// in SIMD lanes - four per SSE/NEON register - so a 7.1.4 bus costs three
+// register passes per sample instead of twelve channel passes.
+// Gain: the required reduction is held for lookahead + 1 samples and smoothed
+// by a lookahead-long moving average, so the gain has fully ramped down by the
+// time a peak leaves the delay line. Release is a one-pole return to unity.
+//
+// The work per sample is fixed (no data-dependent loops beyond the amortized
+// O(1) running minimum), so the cost doesn't depend on the material.
+//
+// SampleType is float or double. The detector and delay line run at the sample
+// width (a double register holds half as many channels); gains stay float.
+template <typename SampleType>
+class BasicTruePeakLimiter
+{
+public:
+    static constexpr int kNumPhases = 4;
+    static constexpr int kTapsPerPhase = 12;
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    void setCeiling(float linearAmplitude);
+
+    // In place; channel count must match prepare(). ceilings, when given, holds
+    // one linear ceiling per sample of the block and overrides setCeiling() -
+    // the engine passes its ramp while the ceiling is automated
+    void process(const juce::dsp::AudioBlock<SampleType>& block, const float* ceilings = nullptr);
+
+    // Detector delay + lookahead
+    int getLatencyInSamples() const { return latency; }
+
+    // Gain applied to the most recent output sample (1 = no reduction)
+    float getCurrentGain() const { return releaseGain; }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    using Phase = std::array<SampleType, kTapsPerPhase>;
+
+    static constexpr int channelsPerRegister = static_cast<int>(Vec::SIMDNumElements);
+
+    // Interpolates the three fractional positions between the two centre taps
+    std::array<Phase, kNumPhases - 1> phaseCoefficients {};
+
+    float ceiling = 1.0f;
+    int numChannels = 0;
+    int numRegisters = 0;
+    int lookahead = 1;
+    int latency = 0;
+    float releaseCoefficient = 0.0f;
+
+    // Per register of channels: detector history (written twice so the newest
+    // kTapsPerPhase samples are always contiguous). Per channel: the audio delay line
+    std::vector<Vec> history;
+    std::vector<SampleType> delayLines;
+    int historyPos = 0;
+    int delayPos = 0;
+
+    // Running minimum of the required gain (monotonic queue over a ring)
+    std::vector<float> minQueueGains;
+    std::vector<std::int64_t> minQueueExpiry;
+    int minQueueHead = 0;
+    int minQueueSize = 0;
+    std::int64_t sampleCounter = 0;
+
+    // Moving average of the held gain
+    std::vector<float> averageBuffer;
+    double averageSum = 0.0;
+    int averagePos = 0;
+
+    float releaseGain = 1.0f;
+
+    float pushRequiredGain(float gain);
+};
+
+using TruePeakLimiter = BasicTruePeakLimiter<float>;
+
+} // namespace dsp
@@ -0,0 +1,107 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace dsp {
+
+namespace {
+
+// Idle workers yield for a few ms after a run (consecutive blocks of a render
+// arrive well within that), then park until the next one
+constexpr int kIdleYields = 4096;
+
+} // namespace
+
+WorkerPool::WorkerPool(int numThreads)
+{
+    workers.reserve(static_cast<size_t>(std::max(numThreads, 0)));
+    for (int i = 0; i < numThreads; ++i)
+        workers.emplace_back([this]() { workerLoop(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        const std::lock_guard<std::mutex> guard(parkLock);
+        quit.store(true, std::memory_order_relaxed);
+    }
+    wakeup.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void WorkerPool::runAvailableTasks()
+{
+    // A successful claim synchronizes with the run that published it, so the
+    // task fields read below belong to that run
+    int unclaimed = unclaimedTasks.load(std::memory_order_relaxed);
+    while (unclaimed > 0)
+    {
+        if (!unclaimedTasks.compare_exchange_weak(unclaimed, unclaimed - 1, std::memory_order_acquire,
+                                                  std::memory_order_relaxed))
+            continue;
+
+        taskFunction(taskContext, taskCount - unclaimed);
+        completedTasks.fetch_add(1, std::memory_order_release);
+        unclaimed = unclaimedTasks.load(std::memory_order_relaxed);
+    }
+}
+
+void WorkerPool::runTasks(int numTasks, TaskFunction function, void* context)
+{
+    if (numTasks <= 0)
+        return;
+
+    // The previous run's tasks have all completed, so no worker reads these
+    taskFunction = function;
+    taskContext = context;
+    taskCount = numTasks;
+    completedTasks.store(0, std::memory_order_relaxed);
+    unclaimedTasks.store(numTasks);
+
+    // Sequentially consistent with the worker's count-then-check: either it
+    // sees the tasks before parking or this sees it parked. The empty lock
+    // waits out one between its check and its wait
+    if (parkedWorkers.load() > 0)
+    {
+        { const std::lock_guard<std::mutex> guard(parkLock); }
+        wakeup.notify_all();
+    }
+
+    runAvailableTasks();
+
+    // Barrier: only tasks still running on a worker hold it up
+    while (completedTasks.load(std::memory_order_acquire) != numTasks)
+        std::this_thread::yield();
+}
+
+void WorkerPool::workerLoop()
+{
+    int idleCount = 0;
+
+    while (!quit.load(std::memory_order_relaxed))
+    {
+        if (unclaimedTasks.load(std::memory_order_relaxed) > 0)
+        {
+            runAvailableTasks();
+            idleCount = 0;
+        }
+        else if (++idleCount < kIdleYields)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> guard(parkLock);
+            parkedWorkers.fetch_add(1);
+            wakeup.wait(guard, [this]()
+            {
+                return unclaimedTasks.load() > 0 || quit.load(std::memory_order_relaxed);
+            });
+            parkedWorkers.fetch_sub(1, std::memory_order_relaxed);
+            idleCount = 0;
+        }
+    }
+}
+
+} // namespace dsp
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dsp {
+
+// Fixed set of worker threads for splitting one block's work into independent
+// tasks (ClipperEngine: channel partitions of the oversampling stages).
+//
+// run() publishes the tasks with a single atomic store of the task count,
+// takes part in them on the calling thread and returns once every task has
+// completed - a per-call barrier that only waits on workers holding a task,
+// not on idle ones still asleep. Tasks are claimed by decrementing that count,
+// so nothing allocates or waits on the OS on the caller's side; it only spins
+// (yielding) until the last task is done.
+//
+// Idle workers yield for a few ms, then park on a condition variable, so a
+// pool left between renders costs nothing. The run() after such a pause wakes
+// them (a brief lock and a notify - the only syscall on the caller's side);
+// back-to-back runs find them still yielding. Threads start in the constructor
+// and join in the destructor - neither belongs on the audio thread.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(int numThreads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int getNumThreads() const { return static_cast<int>(workers.size()); }
+
+    // Calls task(index) once for every index in [0, numTasks), spread over the
+    // workers and the calling thread. One run() at a time
+    template <typename Task>
+    void run(int numTasks, Task& task)
+    {
+        runTasks(numTasks, [](void* context, int index) { (*static_cast<Task*>(context))(index); }, &task);
+    }
+
+private:
+    using TaskFunction = void (*)(void*, int);
+
+    void runTasks(int numTasks, TaskFunction function, void* context);
+    void workerLoop();
+    void runAvailableTasks();
+
+    // Written by run() before the tasks are published. A claimed task keeps
+    // them valid - run() can't return until it has completed
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    int taskCount = 0;
+
+    alignas(64) std::atomic<int> unclaimedTasks { 0 };
+    alignas(64) std::atomic<int> completedTasks { 0 };
+    std::atomic<bool> quit { false };
+
+    // Parked workers, woken by the next run()
+    std::atomic<int> parkedWorkers { 0 };
+    std::mutex parkLock;
+    std::condition_variable wakeup;
+
+    std::vector<std::thread> workers;
+};
+
+} // namespace dsp
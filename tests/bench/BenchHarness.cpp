@@ -0,0 +1,139 @@
+#include "BenchHarness.h"
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double timeIterations(const Benchmark& benchmark, long iterations)
+{
+    const auto start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+        benchmark.body();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+Result measure(const Benchmark& benchmark, const RunOptions& options)
+{
+    // Warm up (caches, branch predictors, filter state), then grow the
+    // iteration count until one repetition takes long enough to time
+    long iterations = 1;
+    double seconds = timeIterations(benchmark, iterations);
+    while (seconds < options.minSecondsPerRep)
+    {
+        iterations = std::max(iterations * 2, static_cast<long>(iterations * options.minSecondsPerRep / std::max(seconds, 1e-9)));
+        seconds = timeIterations(benchmark, iterations);
+    }
+
+    std::vector<double> nsPerSample;
+    for (int rep = 0; rep < options.repetitions; ++rep)
+    {
+        const double repSeconds = timeIterations(benchmark, iterations);
+        const double samples = static_cast<double>(iterations) * benchmark.samplesPerIteration;
+        nsPerSample.push_back(repSeconds * 1e9 / samples);
+    }
+
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+    const double median = nsPerSample[nsPerSample.size() / 2];
+
+    // Realtime multiple: audio seconds processed per CPU second
+    return { benchmark.name, median, 1e9 / (median * benchmark.sampleRate) };
+}
+
+} // namespace
+
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::vector<Result> runAll(const RunOptions& options)
+{
+    std::vector<Result> results;
+
+    std::printf("%-56s %12s %12s\n", "benchmark", "ns/sample", "x realtime");
+    for (const auto& benchmark : registry())
+    {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+
+        const auto result = measure(benchmark, options);
+        std::printf("%-56s %12.2f %12.1f\n", result.name.c_str(), result.nsPerSample, result.realtimeMultiple);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+bool writeJson(const std::vector<Result>& results, const std::string& path)
+{
+    juce::Array<juce::var> entries;
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", juce::String(result.name));
+        entry->setProperty("nsPerSample", result.nsPerSample);
+        entry->setProperty("realtimeMultiple", result.realtimeMultiple);
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("benchmarks", entries);
+
+    const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    return file.replaceWithText(juce::JSON::toString(juce::var(root)));
+}
+
+bool readJson(const std::string& path, std::vector<Result>& results)
+{
+    const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    if (!file.existsAsFile())
+        return false;
+
+    const auto parsed = juce::JSON::parse(file.loadFileAsString());
+    const auto* entries = parsed.getProperty("benchmarks", {}).getArray();
+    if (entries == nullptr)
+        return false;
+
+    for (const auto& entry : *entries)
+    {
+        results.push_back({ entry.getProperty("name", {}).toString().toStdString(),
+                            static_cast<double>(entry.getProperty("nsPerSample", 0.0)),
+                            static_cast<double>(entry.getProperty("realtimeMultiple", 0.0)) });
+    }
+    return true;
+}
+
+int reportRegressions(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance)
+{
+    int regressions = 0;
+
+    for (const auto& result : results)
+    {
+        const auto match = std::find_if(baseline.begin(), baseline.end(),
+                                        [&result](const Result& b) { return b.name == result.name; });
+        if (match == baseline.end() || match->nsPerSample <= 0.0)
+            continue;
+
+        const double ratio = result.nsPerSample / match->nsPerSample;
+        if (ratio > 1.0 + tolerance)
+        {
+            std::printf("REGRESSION %-45s %8.2f -> %8.2f ns/sample (+%.0f%%)\n", result.name.c_str(),
+                        match->nsPerSample, result.nsPerSample, (ratio - 1.0) * 100.0);
+            ++regressions;
+        }
+    }
+
+    return regressions;
+}
+
+} // namespace bench
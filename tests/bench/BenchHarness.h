@@ -0,0 +1,56 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal timing harness for the DSP benchmarks (guillotine_bench).
+//
+// A benchmark is one callable that processes samplesPerIteration sample frames.
+// The harness calibrates the iteration count, times several repetitions and
+// reports the median as ns per sample frame and as a multiple of realtime.
+namespace bench {
+
+struct Benchmark
+{
+    std::string name;
+    int samplesPerIteration = 0;
+    double sampleRate = 44100.0;
+    std::function<void()> body;
+};
+
+struct Result
+{
+    std::string name;
+    double nsPerSample = 0.0;
+    double realtimeMultiple = 0.0;
+};
+
+// Benchmarks register themselves at static-init time through a Registrar
+std::vector<Benchmark>& registry();
+
+struct Registrar
+{
+    explicit Registrar(const std::function<void(std::vector<Benchmark>&)>& registerBenchmarks)
+    {
+        registerBenchmarks(registry());
+    }
+};
+
+struct RunOptions
+{
+    std::string filter;            // Substring match on the name, empty = all
+    double minSecondsPerRep = 0.02;
+    int repetitions = 5;
+};
+
+std::vector<Result> runAll(const RunOptions& options);
+
+// JSON baseline: { "benchmarks": [ { "name", "nsPerSample", "realtimeMultiple" } ] }
+bool writeJson(const std::vector<Result>& results, const std::string& path);
+bool readJson(const std::string& path, std::vector<Result>& results);
+
+// Prints every benchmark slower than baseline * (1 + tolerance), returns their count
+int reportRegressions(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance);
+
+} // namespace bench
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+
+namespace bench {
+
+constexpr double kSampleRate = 44100.0;
+
+// Program-like test signal: a few inharmonic partials peaking around +1.5 dB,
+// slightly different per channel, so the clipper works on most of the block
+template <typename SampleType = float>
+juce::AudioBuffer<SampleType> makeTestSignal(int numChannels, int numSamples)
+{
+    constexpr double pi = 3.14159265358979323846;
+    juce::AudioBuffer<SampleType> buffer(numChannels, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        SampleType* data = buffer.getWritePointer(ch);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = static_cast<double>(i) / kSampleRate;
+            data[i] = static_cast<SampleType>(0.7 * std::sin(2.0 * pi * 110.0 * t + ch)
+                                              + 0.3 * std::sin(2.0 * pi * 1870.0 * t)
+                                              + 0.2 * std::sin(2.0 * pi * 7300.0 * t + 0.5 * ch));
+        }
+    }
+    return buffer;
+}
+
+// Restores the input before each iteration so in-place processing always sees
+// the same material (a memcpy, small next to the DSP being timed)
+template <typename SampleType>
+void restore(juce::AudioBuffer<SampleType>& work, const juce::AudioBuffer<SampleType>& source)
+{
+    for (int ch = 0; ch < work.getNumChannels(); ++ch)
+        work.copyFrom(ch, 0, source, ch, 0, work.getNumSamples());
+}
+
+} // namespace bench
@@ -0,0 +1,94 @@
+#include "BenchHarness.h"
+#include "BenchSignals.h"
+#include "dsp/Clipper.h"
+
+#include <memory>
+
+namespace {
+
+constexpr int kBlockSize = 512;
+constexpr int kNumChannels = 2;
+
+const char* const kCurveNames[] = { "hard", "quintic", "cubic", "tanh", "arctan", "knee", "t2" };
+
+struct ClipperState
+{
+    dsp::Clipper clipper;
+    juce::AudioBuffer<float> source = bench::makeTestSignal(kNumChannels, kBlockSize);
+    juce::AudioBuffer<float> work { kNumChannels, kBlockSize };
+};
+
+void registerClipperBenchmarks(std::vector<bench::Benchmark>& benchmarks)
+{
+    // Clipper::processInternal per curve, independent and stereo-linked
+    for (int curve = 0; curve < dsp::kNumCurveTypes; ++curve)
+    {
+        for (const bool linked : { false, true })
+        {
+            auto state = std::make_shared<ClipperState>();
+            state->clipper.setCurve(static_cast<dsp::CurveType>(curve));
+            state->clipper.setCurveExponent(2.0f);
+            state->clipper.setCeiling(0.7f);
+            state->clipper.setStereoLink(linked);
+
+            benchmarks.push_back({ std::string("clipper/") + kCurveNames[curve] + (linked ? "/linked" : "/independent"),
+                                   kBlockSize, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->clipper.processInternal(state->work.getArrayOfWritePointers(),
+                                                                      kNumChannels, kBlockSize);
+                                   } });
+        }
+
+        // Lookup-table evaluation for the curves that have one, both interpolations
+        if (dsp::CurveTable::isTabulated(static_cast<dsp::CurveType>(curve)))
+        {
+            for (const auto interpolation : { dsp::CurveTable::Interpolation::Hermite,
+                                              dsp::CurveTable::Interpolation::Linear })
+            {
+                auto state = std::make_shared<ClipperState>();
+                state->clipper.setCurve(static_cast<dsp::CurveType>(curve));
+                state->clipper.setCurveExponent(2.0f);
+                state->clipper.setCeiling(0.7f);
+                state->clipper.setCurveTable(true);
+                state->clipper.setCurveTablePrecision({ 2048, interpolation });
+                state->clipper.prepare(kNumChannels);
+
+                const bool hermite = interpolation == dsp::CurveTable::Interpolation::Hermite;
+                benchmarks.push_back({ std::string("clipper/") + kCurveNames[curve] + (hermite ? "/table" : "/table-linear"),
+                                       kBlockSize, bench::kSampleRate,
+                                       [state]()
+                                       {
+                                           bench::restore(state->work, state->source);
+                                           state->clipper.processInternal(state->work.getArrayOfWritePointers(),
+                                                                          kNumChannels, kBlockSize);
+                                       } });
+            }
+        }
+
+        // ADAA at the base rate, each order
+        for (const auto mode : { dsp::Clipper::Antialiasing::Adaa1, dsp::Clipper::Antialiasing::Adaa2 })
+        {
+            auto state = std::make_shared<ClipperState>();
+            state->clipper.setCurve(static_cast<dsp::CurveType>(curve));
+            state->clipper.setCurveExponent(2.0f);
+            state->clipper.setCeiling(0.7f);
+            state->clipper.setAntialiasing(mode);
+
+            const char* order = (mode == dsp::Clipper::Antialiasing::Adaa1) ? "/adaa1" : "/adaa2";
+            benchmarks.push_back({ std::string("clipper/") + kCurveNames[curve] + order,
+                                   kBlockSize, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->clipper.processInternal(state->work.getArrayOfWritePointers(),
+                                                                      kNumChannels, kBlockSize);
+                                   } });
+        }
+    }
+}
+
+const bench::Registrar registrar(registerClipperBenchmarks);
+
+} // namespace
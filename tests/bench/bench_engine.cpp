@@ -0,0 +1,265 @@
+#include "BenchHarness.h"
+#include "BenchSignals.h"
+#include "dsp/ClipperEngine.h"
+
+#include <memory>
+
+namespace {
+
+constexpr int kOversamplingFactor = 2;  // 4x, the plugin default
+
+template <typename SampleType = float>
+struct EngineState
+{
+    dsp::BasicClipperEngine<SampleType> engine;
+    juce::AudioBuffer<SampleType> source;
+    juce::AudioBuffer<SampleType> work;
+};
+
+template <typename SampleType>
+bench::Benchmark makePrecisionBenchmark(const std::string& name, int factorIndex)
+{
+    auto state = std::make_shared<EngineState<SampleType>>();
+    state->engine.prepare(bench::kSampleRate, 512, 2);
+    state->engine.setOversamplingFactor(factorIndex);
+    state->engine.setCeiling(-3.0f);
+    state->engine.setCurve(3);  // Tanh
+    state->engine.setTruePeakMode(true);
+    state->engine.reset();
+    state->source = bench::makeTestSignal<SampleType>(2, 512);
+    state->work.setSize(2, 512);
+
+    return { name, 512, bench::kSampleRate,
+             [state]()
+             {
+                 bench::restore(state->work, state->source);
+                 state->engine.process(state->work);
+             } };
+}
+
+void registerEngineBenchmarks(std::vector<bench::Benchmark>& benchmarks)
+{
+    // Full ClipperEngine::process across block sizes, channel counts and the
+    // delta / M/S / stereo link combinations
+    for (const int blockSize : { 64, 512, 2048 })
+    {
+        for (const int numChannels : { 1, 2 })
+        {
+            for (int flags = 0; flags < 8; ++flags)
+            {
+                const bool delta = (flags & 1) != 0;
+                const bool midSide = (flags & 2) != 0;
+                const bool link = (flags & 4) != 0;
+
+                // M/S and link need two channels
+                if (numChannels == 1 && (midSide || link))
+                    continue;
+
+                auto state = std::make_shared<EngineState<>>();
+                state->engine.prepare(bench::kSampleRate, blockSize, numChannels);
+                state->engine.setOversamplingFactor(kOversamplingFactor);
+                state->engine.setCeiling(-3.0f);
+                state->engine.setCurve(3);  // Tanh
+                state->engine.setDeltaMonitor(delta);
+                state->engine.setChannelMode(midSide);
+                state->engine.setStereoLink(link);
+                state->engine.reset();
+                state->source = bench::makeTestSignal(numChannels, blockSize);
+                state->work.setSize(numChannels, blockSize);
+
+                std::string name = "engine/" + std::to_string(blockSize) + "/" + std::to_string(numChannels) + "ch/";
+                name += delta ? "delta" : "normal";
+                if (midSide)
+                    name += "+ms";
+                if (link)
+                    name += "+link";
+
+                benchmarks.push_back({ name, blockSize, bench::kSampleRate,
+                                       [state]()
+                                       {
+                                           bench::restore(state->work, state->source);
+                                           state->engine.process(state->work);
+                                       } });
+            }
+        }
+    }
+
+    // ADAA at low factors against plain clipping at high ones (polyphase engine)
+    const char* const antialiasingNames[] = { "off", "adaa1", "adaa2" };
+    for (const int factorIndex : { 0, 1, 4 })
+    {
+        for (int antialiasing = 0; antialiasing < 3; ++antialiasing)
+        {
+            auto state = std::make_shared<EngineState<>>();
+            state->engine.prepare(bench::kSampleRate, 512, 2);
+            state->engine.setOversamplingEngine(true);
+            state->engine.setOversamplingFactor(factorIndex);
+            state->engine.setCeiling(-3.0f);
+            state->engine.setCurve(3);  // Tanh
+            state->engine.setAntialiasing(antialiasing);
+            state->engine.reset();
+            state->source = bench::makeTestSignal(2, 512);
+            state->work.setSize(2, 512);
+
+            const std::string name = "engine/antialiasing/" + std::to_string(1 << factorIndex) + "x/"
+                                     + antialiasingNames[antialiasing];
+            benchmarks.push_back({ name, 512, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->engine.process(state->work);
+                                   } });
+        }
+    }
+
+    // Surround buses with their layout's M/S pairs and link groups, sample and
+    // true peak ceiling (the true-peak detector packs channels into SIMD lanes)
+    for (const int numChannels : { 1, 2, 6, 8, 12 })
+    {
+        for (const bool truePeak : { false, true })
+        {
+            auto state = std::make_shared<EngineState<>>();
+            state->engine.prepare(bench::kSampleRate, 512, numChannels);
+            state->engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(numChannels));
+            state->engine.setOversamplingFactor(kOversamplingFactor);
+            state->engine.setCeiling(-3.0f);
+            state->engine.setCurve(3);  // Tanh
+            state->engine.setStereoLink(true);
+            state->engine.setTruePeakMode(truePeak);
+            state->engine.reset();
+            state->source = bench::makeTestSignal(numChannels, 512);
+            state->work.setSize(numChannels, 512);
+
+            const std::string name = "engine/surround/" + std::to_string(numChannels) + "ch/"
+                                     + (truePeak ? "truepeak" : "samplepeak");
+            benchmarks.push_back({ name, 512, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->engine.process(state->work);
+                                   } });
+        }
+    }
+
+    // Digital silence at 4x and 32x: the first block runs after the engine has
+    // been silent long enough to skip the clip path
+    for (const int factorIndex : { 2, 5 })
+    {
+        auto state = std::make_shared<EngineState<>>();
+        state->engine.prepare(bench::kSampleRate, 512, 2);
+        state->engine.setOversamplingFactor(factorIndex);
+        state->engine.setCeiling(-3.0f);
+        state->engine.setCurve(3);  // Tanh
+        state->engine.reset();
+        state->source.setSize(2, 512);
+        state->source.clear();
+        state->work.setSize(2, 512);
+
+        const std::string name = "engine/silence/" + std::to_string(1 << factorIndex) + "x";
+        benchmarks.push_back({ name, 512, bench::kSampleRate,
+                               [state]()
+                               {
+                                   bench::restore(state->work, state->source);
+                                   state->engine.process(state->work);
+                               } });
+    }
+
+    // Gain-reduction metering against none, at 1x and 8x: metering reads every
+    // clip-rate sample
+    for (const int factorIndex : { 0, 3 })
+    {
+        for (const bool metering : { false, true })
+        {
+            auto state = std::make_shared<EngineState<>>();
+            state->engine.prepare(bench::kSampleRate, 512, 2);
+            state->engine.setOversamplingFactor(factorIndex);
+            state->engine.setCeiling(-3.0f);
+            state->engine.setCurve(3);  // Tanh
+            state->engine.setClipMetering(metering);
+            state->engine.reset();
+            state->source = bench::makeTestSignal(2, 512);
+            state->work.setSize(2, 512);
+
+            const std::string name = "engine/metering/" + std::to_string(1 << factorIndex) + "x/"
+                                     + (metering ? "on" : "off");
+            benchmarks.push_back({ name, 512, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->engine.process(state->work);
+                                   } });
+        }
+    }
+
+    // Float against double processing, full signal path in each precision
+    for (const int factorIndex : { 0, 2, 4 })
+    {
+        const std::string name = "engine/precision/" + std::to_string(1 << factorIndex) + "x/";
+        benchmarks.push_back(makePrecisionBenchmark<float>(name + "float", factorIndex));
+        benchmarks.push_back(makePrecisionBenchmark<double>(name + "double", factorIndex));
+    }
+
+    // Ceiling automation: the block split at 0, 1 or 8 timestamped events, each
+    // moving the ceiling (so every piece ramps), against the plain block
+    for (const int numEvents : { 0, 1, 8 })
+    {
+        auto state = std::make_shared<EngineState<>>();
+        state->engine.prepare(bench::kSampleRate, 512, 2);
+        state->source = bench::makeTestSignal(2, 512);
+        state->work.setSize(2, 512);
+
+        auto parameters = std::make_shared<dsp::EngineParameters>();
+        parameters->curve = 3;  // Tanh
+        parameters->oversampling = kOversamplingFactor;
+        state->engine.setParameters(*parameters);
+
+        const std::string name = "engine/automation/" + std::to_string(numEvents) + "events";
+        benchmarks.push_back({ name, 512, bench::kSampleRate,
+                               [state, parameters, numEvents]()
+                               {
+                                   for (int event = 0; event < numEvents; ++event)
+                                   {
+                                       ++parameters->version;
+                                       parameters->ceiling = (parameters->version % 2 == 0) ? -3.0f : -6.0f;
+                                       state->engine.addParameterEvent(event * 512 / numEvents, *parameters);
+                                   }
+
+                                   bench::restore(state->work, state->source);
+                                   state->engine.process(state->work);
+                               } });
+    }
+
+    // Offline rendering of wide buses: oversampling filters split across worker
+    // threads against the inline path, at render-sized blocks
+    for (const int factorIndex : { 3, 5 })
+    {
+        for (const int numThreads : { 0, 1, 3 })
+        {
+            constexpr int kChannels = 12;
+            constexpr int kRenderBlock = 4096;
+            auto state = std::make_shared<EngineState<>>();
+            state->engine.setWorkerThreads(numThreads);
+            state->engine.prepare(bench::kSampleRate, kRenderBlock, kChannels);
+            state->engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(kChannels));
+            state->engine.setOversamplingFactor(factorIndex);
+            state->engine.setCeiling(-3.0f);
+            state->engine.setCurve(3);  // Tanh
+            state->engine.reset();
+            state->source = bench::makeTestSignal(kChannels, kRenderBlock);
+            state->work.setSize(kChannels, kRenderBlock);
+
+            const std::string name = "engine/threads/" + std::to_string(1 << factorIndex) + "x/"
+                                     + std::to_string(numThreads) + "workers";
+            benchmarks.push_back({ name, kRenderBlock, bench::kSampleRate,
+                                   [state]()
+                                   {
+                                       bench::restore(state->work, state->source);
+                                       state->engine.process(state->work);
+                                   } });
+        }
+    }
+}
+
+const bench::Registrar registrar(registerEngineBenchmarks);
+
+} // namespace
@@ -0,0 +1,70 @@
+// guillotine_bench - DSP chain benchmarks
+//
+// Usage:
+//   guillotine_bench [--filter TEXT] [--json out.json] [--baseline base.json]
+//                    [--tolerance 0.15] [--min-time seconds]
+//
+// With --baseline, exits non-zero when any benchmark is slower than the
+// baseline by more than the tolerance.
+
+#include "BenchHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    bench::RunOptions options;
+    std::string jsonPath;
+    std::string baselinePath;
+    double tolerance = 0.15;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            options.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+            tolerance = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+            options.minSecondsPerRep = std::atof(argv[++i]);
+        else
+        {
+            std::fprintf(stderr, "usage: guillotine_bench [--filter TEXT] [--json out.json] "
+                                 "[--baseline base.json] [--tolerance 0.15] [--min-time seconds]\n");
+            return 2;
+        }
+    }
+
+    const auto results = bench::runAll(options);
+
+    if (!jsonPath.empty() && !bench::writeJson(results, jsonPath))
+    {
+        std::fprintf(stderr, "could not write %s\n", jsonPath.c_str());
+        return 2;
+    }
+
+    if (!baselinePath.empty())
+    {
+        std::vector<bench::Result> baseline;
+        if (!bench::readJson(baselinePath, baseline))
+        {
+            std::fprintf(stderr, "could not read baseline %s\n", baselinePath.c_str());
+            return 2;
+        }
+
+        const int regressions = bench::reportRegressions(results, baseline, tolerance);
+        std::printf("%d regression(s) against %s (tolerance %.0f%%)\n", regressions, baselinePath.c_str(),
+                    tolerance * 100.0);
+        return regressions > 0 ? 1 : 0;
+    }
+
+    return 0;
+}
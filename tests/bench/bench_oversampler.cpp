@@ -0,0 +1,119 @@
+#include "BenchHarness.h"
+#include "BenchSignals.h"
+#include "dsp/Oversampler.h"
+
+#include <memory>
+
+namespace {
+
+constexpr int kBlockSize = 512;
+constexpr int kNumChannels = 2;
+constexpr int kPrepareChannels = 16;
+
+using dsp::Oversampler;
+
+struct Variant
+{
+    const char* name;
+    Oversampler::FilterType filterType;
+    Oversampler::Backend backend;
+    Oversampler::FilterQuality quality = Oversampler::FilterQuality::High;
+};
+
+const Variant kVariants[] = {
+    { "min", Oversampler::FilterType::MinimumPhase, Oversampler::Backend::Juce },
+    { "lin", Oversampler::FilterType::LinearPhase, Oversampler::Backend::Juce },
+    { "polyphase", Oversampler::FilterType::MinimumPhase, Oversampler::Backend::PolyphaseAllpass },
+    { "lowlatency", Oversampler::FilterType::LowLatency, Oversampler::Backend::Juce },
+    { "min-efficient", Oversampler::FilterType::MinimumPhase, Oversampler::Backend::Juce, Oversampler::FilterQuality::Efficient },
+    { "lin-efficient", Oversampler::FilterType::LinearPhase, Oversampler::Backend::Juce, Oversampler::FilterQuality::Efficient },
+};
+
+struct OversamplerState
+{
+    Oversampler oversampler;
+    juce::AudioBuffer<float> source = bench::makeTestSignal(kNumChannels, kBlockSize);
+    juce::AudioBuffer<float> work { kNumChannels, kBlockSize };
+};
+
+std::shared_ptr<OversamplerState> makeState(int factorIndex, const Variant& variant)
+{
+    auto state = std::make_shared<OversamplerState>();
+    state->oversampler.prepare(bench::kSampleRate, kBlockSize, kNumChannels);
+    state->oversampler.setOversamplingFactor(factorIndex);
+    state->oversampler.setFilterType(variant.filterType);
+    state->oversampler.setBackend(variant.backend);
+    state->oversampler.setFilterQuality(variant.quality);
+    state->oversampler.releaseOutgoing();
+    state->oversampler.reset();
+    bench::restore(state->work, state->source);
+    return state;
+}
+
+constexpr int kPrepareFactor = 3;
+
+// Builds every configuration, what prepare() used to do up front, and ends back
+// on the default 8x one
+void buildAllConfigurations(Oversampler& oversampler)
+{
+    for (const auto& variant : kVariants)
+        for (int factorIndex = 1; factorIndex < Oversampler::NumFactors; ++factorIndex)
+            oversampler.setConfiguration(factorIndex, variant.filterType, variant.backend, variant.quality);
+
+    const auto& active = kVariants[0];
+    oversampler.setConfiguration(kPrepareFactor, active.filterType, active.backend, active.quality);
+    oversampler.releaseOutgoing();
+}
+
+void registerOversamplerBenchmarks(std::vector<bench::Benchmark>& benchmarks)
+{
+    // Up and down separately, per factor and filter type (1x has nothing to time)
+    for (int factorIndex = 1; factorIndex < Oversampler::NumFactors; ++factorIndex)
+    {
+        const std::string factor = std::to_string(1 << factorIndex) + "x";
+
+        for (const auto& variant : kVariants)
+        {
+            auto up = makeState(factorIndex, variant);
+            benchmarks.push_back({ "oversampler/" + factor + "/" + variant.name + "/up", kBlockSize, bench::kSampleRate,
+                                   [up]()
+                                   {
+                                       int numOversampled = 0;
+                                       up->oversampler.processSamplesUp(up->work, numOversampled);
+                                   } });
+
+            // Down reads the oversampled buffer an initial up left behind
+            auto down = makeState(factorIndex, variant);
+            int numOversampled = 0;
+            down->oversampler.processSamplesUp(down->work, numOversampled);
+            benchmarks.push_back({ "oversampler/" + factor + "/" + variant.name + "/down", kBlockSize, bench::kSampleRate,
+                                   [down]() { down->oversampler.processSamplesDown(down->work, kBlockSize); } });
+        }
+    }
+
+    // prepareToPlay cost at 16 channels. One "sample" per iteration, so ns/sample
+    // reads as ns per prepare(). "active" builds the 8x configuration only,
+    // "all" then switches through the rest
+    for (const int numPartitions : { 1, kPrepareChannels })
+    {
+        const std::string prefix = "oversampler/prepare/16ch/" + std::to_string(numPartitions) + "partitions/";
+        auto active = std::make_shared<Oversampler>();
+        active->setOversamplingFactor(kPrepareFactor);
+        benchmarks.push_back({ prefix + "active", 1, bench::kSampleRate,
+                               [active, numPartitions]()
+                               { active->prepare(bench::kSampleRate, kBlockSize, kPrepareChannels, numPartitions); } });
+
+        auto all = std::make_shared<Oversampler>();
+        all->setOversamplingFactor(kPrepareFactor);
+        benchmarks.push_back({ prefix + "all", 1, bench::kSampleRate,
+                               [all, numPartitions]()
+                               {
+                                   all->prepare(bench::kSampleRate, kBlockSize, kPrepareChannels, numPartitions);
+                                   buildAllConfigurations(*all);
+                               } });
+    }
+}
+
+const bench::Registrar registrar(registerOversamplerBenchmarks);
+
+} // namespace
@@ -451,7 +451,16 @@ def run_comparison():
     
     # Available modes (based on current build)
     os_modes = ["1x", "2x", "4x", "8x", "16x", "32x"]
-    filter_types = ["Minimum Phase", "Linear Phase"]
+    # (filter type, oversampling engine, filter quality) - the polyphase allpass
+    # engine is min-phase only, and quality only changes the JUCE stages past 2x
+    configurations = [
+        ("Minimum Phase", "JUCE", "High"),
+        ("Minimum Phase", "JUCE", "Efficient"),
+        ("Minimum Phase", "Polyphase Allpass", "High"),
+        ("Linear Phase", "JUCE", "High"),
+        ("Linear Phase", "JUCE", "Efficient"),
+        ("Low Latency", "JUCE", "High"),
+    ]
     
     print("=" * 80)
     print("OVERSAMPLING COMPARISON TEST")
@@ -477,19 +486,21 @@ def run_comparison():
     results = {}
     
     # Run tests for each configuration
-    for filter_type in filter_types:
+    for filter_type, engine, quality in configurations:
         print(f"\n{'='*40}")
-        print(f"Filter: {filter_type}")
+        print(f"Filter: {filter_type} ({engine}, {quality})")
         print(f"{'='*40}")
         
         for os_mode in available_os:
-            key = f"{os_mode} {filter_type}"
+            key = f"{os_mode} {filter_type} ({engine}, {quality})"
             
             try:
                 plugin = load_plugin(plugin_path)
                 plugin.bypass_clipper = False
                 plugin.oversampling = os_mode
                 plugin.filter_type = filter_type
+                plugin.oversampling_engine = engine
+                plugin.filter_quality = quality
                 plugin.input_gain_db = 0.0
                 plugin.output_gain_db = 0.0
                 
@@ -540,12 +551,12 @@ def run_comparison():
     print("SUMMARY TABLE")
     print("=" * 120)
     print()
-    print(f"{'Mode':<20} {'Intersamp':>10} {'Aliasing':>10} {'PreRing':>10} {'Attack':>10} {'CPU':>10} {'Latency':>10}")
-    print(f"{'':20} {'(dB)':>10} {'(dB)':>10} {'(dB)':>10} {'(samp)':>10} {'(ms)':>10} {'(samp)':>10}")
+    print(f"{'Mode':<50} {'Intersamp':>10} {'Aliasing':>10} {'PreRing':>10} {'Attack':>10} {'CPU':>10} {'Latency':>10}")
+    print(f"{'':50} {'(dB)':>10} {'(dB)':>10} {'(dB)':>10} {'(samp)':>10} {'(ms)':>10} {'(samp)':>10}")
     print("-" * 120)
 
     for key, data in sorted(results.items()):
-        print(f"{key:<20} {data['intersample_db']:>+10.2f} {data['aliasing_db']:>10.1f} {data['pre_ring_db']:>10.1f} {data['attack_samples']:>10} {data['cpu_ms']:>10.3f} {data['latency_measured']:>10}")
+        print(f"{key:<50} {data['intersample_db']:>+10.2f} {data['aliasing_db']:>10.1f} {data['pre_ring_db']:>10.1f} {data['attack_samples']:>10} {data['cpu_ms']:>10.3f} {data['latency_measured']:>10}")
 
     print()
     print("INTERPRETATION:")
@@ -0,0 +1,182 @@
+#include "allocation_tracker.h"
+#include "dsp/RealtimeScope.h"
+#include <atomic>
+#include <cstdlib>
+
+#if GUILLOTINE_TRACK_ALLOCATIONS && defined(__GLIBC__)
+#include <cerrno>
+#include <malloc.h>
+#endif
+
+namespace test_utils {
+
+namespace {
+std::atomic<size_t> realtimeAllocations { 0 };
+} // namespace
+
+const char* RealtimeAllocationError::what() const noexcept
+{
+    return "heap allocation inside a real-time scope (e.g. ClipperEngine::process)";
+}
+
+size_t getRealtimeAllocationCount()
+{
+    return realtimeAllocations.load();
+}
+
+} // namespace test_utils
+
+#if GUILLOTINE_TRACK_ALLOCATIONS
+
+namespace {
+
+// Set while the error is thrown: the exception object itself comes from malloc
+thread_local bool reportingError = false;
+
+// Returns false when the allocation must not happen (inside a realtime scope)
+bool allowAllocation()
+{
+    if (!dsp::RealtimeScope::isActive() || reportingError)
+        return true;
+
+    test_utils::realtimeAllocations.fetch_add(1);
+    return false;
+}
+
+void* allocate(size_t size, size_t alignment)
+{
+    if (size == 0)
+        size = 1;
+
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+        ptr = std::malloc(size);
+    else if (posix_memalign(&ptr, alignment, size) != 0)
+        ptr = nullptr;
+
+    return ptr;
+}
+
+// Cleared again as the throw unwinds this frame
+struct ReportingError
+{
+    ReportingError() noexcept { reportingError = true; }
+    ~ReportingError() { reportingError = false; }
+};
+
+void* allocateOrThrow(size_t size, size_t alignment)
+{
+    if (!allowAllocation())
+    {
+        const ReportingError reporting;
+        throw test_utils::RealtimeAllocationError();
+    }
+
+    if (void* ptr = allocate(size, alignment))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* allocateNoThrow(size_t size, size_t alignment) noexcept
+{
+    // Still counted - tests compare getRealtimeAllocationCount() around process()
+    if (!allowAllocation())
+        return nullptr;
+
+    return allocate(size, alignment);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t al) { return allocateOrThrow(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return allocateOrThrow(size, static_cast<size_t>(al)); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocateNoThrow(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocateNoThrow(size, static_cast<size_t>(al)); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+// The C allocator, for what bypasses operator new (juce::HeapBlock). glibc
+// exports its own implementation under __libc_*, so these forward there. They
+// count but still allocate - operator new above only reaches malloc outside a
+// scope, so nothing is counted twice
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size)
+{
+    allowAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    allowAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    allowAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    allowAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    allowAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+    allowAllocation();
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+
+    void* allocated = __libc_memalign(alignment, size);
+    if (allocated == nullptr)
+        return ENOMEM;
+
+    *ptr = allocated;
+    return 0;
+}
+
+void free(void* ptr)
+{
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+#endif
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace test_utils {
+
+// With GUILLOTINE_TRACK_ALLOCATIONS the unit tests replace the global operator
+// new (allocation_tracker.cpp). Any allocation inside a dsp::RealtimeScope -
+// e.g. during ClipperEngine::process - is counted and throws this, so the test
+// that triggered it fails with a clear message.
+//
+// On glibc malloc, calloc, realloc and the aligned variants are replaced too,
+// so juce::HeapBlock is seen. Those only count - C callers can't take an
+// exception. Elsewhere only operator new is tracked.
+struct RealtimeAllocationError : std::bad_alloc
+{
+    const char* what() const noexcept override;
+};
+
+// Allocations attempted inside a realtime scope since the program started
+size_t getRealtimeAllocationCount();
+
+} // namespace test_utils
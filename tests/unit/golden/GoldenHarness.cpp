@@ -0,0 +1,294 @@
+#include "GoldenHarness.h"
+
+#include "dsp/ClipperEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace golden {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kCurveNames[] = { "hard", "quintic", "cubic", "tanh", "arctan", "knee", "t2" };
+
+struct Mode
+{
+    const char* name;
+    bool needsOversampling;  // Identical to "min" at 1x, so skipped there
+    void (*apply)(dsp::EngineParameters&);
+};
+
+const Mode kModes[] = {
+    { "min", false, [](dsp::EngineParameters&) {} },
+    { "linear", true, [](dsp::EngineParameters& p) { p.filterType = 1; } },
+    { "lowlatency", true, [](dsp::EngineParameters& p) { p.filterType = 2; } },
+    { "polyphase", true, [](dsp::EngineParameters& p) { p.polyphaseAllpass = true; } },
+    { "efficient", true, [](dsp::EngineParameters& p) { p.efficientFilters = true; } },
+    { "ms", false, [](dsp::EngineParameters& p) { p.midSide = true; p.stereoLink = false; } },
+    { "delta", false, [](dsp::EngineParameters& p) { p.deltaMonitor = true; } },
+    { "truepeak", false, [](dsp::EngineParameters& p) { p.truePeak = true; } },
+    { "adaa1", false, [](dsp::EngineParameters& p) { p.antialiasing = 1; } },
+    { "adaa2", false, [](dsp::EngineParameters& p) { p.antialiasing = 2; } },
+    { "table", false, [](dsp::EngineParameters& p) { p.curveTable = true; } },
+};
+
+juce::File referenceFile(const juce::File& directory, const std::string& resultName)
+{
+    return directory.getChildFile(juce::String(resultName) + ".wav");
+}
+
+bool readWav(const juce::File& file, juce::AudioBuffer<float>& audio, double& sampleRate)
+{
+    auto stream = file.createInputStream();
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(stream.release(), true));
+    if (reader == nullptr)
+        return false;
+
+    audio.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+    sampleRate = reader->sampleRate;
+    return reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+}
+
+juce::Result writeReference(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate)
+{
+    if (!file.getParentDirectory().createDirectory())
+        return juce::Result::fail("could not create " + file.getParentDirectory().getFullPathName());
+
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    if (stream == nullptr)
+        return juce::Result::fail("could not write " + file.getFullPathName());
+
+    // 32-bit WAV is IEEE float, so references keep the engine output exactly
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+        stream.get(), sampleRate, static_cast<unsigned int>(audio.getNumChannels()), 32, {}, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("could not create a WAV writer for " + file.getFullPathName());
+
+    stream.release();  // Owned by the writer now
+
+    if (!writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples()))
+        return juce::Result::fail("write error for " + file.getFullPathName());
+    return juce::Result::ok();
+}
+
+Result check(const Fixture& fixture, const Configuration& configuration, const RunOptions& options)
+{
+    Result result;
+    result.name = fixture.name + "/" + configuration.name;
+
+    const auto rendered = render(fixture, configuration, options.blockSize);
+    const double audioSeconds = fixture.audio.getNumSamples() / fixture.sampleRate;
+    result.realtimeMultiple = rendered.seconds > 0.0 ? audioSeconds / rendered.seconds : 0.0;
+    result.nsPerSample = rendered.seconds * 1e9 / fixture.audio.getNumSamples();
+
+    const auto file = referenceFile(options.referenceDirectory, result.name);
+
+    if (options.update)
+    {
+        const auto written = writeReference(file, rendered.audio, fixture.sampleRate);
+        result.status = written.wasOk() ? Status::Updated : Status::Error;
+        result.message = written.getErrorMessage().toStdString();
+        return result;
+    }
+
+    if (!file.existsAsFile())
+    {
+        result.status = Status::Missing;
+        return result;
+    }
+
+    juce::AudioBuffer<float> reference;
+    double referenceRate = 0.0;
+    if (!readWav(file, reference, referenceRate))
+    {
+        result.status = Status::Error;
+        result.message = "could not read " + file.getFullPathName().toStdString();
+        return result;
+    }
+
+    if (reference.getNumChannels() != rendered.audio.getNumChannels()
+        || reference.getNumSamples() != rendered.audio.getNumSamples()
+        || referenceRate != fixture.sampleRate)
+    {
+        result.status = Status::Mismatch;
+        result.message = "reference format differs";
+        return result;
+    }
+
+    for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+    {
+        const float* expected = reference.getReadPointer(ch);
+        const float* actual = rendered.audio.getReadPointer(ch);
+        for (int i = 0; i < reference.getNumSamples(); ++i)
+        {
+            // NaN fails the comparison below, so it can't pass as a small error
+            const float error = std::abs(actual[i] - expected[i]);
+            if (!(error <= result.maxError))
+                result.maxError = std::isnan(error) ? std::numeric_limits<float>::infinity() : error;
+        }
+    }
+
+    result.status = result.maxError <= options.tolerance ? Status::Match : Status::Mismatch;
+    return result;
+}
+
+} // namespace
+
+std::vector<Configuration> makeMatrix()
+{
+    std::vector<Configuration> matrix;
+
+    for (int curve = 0; curve < static_cast<int>(std::size(kCurveNames)); ++curve)
+    {
+        for (int factorIndex = 0; factorIndex < 6; ++factorIndex)
+        {
+            for (const auto& mode : kModes)
+            {
+                if (mode.needsOversampling && factorIndex == 0)
+                    continue;
+
+                // Driven into the curve: +6 dB into a -3 dB ceiling
+                dsp::EngineParameters parameters;
+                parameters.inputGain = 6.0f;
+                parameters.ceiling = -3.0f;
+                parameters.curve = curve;
+                parameters.curveExponent = 2.0f;
+                parameters.oversampling = factorIndex;
+                mode.apply(parameters);
+
+                matrix.push_back({ std::string(kCurveNames[curve]) + "/" + std::to_string(1 << factorIndex) + "x/"
+                                       + mode.name,
+                                   parameters });
+            }
+        }
+    }
+
+    return matrix;
+}
+
+std::vector<Fixture> loadFixtures(const juce::File& directory, juce::StringArray& errors)
+{
+    std::vector<Fixture> fixtures;
+
+    auto files = directory.findChildFiles(juce::File::findFiles, false, "*.wav");
+    files.sort();
+
+    for (const auto& file : files)
+    {
+        Fixture fixture;
+        fixture.name = file.getFileNameWithoutExtension().toStdString();
+        if (!readWav(file, fixture.audio, fixture.sampleRate) || fixture.audio.getNumSamples() == 0)
+        {
+            errors.add("could not read " + file.getFullPathName() + " (git lfs pull?)");
+            continue;
+        }
+        fixtures.push_back(std::move(fixture));
+    }
+
+    return fixtures;
+}
+
+Render render(const Fixture& fixture, const Configuration& configuration, int blockSize)
+{
+    const int numChannels = fixture.audio.getNumChannels();
+    const int totalSamples = fixture.audio.getNumSamples();
+
+    dsp::ClipperEngine engine;
+    engine.prepare(fixture.sampleRate, blockSize, numChannels);
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(numChannels));
+
+    // Parameters go in before reset() so the render starts without gain ramps
+    // or an oversampling crossfade
+    auto parameters = configuration.parameters;
+    parameters.version = 1;
+    engine.setParameters(parameters);
+    engine.reset();
+
+    Render result;
+    result.audio.setSize(numChannels, totalSamples);
+
+    // Drop the first `latency` output samples and flush the tail with silence
+    int samplesToSkip = engine.getLatencyInSamples();
+    int readPosition = 0;
+    int samplesWritten = 0;
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    Clock::duration processing {};
+
+    while (samplesWritten < totalSamples)
+    {
+        block.clear();
+        const int numToRead = juce::jlimit(0, blockSize, totalSamples - readPosition);
+        for (int ch = 0; ch < numChannels; ++ch)
+            block.copyFrom(ch, 0, fixture.audio, ch, readPosition, numToRead);
+        readPosition += numToRead;
+
+        const auto start = Clock::now();
+        engine.process(block);
+        processing += Clock::now() - start;
+
+        const int skipped = std::min(samplesToSkip, blockSize);
+        samplesToSkip -= skipped;
+
+        const int numToWrite = std::min(blockSize - skipped, totalSamples - samplesWritten);
+        for (int ch = 0; ch < numChannels; ++ch)
+            result.audio.copyFrom(ch, samplesWritten, block, ch, skipped, numToWrite);
+        samplesWritten += numToWrite;
+    }
+
+    result.seconds = std::chrono::duration<double>(processing).count();
+    return result;
+}
+
+std::vector<Result> runAll(const std::vector<Fixture>& fixtures, const std::vector<Configuration>& matrix,
+                           const RunOptions& options)
+{
+    struct Task
+    {
+        const Fixture* fixture;
+        const Configuration* configuration;
+    };
+
+    std::vector<Task> tasks;
+    for (const auto& fixture : fixtures)
+        for (const auto& configuration : matrix)
+            if (options.filter.empty() || (fixture.name + "/" + configuration.name).find(options.filter) != std::string::npos)
+                tasks.push_back({ &fixture, &configuration });
+
+    // Each task has its own engine and output slot - nothing is shared but the index
+    std::vector<Result> results(tasks.size());
+    std::atomic<size_t> next { 0 };
+
+    const int numCores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int numWorkers = std::max(1, std::min(options.jobs > 0 ? options.jobs : numCores, static_cast<int>(tasks.size())));
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.emplace_back([&]()
+        {
+            for (size_t index = next++; index < tasks.size(); index = next++)
+                results[index] = check(*tasks[index].fixture, *tasks[index].configuration, options);
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return results;
+}
+
+} // namespace golden
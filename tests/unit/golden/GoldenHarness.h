@@ -0,0 +1,77 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "dsp/EngineParameters.h"
+
+#include <string>
+#include <vector>
+
+// Golden-file regression harness for ClipperEngine (guillotine_golden).
+//
+// Streams every fixture WAV (tests/fixtures/input) through the engine for each
+// configuration of a curve x oversampling x mode matrix, block by block and
+// latency compensated like guillotine_render, and compares the output against
+// stored references (tests/fixtures/references/engine/<fixture>/<config>.wav,
+// 32-bit float) within an absolute tolerance. Each render is timed, so the
+// same run tracks throughput per configuration.
+namespace golden {
+
+struct Configuration
+{
+    std::string name;  // "<curve>/<factor>/<mode>", also the reference path
+    dsp::EngineParameters parameters;
+};
+
+// Every curve at every oversampling factor, in each mode (filter types, the
+// polyphase engine, M/S, delta, true peak, ADAA)
+std::vector<Configuration> makeMatrix();
+
+struct Fixture
+{
+    std::string name;  // File name without extension
+    juce::AudioBuffer<float> audio;
+    double sampleRate = 44100.0;
+};
+
+// Reads every .wav in the directory; unreadable files (e.g. LFS pointers that
+// were never pulled) are reported in errors and skipped
+std::vector<Fixture> loadFixtures(const juce::File& directory, juce::StringArray& errors);
+
+// Output the same length as the input, lined up with it sample for sample
+struct Render
+{
+    juce::AudioBuffer<float> audio;
+    double seconds = 0.0;  // Wall time in ClipperEngine::process
+};
+
+Render render(const Fixture& fixture, const Configuration& configuration, int blockSize);
+
+enum class Status { Match, Mismatch, Missing, Updated, Error };
+
+struct Result
+{
+    std::string name;           // "<fixture>/<configuration>"
+    Status status = Status::Error;
+    float maxError = 0.0f;      // Largest absolute sample difference
+    double nsPerSample = 0.0;
+    double realtimeMultiple = 0.0;
+    std::string message;
+};
+
+struct RunOptions
+{
+    juce::File referenceDirectory;
+    std::string filter;         // Substring match on the result name, empty = all
+    int blockSize = 512;
+    int jobs = 0;               // 0 = one per core
+    float tolerance = 1.0e-5f;  // About -100 dBFS
+    bool update = false;        // Write the references instead of comparing
+};
+
+// Renders every fixture x configuration on a pool of threads. Results come
+// back in matrix order whatever the thread count
+std::vector<Result> runAll(const std::vector<Fixture>& fixtures, const std::vector<Configuration>& matrix,
+                           const RunOptions& options);
+
+} // namespace golden
@@ -0,0 +1,148 @@
+// guillotine_golden - ClipperEngine golden-file regression run
+//
+// Usage:
+//   guillotine_golden [--update] [--filter TEXT] [--jobs N] [--block-size N]
+//                     [--tolerance 1e-5] [--fixtures DIR] [--strict]
+//                     [--json out.json] [--baseline base.json] [--speed-tolerance 0.15]
+//
+// Compares every fixture x configuration against its reference and exits
+// non-zero on any mismatch (or, with --strict, a missing reference). --update
+// rewrites the references from the current engine instead. --json records
+// throughput per configuration in guillotine_bench's format, --baseline
+// compares against such a file; run with --jobs 1 for stable timings.
+
+#include "GoldenHarness.h"
+#include "../../bench/BenchHarness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+const char* statusLabel(golden::Status status)
+{
+    switch (status)
+    {
+        case golden::Status::Match:    return "ok";
+        case golden::Status::Mismatch: return "MISMATCH";
+        case golden::Status::Missing:  return "missing";
+        case golden::Status::Updated:  return "updated";
+        case golden::Status::Error:    return "ERROR";
+    }
+    return "";
+}
+
+double toDecibels(float error)
+{
+    return error > 0.0f ? 20.0 * std::log10(static_cast<double>(error)) : -999.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    golden::RunOptions options;
+    juce::File fixturesDirectory(GUILLOTINE_FIXTURES_DIR);
+    std::string jsonPath;
+    std::string baselinePath;
+    double speedTolerance = 0.15;
+    bool strict = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--update") == 0)
+            options.update = true;
+        else if (std::strcmp(argv[i], "--strict") == 0)
+            strict = true;
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            options.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--jobs") == 0 && hasValue)
+            options.jobs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--block-size") == 0 && hasValue)
+            options.blockSize = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+            options.tolerance = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--fixtures") == 0 && hasValue)
+            fixturesDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--speed-tolerance") == 0 && hasValue)
+            speedTolerance = std::atof(argv[++i]);
+        else
+        {
+            std::fprintf(stderr, "usage: guillotine_golden [--update] [--filter TEXT] [--jobs N] [--block-size N] "
+                                 "[--tolerance 1e-5] [--fixtures DIR] [--strict] [--json out.json] "
+                                 "[--baseline base.json] [--speed-tolerance 0.15]\n");
+            return 2;
+        }
+    }
+
+    options.referenceDirectory = fixturesDirectory.getChildFile("references/engine");
+
+    juce::StringArray errors;
+    const auto fixtures = golden::loadFixtures(fixturesDirectory.getChildFile("input"), errors);
+    for (const auto& error : errors)
+        std::fprintf(stderr, "%s\n", error.toRawUTF8());
+
+    if (fixtures.empty())
+    {
+        std::fprintf(stderr, "no readable fixtures in %s\n", fixturesDirectory.getChildFile("input").getFullPathName().toRawUTF8());
+        return strict ? 1 : 0;
+    }
+
+    const auto results = golden::runAll(fixtures, golden::makeMatrix(), options);
+
+    int counts[5] = {};
+    std::vector<bench::Result> throughput;
+
+    std::printf("%-48s %-9s %12s %12s\n", "configuration", "status", "max error dB", "x realtime");
+    for (const auto& result : results)
+    {
+        ++counts[static_cast<int>(result.status)];
+        throughput.push_back({ "golden/" + result.name, result.nsPerSample, result.realtimeMultiple });
+
+        std::printf("%-48s %-9s %12.1f %12.1f", result.name.c_str(), statusLabel(result.status),
+                    toDecibels(result.maxError), result.realtimeMultiple);
+        if (!result.message.empty())
+            std::printf("  %s", result.message.c_str());
+        std::printf("\n");
+    }
+
+    std::printf("%zu configuration(s): %d ok, %d mismatched, %d missing, %d updated, %d errors (tolerance %g)\n",
+                results.size(), counts[0], counts[1], counts[2], counts[3], counts[4], options.tolerance);
+    if (counts[2] > 0)
+        std::printf("missing references: run with --update to record them in %s\n",
+                    options.referenceDirectory.getFullPathName().toRawUTF8());
+
+    if (!jsonPath.empty() && !bench::writeJson(throughput, jsonPath))
+    {
+        std::fprintf(stderr, "could not write %s\n", jsonPath.c_str());
+        return 2;
+    }
+
+    int regressions = 0;
+    if (!baselinePath.empty())
+    {
+        std::vector<bench::Result> baseline;
+        if (!bench::readJson(baselinePath, baseline))
+        {
+            std::fprintf(stderr, "could not read baseline %s\n", baselinePath.c_str());
+            return 2;
+        }
+
+        regressions = bench::reportRegressions(throughput, baseline, speedTolerance);
+        std::printf("%d throughput regression(s) against %s (tolerance %.0f%%)\n", regressions, baselinePath.c_str(),
+                    speedTolerance * 100.0);
+    }
+
+    const bool failed = counts[1] > 0 || counts[4] > 0 || (strict && counts[2] > 0) || regressions > 0;
+    return failed ? 1 : 0;
+}
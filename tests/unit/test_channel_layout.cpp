@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dsp/ChannelLayout.h"
+
+using dsp::ChannelLayout;
+
+// =============================================================================
+// Bus Layouts [layout]
+// =============================================================================
+
+TEST_CASE("Channel layout: mono and stereo keep the plain front pair", "[layout]")
+{
+    for (const auto& set : { juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo() })
+    {
+        const auto layout = ChannelLayout::fromChannelSet(set);
+        REQUIRE(layout.midSidePairs == std::vector<std::pair<int, int>> { { 0, 1 } });
+        REQUIRE(layout.linkGroups.empty());
+    }
+}
+
+TEST_CASE("Channel layout: 5.1 pairs fronts and surrounds, LFE unlinked", "[layout]")
+{
+    const auto set = juce::AudioChannelSet::create5point1();
+    const auto layout = ChannelLayout::fromChannelSet(set);
+
+    const int lfe = set.getChannelIndexForType(juce::AudioChannelSet::LFE);
+    const int centre = set.getChannelIndexForType(juce::AudioChannelSet::centre);
+    REQUIRE(layout.midSidePairs.size() == 2);
+    REQUIRE(layout.linkGroups.size() == 6);
+    REQUIRE(layout.linkGroups[static_cast<size_t>(lfe)] < 0);
+    REQUIRE(layout.linkGroups[static_cast<size_t>(centre)] == 0);
+
+    // The centre has no counterpart, the LFE is never an M/S channel
+    for (const auto& [left, right] : layout.midSidePairs)
+        for (int ch : { left, right })
+        {
+            REQUIRE(ch != lfe);
+            REQUIRE(ch != centre);
+        }
+}
+
+TEST_CASE("Channel layout: 7.1.4 pairs every speaker pair", "[layout]")
+{
+    const auto set = juce::AudioChannelSet::create7point1point4();
+    const auto layout = ChannelLayout::fromChannelSet(set);
+
+    // L/R, side, rear, top front, top rear
+    REQUIRE(layout.midSidePairs.size() == 5);
+    REQUIRE(layout.linkGroups.size() == 12);
+}
+
+TEST_CASE("Channel layout: discrete channels link everything with one pair", "[layout]")
+{
+    const auto layout = ChannelLayout::fromChannelSet(juce::AudioChannelSet::discreteChannels(5));
+    REQUIRE(layout.midSidePairs == std::vector<std::pair<int, int>> { { 0, 1 } });
+    REQUIRE(layout.linkGroups.empty());
+}
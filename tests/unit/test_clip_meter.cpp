@@ -0,0 +1,251 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/ClipMeter.h"
+#include "dsp/Clipper.h"
+#include "dsp/ClipperEngine.h"
+#include "test_utils.h"
+
+#include <thread>
+
+using Catch::Approx;
+using dsp::ClipMeter;
+using dsp::Clipper;
+using dsp::ClipperEngine;
+using dsp::ClipStats;
+using dsp::CurveType;
+using namespace test_utils;
+
+// =============================================================================
+// Statistics [meter][stats]
+// =============================================================================
+
+TEST_CASE("Clip meter: frames land in 1 dB histogram bins", "[meter][stats]")
+{
+    ClipStats stats;
+    stats.addFrame(1.0f);                                    // untouched
+    stats.addFrame(juce::Decibels::decibelsToGain(-0.5f));   // 0.5 dB
+    stats.addFrame(juce::Decibels::decibelsToGain(-3.5f));   // 3.5 dB
+    stats.addFrame(juce::Decibels::decibelsToGain(-40.0f));  // past the last bin
+
+    REQUIRE(stats.totalFrames == 4);
+    REQUIRE(stats.clippedFrames == 3);
+    REQUIRE(stats.histogram[0] == 2);
+    REQUIRE(stats.histogram[3] == 1);
+    REQUIRE(stats.histogram[ClipStats::kNumHistogramBins - 1] == 1);
+    REQUIRE(stats.maxGainReductionDb == Approx(40.0f).margin(0.01));
+    REQUIRE(stats.getClipPercentage() == Approx(75.0f));
+}
+
+TEST_CASE("Clip meter: reduction under the threshold is not clipping", "[meter][stats]")
+{
+    ClipStats stats;
+    stats.addFrame(juce::Decibels::decibelsToGain(-0.05f));
+
+    REQUIRE(stats.clippedFrames == 0);
+    REQUIRE(stats.maxGainReductionDb == 0.0f);
+}
+
+TEST_CASE("Clip meter: collect returns everything published and clears", "[meter][stats]")
+{
+    ClipMeter meter;
+    ClipStats block;
+    block.addFrame(juce::Decibels::decibelsToGain(-6.0f));
+    block.addFrame(1.0f);
+    block.addBlock(true);
+
+    meter.publish(block);
+    meter.publish(block);
+
+    const auto collected = meter.collect();
+    REQUIRE(collected.totalFrames == 4);
+    REQUIRE(collected.clippedFrames == 2);
+    REQUIRE(collected.histogram[6] == 2);
+    REQUIRE(collected.maxGainReductionDb == Approx(6.0f).margin(0.01));
+    REQUIRE(collected.blocks == 2);
+    REQUIRE(collected.skippedBlocks == 2);
+
+    const auto empty = meter.collect();
+    REQUIRE(empty.totalFrames == 0);
+    REQUIRE(empty.blocks == 0);
+    REQUIRE(empty.maxGainReductionDb == 0.0f);
+}
+
+TEST_CASE("Clip meter: concurrent collects add up to everything published", "[meter][thread]")
+{
+    constexpr int kNumBlocks = 20000;
+    ClipMeter meter;
+    std::atomic<bool> done { false };
+
+    ClipStats block;
+    for (int i = 0; i < 64; ++i)
+        block.addFrame(i % 2 == 0 ? 0.5f : 1.0f);
+
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < kNumBlocks; ++i)
+            meter.publish(block);
+        done = true;
+    });
+
+    ClipStats total;
+    while (!done)
+        total.merge(meter.collect());
+    producer.join();
+    total.merge(meter.collect());
+
+    REQUIRE(total.totalFrames == static_cast<std::uint64_t>(kNumBlocks) * 64);
+    REQUIRE(total.clippedFrames == static_cast<std::uint64_t>(kNumBlocks) * 32);
+    REQUIRE(total.histogram[6] == static_cast<std::uint64_t>(kNumBlocks) * 32);
+}
+
+// =============================================================================
+// Clipper Metering [meter][clipper]
+// =============================================================================
+
+TEST_CASE("Clip meter: metering does not change the clipper output", "[meter][clipper]")
+{
+    const auto curve = static_cast<CurveType>(GENERATE(0, 1, 2, 3, 4, 5, 6));
+    const bool linked = GENERATE(false, true);
+    CAPTURE(static_cast<int>(curve), linked);
+
+    Clipper plain;
+    Clipper metered;
+    for (auto* clipper : { &plain, &metered })
+    {
+        clipper->setCurve(curve);
+        clipper->setCeiling(0.5f);
+        clipper->setStereoLink(linked);
+    }
+
+    auto expected = generateSine(440.0f, 1000, 0.9f);
+    auto actual = expected;
+
+    ClipStats stats;
+    plain.processInternal(expected.getArrayOfWritePointers(), kNumChannels, expected.getNumSamples());
+    metered.processInternal(actual.getArrayOfWritePointers(), kNumChannels, actual.getNumSamples(), &stats);
+
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < expected.getNumSamples(); ++i)
+            REQUIRE(actual.getSample(ch, i) == expected.getSample(ch, i));
+
+    REQUIRE(stats.totalFrames == 1000);
+}
+
+TEST_CASE("Clip meter: hard clip counts the frames above the ceiling", "[meter][clipper]")
+{
+    Clipper clipper;
+    clipper.setCurve(CurveType::Hard);
+    clipper.setCeiling(0.5f);
+
+    // Square wave: half the frames at 1.0 (6 dB over), half at 0.25 (untouched)
+    juce::AudioBuffer<float> buffer(kNumChannels, 512);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < 512; ++i)
+            buffer.setSample(ch, i, (i / 8) % 2 == 0 ? 1.0f : -0.25f);
+
+    ClipStats stats;
+    clipper.processInternal(buffer.getArrayOfWritePointers(), kNumChannels, 512, &stats);
+
+    REQUIRE(stats.totalFrames == 512);
+    REQUIRE(stats.clippedFrames == 256);
+    REQUIRE(stats.getClipPercentage() == Approx(50.0f));
+    REQUIRE(stats.maxGainReductionDb == Approx(6.02f).margin(0.01));
+    REQUIRE(stats.histogram[6] == 256);
+}
+
+TEST_CASE("Clip meter: a frame meters its most reduced channel", "[meter][clipper]")
+{
+    Clipper clipper;
+    clipper.setCurve(CurveType::Hard);
+    clipper.setCeiling(0.5f);
+
+    // Only the right channel is over
+    juce::AudioBuffer<float> buffer(kNumChannels, 64);
+    for (int i = 0; i < 64; ++i)
+    {
+        buffer.setSample(0, i, 0.1f);
+        buffer.setSample(1, i, 2.0f);
+    }
+
+    ClipStats stats;
+    clipper.processInternal(buffer.getArrayOfWritePointers(), kNumChannels, 64, &stats);
+
+    REQUIRE(stats.clippedFrames == 64);
+    REQUIRE(stats.maxGainReductionDb == Approx(12.04f).margin(0.01));
+}
+
+// =============================================================================
+// Engine Integration [meter][engine]
+// =============================================================================
+
+TEST_CASE("Clip meter: engine counts frames at the clip rate", "[meter][engine]")
+{
+    const int factorIndex = GENERATE(0, 2);
+    CAPTURE(factorIndex);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setCeiling(-6.0f);
+    engine.setClipMetering(true);
+    engine.reset();
+
+    auto buffer = generateSine(100.0f, kBlockSize, 0.9f);
+    engine.process(buffer);
+
+    const auto& stats = engine.getLastClipStats();
+    REQUIRE(stats.totalFrames == static_cast<std::uint64_t>(kBlockSize << factorIndex));
+    REQUIRE(stats.clippedFrames > 0);
+    REQUIRE(stats.maxGainReductionDb > 0.0f);
+
+    // The lock-free meter saw the same block
+    const auto collected = engine.getClipMeter().collect();
+    REQUIRE(collected.totalFrames == stats.totalFrames);
+    REQUIRE(collected.clippedFrames == stats.clippedFrames);
+    REQUIRE(collected.blocks == 1);
+    REQUIRE(collected.skippedBlocks == 0);
+}
+
+TEST_CASE("Clip meter: quiet hard-clipped material reports no clipping", "[meter][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setCurve(0);
+    engine.setOversamplingFactor(0);
+    engine.setClipMetering(true);
+    engine.reset();
+
+    auto buffer = generateSine(440.0f, kBlockSize, 0.25f);
+    engine.process(buffer);
+
+    REQUIRE(engine.getLastClipStats().clippedFrames == 0);
+    REQUIRE(engine.getLastClipStats().getClipPercentage() == 0.0f);
+}
+
+TEST_CASE("Clip meter: engine meters nothing unless metering is on", "[meter][engine]")
+{
+    ClipperEngine plain, metered;
+    for (auto* engine : { &plain, &metered })
+    {
+        engine->prepare(kSampleRate, kBlockSize, kNumChannels);
+        engine->setOversamplingFactor(2);
+        engine->setCeiling(-6.0f);
+        engine->reset();
+    }
+    metered.setClipMetering(true);
+
+    auto a = generateSine(100.0f, kBlockSize, 0.9f);
+    auto b = a;
+    plain.process(a);
+    metered.process(b);
+
+    REQUIRE(plain.getLastClipStats().totalFrames == 0);
+    REQUIRE(plain.getClipMeter().collect().blocks == 0);
+    REQUIRE(metered.getLastClipStats().clippedFrames > 0);
+
+    // Metering only reads the clipped signal
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+}
@@ -4,6 +4,9 @@
 #include "dsp/Clipper.h"
 #include "test_utils.h"
 
+#include <limits>
+#include <random>
+
 using Catch::Approx;
 using dsp::Clipper;
 using dsp::CurveType;
@@ -507,6 +510,34 @@ TEST_CASE("Stereo link: both channels below threshold pass unchanged", "[stereol
     REQUIRE(outR == Approx(inputR).margin(kClipperTolerance));
 }
 
+TEST_CASE("Stereo link: link groups only tie their own channels", "[stereolink]")
+{
+    // 5.1 style: L R C LFE Ls Rs, LFE unlinked, surrounds their own group
+    Clipper clipper;
+    clipper.prepare(6);
+    clipper.setCeiling(1.0f);
+    clipper.setCurve(CurveType::Hard);
+    clipper.setStereoLink(true);
+    clipper.setLinkGroups({ 0, 0, 0, -1, 1, 1 });
+
+    const float inputs[] = { 2.0f, 0.5f, 0.4f, 0.6f, 0.3f, 0.8f };
+    juce::AudioBuffer<float> buffer(6, 1);
+    for (int ch = 0; ch < 6; ++ch)
+        buffer.setSample(ch, 0, inputs[ch]);
+
+    clipper.process(buffer);
+
+    // Front group follows L's gain reduction
+    REQUIRE(buffer.getSample(0, 0) == Approx(1.0f).margin(kClipperTolerance));
+    REQUIRE(buffer.getSample(1, 0) == Approx(0.25f).margin(kClipperTolerance));
+    REQUIRE(buffer.getSample(2, 0) == Approx(0.2f).margin(kClipperTolerance));
+
+    // LFE and the unclipped surround group are untouched by the front's overload
+    REQUIRE(buffer.getSample(3, 0) == Approx(0.6f).margin(kClipperTolerance));
+    REQUIRE(buffer.getSample(4, 0) == Approx(0.3f).margin(kClipperTolerance));
+    REQUIRE(buffer.getSample(5, 0) == Approx(0.8f).margin(kClipperTolerance));
+}
+
 // =============================================================================
 // All Curve Types Test
 // =============================================================================
@@ -538,3 +569,359 @@ TEST_CASE("All curve types produce bounded output", "[curves]")
     // Output should always be bounded by ceiling
     REQUIRE(std::abs(output) <= 1.0f + kClipperTolerance);
 }
+
+TEST_CASE("Linked loops match scalar curve for every curve and ceiling", "[curves][stereolink]")
+{
+    auto curveType = GENERATE(
+        CurveType::Hard,
+        CurveType::Quintic,
+        CurveType::Cubic,
+        CurveType::Tanh,
+        CurveType::Arctan,
+        CurveType::Knee,
+        CurveType::T2
+    );
+    auto ceiling = GENERATE(1.0f, 0.5f);
+    auto exponent = GENERATE(1.5f, 3.0f);
+    CAPTURE(static_cast<int>(curveType), ceiling, exponent);
+
+    auto clipper = makeClipper();
+    clipper.setCeiling(ceiling);
+    clipper.setCurve(curveType);
+    clipper.setCurveExponent(exponent);
+    clipper.setStereoLink(true);
+
+    // Loud channel drives the gain reduction, quiet channel follows it
+    auto input = GENERATE(0.2f, 0.6f, 0.95f, 1.3f, 4.0f);
+    CAPTURE(input);
+
+    auto [outL, outR] = processStereoSample(clipper, input, -0.5f * input);
+
+    float expected = dsp::curves::applyWithCeiling(curveType, input, ceiling, exponent);
+    REQUIRE(outL == Approx(expected).margin(kClipperTolerance));
+    REQUIRE(outR == Approx(-0.5f * expected).margin(kClipperTolerance));
+}
+
+// =============================================================================
+// Antiderivative Anti-Aliasing Tests [adaa]
+// =============================================================================
+
+namespace {
+
+using Antialiasing = Clipper::Antialiasing;
+
+constexpr CurveType kAllCurves[] = {
+    CurveType::Hard, CurveType::Quintic, CurveType::Cubic, CurveType::Tanh,
+    CurveType::Arctan, CurveType::Knee, CurveType::T2
+};
+
+// Ratio (dB) of non-harmonic to harmonic power for a coherent sine of 'cycles'
+// periods per 4096 samples, measured on the second period once ADAA has settled.
+// cycles is odd, so no folded harmonic lands on a real one
+float measureAliasingDb(Antialiasing mode, CurveType curve, int cycles, float amplitude)
+{
+    constexpr int N = 4096;
+    Clipper clipper;
+    clipper.setCurve(curve);
+    clipper.setCurveExponent(2.0f);
+    clipper.setAntialiasing(mode);
+
+    juce::AudioBuffer<float> buffer(1, 2 * N);
+    for (int i = 0; i < 2 * N; ++i)
+        buffer.setSample(0, i, amplitude * static_cast<float>(std::sin(2.0 * kPi * cycles * i / N)));
+    clipper.process(buffer);
+
+    const float* y = buffer.getReadPointer(0) + N;
+    double harmonicPower = 0.0;
+    double aliasPower = 0.0;
+
+    for (int bin = 1; bin < N / 2; ++bin)
+    {
+        double re = 0.0;
+        double im = 0.0;
+        for (int n = 0; n < N; ++n)
+        {
+            const double phase = 2.0 * kPi * static_cast<double>((static_cast<long>(bin) * n) % N) / N;
+            re += y[n] * std::cos(phase);
+            im -= y[n] * std::sin(phase);
+        }
+
+        const double power = re * re + im * im;
+        if (bin % cycles == 0)
+            harmonicPower += power;
+        else
+            aliasPower += power;
+    }
+
+    return static_cast<float>(10.0 * std::log10(aliasPower / harmonicPower));
+}
+
+} // namespace
+
+TEST_CASE("ADAA antiderivatives: derivatives match the curves", "[adaa][curves]")
+{
+    constexpr double h = 1e-5;
+
+    for (CurveType curve : kAllCurves)
+    {
+        CAPTURE(static_cast<int>(curve));
+        REQUIRE(dsp::curves::antiderivative1(curve, 0.0) == Approx(0.0).margin(1e-12));
+        REQUIRE(dsp::curves::antiderivative2(curve, 0.0) == Approx(0.0).margin(1e-12));
+
+        // Offset grid stays clear of the kinks at the curve edges
+        for (double x = -3.013; x < 3.0; x += 0.05)
+        {
+            CAPTURE(x);
+            const double slope1 = (dsp::curves::antiderivative1(curve, x + h) - dsp::curves::antiderivative1(curve, x - h)) / (2.0 * h);
+            const double slope2 = (dsp::curves::antiderivative2(curve, x + h) - dsp::curves::antiderivative2(curve, x - h)) / (2.0 * h);
+
+            REQUIRE(slope1 == Approx(dsp::curves::apply(curve, static_cast<float>(x))).margin(1e-4));
+            REQUIRE(slope2 == Approx(dsp::curves::antiderivative1(curve, x)).margin(1e-4));
+        }
+    }
+}
+
+TEST_CASE("ADAA: slow signals follow the curve with the order's delay", "[adaa]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    auto curve = GENERATE(CurveType::Hard, CurveType::Tanh, CurveType::Knee);
+    CAPTURE(static_cast<int>(mode), static_cast<int>(curve));
+
+    Clipper clipper;
+    clipper.setCurve(curve);
+    clipper.setCeiling(0.5f);
+    clipper.setAntialiasing(mode);
+
+    auto input = generateSine(50.0f, kBlockSize * 4, 1.0f);
+    auto output = input;
+    clipper.process(output);
+
+    // First order sits half a sample behind, second order a whole sample
+    for (int i = 2; i < input.getNumSamples(); ++i)
+    {
+        const float delayed = (mode == Antialiasing::Adaa1)
+            ? 0.5f * (input.getSample(0, i) + input.getSample(0, i - 1))
+            : input.getSample(0, i - 1);
+        const float expected = dsp::curves::applyWithCeiling(curve, delayed, 0.5f);
+        REQUIRE(output.getSample(0, i) == Approx(expected).margin(2e-3));
+    }
+}
+
+TEST_CASE("ADAA: output never exceeds the ceiling", "[adaa]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    for (CurveType curve : kAllCurves)
+    {
+        CAPTURE(static_cast<int>(curve));
+        Clipper clipper;
+        clipper.setCurve(curve);
+        clipper.setCeiling(0.5f);
+        clipper.setAntialiasing(mode);
+
+        // Full-scale noise with large jumps between samples
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(0, i, dist(rng));
+        clipper.process(buffer);
+
+        REQUIRE(calculatePeak(buffer) <= 0.5f + kClipperTolerance);
+    }
+}
+
+TEST_CASE("ADAA: constant input settles to the curve value", "[adaa]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    auto level = GENERATE(0.3f, 2.0f, -5.0f);
+    CAPTURE(static_cast<int>(mode), level);
+
+    for (CurveType curve : kAllCurves)
+    {
+        CAPTURE(static_cast<int>(curve));
+        Clipper clipper;
+        clipper.setCurve(curve);
+        clipper.setAntialiasing(mode);
+
+        auto buffer = generateDC(level, 16);
+        clipper.process(buffer);
+
+        // Equal neighbours take the midpoint fallback - no 0/0
+        REQUIRE(buffer.getSample(0, 15) == Approx(dsp::curves::apply(curve, level)).margin(kClipperTolerance));
+    }
+}
+
+TEST_CASE("ADAA: non-finite input does not stick in the history", "[adaa]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    Clipper clipper;
+    clipper.setCurve(CurveType::Tanh);
+    clipper.setAntialiasing(mode);
+
+    auto buffer = generateSine(440.0f, 64, 0.8f);
+    buffer.setSample(0, 10, std::numeric_limits<float>::quiet_NaN());
+    buffer.setSample(0, 20, std::numeric_limits<float>::infinity());
+    clipper.process(buffer);
+
+    for (int i = 24; i < buffer.getNumSamples(); ++i)
+        REQUIRE(std::isfinite(buffer.getSample(0, i)));
+}
+
+TEST_CASE("ADAA: a zero ceiling restarts the history from silence", "[adaa]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    Clipper clipper;
+    clipper.setCurve(CurveType::Tanh);
+    clipper.setAntialiasing(mode);
+
+    auto loud = generateDC(0.9f, 16);
+    clipper.process(loud);
+
+    clipper.setCeiling(0.0f);
+    auto muted = generateDC(0.9f, 16);
+    clipper.process(muted);
+    REQUIRE(calculatePeak(muted) == 0.0f);
+
+    // Back from silence the first output averages the new input with the
+    // zeros just output, not with the input from before the mute
+    clipper.setCeiling(1.0f);
+    auto quiet = generateDC(-0.01f, 16);
+    clipper.process(quiet);
+
+    const float expected = (mode == Antialiasing::Adaa1) ? -0.01f / 2.0f : -0.01f / 3.0f;
+    REQUIRE(quiet.getSample(0, 0) == Approx(expected).margin(1.0e-4f));
+}
+
+TEST_CASE("ADAA stereo link: quiet channel takes the loud channel's gain", "[adaa][stereolink]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    auto curve = GENERATE(CurveType::Hard, CurveType::Tanh, CurveType::T2);
+    CAPTURE(static_cast<int>(mode), static_cast<int>(curve));
+
+    Clipper clipper;
+    clipper.setCurve(curve);
+    clipper.setAntialiasing(mode);
+    clipper.setStereoLink(true);
+
+    // R is L at a quarter of the level - it stays below the ceiling alone
+    auto buffer = generateSine(440.0f, kBlockSize, 3.0f);
+    for (int i = 0; i < kBlockSize; ++i)
+        buffer.setSample(1, i, 0.25f * buffer.getSample(0, i));
+    clipper.process(buffer);
+
+    for (int i = 0; i < kBlockSize; ++i)
+        REQUIRE(buffer.getSample(1, i) == Approx(0.25f * buffer.getSample(0, i)).margin(1e-5));
+    REQUIRE(calculatePeak(buffer) <= 1.0f + kClipperTolerance);
+    REQUIRE(calculatePeak(buffer) > 0.9f);
+}
+
+TEST_CASE("ADAA stereo link: matches unlinked ADAA where nothing clips", "[adaa][stereolink]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    Clipper linked, unlinked;
+    for (auto* clipper : { &linked, &unlinked })
+    {
+        clipper->setCurve(CurveType::Hard);
+        clipper->setAntialiasing(mode);
+    }
+    linked.setStereoLink(true);
+
+    auto a = generateSine(440.0f, kBlockSize, 0.9f);
+    for (int i = 0; i < kBlockSize; ++i)
+        a.setSample(1, i, 0.7f * static_cast<float>(std::sin(2.0 * kPi * 1234.0 * i / kSampleRate)));
+    auto b = a;
+    linked.process(a);
+    unlinked.process(b);
+
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            REQUIRE(a.getSample(ch, i) == Approx(b.getSample(ch, i)).margin(1e-6));
+}
+
+TEST_CASE("ADAA stereo link: output never exceeds the ceiling", "[adaa][stereolink]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    for (CurveType curve : kAllCurves)
+    {
+        CAPTURE(static_cast<int>(curve));
+        Clipper clipper;
+        clipper.setCurve(curve);
+        clipper.setCeiling(0.5f);
+        clipper.setAntialiasing(mode);
+        clipper.setStereoLink(true);
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, (ch == 0 ? 1.0f : 0.1f) * dist(rng));
+        clipper.process(buffer);
+
+        REQUIRE(calculatePeak(buffer) <= 0.5f + kClipperTolerance);
+    }
+}
+
+TEST_CASE("ADAA stereo link: toggling link mid-stream stays continuous", "[adaa][stereolink]")
+{
+    auto mode = GENERATE(Antialiasing::Adaa1, Antialiasing::Adaa2);
+    CAPTURE(static_cast<int>(mode));
+
+    Clipper clipper;
+    clipper.setCurve(CurveType::Tanh);
+    clipper.setAntialiasing(mode);
+
+    // A 100Hz sine at 2.0 moves ~0.03 per sample before the curve
+    const double phaseIncrement = 2.0 * kPi * 100.0 / kSampleRate;
+    float previous = 0.0f;
+    float maxStep = 0.0f;
+
+    for (int block = 0; block < 6; ++block)
+    {
+        clipper.setStereoLink(block % 2 == 1);
+
+        juce::AudioBuffer<float> buffer(2, 64);
+        for (int i = 0; i < 64; ++i)
+        {
+            const float x = 2.0f * static_cast<float>(std::sin(phaseIncrement * (block * 64 + i)));
+            buffer.setSample(0, i, x);
+            buffer.setSample(1, i, 0.5f * x);
+        }
+        clipper.process(buffer);
+
+        for (int i = 0; i < 64; ++i)
+        {
+            if (block > 0 || i > 0)
+                maxStep = std::max(maxStep, std::abs(buffer.getSample(0, i) - previous));
+            previous = buffer.getSample(0, i);
+        }
+    }
+
+    REQUIRE(maxStep < 0.05f);
+}
+
+TEST_CASE("ADAA: each order lowers aliasing at 1x", "[adaa][aliasing]")
+{
+    auto curve = GENERATE(CurveType::Hard, CurveType::Cubic, CurveType::Tanh, CurveType::Arctan);
+    CAPTURE(static_cast<int>(curve));
+
+    // ~5kHz at 44.1kHz, driven 12dB into the curve
+    constexpr int cycles = 465;
+    const float off = measureAliasingDb(Antialiasing::Off, curve, cycles, 4.0f);
+    const float first = measureAliasingDb(Antialiasing::Adaa1, curve, cycles, 4.0f);
+    const float second = measureAliasingDb(Antialiasing::Adaa2, curve, cycles, 4.0f);
+    CAPTURE(off, first, second);
+
+    REQUIRE(first < off - 5.0f);
+    REQUIRE(second < first - 5.0f);
+}
@@ -4,6 +4,9 @@
 #include "dsp/ClipperEngine.h"
 #include "test_utils.h"
 
+#include <tuple>
+#include <vector>
+
 using Catch::Approx;
 using dsp::ClipperEngine;
 using dsp::CurveType;
@@ -47,6 +50,63 @@ TEST_CASE("Engine latency: linear-phase all factors", "[engine][latency]")
     }
 }
 
+TEST_CASE("Engine latency: ADAA adds its delay rounded at the base rate", "[engine][latency][adaa]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+
+    // Half a clip-rate sample (1st order) or one (2nd order), divided by the factor
+    constexpr int kExtraLatency[2][3] = { { 1, 0, 0 }, { 1, 1, 0 } };
+
+    for (int order = 1; order <= 2; ++order)
+    {
+        for (int i = 0; i <= 2; ++i)
+        {
+            CAPTURE(order, i);
+            engine.setOversamplingFactor(i);
+            engine.setAntialiasing(0);
+            const int baseLatency = engine.getLatencyInSamples();
+
+            engine.setAntialiasing(order);
+            REQUIRE(engine.getLatencyInSamples() == baseLatency + kExtraLatency[order - 1][i]);
+        }
+    }
+}
+
+TEST_CASE("Engine latency: low latency folds ADAA into its compensation", "[engine][latency][lowlatency]")
+{
+    auto order = GENERATE(0, 1, 2);
+    CAPTURE(order);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setFilterType(2);  // Low latency
+    engine.setOversamplingFactor(2);
+    engine.setAntialiasing(order);
+
+    // Under 1ms at 4x, and no more than minimum phase without ADAA
+    REQUIRE(engine.getLatencyInSamples() < static_cast<int>(kSampleRate * 0.001));
+    REQUIRE(engine.getLatencyInSamples() <= kExpectedLatencyMinPhase[2]);
+
+    // A sine below the clip point comes out as the input delayed by exactly that
+    engine.setCeiling(0.0f);
+    engine.setCurve(0);
+    constexpr int kNumBlocks = 8;
+    auto input = generateSine(100.0f, kBlockSize * kNumBlocks, 0.25f);
+    auto output = input;
+    for (int block = 0; block < kNumBlocks; ++block)
+    {
+        juce::AudioBuffer<float> chunk(output.getArrayOfWritePointers(), kNumChannels, block * kBlockSize, kBlockSize);
+        engine.process(chunk);
+    }
+
+    const int latency = engine.getLatencyInSamples();
+    float maxError = 0.0f;
+    for (int i = 2 * kBlockSize; i < kNumBlocks * kBlockSize; ++i)
+        maxError = std::max(maxError, std::abs(output.getSample(0, i) - input.getSample(0, i - latency)));
+    REQUIRE(maxError < 0.001f);
+}
+
 TEST_CASE("Engine latency: consistent across multiple queries", "[engine][latency]")
 {
     ClipperEngine engine;
@@ -354,6 +414,47 @@ TEST_CASE("Engine M/S: disabled passes L/R unchanged", "[engine][ms]")
     }
 }
 
+TEST_CASE("Engine M/S: surround pairs round-trip and stay linked within groups", "[engine][ms][surround]")
+{
+    // 7.1.4: L R C LFE Lss Rss Lrs Rrs Ltf Rtf Ltr Rtr
+    constexpr int kChannels = 12;
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kChannels);
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(kChannels));
+    engine.setCeiling(0.0f);
+    engine.setCurve(static_cast<int>(CurveType::Hard));
+    engine.setOversamplingFactor(0);
+    engine.setChannelMode(true);
+    engine.setStereoLink(true);
+    engine.setEnforceCeiling(true);
+
+    // Everything under the ceiling: M/S on every pair must be an identity
+    juce::AudioBuffer<float> buffer(kChannels, kBlockSize);
+    for (int ch = 0; ch < kChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(ch, i, 0.05f * static_cast<float>(ch + 1) * (ch % 2 == 0 ? 1.0f : -0.5f));
+
+    const auto input = buffer;
+    engine.process(buffer);
+
+    for (int ch = 0; ch < kChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            REQUIRE(buffer.getSample(ch, i) == Approx(input.getSample(ch, i)).margin(0.001f));
+
+    // An overloaded LFE is clipped on its own - the mains aren't ducked under it
+    engine.setChannelMode(false);
+    for (int ch = 0; ch < kChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(ch, i, ch == 3 ? 2.0f : 0.5f);
+
+    engine.process(buffer);
+
+    REQUIRE(buffer.getSample(3, kBlockSize - 1) == Approx(1.0f).margin(0.001f));
+    for (int ch = 0; ch < kChannels; ++ch)
+        if (ch != 3)
+            REQUIRE(buffer.getSample(ch, kBlockSize - 1) == Approx(0.5f).margin(0.001f));
+}
+
 // =============================================================================
 // Reset Tests [engine][reset]
 // =============================================================================
@@ -473,3 +574,1013 @@ TEST_CASE("Engine reset: consistent behavior across multiple resets", "[engine][
         REQUIRE(peak < 0.001f);
     }
 }
+
+// =============================================================================
+// Oversampling Switch Tests [engine][switch]
+// =============================================================================
+
+namespace {
+
+// Max sample-to-sample step of a continuous sine pushed through the engine in
+// blocks, with the oversampling factor switched before block switchBlock
+float maxStepAcrossSwitch(ClipperEngine& engine, int fromFactor, int toFactor, int switchBlock)
+{
+    constexpr int numBlocks = 8;
+    const double phaseIncrement = 2.0 * kPi * 1000.0 / kSampleRate;
+    float previous = 0.0f;
+    float maxStep = 0.0f;
+
+    engine.setOversamplingFactor(fromFactor);
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        if (block == switchBlock)
+            engine.setOversamplingFactor(toFactor);
+
+        juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, 0.5f * static_cast<float>(std::sin(phaseIncrement * (block * kBlockSize + i))));
+
+        engine.process(buffer);
+
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float sample = buffer.getSample(0, i);
+            if (block >= 2)
+                maxStep = std::max(maxStep, std::abs(sample - previous));
+            previous = sample;
+        }
+    }
+
+    return maxStep;
+}
+
+} // namespace
+
+TEST_CASE("Engine switch: factor change crossfades without a jump", "[engine][switch]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingEngine(true);  // Filter state starts from silence on switch
+    engine.setCeiling(0.0f);
+
+    auto toFactor = GENERATE(2, 3, 5);
+    CAPTURE(toFactor);
+
+    // A 1kHz sine at 0.5 moves at most ~0.07 per sample - a hard switch into
+    // cold filters drops towards zero for a few samples
+    const float maxStep = maxStepAcrossSwitch(engine, 0, toFactor, 4);
+    REQUIRE(maxStep < 0.1f);
+}
+
+TEST_CASE("Engine switch: output settles to the new configuration", "[engine][switch]")
+{
+    ClipperEngine switched, fresh;
+    for (auto* engine : { &switched, &fresh })
+    {
+        engine->prepare(kSampleRate, kBlockSize, kNumChannels);
+        engine->setOversamplingEngine(true);
+        engine->setCeiling(-6.0f);
+    }
+
+    // Same continuous input; one engine switches 1x -> 4x at block 1, the other
+    // runs 4x throughout. Once the 5ms fade is over both must match closely
+    switched.setOversamplingFactor(0);
+    fresh.setOversamplingFactor(2);
+
+    const double phaseIncrement = 2.0 * kPi * 1000.0 / kSampleRate;
+    float maxDifference = 0.0f;
+
+    for (int block = 0; block < 8; ++block)
+    {
+        if (block == 1)
+            switched.setOversamplingFactor(2);
+
+        juce::AudioBuffer<float> a(kNumChannels, kBlockSize), b(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const float x = 0.8f * static_cast<float>(std::sin(phaseIncrement * (block * kBlockSize + i)));
+                a.setSample(ch, i, x);
+                b.setSample(ch, i, x);
+            }
+
+        switched.process(a);
+        fresh.process(b);
+
+        if (block >= 4)
+            for (int i = 0; i < kBlockSize; ++i)
+                maxDifference = std::max(maxDifference, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+    }
+
+    REQUIRE(maxDifference < 1e-3f);
+}
+
+// =============================================================================
+// Auto Oversampling Tests [engine][auto]
+// =============================================================================
+
+namespace {
+
+// Continuous 1kHz sine for one block, amplitude per block
+juce::AudioBuffer<float> sineBlock(int block, float amplitude)
+{
+    const double phaseIncrement = 2.0 * kPi * 1000.0 / kSampleRate;
+    juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(ch, i, amplitude * static_cast<float>(std::sin(phaseIncrement * (block * kBlockSize + i))));
+    return buffer;
+}
+
+// Past the 100ms hold and the 5ms fade at 44.1kHz / 512
+constexpr int kBlocksToSleep = 12;
+
+void prepareAutoEngine(ClipperEngine& engine, bool autoOversampling)
+{
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingEngine(true);
+    engine.setOversamplingFactor(2);
+    engine.setCeiling(-6.0f);
+    engine.setAutoOversampling(autoOversampling);
+}
+
+} // namespace
+
+TEST_CASE("Engine auto: quiet input sleeps behind a delay matched to the clip path", "[engine][auto]")
+{
+    // ADAA adds half or a whole clip-rate sample and smooths, the delay has to follow
+    auto antialiasing = GENERATE(0, 1, 2);
+    CAPTURE(antialiasing);
+
+    ClipperEngine automatic, always;
+    prepareAutoEngine(automatic, true);
+    prepareAutoEngine(always, false);
+    automatic.setAntialiasing(antialiasing);
+    always.setAntialiasing(antialiasing);
+
+    // Hard curve is linear up to the ceiling (0.5); 0.2 leaves the headroom
+    float maxDifference = 0.0f;
+    for (int block = 0; block < kBlocksToSleep + 4; ++block)
+    {
+        auto a = sineBlock(block, 0.2f);
+        auto b = sineBlock(block, 0.2f);
+        automatic.process(a);
+        always.process(b);
+
+        if (block >= kBlocksToSleep)
+            for (int i = 0; i < kBlockSize; ++i)
+                maxDifference = std::max(maxDifference, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+    }
+
+    REQUIRE_FALSE(automatic.isOversamplingPathActive());
+
+    // Asleep, the output is what the clip path would have passed. A delay
+    // rounded to whole samples is off by more than 1e-3 here
+    CAPTURE(maxDifference);
+    REQUIRE(maxDifference < 2e-4f);
+}
+
+TEST_CASE("Engine auto: loud input wakes the clip path warm", "[engine][auto]")
+{
+    ClipperEngine automatic, always;
+    prepareAutoEngine(automatic, true);
+    prepareAutoEngine(always, false);
+
+    float maxDifference = 0.0f;
+    for (int block = 0; block < kBlocksToSleep + 8; ++block)
+    {
+        const float amplitude = (block < kBlocksToSleep) ? 0.2f : 0.9f;
+        auto a = sineBlock(block, amplitude);
+        auto b = sineBlock(block, amplitude);
+        automatic.process(a);
+        always.process(b);
+
+        // One block for the fade, then both must clip the same way
+        if (block > kBlocksToSleep)
+            for (int i = 0; i < kBlockSize; ++i)
+                maxDifference = std::max(maxDifference, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+    }
+
+    REQUIRE(automatic.isOversamplingPathActive());
+    REQUIRE(maxDifference < 1e-3f);
+}
+
+TEST_CASE("Engine auto: a burst after quiet input is clipped from its first sample", "[engine][auto]")
+{
+    auto filterType = GENERATE(0, 2);  // Minimum phase (polyphase), low latency
+    auto onset = GENERATE(0, 100);     // Burst start within the waking block
+    CAPTURE(filterType, onset);
+
+    // Without the ceiling clamp, anything the wake lets through unclipped shows
+    ClipperEngine automatic, always;
+    for (auto* engine : { &automatic, &always })
+    {
+        prepareAutoEngine(*engine, engine == &automatic);
+        engine->setFilterType(filterType);
+        engine->setEnforceCeiling(false);
+    }
+
+    const int burstStart = (kBlocksToSleep + 1) * kBlockSize + onset;
+    const double phaseIncrement = 2.0 * kPi * 1000.0 / kSampleRate;
+    float autoPeak = 0.0f, alwaysPeak = 0.0f;
+
+    for (int block = 0; block < kBlocksToSleep + 4; ++block)
+    {
+        juce::AudioBuffer<float> a(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const int n = block * kBlockSize + i;
+                const double phase = phaseIncrement * n;
+                a.setSample(ch, i, (n < burstStart) ? 0.05f * static_cast<float>(std::sin(phase))
+                                                    : 0.95f * static_cast<float>(std::sin(phase + 1.3)));
+            }
+        }
+        auto b = a;
+
+        automatic.process(a);
+        always.process(b);
+
+        if (block == kBlocksToSleep)
+            REQUIRE_FALSE(automatic.isOversamplingPathActive());
+
+        autoPeak = std::max(autoPeak, calculatePeak(a, 0, kBlockSize));
+        alwaysPeak = std::max(alwaysPeak, calculatePeak(b, 0, kBlockSize));
+    }
+
+    // The ceiling is 0.5. The filters ring up to 20% past it on either path,
+    // an onset that slips through unclipped reaches the input's 0.95
+    CAPTURE(autoPeak, alwaysPeak);
+    REQUIRE(autoPeak <= alwaysPeak + 1e-4f);
+    REQUIRE(autoPeak < 0.65f);
+}
+
+TEST_CASE("Engine auto: sleeping and waking fade without a jump", "[engine][auto]")
+{
+    ClipperEngine engine;
+    prepareAutoEngine(engine, true);
+
+    // 0.3 crosses the -6dB headroom under the 0.5 ceiling without clipping, so
+    // the output should move no more than the input does (the amplitude steps
+    // at block edges included). A cold or misaligned switch jumps well past it
+    float previousIn = 0.0f, previousOut = 0.0f;
+    float maxInputStep = 0.0f, maxOutputStep = 0.0f;
+    int transitions = 0;
+    bool wasActive = engine.isOversamplingPathActive();
+
+    for (int block = 0; block < 4 * kBlocksToSleep; ++block)
+    {
+        const float amplitude = ((block / kBlocksToSleep) % 2 == 0) ? 0.2f : 0.3f;
+        auto buffer = sineBlock(block, amplitude);
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float sample = buffer.getSample(0, i);
+            if (block > 0)
+                maxInputStep = std::max(maxInputStep, std::abs(sample - previousIn));
+            previousIn = sample;
+        }
+
+        engine.process(buffer);
+
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float sample = buffer.getSample(0, i);
+            if (block > 0)
+                maxOutputStep = std::max(maxOutputStep, std::abs(sample - previousOut));
+            previousOut = sample;
+        }
+
+        if (engine.isOversamplingPathActive() != wasActive)
+            ++transitions;
+        wasActive = engine.isOversamplingPathActive();
+    }
+
+    CAPTURE(transitions, maxInputStep, maxOutputStep);
+    REQUIRE(transitions >= 3);
+    REQUIRE(maxOutputStep < maxInputStep + 0.01f);
+}
+
+TEST_CASE("Engine auto: curves that shape every level never sleep", "[engine][auto]")
+{
+    auto curve = GENERATE(4, 6);  // Arctan, T2
+    CAPTURE(curve);
+
+    ClipperEngine engine;
+    prepareAutoEngine(engine, true);
+    engine.setCurve(curve);
+    engine.setCurveExponent(2.0f);
+
+    for (int block = 0; block < kBlocksToSleep + 4; ++block)
+    {
+        auto buffer = sineBlock(block, 0.01f);
+        engine.process(buffer);
+    }
+
+    REQUIRE(engine.isOversamplingPathActive());
+}
+
+TEST_CASE("Engine auto: delta monitoring keeps the clip path running", "[engine][auto]")
+{
+    ClipperEngine engine;
+    prepareAutoEngine(engine, true);
+    engine.setDeltaMonitor(true);
+
+    for (int block = 0; block < kBlocksToSleep + 4; ++block)
+    {
+        auto buffer = sineBlock(block, 0.01f);
+        engine.process(buffer);
+    }
+
+    REQUIRE(engine.isOversamplingPathActive());
+}
+
+// =============================================================================
+// Double Precision Tests [engine][double]
+// =============================================================================
+
+namespace {
+
+// Same tone in both precisions, written at double resolution
+juce::AudioBuffer<double> toDouble(const juce::AudioBuffer<float>& buffer)
+{
+    juce::AudioBuffer<double> result(buffer.getNumChannels(), buffer.getNumSamples());
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            result.setSample(ch, i, static_cast<double>(buffer.getSample(ch, i)));
+    return result;
+}
+
+template <typename Engine>
+void configureForComparison(Engine& engine, int factorIndex, bool linearPhase, bool polyphase, int curve)
+{
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setFilterType(linearPhase);
+    engine.setOversamplingEngine(polyphase);
+    engine.setCurve(curve);
+    engine.setInputGain(6.0f);
+    engine.setCeiling(-3.0f);
+    engine.setTruePeakMode(true);
+}
+
+} // namespace
+
+TEST_CASE("Engine double: output tracks the float engine", "[engine][double]")
+{
+    auto factorIndex = GENERATE(0, 2, 4);
+    auto linearPhase = GENERATE(false, true);
+    auto polyphase = GENERATE(false, true);
+    auto curve = GENERATE(0, 3, 5);
+    CAPTURE(factorIndex, linearPhase, polyphase, curve);
+
+    ClipperEngine single;
+    dsp::ClipperEngineDouble precise;
+    configureForComparison(single, factorIndex, linearPhase, polyphase, curve);
+    configureForComparison(precise, factorIndex, linearPhase, polyphase, curve);
+    REQUIRE(precise.getLatencyInSamples() == single.getLatencyInSamples());
+
+    double maxDifference = 0.0;
+    for (int block = 0; block < 8; ++block)
+    {
+        auto a = generateSine(997.0f, kBlockSize, 0.9f);
+        auto b = toDouble(a);
+        single.process(a);
+        precise.process(b);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                maxDifference = std::max(maxDifference, std::abs(b.getSample(ch, i) - a.getSample(ch, i)));
+    }
+
+    // Float rounding through the filters, well under -80dB
+    REQUIRE(maxDifference < 1e-4);
+    REQUIRE(precise.getLastPreClipPeak() == Approx(single.getLastPreClipPeak()).margin(1e-5f));
+}
+
+TEST_CASE("Engine double: unclipped signal keeps double resolution", "[engine][double]")
+{
+    dsp::ClipperEngineDouble engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);
+
+    // Steps of 1e-12 vanish in float (ulp at 0.25 is 3e-8). At 1x, unity gain
+    // and below the ceiling the hard curve passes them through untouched
+    juce::AudioBuffer<double> buffer(kNumChannels, kBlockSize);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(ch, i, 0.25 + 1e-12 * i);
+
+    auto input = buffer;
+    engine.process(buffer);
+
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            REQUIRE(buffer.getSample(ch, i) == input.getSample(ch, i));
+}
+
+TEST_CASE("Engine double: approximated curves carry the kernels' float accuracy", "[engine][double]")
+{
+    auto curve = GENERATE(CurveType::Tanh, CurveType::Arctan, CurveType::T2);
+    CAPTURE(static_cast<int>(curve));
+
+    dsp::ClipperEngineDouble engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);
+    engine.setCurve(static_cast<int>(curve));
+    engine.setCurveExponent(2.5f);
+    engine.setCeiling(-6.0f);
+
+    juce::AudioBuffer<double> buffer(kNumChannels, kBlockSize);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            buffer.setSample(ch, i, 1.5 * std::sin(2.0 * kPi * 997.0 * i / kSampleRate));
+
+    auto input = buffer;
+    engine.process(buffer);
+
+    // Not full double precision: the block kernels approximate these curves to
+    // ~1e-6 of ceiling in double as in float. Exact curves (Hard, Cubic, Knee) stay exact
+    const double ceiling = juce::Decibels::decibelsToGain(-6.0);
+    double maxError = 0.0;
+    for (int i = 0; i < kBlockSize; ++i)
+    {
+        const double exact = dsp::curves::applyWithCeiling(curve, input.getSample(0, i), ceiling, 2.5f);
+        maxError = std::max(maxError, std::abs(buffer.getSample(0, i) - exact) / ceiling);
+    }
+    CAPTURE(maxError);
+    REQUIRE(maxError < 1.0e-5);
+}
+
+// =============================================================================
+// Worker Threads [engine][threads]
+// =============================================================================
+
+namespace {
+
+void configureWide(ClipperEngine& engine, int channels, int threads, int factorIndex, bool linearPhase, bool polyphase)
+{
+    engine.setWorkerThreads(threads);
+    engine.prepare(kSampleRate, kBlockSize, channels);
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(channels));
+    engine.setOversamplingFactor(factorIndex);
+    engine.setFilterType(linearPhase);
+    engine.setOversamplingEngine(polyphase);
+    engine.setCurve(3);
+    engine.setInputGain(6.0f);
+    engine.setCeiling(-3.0f);
+}
+
+juce::AudioBuffer<float> generateWide(int channels, int block)
+{
+    juce::AudioBuffer<float> buffer(channels, kBlockSize);
+    for (int ch = 0; ch < channels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const int n = block * kBlockSize + i;
+            buffer.setSample(ch, i, 0.9f * static_cast<float>(std::sin(2.0 * kPi * 220.0 * (ch + 1) * n / kSampleRate)));
+        }
+    return buffer;
+}
+
+} // namespace
+
+TEST_CASE("Engine threads: output matches the single-threaded engine exactly", "[engine][threads]")
+{
+    // Only the oversampling filters are split, per channel, so every thread
+    // count has to give the same bits as the inline path
+    auto channels = GENERATE(2, 6, 12);
+    auto threads = GENERATE(1, 3);
+    auto factorIndex = GENERATE(2, 5);
+    auto linearPhase = GENERATE(false, true);
+    auto polyphase = GENERATE(false, true);
+    CAPTURE(channels, threads, factorIndex, linearPhase, polyphase);
+
+    ClipperEngine serial, threaded;
+    configureWide(serial, channels, 0, factorIndex, linearPhase, polyphase);
+    configureWide(threaded, channels, threads, factorIndex, linearPhase, polyphase);
+    REQUIRE(threaded.getWorkerThreads() == threads);
+    REQUIRE(threaded.getLatencyInSamples() == serial.getLatencyInSamples());
+
+    for (int block = 0; block < 12; ++block)
+    {
+        // Exercise the delta path, true peak and a factor switch crossfade on the way
+        const bool delta = (block >= 4 && block < 6);
+        for (auto* engine : { &serial, &threaded })
+        {
+            engine->setDeltaMonitor(delta);
+            engine->setTruePeakMode(block >= 6);
+            engine->setAutoOversampling(block >= 8);
+            if (block == 7)
+                engine->setOversamplingFactor(factorIndex - 1);
+        }
+
+        // A host switching between live and offline mid-stream
+        threaded.setWorkerThreadsActive(block % 3 != 1);
+
+        auto a = generateWide(channels, block);
+        auto b = a;
+        serial.process(a);
+        threaded.process(b);
+
+        for (int ch = 0; ch < channels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(b.getSample(ch, i) == a.getSample(ch, i));
+
+        REQUIRE(threaded.getLastPreClipPeak() == serial.getLastPreClipPeak());
+        REQUIRE(threaded.getLastPostClipPeak() == serial.getLastPostClipPeak());
+    }
+}
+
+TEST_CASE("Engine threads: more workers than channels are capped", "[engine][threads]")
+{
+    ClipperEngine engine;
+    configureWide(engine, 2, 7, 3, false, false);
+
+    auto buffer = generateWide(2, 0);
+    engine.process(buffer);
+    REQUIRE(calculatePeak(buffer) > 0.0f);
+
+    // Mono leaves nothing to split and stays inline
+    ClipperEngine mono;
+    configureWide(mono, 1, 3, 3, false, false);
+    auto single = generateWide(1, 0);
+    mono.process(single);
+    REQUIRE(calculatePeak(single) > 0.0f);
+}
+
+// =============================================================================
+// Parameter Snapshots [engine][params]
+// =============================================================================
+
+namespace {
+
+dsp::EngineParameters makeSnapshot(std::uint32_t version)
+{
+    dsp::EngineParameters parameters;
+    parameters.version = version;
+    parameters.inputGain = 6.0f;
+    parameters.outputGain = -1.5f;
+    parameters.ceiling = -3.0f;
+    parameters.curve = 5;
+    parameters.curveExponent = 2.5f;
+    parameters.oversampling = 3;
+    parameters.polyphaseAllpass = true;
+    parameters.efficientFilters = true;
+    parameters.antialiasing = 1;
+    parameters.midSide = true;
+    parameters.truePeak = true;
+    return parameters;
+}
+
+} // namespace
+
+TEST_CASE("Engine params: snapshot matches the individual setters", "[engine][params]")
+{
+    const auto parameters = makeSnapshot(1);
+
+    ClipperEngine viaSnapshot, viaSetters;
+    viaSnapshot.prepare(kSampleRate, kBlockSize, kNumChannels);
+    viaSetters.prepare(kSampleRate, kBlockSize, kNumChannels);
+
+    viaSnapshot.setParameters(parameters);
+    viaSetters.setInputGain(parameters.inputGain);
+    viaSetters.setOutputGain(parameters.outputGain);
+    viaSetters.setCeiling(parameters.ceiling);
+    viaSetters.setCurve(parameters.curve);
+    viaSetters.setCurveExponent(parameters.curveExponent);
+    viaSetters.setOversamplingFactor(parameters.oversampling);
+    viaSetters.setFilterType(parameters.filterType);
+    viaSetters.setOversamplingEngine(parameters.polyphaseAllpass);
+    viaSetters.setEfficientFilters(parameters.efficientFilters);
+    viaSetters.setAutoOversampling(parameters.autoOversampling);
+    viaSetters.setAntialiasing(parameters.antialiasing);
+    viaSetters.setChannelMode(parameters.midSide);
+    viaSetters.setStereoLink(parameters.stereoLink);
+    viaSetters.setDeltaMonitor(parameters.deltaMonitor);
+    viaSetters.setBypass(parameters.bypass);
+    viaSetters.setEnforceCeiling(parameters.enforceCeiling);
+    viaSetters.setTruePeakMode(parameters.truePeak);
+
+    REQUIRE(viaSnapshot.getLatencyInSamples() == viaSetters.getLatencyInSamples());
+
+    for (int block = 0; block < 4; ++block)
+    {
+        auto a = generateSine(997.0f, kBlockSize, 0.9f);
+        auto b = a;
+        viaSnapshot.setParameters(parameters);
+        viaSnapshot.process(a);
+        viaSetters.process(b);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+    }
+}
+
+TEST_CASE("Engine params: only a new version is applied", "[engine][params]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+
+    auto parameters = makeSnapshot(1);
+    engine.setParameters(parameters);
+    const int latency = engine.getLatencyInSamples();
+
+    // Same version: the changed field is ignored
+    parameters.oversampling = 0;
+    parameters.truePeak = false;
+    engine.setParameters(parameters);
+    REQUIRE(engine.getLatencyInSamples() == latency);
+
+    // New version: only now does it land
+    parameters.version = 2;
+    engine.setParameters(parameters);
+    REQUIRE(engine.getLatencyInSamples() < latency);
+
+    // prepare() forgets the snapshot, the same version applies again in full
+    engine.setOversamplingFactor(4);
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setParameters(parameters);
+
+    ClipperEngine reference;
+    reference.prepare(kSampleRate, kBlockSize, kNumChannels);
+    reference.setParameters(parameters);
+    REQUIRE(engine.getLatencyInSamples() == reference.getLatencyInSamples());
+}
+
+namespace {
+
+// Max sample-to-sample step of a continuous 1kHz sine at 0.5 through the
+// engine, calling beforeBlock(block) ahead of each block
+template <typename BeforeBlock>
+float maxStepAcrossChanges(ClipperEngine& engine, BeforeBlock&& beforeBlock)
+{
+    constexpr int numBlocks = 8;
+    const double phaseIncrement = 2.0 * kPi * 1000.0 / kSampleRate;
+    float previous = 0.0f;
+    float maxStep = 0.0f;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        beforeBlock(block);
+
+        juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, 0.5f * static_cast<float>(std::sin(phaseIncrement * (block * kBlockSize + i))));
+
+        engine.process(buffer);
+
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float sample = buffer.getSample(0, i);
+            if (block >= 2)
+                maxStep = std::max(maxStep, std::abs(sample - previous));
+            previous = sample;
+        }
+    }
+
+    return maxStep;
+}
+
+} // namespace
+
+TEST_CASE("Engine params: one snapshot changing several oversampler fields fades once", "[engine][params][switch]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+
+    dsp::EngineParameters first;
+    first.version = 1;
+    first.oversampling = 2;
+
+    // Factor and filter type together: switching per field would fade out of
+    // a freshly reset 8x minimum-phase configuration instead of the 4x one
+    auto second = first;
+    second.version = 2;
+    second.oversampling = 3;
+    second.filterType = 1;
+
+    // A 1kHz sine at 0.5 moves at most ~0.07 per sample - fading from cold
+    // filters drops towards zero for a few samples
+    const float maxStep = maxStepAcrossChanges(engine, [&](int block)
+    {
+        engine.setParameters(block < 3 ? first : second);
+    });
+    REQUIRE(maxStep < 0.1f);
+}
+
+TEST_CASE("Engine params: switching back mid-fade carries on from the mix", "[engine][params][switch]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+
+    dsp::EngineParameters first;
+    first.version = 1;
+    first.oversampling = 2;
+    first.polyphaseAllpass = true;
+
+    auto second = first;
+    second.version = 2;
+    second.oversampling = 4;
+
+    // Back to 4x 100 samples into the 5ms fade: the 4x filters were still
+    // running as the outgoing configuration and must not restart cold
+    auto third = first;
+    third.version = 3;
+
+    const float maxStep = maxStepAcrossChanges(engine, [&](int block)
+    {
+        if (block == 0)
+            engine.setParameters(first);
+        if (block == 3)
+        {
+            engine.setParameters(second);
+            REQUIRE(engine.addParameterEvent(100, third));
+        }
+    });
+    REQUIRE(maxStep < 0.1f);
+}
+
+// =============================================================================
+// Parameter Events [engine][events]
+// =============================================================================
+
+TEST_CASE("Engine events: split block matches processing the pieces", "[engine][events]")
+{
+    auto factorIndex = GENERATE(0, 2);
+    auto delta = GENERATE(false, true);
+    CAPTURE(factorIndex, delta);
+
+    auto first = makeSnapshot(1);
+    first.oversampling = factorIndex;
+    first.deltaMonitor = delta;
+    auto second = first;
+    second.version = 2;
+    second.ceiling = -9.0f;          // Ramps
+    second.curveExponent = 1.5f;
+    auto third = second;
+    third.version = 3;
+    third.oversampling = factorIndex + 1;  // Crossfades
+    third.antialiasing = 0;
+
+    ClipperEngine evented, pieces;
+    for (auto* engine : { &evented, &pieces })
+    {
+        engine->prepare(kSampleRate, kBlockSize, kNumChannels);
+        engine->setParameters(first);
+    }
+
+    constexpr int kFirstEvent = 100;
+    constexpr int kSecondEvent = 300;
+
+    for (int block = 0; block < 6; ++block)
+    {
+        auto a = generateSine(997.0f, kBlockSize, 0.9f);
+        auto b = a;
+
+        if (block == 2)
+        {
+            REQUIRE(evented.addParameterEvent(kFirstEvent, second));
+            REQUIRE(evented.addParameterEvent(kSecondEvent, third));
+            evented.process(a);
+
+            std::vector<dsp::EnvelopeBin> bins;
+            for (auto [start, end, next] : { std::tuple { 0, kFirstEvent, &second },
+                                             std::tuple { kFirstEvent, kSecondEvent, &third },
+                                             std::tuple { kSecondEvent, kBlockSize, static_cast<dsp::EngineParameters*>(nullptr) } })
+            {
+                juce::AudioBuffer<float> piece(b.getArrayOfWritePointers(), kNumChannels, start, end - start);
+                pieces.process(piece);
+                for (int i = 0; i < pieces.getNumEnvelopeBins(); ++i)
+                    bins.push_back(pieces.getEnvelopeBin(i));
+                if (next != nullptr)
+                    pieces.setParameters(*next);
+            }
+
+            // The bins of all pieces, in order, as one block's worth
+            REQUIRE(evented.getNumEnvelopeBins() == static_cast<int>(bins.size()));
+            for (size_t i = 0; i < bins.size(); ++i)
+            {
+                REQUIRE(evented.getEnvelopeBin(static_cast<int>(i)).preClip == bins[i].preClip);
+                REQUIRE(evented.getEnvelopeBin(static_cast<int>(i)).postClip == bins[i].postClip);
+            }
+        }
+        else
+        {
+            evented.process(a);
+            pieces.process(b);
+        }
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+    }
+
+    REQUIRE(evented.getLatencyInSamples() == pieces.getLatencyInSamples());
+}
+
+TEST_CASE("Engine events: late, out-of-order and overflowing events", "[engine][events]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setParameters(makeSnapshot(1));
+    REQUIRE(engine.getLatencyInSamples() > 0);
+
+    // Past the block: applied once the block is done
+    auto late = makeSnapshot(2);
+    late.oversampling = 0;
+    late.truePeak = false;
+    late.antialiasing = 0;
+    REQUIRE(engine.addParameterEvent(10 * kBlockSize, late));
+
+    auto buffer = generateSine(997.0f, kBlockSize, 0.5f);
+    engine.process(buffer);
+    REQUIRE(engine.getLatencyInSamples() == 0);
+
+    // Fixed capacity, earlier offsets than queued ones are moved up
+    for (int i = 0; i < ClipperEngine::maxParameterEvents; ++i)
+        REQUIRE(engine.addParameterEvent(ClipperEngine::maxParameterEvents - i, makeSnapshot(static_cast<std::uint32_t>(3 + i))));
+    REQUIRE_FALSE(engine.addParameterEvent(0, makeSnapshot(100)));
+
+    engine.process(buffer);
+    REQUIRE(calculatePeak(buffer) > 0.0f);
+}
+
+TEST_CASE("Engine events: ceiling automation ramps instead of stepping", "[engine][events]")
+{
+    auto factorIndex = GENERATE(0, 2);
+    auto curve = GENERATE(0, 3);
+    auto truePeak = GENERATE(false, true);
+    CAPTURE(factorIndex, curve, truePeak);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setOversamplingEngine(true);
+    engine.setCurve(curve);
+    engine.setCeiling(0.0f);
+    engine.setTruePeakMode(truePeak);
+
+    // Full-scale 100Hz: a ceiling step lands on a slope of ~0.014 per sample
+    constexpr int kBlocks = 6;
+    juce::AudioBuffer<float> output(kNumChannels, kBlocks * kBlockSize);
+    for (int block = 0; block < kBlocks; ++block)
+    {
+        juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, static_cast<float>(std::sin(2.0 * kPi * 100.0 * (block * kBlockSize + i) / kSampleRate)));
+
+        // -12dB in the middle of a block, at the top of a cycle (1433 = 3.25 periods)
+        if (block == 2)
+        {
+            auto lower = makeSnapshot(1);
+            lower.inputGain = 0.0f;
+            lower.outputGain = 0.0f;
+            lower.ceiling = -12.0f;
+            lower.curve = curve;
+            lower.oversampling = factorIndex;
+            lower.antialiasing = 0;
+            lower.midSide = false;
+            lower.truePeak = truePeak;
+            REQUIRE(engine.addParameterEvent(1433 - 2 * kBlockSize, lower));
+        }
+
+        engine.process(buffer);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            output.copyFrom(ch, block * kBlockSize, buffer, ch, 0, kBlockSize);
+    }
+
+    // A step of 1 - 0.25 would show as one huge sample-to-sample jump
+    float maxStep = 0.0f;
+    for (int i = 1; i < output.getNumSamples(); ++i)
+        maxStep = std::max(maxStep, std::abs(output.getSample(0, i) - output.getSample(0, i - 1)));
+    CAPTURE(maxStep);
+    REQUIRE(maxStep < 0.05f);
+
+    // And the new ceiling holds once the 2ms ramp is over
+    float settledPeak = 0.0f;
+    for (int i = 4 * kBlockSize; i < output.getNumSamples(); ++i)
+        settledPeak = std::max(settledPeak, std::abs(output.getSample(0, i)));
+    REQUIRE(settledPeak <= juce::Decibels::decibelsToGain(-12.0f) + 0.001f);
+}
+
+// =============================================================================
+// Silence Skip Tests [engine][silence]
+// =============================================================================
+
+namespace {
+
+// Linear phase, ADAA and the true-peak limiter: the longest tails the clip path has
+void prepareSilenceEngine(ClipperEngine& engine)
+{
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(2);
+    engine.setFilterType(true);
+    engine.setAntialiasing(1);
+    engine.setTruePeakMode(true);
+    engine.setCeiling(-6.0f);
+    engine.setClipMetering(true);
+}
+
+juce::AudioBuffer<float> silentBlock()
+{
+    juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+    buffer.clear();
+    return buffer;
+}
+
+} // namespace
+
+TEST_CASE("Engine silence: zero input skips the clip path after the tails", "[engine][silence]")
+{
+    ClipperEngine engine;
+    prepareSilenceEngine(engine);
+
+    auto burst = generateSine(1000.0f, kBlockSize, 0.9f);
+    engine.process(burst);
+    engine.getClipMeter().collect();
+
+    // The first silent block still carries the delayed tail of the burst
+    auto tail = silentBlock();
+    engine.process(tail);
+    REQUIRE_FALSE(engine.isSkippingSilence());
+    REQUIRE(tail.getMagnitude(0, kBlockSize) > 0.0f);
+
+    int skipped = 0;
+    for (int block = 1; block < kBlocksToSleep; ++block)
+    {
+        auto buffer = silentBlock();
+        engine.process(buffer);
+        skipped += engine.isSkippingSilence() ? 1 : 0;
+        REQUIRE(engine.getLastClipStats().totalFrames == static_cast<std::uint64_t>(kBlockSize * 4));
+    }
+
+    REQUIRE(engine.isSkippingSilence());
+    REQUIRE(skipped > 0);
+
+    const auto collected = engine.getClipMeter().collect();
+    REQUIRE(collected.blocks == static_cast<std::uint64_t>(kBlocksToSleep));
+    REQUIRE(collected.skippedBlocks == static_cast<std::uint64_t>(skipped));
+
+    auto buffer = silentBlock();
+    engine.process(buffer);
+    REQUIRE(buffer.getMagnitude(0, kBlockSize) == 0.0f);
+    REQUIRE(engine.getLastPreClipPeak() == 0.0f);
+    REQUIRE(engine.getLastPostClipPeak() == 0.0f);
+}
+
+TEST_CASE("Engine silence: audio after a skip matches a clean start", "[engine][silence]")
+{
+    ClipperEngine skipping, fresh;
+    prepareSilenceEngine(skipping);
+    prepareSilenceEngine(fresh);
+
+    auto burst = generateSine(1000.0f, kBlockSize, 0.9f);
+    skipping.process(burst);
+    for (int block = 0; block < kBlocksToSleep; ++block)
+    {
+        auto buffer = silentBlock();
+        skipping.process(buffer);
+    }
+    REQUIRE(skipping.isSkippingSilence());
+
+    // The skip left the clip path exactly as prepare() does
+    for (int block = 0; block < 4; ++block)
+    {
+        auto a = sineBlock(block, 0.9f);
+        auto b = a;
+        skipping.process(a);
+        fresh.process(b);
+        REQUIRE_FALSE(skipping.isSkippingSilence());
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+    }
+}
+
+TEST_CASE("Engine silence: auto oversampling's sleeping blocks count as skipped", "[engine][silence][auto]")
+{
+    ClipperEngine engine;
+    prepareAutoEngine(engine, true);
+    engine.setClipMetering(true);
+
+    for (int block = 0; block < kBlocksToSleep + 4; ++block)
+    {
+        auto buffer = sineBlock(block, 0.2f);
+        engine.process(buffer);
+    }
+
+    REQUIRE_FALSE(engine.isOversamplingPathActive());
+    REQUIRE_FALSE(engine.isSkippingSilence());
+
+    const auto collected = engine.getClipMeter().collect();
+    REQUIRE(collected.blocks == static_cast<std::uint64_t>(kBlocksToSleep + 4));
+    REQUIRE(collected.skippedBlocks >= 4);
+    REQUIRE(collected.skippedBlocks < collected.blocks);
+}
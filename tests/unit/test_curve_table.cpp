@@ -0,0 +1,362 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/CurveTable.h"
+#include "dsp/Clipper.h"
+#include "dsp/SaturatorKernels.h"
+#include "test_utils.h"
+
+#include <chrono>
+#include <limits>
+#include <random>
+#include <thread>
+
+using Catch::Approx;
+using dsp::CurveLookup;
+using dsp::CurveTable;
+using dsp::CurveType;
+namespace curves = dsp::curves;
+using namespace test_utils;
+
+namespace {
+
+using Interpolation = CurveTable::Interpolation;
+
+// Mix of quiet, near-ceiling and heavily driven samples, past Arctan's table range
+template <typename T = float>
+std::vector<T> makeTestSignal(int numSamples, T ceiling)
+{
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<T> dist(T(-100) * ceiling, T(100) * ceiling);
+
+    std::vector<T> signal(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i)
+    {
+        T sample = dist(rng);
+        if (i % 3 == 0)
+            sample *= T(0.01);
+        signal[static_cast<size_t>(i)] = sample;
+    }
+
+    signal[0] = T(0);
+    signal[1] = ceiling;
+    signal[2] = -ceiling;
+    return signal;
+}
+
+// Largest |table - exact| over a dense sweep of the unit curve
+double maxTableError(const CurveTable& table, float exponent)
+{
+    double maxError = 0.0;
+    for (int i = -200000; i <= 200000; ++i)
+    {
+        const double x = i * 0.0005;  // +-100
+        const double expected = curves::apply(table.getCurve(), x, exponent);
+        maxError = std::max(maxError, std::abs(table.evaluate(x) - expected));
+    }
+    return maxError;
+}
+
+template <typename T>
+T maxBlockError(const CurveTable& table, int numSamples, T ceiling, float exponent)
+{
+    const auto input = makeTestSignal(numSamples, ceiling);
+    auto output = input;
+    curves::applyBlock(table.getCurve(), output.data(), numSamples, ceiling, exponent, &table);
+
+    T maxError = T(0);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        const T expected = curves::applyWithCeiling(table.getCurve(), input[i], ceiling, exponent);
+        maxError = std::max(maxError, std::abs(expected - output[i]) / ceiling);
+    }
+    return maxError;
+}
+
+// acquire() only flags its request - this loop passes it on like the plugin's
+// service timer, and gives the builder a generous while
+const CurveTable* waitForTable(CurveLookup& lookup, CurveType curve, float exponent)
+{
+    for (int attempt = 0; attempt < 400; ++attempt)
+    {
+        if (const CurveTable* table = lookup.acquire(curve, exponent))
+            return table;
+        CurveLookup::serviceRequests();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// =============================================================================
+// Table Accuracy vs SaturatorCurves.h [curvetable]
+// =============================================================================
+
+TEST_CASE("Curve table: Hermite tables match the exact curves", "[curvetable]")
+{
+    auto curve = GENERATE(CurveType::Tanh, CurveType::Arctan, CurveType::T2);
+    auto exponent = GENERATE(1.0f, 1.5f, 2.0f, 4.0f);
+    auto size = GENERATE(2048, 4096);
+    CAPTURE(static_cast<int>(curve), exponent, size);
+
+    const CurveTable table(curve, exponent, { size, Interpolation::Hermite });
+    REQUIRE(maxTableError(table, exponent) < 1.0e-6);
+}
+
+TEST_CASE("Curve table: linear tables trade accuracy for size", "[curvetable]")
+{
+    auto curve = GENERATE(CurveType::Tanh, CurveType::Arctan, CurveType::T2);
+    CAPTURE(static_cast<int>(curve));
+
+    const float exponent = 2.0f;
+    const CurveTable coarse(curve, exponent, { 1024, Interpolation::Linear });
+    const CurveTable fine(curve, exponent, { 4096, Interpolation::Linear });
+    const CurveTable hermite(curve, exponent, { 1024, Interpolation::Hermite });
+
+    const double coarseError = maxTableError(coarse, exponent);
+    const double fineError = maxTableError(fine, exponent);
+    CAPTURE(coarseError, fineError);
+
+    // Second order: 4x the segments, about 1/16 the error
+    REQUIRE(fineError < 1.0e-4);
+    REQUIRE(fineError < coarseError / 8.0);
+    REQUIRE(maxTableError(hermite, exponent) < coarseError);
+}
+
+TEST_CASE("Curve table: size is clamped and only transcendental curves are tabulated", "[curvetable]")
+{
+    REQUIRE(CurveTable(CurveType::Tanh, 2.0f, { 1, Interpolation::Hermite }).getSize() == 16);
+    REQUIRE(CurveTable(CurveType::Tanh, 2.0f, { 1 << 20, Interpolation::Hermite }).getSize() == 65536);
+
+    REQUIRE(CurveTable::isTabulated(CurveType::Tanh));
+    REQUIRE(CurveTable::isTabulated(CurveType::Arctan));
+    REQUIRE(CurveTable::isTabulated(CurveType::T2));
+    REQUIRE_FALSE(CurveTable::isTabulated(CurveType::Hard));
+    REQUIRE_FALSE(CurveTable::isTabulated(CurveType::Knee));
+
+    // Only T2's table belongs to one exponent
+    const CurveTable tanh(CurveType::Tanh, 2.0f, {});
+    const CurveTable t2(CurveType::T2, 2.0f, {});
+    REQUIRE(tanh.matches(CurveType::Tanh, 3.0f));
+    REQUIRE_FALSE(tanh.matches(CurveType::Arctan, 2.0f));
+    REQUIRE(t2.matches(CurveType::T2, 2.0f));
+    REQUIRE_FALSE(t2.matches(CurveType::T2, 2.5f));
+}
+
+// =============================================================================
+// Block Kernels [curvetable][kernels]
+// =============================================================================
+
+TEST_CASE("Curve table: block kernel matches scalar applyWithCeiling", "[curvetable][kernels]")
+{
+    auto curve = GENERATE(CurveType::Tanh, CurveType::Arctan, CurveType::T2);
+    auto ceiling = GENERATE(1.0f, 0.5f, 0.1f);
+    auto numSamples = GENERATE(3, 17, 1021);
+    CAPTURE(static_cast<int>(curve), ceiling, numSamples);
+
+    const CurveTable table(curve, 2.5f, {});
+    REQUIRE(maxBlockError(table, numSamples, ceiling, 2.5f) < 2.0e-6f);
+    REQUIRE(maxBlockError(table, numSamples, static_cast<double>(ceiling), 2.5f) < 2.0e-6);
+}
+
+TEST_CASE("Curve table: linked kernel uses the table's gain", "[curvetable][kernels][stereolink]")
+{
+    const CurveTable table(CurveType::Tanh, 2.0f, {});
+    const auto left = makeTestSignal(300, 0.5f);
+    auto right = left;
+    for (auto& sample : right)
+        sample *= -0.3f;
+
+    auto outLeft = left;
+    auto outRight = right;
+    float* channels[] = { outLeft.data(), outRight.data() };
+    curves::applyLinkedBlock(CurveType::Tanh, channels, 2, 300, 0.5f, 2.0f, &table);
+
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        const float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        const float gain = (peak > 0.0f) ? std::abs(curves::applyWithCeiling(CurveType::Tanh, peak, 0.5f)) / peak : 1.0f;
+
+        REQUIRE(outLeft[i] == Approx(left[i] * gain).margin(2.0e-6f));
+        REQUIRE(outRight[i] == Approx(right[i] * gain).margin(2.0e-6f));
+    }
+}
+
+TEST_CASE("Curve table: a table for another curve or exponent is ignored", "[curvetable][kernels]")
+{
+    const auto input = makeTestSignal(kBlockSize, 1.0f);
+
+    auto approximated = input;
+    curves::applyBlock(CurveType::T2, approximated.data(), kBlockSize, 1.0f, 3.0f);
+
+    for (const auto& table : { CurveTable(CurveType::T2, 2.0f, {}), CurveTable(CurveType::Tanh, 3.0f, {}) })
+    {
+        auto output = input;
+        curves::applyBlock(CurveType::T2, output.data(), kBlockSize, 1.0f, 3.0f, &table);
+        REQUIRE(output == approximated);
+    }
+}
+
+TEST_CASE("Curve table: non-finite input behaves like the exact curves", "[curvetable][kernels]")
+{
+    auto curve = GENERATE(CurveType::Tanh, CurveType::Arctan, CurveType::T2);
+    CAPTURE(static_cast<int>(curve));
+
+    const CurveTable table(curve, 2.0f, {});
+    constexpr float inf = std::numeric_limits<float>::infinity();
+
+    // Enough samples for a full vector and a scalar tail
+    std::vector<float> data { inf, -inf, std::numeric_limits<float>::quiet_NaN(), 1.0e30f, -1.0e30f,
+                              inf, -inf, std::numeric_limits<float>::quiet_NaN(), 0.25f };
+    curves::applyBlock(curve, data.data(), static_cast<int>(data.size()), 0.5f, 2.0f, &table);
+
+    for (int base : { 0, 5 })
+    {
+        REQUIRE(data[static_cast<size_t>(base)] == Approx(0.5f));
+        REQUIRE(data[static_cast<size_t>(base + 1)] == Approx(-0.5f));
+        REQUIRE(std::isnan(data[static_cast<size_t>(base + 2)]));
+    }
+    REQUIRE(data[3] == Approx(0.5f));
+    REQUIRE(data[4] == Approx(-0.5f));
+}
+
+// =============================================================================
+// Background Rebuild [curvetable][lookup]
+// =============================================================================
+
+TEST_CASE("Curve lookup: nothing until a table is built", "[curvetable][lookup]")
+{
+    CurveLookup lookup;
+    REQUIRE(lookup.acquire(CurveType::Tanh, 2.0f) == nullptr);
+
+    lookup.build(CurveType::Tanh, 2.0f);
+    const CurveTable* table = lookup.acquire(CurveType::Tanh, 2.0f);
+    REQUIRE(table != nullptr);
+    REQUIRE(table->matches(CurveType::Tanh, 2.0f));
+
+    // Tanh ignores the exponent, so its table stays
+    REQUIRE(lookup.acquire(CurveType::Tanh, 3.5f) == table);
+}
+
+TEST_CASE("Curve lookup: an exponent change is rebuilt off the calling thread", "[curvetable][lookup]")
+{
+    CurveLookup lookup;
+    lookup.build(CurveType::T2, 2.0f);
+    REQUIRE(lookup.acquire(CurveType::T2, 2.0f) != nullptr);
+
+    // The old table no longer fits: the caller gets nothing until the builder is done
+    REQUIRE(lookup.acquire(CurveType::T2, 3.0f) == nullptr);
+
+    const CurveTable* rebuilt = waitForTable(lookup, CurveType::T2, 3.0f);
+    REQUIRE(rebuilt != nullptr);
+    REQUIRE(rebuilt->matches(CurveType::T2, 3.0f));
+
+    // Sweeping through many exponents settles on the last one asked for
+    for (int step = 0; step < 50; ++step)
+        lookup.acquire(CurveType::T2, 1.0f + 0.05f * static_cast<float>(step));
+
+    const CurveTable* last = waitForTable(lookup, CurveType::T2, 3.45f);
+    REQUIRE(last != nullptr);
+    REQUIRE(last->matches(CurveType::T2, 3.45f));
+}
+
+TEST_CASE("Curve lookup: a precision change rebuilds the current table", "[curvetable][lookup]")
+{
+    CurveLookup lookup;
+    lookup.build(CurveType::Arctan, 2.0f);
+    REQUIRE(lookup.acquire(CurveType::Arctan, 2.0f)->getSize() == CurveTable::Precision {}.size);
+
+    lookup.setPrecision({ 512, Interpolation::Linear });
+
+    const CurveTable* table = nullptr;
+    for (int attempt = 0; attempt < 400; ++attempt)
+    {
+        table = lookup.acquire(CurveType::Arctan, 2.0f);
+        if (table != nullptr && table->getSize() == 512)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    REQUIRE(table != nullptr);
+    REQUIRE(table->getSize() == 512);
+    REQUIRE(table->getPrecision().interpolation == Interpolation::Linear);
+}
+
+// =============================================================================
+// Clipper Integration [curvetable][clipper]
+// =============================================================================
+
+TEST_CASE("Curve table: clipper output matches the approximation kernels", "[curvetable][clipper]")
+{
+    auto curveIndex = GENERATE(3, 4, 6);
+    auto linked = GENERATE(false, true);
+    CAPTURE(curveIndex, linked);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    auto configure = [&](dsp::Clipper& clipper, bool useTable)
+    {
+        clipper.setCurve(curve);
+        clipper.setCurveExponent(3.0f);
+        clipper.setCeiling(0.5f);
+        clipper.setStereoLink(linked);
+        clipper.setCurveTable(useTable);
+        clipper.prepare(kNumChannels);
+    };
+
+    dsp::Clipper tabled;
+    dsp::Clipper approximated;
+    configure(tabled, true);
+    configure(approximated, false);
+
+    auto input = generateSine(997.0f, kBlockSize, 2.0f);
+    auto withTable = input;
+    auto withApproximation = input;
+    tabled.process(withTable);
+    approximated.process(withApproximation);
+
+    REQUIRE(tabled.isCurveTableActive());
+    REQUIRE_FALSE(approximated.isCurveTableActive());
+
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            REQUIRE(withTable.getSample(ch, i) == Approx(withApproximation.getSample(ch, i)).margin(2.0e-6f));
+}
+
+TEST_CASE("Curve table: curves without a table and ADAA keep their kernels", "[curvetable][clipper]")
+{
+    dsp::Clipper clipper;
+    clipper.setCurve(CurveType::Knee);
+    clipper.setCurveTable(true);
+    clipper.prepare(kNumChannels);
+
+    auto buffer = generateSine(997.0f, kBlockSize, 2.0f);
+    clipper.process(buffer);
+    REQUIRE_FALSE(clipper.isCurveTableActive());
+
+    clipper.setCurve(CurveType::Tanh);
+    clipper.setAntialiasing(dsp::Clipper::Antialiasing::Adaa1);
+    clipper.process(buffer);
+    REQUIRE_FALSE(clipper.isCurveTableActive());
+}
+
+TEST_CASE("Curve table: enabling tables after prepare still builds one", "[curvetable][clipper]")
+{
+    dsp::Clipper clipper;
+    clipper.setCurve(CurveType::Arctan);
+    clipper.prepare(kNumChannels);
+
+    // Prepared without tables, so nothing was asked of the builder yet
+    auto buffer = generateSine(997.0f, kBlockSize, 2.0f);
+    clipper.process(buffer);
+    REQUIRE_FALSE(clipper.isCurveTableActive());
+
+    clipper.setCurveTable(true);
+    for (int attempt = 0; attempt < 400 && !clipper.isCurveTableActive(); ++attempt)
+    {
+        dsp::CurveLookup::serviceRequests();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        clipper.process(buffer);
+    }
+    REQUIRE(clipper.isCurveTableActive());
+}
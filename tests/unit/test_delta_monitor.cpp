@@ -133,6 +133,31 @@ TEST_CASE("Engine delta: signal below ceiling produces silence", "[delta][engine
     REQUIRE(peak < 0.01f);
 }
 
+TEST_CASE("Engine delta: ADAA delay is matched on the dry signal", "[delta][engine][adaa]")
+{
+    auto order = GENERATE(1, 2);
+    auto factorIndex = GENERATE(0, 1);
+    CAPTURE(order, factorIndex);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setCeiling(0.0f);
+    engine.setCurve(static_cast<int>(CurveType::Hard));
+    engine.setOversamplingEngine(true);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setAntialiasing(order);
+    engine.setDeltaMonitor(true);
+
+    // Below the ceiling ADAA only delays and smooths - the dry copy gets the
+    // same treatment, so nothing is left over
+    for (int block = 0; block < 4; ++block)
+    {
+        auto buffer = generateSine(5000.0f, kBlockSize, 0.8f);
+        engine.process(buffer);
+        REQUIRE(calculatePeak(buffer) < 1e-4f);
+    }
+}
+
 TEST_CASE("Engine delta: signal above ceiling produces delta", "[delta][engine]")
 {
     ClipperEngine engine;
@@ -210,7 +235,7 @@ TEST_CASE("Engine delta: disabled outputs wet signal", "[delta][engine]")
 TEST_CASE("Engine delta: works with both filter types", "[delta][engine]")
 {
     // Delta monitoring should work with minimum-phase AND linear-phase
-    // Both oversamplers use same filter type for phase-matched cancellation
+    // The difference is downsampled through the wet filter chain for phase-matched cancellation
 
     auto isLinearPhase = GENERATE(false, true);
     CAPTURE(isLinearPhase);
@@ -241,3 +266,46 @@ TEST_CASE("Engine delta: works with both filter types", "[delta][engine]")
     // Delta should be non-zero (clipped amount)
     REQUIRE(maxPeak > 0.3f);  // Should have significant delta
 }
+
+TEST_CASE("Engine delta: wet + delta equals unclipped filtered signal", "[delta][engine][reconstruction]")
+{
+    // Delta is formed in the oversampled domain and shares the wet downsampler,
+    // so wet + delta must match the same chain with clipping disabled
+    auto usePolyphase = GENERATE(false, true);
+    auto isMidSide = GENERATE(false, true);
+    CAPTURE(usePolyphase, isMidSide);
+
+    auto makeEngine = [&](float ceilingDb, bool delta)
+    {
+        auto engine = std::make_unique<ClipperEngine>();
+        engine->prepare(kSampleRate, kBlockSize, kNumChannels);
+        engine->setCeiling(ceilingDb);
+        engine->setCurve(static_cast<int>(CurveType::Hard));
+        engine->setOversamplingFactor(2);   // 4x
+        engine->setOversamplingEngine(usePolyphase);
+        engine->setChannelMode(isMidSide);
+        engine->setEnforceCeiling(false);
+        engine->setDeltaMonitor(delta);
+        return engine;
+    };
+
+    auto wetEngine = makeEngine(-6.0f, false);
+    auto deltaEngine = makeEngine(-6.0f, true);
+    auto cleanEngine = makeEngine(24.0f, false);  // ceiling far above the signal
+
+    auto input = generateSine(997.0f, kBlockSize, 0.9f);
+    for (int block = 0; block < 3; ++block)
+    {
+        auto wet = input;
+        auto delta = input;
+        auto clean = input;
+        wetEngine->process(wet);
+        deltaEngine->process(delta);
+        cleanEngine->process(clean);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(wet.getSample(ch, i) + delta.getSample(ch, i)
+                        == Approx(clean.getSample(ch, i)).margin(kDeltaTolerance));
+    }
+}
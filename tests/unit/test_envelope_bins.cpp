@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/EnvelopeBins.h"
+#include "dsp/ClipperEngine.h"
+#include "test_utils.h"
+
+using Catch::Approx;
+using dsp::ClipperEngine;
+using dsp::EnvelopeBin;
+using dsp::EnvelopeBins;
+using namespace test_utils;
+
+namespace {
+
+constexpr int kMaxBlockSize = 2048;
+
+// Runs the engine over a buffer in fixed-size blocks and collects every bin
+std::vector<EnvelopeBin> collectBins(ClipperEngine& engine, juce::AudioBuffer<float>& buffer, int blockSize)
+{
+    std::vector<EnvelopeBin> bins;
+    for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+    {
+        const int n = std::min(blockSize, buffer.getNumSamples() - start);
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, n);
+        engine.process(block);
+
+        for (int i = 0; i < engine.getNumEnvelopeBins(); ++i)
+            bins.push_back(engine.getEnvelopeBin(i));
+    }
+    return bins;
+}
+
+std::vector<EnvelopeBin> renderBins(int blockSize, int numSamples, bool deltaMonitor = false)
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kMaxBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);
+    engine.setInputGain(6.0f);
+    engine.setCeiling(-6.0f);
+    engine.setDeltaMonitor(deltaMonitor);
+    engine.reset();
+
+    auto buffer = generateSine(220.0f, numSamples, 0.8f);
+    return collectBins(engine, buffer, blockSize);
+}
+
+} // namespace
+
+// =============================================================================
+// Bin Boundaries [envelope][bins]
+// =============================================================================
+
+TEST_CASE("Envelope bins: bin length follows the sample rate", "[envelope][bins]")
+{
+    EnvelopeBins bins;
+
+    bins.prepare(44100.0, 512);
+    REQUIRE(bins.getBinLength() == 221);  // 5ms, rounded
+
+    bins.prepare(96000.0, 512);
+    REQUIRE(bins.getBinLength() == 480);
+
+    bins.prepare(48000.0, 512, 0.01);
+    REQUIRE(bins.getBinLength() == 480);
+}
+
+TEST_CASE("Envelope bins: one block can complete several bins", "[envelope][bins]")
+{
+    EnvelopeBins bins;
+    bins.prepare(1000.0, 64, 0.01);  // 10 samples per bin
+    REQUIRE(bins.getBinLength() == 10);
+
+    // 35 samples: bins [0,10) [10,20) [20,30) complete, [30,35) stays open
+    for (int start = 0; start < 35; start += bins.samplesToBoundary(start))
+        bins.addPreClip(start, static_cast<float>(start / 10 + 1) * 0.1f);
+    bins.finishBlock(35);
+
+    REQUIRE(bins.getNumCompletedBins() == 3);
+    REQUIRE(bins.getCompletedBin(0).preClip == Approx(0.1f));
+    REQUIRE(bins.getCompletedBin(1).preClip == Approx(0.2f));
+    REQUIRE(bins.getCompletedBin(2).preClip == Approx(0.3f));
+
+    // The open bin carries over and closes 5 samples into the next block
+    REQUIRE(bins.samplesToBoundary(0) == 5);
+    bins.addPreClip(0, 0.05f);
+    bins.finishBlock(5);
+
+    REQUIRE(bins.getNumCompletedBins() == 1);
+    REQUIRE(bins.getCompletedBin(0).preClip == Approx(0.4f));
+}
+
+TEST_CASE("Envelope bins: small blocks complete a bin only when it fills", "[envelope][bins]")
+{
+    EnvelopeBins bins;
+    bins.prepare(1000.0, 64, 0.01);
+
+    int completed = 0;
+    for (int block = 0; block < 30; ++block)
+    {
+        bins.addPreClip(0, 0.5f);
+        bins.finishBlock(3);
+        completed += bins.getNumCompletedBins();
+    }
+
+    // 90 samples = 9 full bins
+    REQUIRE(completed == 9);
+}
+
+// =============================================================================
+// Engine Integration [envelope][engine]
+// =============================================================================
+
+TEST_CASE("Envelope bins: engine output is independent of block size", "[envelope][engine]")
+{
+    const int blockSize = GENERATE(32, 441, 512, 2048);
+    CAPTURE(blockSize);
+
+    constexpr int kNumSamples = 44100;
+    const auto reference = renderBins(64, kNumSamples);
+    const auto bins = renderBins(blockSize, kNumSamples);
+
+    // 1s at 221 samples per bin
+    REQUIRE(reference.size() == static_cast<size_t>(kNumSamples / 221));
+    REQUIRE(bins.size() == reference.size());
+
+    for (size_t i = 0; i < bins.size(); ++i)
+    {
+        CAPTURE(i);
+        REQUIRE(bins[i].preClip == Approx(reference[i].preClip).margin(1e-4));
+        REQUIRE(bins[i].postClip == Approx(reference[i].postClip).margin(1e-4));
+    }
+}
+
+TEST_CASE("Envelope bins: transient lands in the bin that contains it", "[envelope][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kMaxBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);
+    engine.reset();
+
+    // Impulse in the middle of bin 7, processed in one large block
+    const int position = 7 * 221 + 100;
+    auto buffer = generateImpulse(position, 0.5f, 2048);
+    const auto bins = collectBins(engine, buffer, 2048);
+
+    REQUIRE(bins.size() == 9);
+    for (size_t i = 0; i < bins.size(); ++i)
+    {
+        CAPTURE(i);
+        REQUIRE(bins[i].preClip == Approx(i == 7 ? 0.5f : 0.0f).margin(1e-6));
+    }
+}
+
+TEST_CASE("Envelope bins: delta mode meters the clipped signal per bin", "[envelope][engine]")
+{
+    constexpr int kNumSamples = 22050;
+    const auto normal = renderBins(512, kNumSamples, false);
+    const auto delta = renderBins(512, kNumSamples, true);
+
+    REQUIRE(delta.size() == normal.size());
+    for (size_t i = 0; i < delta.size(); ++i)
+    {
+        CAPTURE(i);
+        REQUIRE(delta[i].preClip == Approx(normal[i].preClip).margin(1e-5));
+        REQUIRE(delta[i].postClip == Approx(normal[i].postClip).margin(1e-4));
+    }
+}
+
+TEST_CASE("Envelope bins: bypass reports post-clip equal to pre-clip", "[envelope][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kMaxBlockSize, kNumChannels);
+    engine.setBypass(true);
+    engine.reset();
+
+    auto buffer = generateSine(440.0f, 4096, 0.9f);
+    const auto bins = collectBins(engine, buffer, 300);
+
+    REQUIRE(bins.size() == static_cast<size_t>(4096 / 221));
+    for (const auto& bin : bins)
+    {
+        REQUIRE(bin.preClip > 0.0f);
+        REQUIRE(bin.postClip == Approx(bin.preClip));
+    }
+}
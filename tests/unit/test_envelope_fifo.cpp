@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "dsp/EnvelopeFifo.h"
+
+#include <thread>
+#include <vector>
+
+using Catch::Approx;
+using dsp::EnvelopeFifo;
+using dsp::EnvelopeFrame;
+
+// =============================================================================
+// Queue Behaviour [envelope][fifo]
+// =============================================================================
+
+TEST_CASE("Envelope FIFO: frames come out in push order", "[envelope][fifo]")
+{
+    EnvelopeFifo fifo(16);
+
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(fifo.push({ static_cast<float>(i), static_cast<float>(i) * 0.5f, 0.25f }));
+
+    REQUIRE(fifo.getNumReady() == 10);
+
+    // Drain in two pieces so the read wraps the ring on the second pass
+    std::vector<EnvelopeFrame> out(16);
+    REQUIRE(fifo.pop(out.data(), 4) == 4);
+    REQUIRE(fifo.pop(out.data() + 4, 16) == 6);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(out[static_cast<size_t>(i)].preClip == Approx(static_cast<float>(i)));
+        REQUIRE(out[static_cast<size_t>(i)].postClip == Approx(static_cast<float>(i) * 0.5f));
+        REQUIRE(out[static_cast<size_t>(i)].threshold == Approx(0.25f));
+    }
+
+    REQUIRE(fifo.getNumReady() == 0);
+}
+
+TEST_CASE("Envelope FIFO: full queue drops new frames instead of blocking", "[envelope][fifo]")
+{
+    EnvelopeFifo fifo(8);
+
+    // AbstractFifo keeps one slot free
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i)
+        accepted += fifo.push({ static_cast<float>(i), 0.0f, 0.0f }) ? 1 : 0;
+
+    REQUIRE(accepted == 7);
+    REQUIRE(fifo.getNumDropped() == 13);
+
+    // The oldest frames survive
+    EnvelopeFrame first;
+    REQUIRE(fifo.pop(&first, 1) == 1);
+    REQUIRE(first.preClip == Approx(0.0f));
+}
+
+TEST_CASE("Envelope FIFO: discardReady empties the queue", "[envelope][fifo]")
+{
+    EnvelopeFifo fifo(8);
+    fifo.push({ 1.0f, 1.0f, 0.0f });
+    fifo.push({ 1.0f, 1.0f, 0.0f });
+
+    fifo.discardReady();
+    REQUIRE(fifo.getNumReady() == 0);
+
+    REQUIRE(fifo.push({ 0.5f, 0.5f, 0.0f }));
+    EnvelopeFrame frame;
+    REQUIRE(fifo.pop(&frame, 1) == 1);
+    REQUIRE(frame.preClip == Approx(0.5f));
+}
+
+// =============================================================================
+// Threading [envelope][thread]
+// =============================================================================
+
+TEST_CASE("Envelope FIFO: concurrent producer and consumer see every frame intact", "[envelope][thread]")
+{
+    constexpr int kNumFrames = 100000;
+    EnvelopeFifo fifo(64);
+
+    std::thread producer([&fifo]()
+    {
+        for (int i = 0; i < kNumFrames;)
+        {
+            // Each field carries the same index, so a torn frame would mismatch
+            const float value = static_cast<float>(i);
+            if (fifo.push({ value, value, value }))
+                ++i;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    std::vector<EnvelopeFrame> chunk(32);
+    int expected = 0;
+    bool intact = true;
+
+    while (expected < kNumFrames)
+    {
+        const int n = fifo.pop(chunk.data(), static_cast<int>(chunk.size()));
+        for (int i = 0; i < n; ++i, ++expected)
+        {
+            const auto& frame = chunk[static_cast<size_t>(i)];
+            const float value = static_cast<float>(expected);
+            intact = intact && frame.preClip == value && frame.postClip == value && frame.threshold == value;
+        }
+        if (n == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    REQUIRE(intact);
+    REQUIRE(expected == kNumFrames);
+}
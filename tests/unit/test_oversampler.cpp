@@ -4,6 +4,9 @@
 #include "dsp/Oversampler.h"
 #include "test_utils.h"
 
+#include <chrono>
+#include <thread>
+
 using Catch::Approx;
 using dsp::Oversampler;
 using namespace test_utils;
@@ -152,6 +155,108 @@ TEST_CASE("LinearPhase reports expected latency", "[latency]")
     REQUIRE(os.getLatencyInSamples() == kExpectedLatencyLinPhase[factorIndex]);
 }
 
+// Max error against the input delayed by the reported latency, after warm-up.
+// A 100 Hz sine is off by ~0.0036 per half sample of unreported delay
+float measureLatencyError(Oversampler& os)
+{
+    constexpr int kNumBlocks = 8;
+    const int latency = os.getLatencyInSamples();
+    auto input = generateSine(100.0f, kBlockSize * kNumBlocks, 0.5f);
+
+    float maxError = 0.0f;
+    for (int block = 0; block < kNumBlocks; ++block)
+    {
+        juce::AudioBuffer<float> blockInput(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            blockInput.copyFrom(ch, 0, input, ch, block * kBlockSize, kBlockSize);
+
+        auto output = processRoundTrip(os, blockInput);
+
+        if (block < 2)
+            continue;
+
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float expected = input.getSample(0, block * kBlockSize + i - latency);
+            maxError = std::max(maxError, std::abs(output.getSample(0, i) - expected));
+        }
+    }
+
+    return maxError;
+}
+
+TEST_CASE("LowLatency reports its delay exactly", "[latency][lowlatency]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    auto clipDelay = GENERATE(0.0, 0.5, 1.0);  // Off, ADAA 1st and 2nd order
+    CAPTURE(factorIndex, clipDelay);
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(factorIndex);
+    os.setFilterType(Oversampler::FilterType::LowLatency);
+
+    // The clip delay only counts when the caller delays the upsampled signal
+    // by that much itself, so check the filters alone here
+    os.setClipDelay(clipDelay);
+    REQUIRE(os.compensatesClipDelay());
+    os.setClipDelay(0.0);
+
+    REQUIRE(measureLatencyError(os) < 0.001f);
+}
+
+TEST_CASE("LowLatency stays under 1ms at 4x", "[latency][lowlatency]")
+{
+    auto clipDelay = GENERATE(0.0, 0.5, 1.0);
+    CAPTURE(clipDelay);
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(2);
+    os.setFilterType(Oversampler::FilterType::LowLatency);
+    os.setClipDelay(clipDelay);
+
+    REQUIRE(os.getLatencyInSamples() < static_cast<int>(kSampleRate * 0.001));
+    REQUIRE(os.getLatencyInSamples() <= kExpectedLatencyMinPhase[2]);
+}
+
+TEST_CASE("Only LowLatency compensates the clip delay", "[latency][lowlatency]")
+{
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(2);
+    os.setClipDelay(1.0);
+
+    os.setFilterType(Oversampler::FilterType::MinimumPhase);
+    REQUIRE_FALSE(os.compensatesClipDelay());
+    REQUIRE(os.getLatencyInSamples() == kExpectedLatencyMinPhase[2]);
+
+    os.setFilterType(Oversampler::FilterType::LinearPhase);
+    REQUIRE_FALSE(os.compensatesClipDelay());
+
+    os.setFilterType(Oversampler::FilterType::LowLatency);
+    REQUIRE(os.compensatesClipDelay());
+    REQUIRE_FALSE(os.compensatesClipDelay(Oversampler::Slot::Outgoing));
+}
+
+TEST_CASE("Double precision reports the float latencies", "[latency][double]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    auto filterType = GENERATE(Oversampler::FilterType::MinimumPhase, Oversampler::FilterType::LinearPhase);
+    CAPTURE(factorIndex);
+
+    using DoubleOversampler = dsp::BasicOversampler<double>;
+    DoubleOversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(factorIndex);
+    os.setFilterType(filterType == Oversampler::FilterType::LinearPhase ? DoubleOversampler::FilterType::LinearPhase
+                                                                        : DoubleOversampler::FilterType::MinimumPhase);
+
+    const auto& expected = (filterType == Oversampler::FilterType::LinearPhase) ? kExpectedLatencyLinPhase
+                                                                                : kExpectedLatencyMinPhase;
+    REQUIRE(os.getLatencyInSamples() == expected[factorIndex]);
+}
+
 TEST_CASE("Latency is consistent across calls", "[latency]")
 {
     Oversampler os;
@@ -337,6 +442,143 @@ TEST_CASE("Factor switching works mid-stream", "[factor]")
     REQUIRE(numSamplesBack == kBlockSize * 2);
 }
 
+TEST_CASE("Switching keeps the previous configuration as outgoing", "[factor][switch]")
+{
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    REQUIRE_FALSE(os.hasOutgoing());
+
+    REQUIRE(os.setOversamplingFactor(1));  // 1x -> 2x
+    REQUIRE_FALSE(os.setOversamplingFactor(1));  // Unchanged
+    REQUIRE(os.hasOutgoing());
+
+    // Active runs 2x, outgoing still runs 1x (no oversampling)
+    auto input = generateSine(440.0f, kBlockSize);
+    int numActive = 0, numOutgoing = 0;
+    REQUIRE(os.processSamplesUp(input, numActive, Oversampler::Slot::Active) != nullptr);
+    REQUIRE(os.processSamplesUp(input, numOutgoing, Oversampler::Slot::Outgoing) == nullptr);
+    REQUIRE(numActive == kBlockSize * 2);
+    REQUIRE(numOutgoing == kBlockSize);
+
+    // 4x linear phase: the outgoing latency is the one being faded out
+    os.setOversamplingFactor(2);
+    os.setFilterType(Oversampler::FilterType::LinearPhase);
+    REQUIRE(os.getLatencyInSamples(Oversampler::Slot::Outgoing) == kExpectedLatencyMinPhase[2]);
+    REQUIRE(os.getLatencyInSamples() == kExpectedLatencyLinPhase[2]);
+
+    os.releaseOutgoing();
+    REQUIRE_FALSE(os.hasOutgoing());
+    REQUIRE(os.getLatencyInSamples(Oversampler::Slot::Outgoing) == 0);
+}
+
+TEST_CASE("Configuration changes switch once and swap back to the outgoing slot", "[factor][switch]")
+{
+    using Switch = Oversampler::Switch;
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(2);
+    os.releaseOutgoing();
+
+    // Factor and filter type at once: 4x min phase is outgoing, not 8x
+    REQUIRE(os.setConfiguration(3, Oversampler::FilterType::LinearPhase, Oversampler::Backend::Juce,
+                                Oversampler::FilterQuality::High) == Switch::Started);
+    REQUIRE(os.getLatencyInSamples(Oversampler::Slot::Outgoing) == kExpectedLatencyMinPhase[2]);
+    REQUIRE(os.getLatencyInSamples() == kExpectedLatencyLinPhase[3]);
+    REQUIRE(os.setConfiguration(3, Oversampler::FilterType::LinearPhase, Oversampler::Backend::Juce,
+                                Oversampler::FilterQuality::High) == Switch::None);
+
+    // Run the 4x configuration as outgoing, then switch back to it: its state
+    // carries on instead of starting from silence
+    auto input = generateSine(440.0f, kBlockSize);
+    for (int i = 0; i < 4; ++i)
+    {
+        auto outgoing = input;
+        int numOversampled = 0;
+        os.processSamplesUp(outgoing, numOversampled, Oversampler::Slot::Outgoing);
+        os.processSamplesDown(outgoing, kBlockSize, Oversampler::Slot::Outgoing);
+    }
+
+    REQUIRE(os.setConfiguration(2, Oversampler::FilterType::MinimumPhase, Oversampler::Backend::Juce,
+                                Oversampler::FilterQuality::High) == Switch::Reversed);
+    REQUIRE(os.getLatencyInSamples() == kExpectedLatencyMinPhase[2]);
+    REQUIRE(os.getLatencyInSamples(Oversampler::Slot::Outgoing) == kExpectedLatencyLinPhase[3]);
+
+    // Warm from the start of the block, unlike a freshly reset configuration
+    auto output = processRoundTrip(os, input);
+    REQUIRE(std::abs(output.getSample(0, 0)) > 0.1f);
+}
+
+TEST_CASE("Configurations are built on first use", "[switch][build]")
+{
+    Oversampler os;
+    os.setOversamplingFactor(2);
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    REQUIRE(os.getNumBuiltConfigurations() == 1);
+
+    // Built by the setter, kept for the next switch back
+    os.setFilterType(Oversampler::FilterType::LowLatency);
+    os.setFilterType(Oversampler::FilterType::MinimumPhase);
+    os.setOversamplingFactor(0);
+    REQUIRE(os.getNumBuiltConfigurations() == 2);
+
+    // prepare() starts over from the active one (1x: nothing)
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    REQUIRE(os.getNumBuiltConfigurations() == 0);
+}
+
+TEST_CASE("Deferred builds switch once the configuration is built", "[switch][build]")
+{
+    using Switch = Oversampler::Switch;
+
+    Oversampler reference;
+    reference.prepare(kSampleRate, kBlockSize, kNumChannels);
+    reference.setConfiguration(3, Oversampler::FilterType::LowLatency, Oversampler::Backend::Juce,
+                               Oversampler::FilterQuality::High);
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(1);
+    os.releaseOutgoing();
+    os.setBuildsDeferred(true);
+
+    // Requested, not built: the 2x configuration keeps running
+    REQUIRE(os.setConfiguration(3, Oversampler::FilterType::LowLatency, Oversampler::Backend::Juce,
+                                Oversampler::FilterQuality::High) == Switch::None);
+    REQUIRE(os.hasPendingConfiguration());
+    REQUIRE(os.getOversamplingFactor() == 2);
+    REQUIRE(os.getCurrentFactorIndex() == 3);
+    REQUIRE(os.applyPendingConfiguration() == Switch::None);
+
+    // Asking for the active configuration again drops the request
+    os.setConfiguration(1, Oversampler::FilterType::MinimumPhase, Oversampler::Backend::Juce,
+                        Oversampler::FilterQuality::High);
+    REQUIRE_FALSE(os.hasPendingConfiguration());
+
+    os.setConfiguration(3, Oversampler::FilterType::LowLatency, Oversampler::Backend::Juce,
+                        Oversampler::FilterQuality::High);
+    auto change = Switch::None;
+    for (int attempt = 0; attempt < 1000 && change == Switch::None; ++attempt)
+    {
+        os.serviceRequests();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        change = os.applyPendingConfiguration();
+    }
+
+    REQUIRE(change == Switch::Started);
+    REQUIRE_FALSE(os.hasPendingConfiguration());
+    REQUIRE(os.getOversamplingFactor() == 8);
+    REQUIRE(os.getLatencyInSamples() == reference.getLatencyInSamples());
+    REQUIRE(os.isOversampling(Oversampler::Slot::Outgoing));
+
+    // Same filters as a configuration built on the spot
+    auto input = generateSine(440.0f, kBlockSize);
+    auto expected = processRoundTrip(reference, input);
+    auto output = processRoundTrip(os, input);
+    for (int i = 0; i < kBlockSize; ++i)
+        REQUIRE(output.getSample(0, i) == expected.getSample(0, i));
+}
+
 TEST_CASE("Filter type switching updates latency correctly", "[filter]")
 {
     Oversampler os;
@@ -387,6 +629,108 @@ TEST_CASE("Filter type switching produces valid output", "[filter]")
     REQUIRE(rmsLin > 0.3f);  // Signal survives
 }
 
+// =============================================================================
+// Filter Quality
+// =============================================================================
+
+TEST_CASE("Efficient quality preserves the passband", "[quality]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    auto filterType = GENERATE(Oversampler::FilterType::MinimumPhase, Oversampler::FilterType::LinearPhase);
+    CAPTURE(factorIndex, static_cast<int>(filterType));
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(factorIndex);
+    os.setFilterType(filterType);
+    os.setFilterQuality(Oversampler::FilterQuality::Efficient);
+
+    // ~14.8 kHz sits inside the first stage's passband, which both qualities
+    // share. 172 whole cycles per block, so repeating the block is seamless
+    const float frequency = 172.0f * static_cast<float>(kSampleRate) / static_cast<float>(kBlockSize);
+    auto input = generateSine(frequency, kBlockSize, 0.5f);
+    for (int i = 0; i < 8; ++i)
+        processRoundTrip(os, input);
+
+    auto output = processRoundTrip(os, input);
+    REQUIRE(calculateRMS(output) / calculateRMS(input) == Approx(1.0f).margin(kRoundTripTolerance));
+}
+
+TEST_CASE("Efficient quality shares the 2x design and never adds latency", "[quality][latency]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    auto filterType = GENERATE(Oversampler::FilterType::MinimumPhase, Oversampler::FilterType::LinearPhase);
+    CAPTURE(factorIndex, static_cast<int>(filterType));
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(factorIndex);
+    os.setFilterType(filterType);
+    const int highLatency = os.getLatencyInSamples();
+
+    REQUIRE(os.setFilterQuality(Oversampler::FilterQuality::Efficient));
+    REQUIRE(os.hasOutgoing());
+
+    if (factorIndex == 1)
+        REQUIRE(os.getLatencyInSamples() == highLatency);
+    else
+        REQUIRE(os.getLatencyInSamples() <= highLatency);
+}
+
+TEST_CASE("Filter quality leaves the polyphase cascades alone", "[quality]")
+{
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(3);
+    os.setBackend(Oversampler::Backend::PolyphaseAllpass);
+
+    REQUIRE_FALSE(os.setFilterQuality(Oversampler::FilterQuality::Efficient));
+    REQUIRE_FALSE(os.hasOutgoing());
+
+    os.setFilterType(Oversampler::FilterType::LowLatency);
+    REQUIRE_FALSE(os.setFilterQuality(Oversampler::FilterQuality::High));
+}
+
+TEST_CASE("Efficient quality still rejects images that fold into the audio band", "[quality][aliasing]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    auto filterType = GENERATE(Oversampler::FilterType::MinimumPhase, Oversampler::FilterType::LinearPhase);
+    CAPTURE(factorIndex, static_cast<int>(filterType));
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(factorIndex);
+    os.setFilterType(filterType);
+    os.setFilterQuality(Oversampler::FilterQuality::Efficient);
+
+    // A tone 1 kHz below the top stage's Nyquist: the last downsampler folds it
+    // to 1 kHz, which every stage below passes - only that stage rejects it
+    const double topRate = kSampleRate * (1 << factorIndex);
+    const double frequency = topRate / 2.0 - 1000.0;
+    constexpr float kAmplitude = 0.5f;
+
+    juce::AudioBuffer<float> buffer(kNumChannels, kBlockSize);
+    float outputRMS = 0.0f;
+    for (int block = 0; block < 8; ++block)
+    {
+        buffer.clear();
+        int numOversampled = 0;
+        float* const* upsampled = os.processSamplesUp(buffer, numOversampled);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < numOversampled; ++i)
+                upsampled[ch][i] = kAmplitude * static_cast<float>(
+                    std::sin(2.0 * kPi * frequency * (block * numOversampled + i) / topRate));
+
+        os.processSamplesDown(buffer, kBlockSize);
+        outputRMS = calculateRMS(buffer);
+    }
+
+    const float rejectionDb = juce::Decibels::gainToDecibels(outputRMS / (kAmplitude / std::sqrt(2.0f)));
+    CAPTURE(rejectionDb);
+    REQUIRE(rejectionDb < -30.0f);
+}
+
 TEST_CASE("reset() clears filter state", "[reset]")
 {
     Oversampler os;
@@ -502,3 +846,66 @@ TEST_CASE("Upsampled count scales with block size", "[blocksize]")
     REQUIRE(numOversampledSamples == blockSize * 4);
 }
 
+
+// =============================================================================
+// Channel Partitions
+// =============================================================================
+
+TEST_CASE("Partitioned processing matches whole-buffer processing", "[partition]")
+{
+    auto factorIndex = GENERATE(1, 3);
+    auto filterType = GENERATE(Oversampler::FilterType::MinimumPhase, Oversampler::FilterType::LinearPhase);
+    auto polyphase = GENERATE(false, true);
+    CAPTURE(factorIndex, polyphase);
+
+    constexpr int kChannels = 6;
+    Oversampler whole, split;
+    whole.prepare(kSampleRate, kBlockSize, kChannels);
+    split.prepare(kSampleRate, kBlockSize, kChannels, 4);
+    REQUIRE(whole.getNumPartitions() == 1);
+    REQUIRE(split.getNumPartitions() == 4);
+
+    for (auto* os : { &whole, &split })
+    {
+        os->setOversamplingFactor(factorIndex);
+        os->setFilterType(filterType);
+        os->setBackend(polyphase ? Oversampler::Backend::PolyphaseAllpass : Oversampler::Backend::Juce);
+    }
+
+    for (int block = 0; block < 4; ++block)
+    {
+        juce::AudioBuffer<float> input(kChannels, kBlockSize);
+        for (int ch = 0; ch < kChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                input.setSample(ch, i, 0.5f * static_cast<float>(std::sin(2.0 * kPi * 300.0 * (ch + 1) * (block * kBlockSize + i) / kSampleRate)));
+
+        auto expected = input;
+        auto actual = input;
+
+        int expectedCount = 0;
+        whole.processSamplesUp(expected, expectedCount);
+        whole.processSamplesDown(expected, kBlockSize);
+
+        // Partitions in reverse order: each one only touches its own channels
+        int actualCount = 0;
+        for (int p = split.getNumPartitions() - 1; p >= 0; --p)
+            split.processSamplesUp(actual, actualCount, Oversampler::Slot::Active, p);
+        for (int p = split.getNumPartitions() - 1; p >= 0; --p)
+            split.processSamplesDown(actual, kBlockSize, Oversampler::Slot::Active, p);
+
+        REQUIRE(actualCount == expectedCount);
+        for (int ch = 0; ch < kChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                REQUIRE(actual.getSample(ch, i) == expected.getSample(ch, i));
+    }
+}
+
+TEST_CASE("Partition count is clamped to the channel count", "[partition]")
+{
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, 2, 8);
+    REQUIRE(os.getNumPartitions() == 2);
+
+    os.prepare(kSampleRate, kBlockSize, 2, 0);
+    REQUIRE(os.getNumPartitions() == 1);
+}
@@ -0,0 +1,266 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/PolyphaseHalfband.h"
+#include "dsp/Oversampler.h"
+#include "test_utils.h"
+
+using Catch::Approx;
+using dsp::Oversampler;
+using dsp::PolyphaseHalfband;
+using namespace test_utils;
+
+namespace {
+
+// Amplitude of one frequency component (single-bin DFT)
+float measureTone(const float* data, int numSamples, double normalizedFrequency)
+{
+    double re = 0.0, im = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double phase = 2.0 * kPi * normalizedFrequency * i;
+        re += data[i] * std::cos(phase);
+        im -= data[i] * std::sin(phase);
+    }
+    return static_cast<float>(2.0 * std::sqrt(re * re + im * im) / numSamples);
+}
+
+// Centre of mass of a smooth pulse after processing, relative to the input pulse
+double measurePulseDelay(Oversampler& os, int numSamples, int pulseCentre)
+{
+    juce::AudioBuffer<float> input(kNumChannels, numSamples);
+    juce::AudioBuffer<float> output(kNumChannels, numSamples);
+    output.clear();
+
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = (i - pulseCentre) / 8.0;
+            input.setSample(ch, i, static_cast<float>(std::exp(-t * t)));
+        }
+
+    int numOversampled = 0;
+    os.processSamplesUp(input, numOversampled);
+    os.processSamplesDown(output, numSamples);
+
+    double moment = 0.0, sum = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        moment += i * output.getSample(0, i);
+        sum += output.getSample(0, i);
+    }
+    return moment / sum - pulseCentre;
+}
+
+} // namespace
+
+// =============================================================================
+// Coefficient Design
+// =============================================================================
+
+TEST_CASE("Polyphase: design yields even, stable, ascending coefficients", "[polyphase][design]")
+{
+    auto attenuation = GENERATE(60.0, 70.0, 90.0);
+    auto transition = GENERATE(0.05, 0.1, 0.3, 0.45);
+    CAPTURE(attenuation, transition);
+
+    auto coefs = PolyphaseHalfband::designCoefficients(attenuation, transition);
+
+    REQUIRE(!coefs.empty());
+    REQUIRE(coefs.size() % 2 == 0);
+    REQUIRE(coefs.size() <= static_cast<size_t>(PolyphaseHalfband::maxCoefficients));
+
+    for (size_t i = 0; i < coefs.size(); ++i)
+    {
+        REQUIRE(coefs[i] > 0.0);
+        REQUIRE(coefs[i] < 1.0);
+        if (i > 0)
+            REQUIRE(coefs[i] > coefs[i - 1]);
+    }
+}
+
+TEST_CASE("Polyphase: tighter specs need more coefficients", "[polyphase][design]")
+{
+    auto loose = PolyphaseHalfband::designCoefficients(60.0, 0.3);
+    auto tight = PolyphaseHalfband::designCoefficients(90.0, 0.05);
+
+    REQUIRE(tight.size() > loose.size());
+}
+
+// =============================================================================
+// Single Stage Response
+// =============================================================================
+
+TEST_CASE("Polyphase: 2x upsampling passes band and rejects image", "[polyphase][filter]")
+{
+    constexpr int numIn = 4096;
+    constexpr double toneFrequency = 0.05;  // of the low rate
+
+    PolyphaseHalfband up;
+    up.prepare(PolyphaseHalfband::designCoefficients(70.0, 0.1), 1);
+
+    std::vector<float> input(numIn), output(2 * numIn);
+    for (int i = 0; i < numIn; ++i)
+        input[static_cast<size_t>(i)] = 0.5f * static_cast<float>(std::sin(2.0 * kPi * toneFrequency * i));
+
+    const float* in[] = { input.data() };
+    float* out[] = { output.data() };
+    up.processUp(in, out, numIn);
+
+    // Skip the filter settling at the start
+    const int skip = 512;
+    const float* steady = output.data() + skip;
+    const int steadyLength = 2 * numIn - skip;
+
+    const float tone = measureTone(steady, steadyLength, toneFrequency / 2.0);
+    const float image = measureTone(steady, steadyLength, 0.5 - toneFrequency / 2.0);
+
+    REQUIRE(tone == Approx(0.5f).margin(0.005f));
+    REQUIRE(20.0f * std::log10(image / tone) < -65.0f);
+}
+
+TEST_CASE("Polyphase: channels are processed independently", "[polyphase][independence]")
+{
+    // Odd channel count exercises a partially filled register
+    constexpr int numChannels = 3;
+    constexpr int numIn = 256;
+    const auto coefs = PolyphaseHalfband::designCoefficients(70.0, 0.1);
+
+    std::vector<std::vector<float>> inputs(numChannels, std::vector<float>(numIn));
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numIn; ++i)
+            inputs[static_cast<size_t>(ch)][static_cast<size_t>(i)] =
+                static_cast<float>(std::sin(0.01 * (ch + 1) * i * 2.0 * kPi));
+
+    // All channels together
+    PolyphaseHalfband multi;
+    multi.prepare(coefs, numChannels);
+    std::vector<std::vector<float>> multiOut(numChannels, std::vector<float>(2 * numIn));
+    const float* in[numChannels];
+    float* out[numChannels];
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        in[ch] = inputs[static_cast<size_t>(ch)].data();
+        out[ch] = multiOut[static_cast<size_t>(ch)].data();
+    }
+    multi.processUp(in, out, numIn);
+
+    // Each channel alone
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        PolyphaseHalfband single;
+        single.prepare(coefs, 1);
+        std::vector<float> singleOut(2 * numIn);
+        const float* singleIn[] = { inputs[static_cast<size_t>(ch)].data() };
+        float* singleOutPtr[] = { singleOut.data() };
+        single.processUp(singleIn, singleOutPtr, numIn);
+
+        for (int i = 0; i < 2 * numIn; ++i)
+            REQUIRE(multiOut[static_cast<size_t>(ch)][static_cast<size_t>(i)] == singleOut[static_cast<size_t>(i)]);
+    }
+}
+
+TEST_CASE("Polyphase: double stages match float", "[polyphase][double]")
+{
+    // Two channels per double register on SSE/NEON, so 3 leaves one half empty
+    constexpr int numChannels = 3;
+    constexpr int numIn = 256;
+    const auto coefs = PolyphaseHalfband::designCoefficients(70.0, 0.1);
+
+    PolyphaseHalfband single;
+    dsp::BasicPolyphaseHalfband<double> precise;
+    single.prepare(coefs, numChannels);
+    precise.prepare(coefs, numChannels);
+
+    std::vector<std::vector<float>> floatIn(numChannels, std::vector<float>(numIn));
+    std::vector<std::vector<double>> doubleIn(numChannels, std::vector<double>(numIn));
+    std::vector<std::vector<float>> floatOut(numChannels, std::vector<float>(2 * numIn));
+    std::vector<std::vector<double>> doubleOut(numChannels, std::vector<double>(2 * numIn));
+    const float* floatInPtrs[numChannels];
+    const double* doubleInPtrs[numChannels];
+    float* floatOutPtrs[numChannels];
+    double* doubleOutPtrs[numChannels];
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto c = static_cast<size_t>(ch);
+        for (int i = 0; i < numIn; ++i)
+        {
+            floatIn[c][static_cast<size_t>(i)] = static_cast<float>(std::sin(0.01 * (ch + 1) * i * 2.0 * kPi));
+            doubleIn[c][static_cast<size_t>(i)] = floatIn[c][static_cast<size_t>(i)];
+        }
+        floatInPtrs[ch] = floatIn[c].data();
+        doubleInPtrs[ch] = doubleIn[c].data();
+        floatOutPtrs[ch] = floatOut[c].data();
+        doubleOutPtrs[ch] = doubleOut[c].data();
+    }
+
+    single.processUp(floatInPtrs, floatOutPtrs, numIn);
+    precise.processUp(doubleInPtrs, doubleOutPtrs, numIn);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < 2 * numIn; ++i)
+            REQUIRE(doubleOut[static_cast<size_t>(ch)][static_cast<size_t>(i)]
+                    == Approx(floatOut[static_cast<size_t>(ch)][static_cast<size_t>(i)]).margin(1e-5));
+}
+
+// =============================================================================
+// Oversampler Backend
+// =============================================================================
+
+TEST_CASE("Polyphase backend: round-trip preserves low-frequency sine", "[polyphase][roundtrip]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    CAPTURE(factorIndex);
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setBackend(Oversampler::Backend::PolyphaseAllpass);
+    os.setOversamplingFactor(factorIndex);
+
+    auto input = generateSine(1000.0f, kBlockSize, 0.5f);
+    juce::AudioBuffer<float> output(kNumChannels, kBlockSize);
+
+    for (int block = 0; block < 4; ++block)
+    {
+        int numOversampled = 0;
+        auto blockInput = input;
+        REQUIRE(os.processSamplesUp(blockInput, numOversampled) != nullptr);
+        REQUIRE(numOversampled == kBlockSize * os.getOversamplingFactor());
+        os.processSamplesDown(output, kBlockSize);
+    }
+
+    REQUIRE(calculatePeak(output) == Approx(0.5f).margin(0.02f));
+}
+
+TEST_CASE("Polyphase backend: reported latency matches measured delay", "[polyphase][latency]")
+{
+    auto factorIndex = GENERATE(1, 2, 3, 4, 5);
+    CAPTURE(factorIndex);
+
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setBackend(Oversampler::Backend::PolyphaseAllpass);
+    os.setOversamplingFactor(factorIndex);
+
+    const double measured = measurePulseDelay(os, kBlockSize, 100);
+    CAPTURE(measured);
+
+    REQUIRE(os.getLatencyInSamples() > 0);
+    REQUIRE(std::abs(measured - os.getLatencyInSamples()) <= 0.5);
+}
+
+TEST_CASE("Polyphase backend: linear phase falls back to JUCE FIR", "[polyphase][latency]")
+{
+    Oversampler os;
+    os.prepare(kSampleRate, kBlockSize, kNumChannels);
+    os.setOversamplingFactor(2);
+    os.setFilterType(Oversampler::FilterType::LinearPhase);
+    int juceLatency = os.getLatencyInSamples();
+
+    os.setBackend(Oversampler::Backend::PolyphaseAllpass);
+    REQUIRE(os.getLatencyInSamples() == juceLatency);
+
+    os.setFilterType(Oversampler::FilterType::MinimumPhase);
+    REQUIRE(os.getLatencyInSamples() < juceLatency);
+}
@@ -0,0 +1,389 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/ClipperEngine.h"
+#include "dsp/RealtimeScope.h"
+#include "allocation_tracker.h"
+#include "test_utils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using dsp::Clipper;
+using dsp::ClipperEngine;
+using dsp::CurveType;
+using namespace test_utils;
+
+namespace {
+
+// Processes one block and reports how many allocations it attempted
+template <typename SampleType>
+size_t countAllocations(dsp::BasicClipperEngine<SampleType>& engine, juce::AudioBuffer<SampleType>& buffer)
+{
+    const size_t before = getRealtimeAllocationCount();
+    engine.process(buffer);
+    return getRealtimeAllocationCount() - before;
+}
+
+} // namespace
+
+// =============================================================================
+// Tracker Sanity [realtime][tracker]
+// =============================================================================
+
+#if GUILLOTINE_TRACK_ALLOCATIONS
+TEST_CASE("Realtime tracker: allocation inside a scope is caught", "[realtime][tracker]")
+{
+    const size_t before = getRealtimeAllocationCount();
+
+    {
+        dsp::RealtimeScope realtime;
+        REQUIRE_THROWS_AS(std::vector<float>(16), RealtimeAllocationError);
+    }
+
+    REQUIRE(getRealtimeAllocationCount() == before + 1);
+
+    // Outside a scope allocation is fine again
+    std::vector<float> allowed(16);
+    REQUIRE(getRealtimeAllocationCount() == before + 1);
+}
+
+#if defined(__GLIBC__)
+TEST_CASE("Realtime tracker: the C allocator is counted too", "[realtime][tracker]")
+{
+    const size_t before = getRealtimeAllocationCount();
+
+    // What juce::HeapBlock uses. Called through volatile pointers: the compiler
+    // knows malloc and friends don't read the scope depth, and would move the
+    // scope across the calls it can see
+    void* (*volatile mallocFunction)(size_t) = std::malloc;
+    void* (*volatile callocFunction)(size_t, size_t) = std::calloc;
+    void* (*volatile reallocFunction)(void*, size_t) = std::realloc;
+
+    void* allocated[3] = {};
+    {
+        dsp::RealtimeScope realtime;
+        allocated[0] = mallocFunction(64);
+        allocated[1] = callocFunction(16, sizeof(float));
+        allocated[2] = reallocFunction(allocated[0], 128);
+    }
+    std::free(allocated[1]);
+    std::free(allocated[2]);
+
+    REQUIRE(getRealtimeAllocationCount() == before + 3);
+}
+#endif
+#endif
+
+// =============================================================================
+// ClipperEngine::process [realtime][engine]
+// =============================================================================
+
+TEST_CASE("Realtime: engine process is allocation-free for every configuration", "[realtime][engine]")
+{
+    auto factorIndex = GENERATE(0, 1, 2, 3, 4, 5);
+    auto linearPhase = GENERATE(false, true);
+    auto polyphase = GENERATE(false, true);
+    CAPTURE(factorIndex, linearPhase, polyphase);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setFilterType(linearPhase);
+    engine.setOversamplingEngine(polyphase);
+    engine.setInputGain(6.0f);
+    engine.setCeiling(-3.0f);
+
+    for (bool midSide : { false, true })
+        for (bool linked : { false, true })
+            for (bool delta : { false, true })
+                for (bool truePeak : { false, true })
+                {
+                    CAPTURE(midSide, linked, delta, truePeak);
+                    engine.setChannelMode(midSide);
+                    engine.setStereoLink(linked);
+                    engine.setDeltaMonitor(delta);
+                    engine.setTruePeakMode(truePeak);
+
+                    auto buffer = generateSine(1000.0f, kBlockSize, 0.9f);
+                    REQUIRE(countAllocations(engine, buffer) == 0);
+                }
+
+    engine.setBypass(true);
+    auto buffer = generateSine(1000.0f, kBlockSize, 0.9f);
+    REQUIRE(countAllocations(engine, buffer) == 0);
+}
+
+TEST_CASE("Realtime: switching oversampling mid-stream is allocation-free", "[realtime][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setDeltaMonitor(true);
+
+    // Each switch starts a crossfade that runs both configurations
+    const int factors[] = { 1, 5, 0, 3, 2, 4 };
+    for (int factorIndex : factors)
+    {
+        CAPTURE(factorIndex);
+        engine.setOversamplingFactor(factorIndex);
+        engine.setFilterType(factorIndex % 2 == 0);
+        engine.setOversamplingEngine(factorIndex > 2);
+
+        for (int block = 0; block < 3; ++block)
+        {
+            auto buffer = generateSine(440.0f, kBlockSize, 0.8f);
+            REQUIRE(countAllocations(engine, buffer) == 0);
+        }
+    }
+}
+
+TEST_CASE("Realtime: auto oversampling sleep and wake are allocation-free", "[realtime][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(4);
+    engine.setFilterType(true);
+    engine.setAutoOversampling(true);
+
+    // Quiet long enough to sleep, then loud again (warm-up replay + fade)
+    for (int block = 0; block < 16; ++block)
+    {
+        CAPTURE(block);
+        auto buffer = generateSine(440.0f, kBlockSize, block < 12 ? 0.1f : 0.9f);
+        REQUIRE(countAllocations(engine, buffer) == 0);
+    }
+    REQUIRE(engine.isOversamplingPathActive());
+}
+
+TEST_CASE("Realtime: ADAA is allocation-free through a switch", "[realtime][engine][adaa]")
+{
+    auto order = GENERATE(1, 2);
+    CAPTURE(order);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setCurve(3);
+    engine.setAntialiasing(order);
+    engine.setDeltaMonitor(true);
+
+    // The switch hands the ADAA histories to the outgoing configuration
+    for (int block = 0; block < 6; ++block)
+    {
+        CAPTURE(block);
+        engine.setOversamplingFactor(block < 3 ? 0 : 1);
+        auto buffer = generateSine(440.0f, kBlockSize, 0.9f);
+        REQUIRE(countAllocations(engine, buffer) == 0);
+    }
+}
+
+TEST_CASE("Realtime: surround buses are allocation-free", "[realtime][engine][surround]")
+{
+    auto channels = GENERATE(1, 6, 8, 12);
+    CAPTURE(channels);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, channels);
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(channels));
+    engine.setOversamplingFactor(2);
+    engine.setInputGain(6.0f);
+
+    for (bool midSide : { false, true })
+        for (bool delta : { false, true })
+        {
+            CAPTURE(midSide, delta);
+            engine.setChannelMode(midSide);
+            engine.setDeltaMonitor(delta);
+            engine.setTruePeakMode(true);
+
+            juce::AudioBuffer<float> buffer(channels, kBlockSize);
+            for (int ch = 0; ch < channels; ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                    buffer.setSample(ch, i, 0.9f * static_cast<float>(std::sin(2.0 * kPi * 440.0 * (ch + 1) * i / kSampleRate)));
+
+            REQUIRE(countAllocations(engine, buffer) == 0);
+        }
+}
+
+TEST_CASE("Realtime: smaller blocks than prepared are allocation-free", "[realtime][engine]")
+{
+    auto blockSize = GENERATE(1, 17, 64, 333, kBlockSize);
+    CAPTURE(blockSize);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(3);
+
+    auto buffer = generateSine(440.0f, blockSize, 0.8f);
+    REQUIRE(countAllocations(engine, buffer) == 0);
+}
+
+TEST_CASE("Realtime: double engine is allocation-free", "[realtime][engine][double]")
+{
+    auto factorIndex = GENERATE(0, 1, 3, 5);
+    auto linearPhase = GENERATE(false, true);
+    auto polyphase = GENERATE(false, true);
+    CAPTURE(factorIndex, linearPhase, polyphase);
+
+    dsp::ClipperEngineDouble engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setFilterType(linearPhase);
+    engine.setOversamplingEngine(polyphase);
+    engine.setInputGain(6.0f);
+
+    for (bool midSide : { false, true })
+        for (bool delta : { false, true })
+            for (int antialiasing : { 0, 2 })
+            {
+                CAPTURE(midSide, delta, antialiasing);
+                engine.setChannelMode(midSide);
+                engine.setDeltaMonitor(delta);
+                engine.setAntialiasing(antialiasing);
+                engine.setTruePeakMode(!delta);
+
+                juce::AudioBuffer<double> buffer(kNumChannels, kBlockSize);
+                for (int ch = 0; ch < kNumChannels; ++ch)
+                    for (int i = 0; i < kBlockSize; ++i)
+                        buffer.setSample(ch, i, 0.9 * std::sin(2.0 * kPi * 1000.0 * i / kSampleRate));
+
+                REQUIRE(countAllocations(engine, buffer) == 0);
+            }
+}
+
+TEST_CASE("Realtime: worker threads are allocation-free", "[realtime][engine][threads]")
+{
+    auto factorIndex = GENERATE(3, 5);
+    auto polyphase = GENERATE(false, true);
+    CAPTURE(factorIndex, polyphase);
+
+    constexpr int kChannels = 8;
+    ClipperEngine engine;
+    engine.setWorkerThreads(3);
+    engine.prepare(kSampleRate, kBlockSize, kChannels);
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(kChannels));
+    engine.setOversamplingFactor(factorIndex);
+    engine.setOversamplingEngine(polyphase);
+    engine.setInputGain(6.0f);
+
+    for (int block = 0; block < 4; ++block)
+    {
+        // A factor switch runs the outgoing configuration's partitions as well
+        if (block == 2)
+            engine.setOversamplingFactor(factorIndex - 1);
+
+        juce::AudioBuffer<float> buffer(kChannels, kBlockSize);
+        for (int ch = 0; ch < kChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, 0.9f * static_cast<float>(std::sin(2.0 * kPi * 440.0 * (ch + 1) * i / kSampleRate)));
+
+        REQUIRE(countAllocations(engine, buffer) == 0);
+    }
+}
+
+TEST_CASE("Realtime: parameter snapshots are allocation-free", "[realtime][engine][params]")
+{
+    // As in live playback: the oversampler builds configurations off the audio thread
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplerBuildsDeferred(true);
+
+    dsp::EngineParameters parameters;
+    for (std::uint32_t version = 1; version <= 12; ++version)
+    {
+        // Every field moves, including the oversampler and curve switches
+        parameters.version = version;
+        parameters.inputGain = static_cast<float>(version);
+        parameters.ceiling = -static_cast<float>(version);
+        parameters.curve = static_cast<int>(version % 7);
+        parameters.oversampling = static_cast<int>(version % 6);
+        parameters.polyphaseAllpass = (version % 2) == 0;
+        parameters.antialiasing = static_cast<int>(version % 3);
+        parameters.midSide = (version % 3) == 0;
+        parameters.truePeak = (version % 4) == 0;
+
+        auto buffer = generateSine(440.0f, kBlockSize, 0.8f);
+        const size_t before = getRealtimeAllocationCount();
+        {
+            dsp::RealtimeScope realtime;
+            engine.setParameters(parameters);
+        }
+        REQUIRE(getRealtimeAllocationCount() == before);
+
+        // Blocks run the previous configuration until the new one is built
+        for (int attempt = 0; attempt < 1000 && engine.isOversamplingSwitchPending(); ++attempt)
+        {
+            engine.serviceRequests();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            REQUIRE(countAllocations(engine, buffer) == 0);
+        }
+        REQUIRE_FALSE(engine.isOversamplingSwitchPending());
+        REQUIRE(countAllocations(engine, buffer) == 0);
+    }
+}
+
+TEST_CASE("Realtime: parameter events are allocation-free", "[realtime][engine][events]")
+{
+    auto factorIndex = GENERATE(0, 3);
+    CAPTURE(factorIndex);
+
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(factorIndex);
+    engine.setInputGain(6.0f);
+
+    dsp::EngineParameters parameters;
+    parameters.oversampling = factorIndex;
+    for (std::uint32_t block = 0; block < 4; ++block)
+    {
+        // Ceiling moves at every event, so the pieces ramp
+        for (int event = 0; event < 8; ++event)
+        {
+            parameters.version = block * 8 + static_cast<std::uint32_t>(event) + 1;
+            parameters.ceiling = -static_cast<float>(event);
+            parameters.deltaMonitor = (event % 4) == 3;
+            REQUIRE(engine.addParameterEvent(event * kBlockSize / 8, parameters));
+        }
+
+        auto buffer = generateSine(440.0f, kBlockSize, 0.8f);
+        REQUIRE(countAllocations(engine, buffer) == 0);
+    }
+}
+
+TEST_CASE("Realtime: curve table requests and swaps are allocation-free", "[realtime][engine][curvetable]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setBypass(false);
+    engine.setCurve(static_cast<int>(CurveType::T2));
+    engine.setCurveTable(true);
+
+    // Every block asks for another T2 table, while the builder swaps finished
+    // ones in on its own thread
+    for (int block = 0; block < 40; ++block)
+    {
+        engine.setCurveExponent(1.0f + 0.075f * static_cast<float>(block));
+        auto buffer = generateSine(440.0f, kBlockSize, 1.5f);
+        REQUIRE(countAllocations(engine, buffer) == 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+// =============================================================================
+// Clipper AudioBlock path [realtime][clipper]
+// =============================================================================
+
+TEST_CASE("Realtime: Clipper AudioBlock overload is allocation-free", "[realtime][clipper]")
+{
+    Clipper clipper;
+    clipper.prepare(kNumChannels);
+    clipper.setCurve(CurveType::Tanh);
+    clipper.setStereoLink(true);
+
+    auto buffer = generateSine(1000.0f, kBlockSize, 1.5f);
+    juce::dsp::AudioBlock<float> block(buffer);
+
+    const size_t before = getRealtimeAllocationCount();
+    clipper.process(block);
+    REQUIRE(getRealtimeAllocationCount() == before);
+    REQUIRE(calculatePeak(buffer) <= 1.0f);
+}
@@ -0,0 +1,300 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/SaturatorKernels.h"
+#include "test_utils.h"
+
+#include <limits>
+#include <random>
+#include <type_traits>
+
+using Catch::Approx;
+using dsp::CurveType;
+namespace curves = dsp::curves;
+using namespace test_utils;
+
+namespace {
+
+// Approximation budget for the SIMD tanh/atan/pow kernels (relative to ceiling)
+constexpr float kKernelTolerance = 1.0e-5f;
+
+// Mix of quiet, near-ceiling and heavily driven samples
+template <typename T = float>
+std::vector<T> makeTestSignal(int numSamples, T ceiling)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<T> dist(T(-8) * ceiling, T(8) * ceiling);
+
+    std::vector<T> signal(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i)
+    {
+        T sample = dist(rng);
+        if (i % 3 == 0)
+            sample *= T(0.1);
+        signal[static_cast<size_t>(i)] = sample;
+    }
+
+    // Exact boundary values
+    signal[0] = T(0);
+    signal[1] = ceiling;
+    signal[2] = -ceiling;
+    return signal;
+}
+
+template <typename T>
+T maxDeviationFromScalar(CurveType curve, int numSamples, T ceiling, float exponent)
+{
+    const auto input = makeTestSignal(numSamples, ceiling);
+    auto output = input;
+    curves::applyBlock(curve, output.data(), numSamples, ceiling, exponent);
+
+    T maxError = T(0);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        const T expected = curves::applyWithCeiling(curve, input[i], ceiling, exponent);
+        maxError = std::max(maxError, std::abs(expected - output[i]) / ceiling);
+    }
+    return maxError;
+}
+
+} // namespace
+
+// =============================================================================
+// Block Kernel vs Scalar Reference
+// =============================================================================
+
+TEST_CASE("Kernels: every curve matches scalar applyWithCeiling", "[kernels]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    auto ceiling = GENERATE(1.0f, 0.5f, 0.1f);
+    auto numSamples = GENERATE(3, 17, 512, 1021);
+    CAPTURE(curveIndex, ceiling, numSamples);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    REQUIRE(maxDeviationFromScalar(curve, numSamples, ceiling, 2.0f) < kKernelTolerance);
+}
+
+TEST_CASE("Kernels: Knee and T2 track the exponent", "[kernels]")
+{
+    auto curve = GENERATE(CurveType::Knee, CurveType::T2);
+    auto exponent = GENERATE(1.0f, 1.5f, 2.0f, 3.0f, 4.0f);
+    CAPTURE(static_cast<int>(curve), exponent);
+
+    REQUIRE(maxDeviationFromScalar(curve, kBlockSize, 1.0f, exponent) < kKernelTolerance);
+}
+
+TEST_CASE("Kernels: double blocks match the scalar double curves", "[kernels][double]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    auto ceiling = GENERATE(1.0, 0.1);
+    auto numSamples = GENERATE(3, 17, 1021);
+    CAPTURE(curveIndex, ceiling, numSamples);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    REQUIRE(maxDeviationFromScalar(curve, numSamples, ceiling, 2.5f) < kKernelTolerance);
+
+    // Exact curves stay exact in double - no float rounding on the way through
+    if (curve == CurveType::Hard || curve == CurveType::Cubic || curve == CurveType::Knee)
+        REQUIRE(maxDeviationFromScalar(curve, numSamples, ceiling, 2.5f) < 1.0e-12);
+}
+
+TEST_CASE("Linked kernel: double gain follows loudest channel", "[kernels][stereolink][double]")
+{
+    auto curveIndex = GENERATE(0, 3, 5, 6);
+    CAPTURE(curveIndex);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    const auto left = makeTestSignal(200, 0.5);
+    auto right = left;
+    for (auto& sample : right)
+        sample *= -0.3;
+
+    auto outLeft = left;
+    auto outRight = right;
+    double* channels[] = { outLeft.data(), outRight.data() };
+    curves::applyLinkedBlock(curve, channels, 2, 200, 0.5, 2.5f);
+
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        const double peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        const double gain = (peak > 0.0) ? std::abs(curves::applyWithCeiling(curve, peak, 0.5, 2.5f)) / peak : 1.0;
+
+        REQUIRE(outLeft[i] == Approx(left[i] * gain).margin(kKernelTolerance));
+        REQUIRE(outRight[i] == Approx(right[i] * gain).margin(kKernelTolerance));
+    }
+}
+
+TEST_CASE("Kernels: compile-time curves match the runtime dispatch", "[kernels]")
+{
+    const auto params = curves::makeCurveParams(2.5f);
+    const auto input = makeTestSignal(kBlockSize, 0.5f);
+
+    auto check = [&](auto curveConstant)
+    {
+        constexpr CurveType curve = decltype(curveConstant)::value;
+        CAPTURE(static_cast<int>(curve));
+
+        auto runtime = input;
+        auto compiled = input;
+        curves::applyBlock(curve, runtime.data(), kBlockSize, 0.5f, 2.5f);
+        curves::applyBlock<curve>(compiled.data(), kBlockSize, 0.5f, params);
+        REQUIRE(compiled == runtime);
+
+        auto left = input;
+        auto right = input;
+        for (auto& sample : right)
+            sample *= -0.3f;
+        auto compiledLeft = left;
+        auto compiledRight = right;
+        float* channels[] = { left.data(), right.data() };
+        float* compiledChannels[] = { compiledLeft.data(), compiledRight.data() };
+        curves::applyLinkedBlock(curve, channels, 2, kBlockSize, 0.5f, 2.5f);
+        curves::applyLinkedBlock<curve>(compiledChannels, 2, kBlockSize, 0.5f, params);
+        REQUIRE(compiledLeft == left);
+        REQUIRE(compiledRight == right);
+    };
+
+    check(std::integral_constant<CurveType, CurveType::Hard> {});
+    check(std::integral_constant<CurveType, CurveType::Quintic> {});
+    check(std::integral_constant<CurveType, CurveType::Cubic> {});
+    check(std::integral_constant<CurveType, CurveType::Tanh> {});
+    check(std::integral_constant<CurveType, CurveType::Arctan> {});
+    check(std::integral_constant<CurveType, CurveType::Knee> {});
+    check(std::integral_constant<CurveType, CurveType::T2> {});
+}
+
+// =============================================================================
+// Edge Cases
+// =============================================================================
+
+TEST_CASE("Kernels: output never exceeds ceiling", "[kernels]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    CAPTURE(curveIndex);
+
+    const float ceiling = 0.5f;
+    auto data = makeTestSignal(kBlockSize, ceiling);
+    for (auto& sample : data)
+        sample *= 100.0f;
+
+    curves::applyBlock(static_cast<CurveType>(curveIndex), data.data(), kBlockSize, ceiling);
+
+    for (float sample : data)
+        REQUIRE(std::abs(sample) <= ceiling);
+}
+
+TEST_CASE("Kernels: zero ceiling produces silence", "[kernels]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    CAPTURE(curveIndex);
+
+    auto data = makeTestSignal(64, 1.0f);
+    curves::applyBlock(static_cast<CurveType>(curveIndex), data.data(), 64, 0.0f);
+
+    for (float sample : data)
+        REQUIRE(sample == 0.0f);
+}
+
+TEST_CASE("Kernels: curves are odd-symmetric", "[kernels]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    CAPTURE(curveIndex);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    auto positive = makeTestSignal(kBlockSize, 1.0f);
+    for (auto& sample : positive)
+        sample = std::abs(sample);
+
+    auto negative = positive;
+    for (auto& sample : negative)
+        sample = -sample;
+
+    curves::applyBlock(curve, positive.data(), kBlockSize, 1.0f);
+    curves::applyBlock(curve, negative.data(), kBlockSize, 1.0f);
+
+    for (int i = 0; i < kBlockSize; ++i)
+        REQUIRE(negative[static_cast<size_t>(i)] == Approx(-positive[static_cast<size_t>(i)]).margin(kClipperTolerance));
+}
+
+TEST_CASE("Kernels: T2 passes NaN through like the scalar curve", "[kernels]")
+{
+    auto exponent = GENERATE(1.0f, 2.0f, 3.5f);
+    CAPTURE(exponent);
+
+    // Long enough to hit the vector body and the scalar tail
+    constexpr int numSamples = 19;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    auto data = makeTestSignal(numSamples, 2.0f);
+    for (int i = 1; i < numSamples; i += 3)
+        data[static_cast<size_t>(i)] = nan;
+    data[0] = inf;
+    data[2] = -inf;
+    const auto input = data;
+
+    curves::applyBlock(CurveType::T2, data.data(), numSamples, 1.0f, exponent);
+
+    REQUIRE(data[0] == 1.0f);
+    REQUIRE(data[2] == -1.0f);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        CAPTURE(i);
+        const float expected = curves::applyWithCeiling(CurveType::T2, input[index], 1.0f, exponent);
+        if (std::isnan(expected))
+            REQUIRE(std::isnan(data[index]));
+        else
+            REQUIRE(data[index] == Approx(expected).margin(kKernelTolerance));
+    }
+}
+
+// =============================================================================
+// Stereo-Linked Kernel
+// =============================================================================
+
+TEST_CASE("Linked kernel: gain follows loudest channel for every curve", "[kernels][stereolink]")
+{
+    auto curveIndex = GENERATE(0, 1, 2, 3, 4, 5, 6);
+    auto ceiling = GENERATE(1.0f, 0.5f);
+    auto numSamples = GENERATE(5, 64, 200);
+    CAPTURE(curveIndex, ceiling, numSamples);
+
+    const auto curve = static_cast<CurveType>(curveIndex);
+    const auto left = makeTestSignal(numSamples, ceiling);
+    auto right = left;
+    for (auto& sample : right)
+        sample *= -0.3f;
+
+    auto outLeft = left;
+    auto outRight = right;
+    float* channels[] = { outLeft.data(), outRight.data() };
+    curves::applyLinkedBlock(curve, channels, 2, numSamples, ceiling, 2.5f);
+
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        const float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        const float gain = (peak > 0.0f)
+            ? std::abs(curves::applyWithCeiling(curve, peak, ceiling, 2.5f)) / peak
+            : 1.0f;
+
+        REQUIRE(outLeft[i] == Approx(left[i] * gain).margin(kKernelTolerance));
+        REQUIRE(outRight[i] == Approx(right[i] * gain).margin(kKernelTolerance));
+    }
+}
+
+TEST_CASE("Linked kernel: linear region passes bit-exact", "[kernels][stereolink]")
+{
+    auto curve = GENERATE(CurveType::Hard, CurveType::Knee);
+    CAPTURE(static_cast<int>(curve));
+
+    // Knee at exponent 1.5 starts at ~0.79 of ceiling
+    auto left = generateSine(1000.0f, kBlockSize, 0.7f);
+    auto right = generateSine(300.0f, kBlockSize, 0.4f);
+    const auto originalLeft = left;
+
+    float* channels[] = { left.getWritePointer(0), right.getWritePointer(0) };
+    curves::applyLinkedBlock(curve, channels, 2, kBlockSize, 1.0f, 1.5f);
+
+    for (int i = 0; i < kBlockSize; ++i)
+        REQUIRE(left.getSample(0, i) == originalLeft.getSample(0, i));
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "dsp/ClipperEngine.h"
+#include "dsp/StageProfiler.h"
+#include "test_utils.h"
+
+#include <chrono>
+#include <thread>
+
+using Catch::Approx;
+using dsp::ClipperEngine;
+using dsp::ProcessStage;
+using dsp::ProcessTimings;
+using dsp::StageProfiler;
+using namespace test_utils;
+
+// Built with GUILLOTINE_PROFILE_STAGES=1 (tests/unit/CMakeLists.txt)
+static_assert(StageProfiler::enabled, "unit tests time the engine stages");
+
+namespace {
+
+void busyWait(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Profiler [profiler]
+// =============================================================================
+
+TEST_CASE("Stage profiler: nested scopes pause the enclosing stage", "[profiler]")
+{
+    StageProfiler profiler;
+    profiler.prepare(kSampleRate);
+    profiler.beginBlock();
+    {
+        StageProfiler::Scope outer(profiler, ProcessStage::Post);
+        busyWait(std::chrono::microseconds(2000));
+        {
+            StageProfiler::Scope inner(profiler, ProcessStage::Upsample);
+            busyWait(std::chrono::microseconds(3000));
+            inner.enter(ProcessStage::Clip);
+            busyWait(std::chrono::microseconds(1000));
+        }
+    }
+    profiler.finishBlock(kBlockSize);
+
+    const auto timings = profiler.collect();
+    REQUIRE(timings.blocks == 1);
+    REQUIRE(timings.getAverageMicroseconds(timings[ProcessStage::Post]) == Approx(2000.0).margin(500.0));
+    REQUIRE(timings.getAverageMicroseconds(timings[ProcessStage::Upsample]) == Approx(3000.0).margin(500.0));
+    REQUIRE(timings.getAverageMicroseconds(timings[ProcessStage::Clip]) == Approx(1000.0).margin(500.0));
+    REQUIRE(timings[ProcessStage::InputGain].totalNanoseconds == 0);
+
+    // The block covers its stages
+    std::uint64_t stageTotal = 0;
+    for (const auto& stage : timings.stages)
+        stageTotal += stage.totalNanoseconds;
+    REQUIRE(timings.block.totalNanoseconds >= stageTotal);
+}
+
+TEST_CASE("Stage profiler: load is block time against the block's length", "[profiler]")
+{
+    StageProfiler profiler;
+    profiler.prepare(48000.0);
+
+    // 480 samples = 10 ms of audio, 2 ms of work
+    profiler.beginBlock();
+    busyWait(std::chrono::microseconds(2000));
+    profiler.finishBlock(480);
+
+    const auto timings = profiler.collect();
+    REQUIRE(timings.budgetNanoseconds == 10000000);
+    REQUIRE(timings.getLoadPercent() == Approx(20.0f).margin(5.0f));
+    REQUIRE(timings.maxLoadPercent == Approx(timings.getLoadPercent()).margin(0.01f));
+}
+
+TEST_CASE("Stage profiler: collect returns everything published and clears", "[profiler]")
+{
+    StageProfiler profiler;
+    profiler.prepare(kSampleRate);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        profiler.beginBlock();
+        {
+            StageProfiler::Scope timing(profiler, ProcessStage::Clip);
+            busyWait(std::chrono::microseconds(100 * (i + 1)));
+        }
+        profiler.finishBlock(kBlockSize);
+    }
+
+    const auto timings = profiler.collect();
+    REQUIRE(timings.blocks == 3);
+    REQUIRE(timings[ProcessStage::Clip].maxNanoseconds >= 300000);
+    REQUIRE(timings[ProcessStage::Clip].totalNanoseconds >= 600000);
+
+    const auto empty = profiler.collect();
+    REQUIRE(empty.blocks == 0);
+    REQUIRE(empty.block.totalNanoseconds == 0);
+    REQUIRE(empty[ProcessStage::Clip].maxNanoseconds == 0);
+    REQUIRE(empty.getLoadPercent() == 0.0f);
+}
+
+TEST_CASE("Stage profiler: concurrent collects add up to every block", "[profiler][thread]")
+{
+    constexpr int kNumBlocks = 20000;
+    StageProfiler profiler;
+    profiler.prepare(kSampleRate);
+    std::atomic<bool> done { false };
+
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < kNumBlocks; ++i)
+        {
+            profiler.beginBlock();
+            profiler.finishBlock(kBlockSize);
+        }
+        done = true;
+    });
+
+    std::uint64_t blocks = 0;
+    std::uint64_t budget = 0;
+    while (!done)
+    {
+        const auto timings = profiler.collect();
+        blocks += timings.blocks;
+        budget += timings.budgetNanoseconds;
+    }
+    producer.join();
+    const auto last = profiler.collect();
+    blocks += last.blocks;
+    budget += last.budgetNanoseconds;
+
+    const auto blockBudget = static_cast<std::uint64_t>(1.0e9 * kBlockSize / kSampleRate);
+    REQUIRE(blocks == kNumBlocks);
+    REQUIRE(budget == blockBudget * kNumBlocks);
+}
+
+// =============================================================================
+// Engine Integration [profiler][engine]
+// =============================================================================
+
+TEST_CASE("Stage profiler: engine times every stage of an oversampled block", "[profiler][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(2);
+    engine.setCeiling(-6.0f);
+    engine.reset();
+
+    auto buffer = generateSine(100.0f, kBlockSize, 0.9f);
+    engine.process(buffer);
+
+    const auto timings = engine.getStageProfiler().collect();
+    REQUIRE(timings.blocks == 1);
+    REQUIRE(timings.block.totalNanoseconds > 0);
+    REQUIRE(timings[ProcessStage::Upsample].totalNanoseconds > 0);
+    REQUIRE(timings[ProcessStage::Clip].totalNanoseconds > 0);
+    REQUIRE(timings[ProcessStage::Downsample].totalNanoseconds > 0);
+    REQUIRE(timings[ProcessStage::Post].totalNanoseconds > 0);
+}
+
+TEST_CASE("Stage profiler: bypassed blocks only time the input gain", "[profiler][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(2);
+    engine.setBypass(true);
+    engine.reset();
+
+    auto buffer = generateSine(100.0f, kBlockSize, 0.9f);
+    engine.process(buffer);
+
+    const auto timings = engine.getStageProfiler().collect();
+    REQUIRE(timings.blocks == 1);
+    REQUIRE(timings[ProcessStage::Upsample].totalNanoseconds == 0);
+    REQUIRE(timings[ProcessStage::Clip].totalNanoseconds == 0);
+    REQUIRE(timings[ProcessStage::Downsample].totalNanoseconds == 0);
+}
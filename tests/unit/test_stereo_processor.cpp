@@ -394,3 +394,56 @@ TEST_CASE("Multi-sample buffer: all samples processed", "[stereo][buffer]")
     REQUIRE(buffer.getSample(0, 3) == Approx(0.0f).margin(kMSTolerance));
     REQUIRE(buffer.getSample(1, 3) == Approx(-0.5f).margin(kMSTolerance));
 }
+
+// =============================================================================
+// Surround Pair Tests [stereo][surround]
+// =============================================================================
+
+TEST_CASE("Surround pairs: each pair encoded, other channels untouched", "[stereo][surround]")
+{
+    StereoProcessor processor;
+    processor.setMidSideMode(true);
+
+    // 5.1 as L R C LFE Ls Rs: front and surround pairs
+    processor.setChannelPairs({ { 0, 1 }, { 4, 5 } });
+
+    juce::AudioBuffer<float> buffer(6, 1);
+    const float inputs[] = { 1.0f, 0.0f, 0.7f, -0.3f, 0.2f, 0.6f };
+    for (int ch = 0; ch < 6; ++ch)
+        buffer.setSample(ch, 0, inputs[ch]);
+
+    REQUIRE(processor.isMidSideActive(6));
+    REQUIRE(processor.isPairedChannel(4, 6));
+    REQUIRE_FALSE(processor.isPairedChannel(2, 6));
+    REQUIRE_FALSE(processor.isPairedChannel(4, 5));
+
+    processor.encodeToMidSide(buffer);
+
+    REQUIRE(buffer.getSample(0, 0) == Approx(0.5f).margin(kMSTolerance));
+    REQUIRE(buffer.getSample(1, 0) == Approx(0.5f).margin(kMSTolerance));
+    REQUIRE(buffer.getSample(2, 0) == 0.7f);
+    REQUIRE(buffer.getSample(3, 0) == -0.3f);
+    REQUIRE(buffer.getSample(4, 0) == Approx(0.4f).margin(kMSTolerance));
+    REQUIRE(buffer.getSample(5, 0) == Approx(-0.2f).margin(kMSTolerance));
+
+    processor.decodeFromMidSide(buffer);
+
+    for (int ch = 0; ch < 6; ++ch)
+        REQUIRE(buffer.getSample(ch, 0) == Approx(inputs[ch]).margin(kMSTolerance));
+}
+
+TEST_CASE("Surround pairs: pairs past the buffer's channels are skipped", "[stereo][surround]")
+{
+    StereoProcessor processor;
+    processor.setMidSideMode(true);
+    processor.setChannelPairs({ { 2, 3 } });
+
+    auto buffer = makeStereoBuffer(0.8f, 0.2f);
+    REQUIRE_FALSE(processor.isMidSideActive(2));
+
+    processor.encodeToMidSide(buffer);
+
+    auto [outL, outR] = getStereo(buffer);
+    REQUIRE(outL == 0.8f);
+    REQUIRE(outR == 0.2f);
+}
@@ -0,0 +1,306 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/TruePeakLimiter.h"
+#include "dsp/ClipperEngine.h"
+#include "test_utils.h"
+
+using Catch::Approx;
+using dsp::ClipperEngine;
+using dsp::TruePeakLimiter;
+using namespace test_utils;
+
+namespace {
+
+// Reference true peak: 16x windowed-sinc reconstruction with a long kernel,
+// far more accurate than the limiter's own 12-tap estimator
+float measureTruePeak(const juce::AudioBuffer<float>& buffer, int startSample)
+{
+    constexpr int kFactor = 16;
+    constexpr int kHalfLength = 48;
+    float peak = 0.0f;
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        const float* data = buffer.getReadPointer(ch);
+        for (int n = startSample + kHalfLength; n < buffer.getNumSamples() - kHalfLength; ++n)
+        {
+            for (int p = 0; p < kFactor; ++p)
+            {
+                const double frac = static_cast<double>(p) / kFactor;
+                double value = 0.0;
+                for (int k = -kHalfLength + 1; k <= kHalfLength; ++k)
+                {
+                    const double t = frac - k;
+                    const double sinc = (std::abs(t) < 1e-12) ? 1.0 : std::sin(kPi * t) / (kPi * t);
+                    const double window = 0.5 + 0.5 * std::cos(kPi * t / (kHalfLength + 1));
+                    value += data[n + k] * sinc * window;
+                }
+                peak = std::max(peak, static_cast<float>(std::abs(value)));
+            }
+        }
+    }
+    return peak;
+}
+
+juce::AudioBuffer<float> generatePhasedSine(double frequency, double phase, float amplitude, int numSamples)
+{
+    juce::AudioBuffer<float> buffer(kNumChannels, numSamples);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample(ch, i, amplitude * static_cast<float>(std::sin(2.0 * kPi * frequency * i / kSampleRate + phase)));
+    return buffer;
+}
+
+void processInBlocks(TruePeakLimiter& limiter, juce::AudioBuffer<float>& buffer, int blockSize)
+{
+    juce::dsp::AudioBlock<float> block(buffer);
+    for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+    {
+        const int n = std::min(blockSize, buffer.getNumSamples() - start);
+        limiter.process(block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(n)));
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Transparency and Latency [truepeak][latency]
+// =============================================================================
+
+TEST_CASE("True peak: signal under the ceiling is only delayed", "[truepeak][latency]")
+{
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+    limiter.setCeiling(1.0f);
+
+    const int latency = limiter.getLatencyInSamples();
+    REQUIRE(latency > 0);
+
+    auto input = generateSine(1000.0f, 4096, 0.5f);
+    auto output = input;
+    processInBlocks(limiter, output, 64);
+
+    for (int i = latency; i < output.getNumSamples(); ++i)
+        REQUIRE(output.getSample(0, i) == input.getSample(0, i - latency));
+    REQUIRE(limiter.getCurrentGain() == 1.0f);
+}
+
+TEST_CASE("True peak: latency is constant across block sizes", "[truepeak][latency]")
+{
+    auto blockSize = GENERATE(1, 13, 64, 512);
+    CAPTURE(blockSize);
+
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+
+    auto buffer = generateImpulse(100, 0.5f, 1024);
+    processInBlocks(limiter, buffer, blockSize);
+
+    REQUIRE(findPeakPosition(buffer) == 100 + limiter.getLatencyInSamples());
+}
+
+// =============================================================================
+// Intersample Peak Control [truepeak][isp]
+// =============================================================================
+
+TEST_CASE("True peak: intersample peaks stay under the ceiling", "[truepeak][isp]")
+{
+    auto frequency = GENERATE(997.0, 5000.0, 11025.0, 15000.0);
+    CAPTURE(frequency);
+
+    constexpr float ceiling = 0.5f;
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+    limiter.setCeiling(ceiling);
+
+    // pi/4 phase at fs/4 puts every true peak exactly between two samples
+    auto buffer = generatePhasedSine(frequency, kPi / 4.0, 1.0f, 8192);
+    processInBlocks(limiter, buffer, 64);
+
+    const float truePeak = measureTruePeak(buffer, 2048);
+    CAPTURE(truePeak);
+    REQUIRE(juce::Decibels::gainToDecibels(truePeak / ceiling) < 0.5f);
+
+    // Minimal reduction: not much quieter than the ceiling either
+    REQUIRE(truePeak > ceiling * 0.9f);
+}
+
+TEST_CASE("True peak: per-sample ceilings follow a ramp like setCeiling every sample", "[truepeak][isp]")
+{
+    // 1.0 down to 0.25 over 88 samples (2ms), mid-block
+    constexpr int kNumSamples = 1024;
+    constexpr int kRampStart = 300;
+    constexpr int kRampLength = 88;
+    std::vector<float> ceilings(static_cast<size_t>(kNumSamples));
+    for (int i = 0; i < kNumSamples; ++i)
+    {
+        const float t = std::clamp(static_cast<float>(i - kRampStart) / kRampLength, 0.0f, 1.0f);
+        ceilings[static_cast<size_t>(i)] = 1.0f - 0.75f * t;
+    }
+
+    auto ramped = generatePhasedSine(5000.0, kPi / 4.0, 0.9f, kNumSamples);
+    auto stepped = ramped;
+
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+    juce::dsp::AudioBlock<float> rampedBlock(ramped);
+    for (int start = 0; start < kNumSamples; start += 64)
+        limiter.process(rampedBlock.getSubBlock(static_cast<size_t>(start), 64), ceilings.data() + start);
+
+    TruePeakLimiter reference;
+    reference.prepare(kSampleRate, kNumChannels);
+    juce::dsp::AudioBlock<float> steppedBlock(stepped);
+    for (int i = 0; i < kNumSamples; ++i)
+    {
+        reference.setCeiling(ceilings[static_cast<size_t>(i)]);
+        reference.process(steppedBlock.getSubBlock(static_cast<size_t>(i), 1));
+    }
+
+    for (int i = 0; i < kNumSamples; ++i)
+        REQUIRE(ramped.getSample(0, i) == stepped.getSample(0, i));
+    REQUIRE(calculatePeak(ramped, kNumSamples - 256) <= 0.25f * 1.001f);
+}
+
+TEST_CASE("True peak: sample clamp alone misses intersample peaks", "[truepeak][isp]")
+{
+    // Documents why the limiter exists - the same fs/4 sine through a sample clamp
+    constexpr float ceiling = 0.75f;
+    auto buffer = generatePhasedSine(11025.0, kPi / 4.0, 1.0f, 4096);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(ch, i, std::clamp(buffer.getSample(ch, i), -ceiling, ceiling));
+
+    REQUIRE(measureTruePeak(buffer, 0) > ceiling * 1.2f);
+}
+
+TEST_CASE("True peak: gain ramps down before a transient arrives", "[truepeak][isp]")
+{
+    constexpr float ceiling = 0.5f;
+    constexpr int kPeakPosition = 400;
+
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+    limiter.setCeiling(ceiling);
+
+    // Quiet bed with one loud sample
+    auto buffer = generateSine(200.0f, 2048, 0.2f);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        buffer.setSample(ch, kPeakPosition, 1.0f);
+
+    processInBlocks(limiter, buffer, 64);
+
+    const int arrival = kPeakPosition + limiter.getLatencyInSamples();
+    REQUIRE(std::abs(buffer.getSample(0, arrival)) <= ceiling * 1.001f);
+    REQUIRE(calculatePeak(buffer) <= ceiling * 1.001f);
+}
+
+TEST_CASE("True peak: gain reduction is linked across channels", "[truepeak][link]")
+{
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, kNumChannels);
+    limiter.setCeiling(0.5f);
+
+    // Loud left, quiet right - the right channel must follow the left's gain
+    juce::AudioBuffer<float> buffer(kNumChannels, 4096);
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    {
+        const float x = static_cast<float>(std::sin(2.0 * kPi * 1000.0 * i / kSampleRate));
+        buffer.setSample(0, i, x);
+        buffer.setSample(1, i, 0.1f * x);
+    }
+    processInBlocks(limiter, buffer, 64);
+
+    for (int i = 2048; i < buffer.getNumSamples(); ++i)
+        REQUIRE(buffer.getSample(1, i) == Approx(0.1f * buffer.getSample(0, i)).margin(1e-6f));
+}
+
+TEST_CASE("True peak: every channel of a wide bus is detected", "[truepeak][link]")
+{
+    // 7.1.4: three full SIMD registers; 6 leaves a partly filled one
+    auto channels = GENERATE(6, 12);
+    CAPTURE(channels);
+
+    constexpr float ceiling = 0.5f;
+    TruePeakLimiter limiter;
+    limiter.prepare(kSampleRate, channels);
+    limiter.setCeiling(ceiling);
+
+    // Only the last channel carries intersample peaks, the rest stay quiet
+    juce::AudioBuffer<float> buffer(channels, 8192);
+    buffer.clear();
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+        buffer.setSample(channels - 1, i, static_cast<float>(std::sin(2.0 * kPi * 11025.0 * i / kSampleRate + kPi / 4.0)));
+
+    processInBlocks(limiter, buffer, 64);
+
+    const float truePeak = measureTruePeak(buffer, 4096);
+    CAPTURE(truePeak);
+    REQUIRE(juce::Decibels::gainToDecibels(truePeak / ceiling) < 0.5f);
+
+    // Same detector as a mono limiter fed that channel alone
+    TruePeakLimiter mono;
+    mono.prepare(kSampleRate, 1);
+    mono.setCeiling(ceiling);
+
+    juce::AudioBuffer<float> single(1, 8192);
+    for (int i = 0; i < single.getNumSamples(); ++i)
+        single.setSample(0, i, static_cast<float>(std::sin(2.0 * kPi * 11025.0 * i / kSampleRate + kPi / 4.0)));
+    processInBlocks(mono, single, 64);
+
+    for (int i = 0; i < single.getNumSamples(); ++i)
+        REQUIRE(buffer.getSample(channels - 1, i) == Approx(single.getSample(0, i)).margin(1e-6f));
+}
+
+// =============================================================================
+// Engine Integration [truepeak][engine]
+// =============================================================================
+
+TEST_CASE("True peak: engine reports limiter lookahead in its latency", "[truepeak][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);
+
+    TruePeakLimiter reference;
+    reference.prepare(kSampleRate, kNumChannels);
+
+    REQUIRE(engine.getLatencyInSamples() == 0);
+
+    engine.setTruePeakMode(true);
+    REQUIRE(engine.getLatencyInSamples() == reference.getLatencyInSamples());
+
+    // True peak mode only applies while the ceiling is enforced
+    engine.setEnforceCeiling(false);
+    REQUIRE(engine.getLatencyInSamples() == 0);
+}
+
+TEST_CASE("True peak: engine output stays under the ceiling between samples", "[truepeak][engine]")
+{
+    ClipperEngine engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setOversamplingFactor(0);  // 1x: hard clip leaves the worst intersample overshoot
+    engine.setCeiling(-6.0f);
+    engine.setEnforceCeiling(true);
+    engine.setTruePeakMode(true);
+
+    const float ceiling = juce::Decibels::decibelsToGain(-6.0f);
+    auto signal = generatePhasedSine(11025.0, kPi / 4.0, 1.0f, 8 * kBlockSize);
+
+    juce::AudioBuffer<float> output(kNumChannels, signal.getNumSamples());
+    for (int start = 0; start < signal.getNumSamples(); start += kBlockSize)
+    {
+        juce::AudioBuffer<float> block(kNumChannels, kBlockSize);
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            block.copyFrom(ch, 0, signal, ch, start, kBlockSize);
+
+        engine.process(block);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            output.copyFrom(ch, start, block, ch, 0, kBlockSize);
+    }
+
+    const float truePeak = measureTruePeak(output, 2 * kBlockSize);
+    CAPTURE(truePeak, ceiling);
+    REQUIRE(juce::Decibels::gainToDecibels(truePeak / ceiling) < 0.5f);
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "dsp/WorkerPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using dsp::WorkerPool;
+
+// =============================================================================
+// Task Distribution [workers]
+// =============================================================================
+
+TEST_CASE("Worker pool: every task runs exactly once per run", "[workers]")
+{
+    auto numThreads = GENERATE(0, 1, 3, 7);
+    auto numTasks = GENERATE(1, 2, 4, 16);
+    CAPTURE(numThreads, numTasks);
+
+    WorkerPool pool(numThreads);
+    REQUIRE(pool.getNumThreads() == numThreads);
+
+    std::vector<std::atomic<int>> counts(static_cast<size_t>(numTasks));
+    auto task = [&](int index) { counts[static_cast<size_t>(index)].fetch_add(1, std::memory_order_relaxed); };
+
+    // Many back-to-back runs, like consecutive blocks of a render
+    constexpr int kRuns = 500;
+    for (int run = 0; run < kRuns; ++run)
+        pool.run(numTasks, task);
+
+    for (auto& count : counts)
+        REQUIRE(count.load() == kRuns);
+}
+
+TEST_CASE("Worker pool: task results are visible when run returns", "[workers]")
+{
+    WorkerPool pool(3);
+
+    // Plain writes from the workers, read right after the barrier
+    std::vector<int> results(4, 0);
+    for (int run = 1; run <= 200; ++run)
+    {
+        auto task = [&](int index) { results[static_cast<size_t>(index)] = run * (index + 1); };
+        pool.run(static_cast<int>(results.size()), task);
+
+        for (int index = 0; index < static_cast<int>(results.size()); ++index)
+            REQUIRE(results[static_cast<size_t>(index)] == run * (index + 1));
+    }
+}
+
+TEST_CASE("Worker pool: runs complete while idle workers are asleep", "[workers]")
+{
+    WorkerPool pool(4);
+
+    // Past the idle yields, every worker is parked. Fewer tasks than threads:
+    // the barrier must not wait for the ones that never wake in time
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::atomic<int> calls { 0 };
+    auto task = [&](int) { calls.fetch_add(1, std::memory_order_relaxed); };
+    for (int run = 1; run <= 100; ++run)
+    {
+        pool.run(1, task);
+        REQUIRE(calls.load() == run);
+    }
+}
+
+TEST_CASE("Worker pool: parked workers wake for the next run", "[workers]")
+{
+    WorkerPool pool(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The calling thread takes task 0 and holds it until task 1 has started,
+    // which only a woken worker can do
+    std::atomic<bool> secondStarted { false };
+    bool overlapped = false;
+    auto task = [&](int index)
+    {
+        if (index == 1)
+        {
+            secondStarted.store(true);
+            return;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!secondStarted.load() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        overlapped = secondStarted.load();
+    };
+
+    pool.run(2, task);
+    REQUIRE(overlapped);
+}
+
+TEST_CASE("Worker pool: empty run returns immediately", "[workers]")
+{
+    WorkerPool pool(2);
+
+    int calls = 0;
+    auto task = [&](int) { ++calls; };
+    pool.run(0, task);
+
+    REQUIRE(calls == 0);
+}
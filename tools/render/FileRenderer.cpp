@@ -0,0 +1,119 @@
+#include "FileRenderer.h"
+
+namespace render {
+
+FileRenderer::FileRenderer(const RenderSettings& renderSettings, int renderBlockSize, int numThreads)
+    : settings(renderSettings),
+      blockSize(juce::jmax(1, renderBlockSize))
+{
+    formatManager.registerBasicFormats();
+    engine.setWorkerThreads(numThreads);
+    engine.setClipMetering(true);  // Per-file statistics
+}
+
+void FileRenderer::prepareFor(double sampleRate, int numChannels)
+{
+    if (sampleRate == preparedSampleRate && numChannels == preparedChannels)
+        return;
+
+    engine.prepare(sampleRate, blockSize, numChannels);
+
+    // Files carry no speaker map - assume the usual layout for the channel count
+    engine.setChannelLayout(dsp::ChannelLayout::forChannelCount(numChannels));
+    preparedSampleRate = sampleRate;
+    preparedChannels = numChannels;
+}
+
+juce::Result FileRenderer::renderFile(const juce::File& input, const juce::File& output)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+        return juce::Result::fail("could not open " + input.getFullPathName());
+
+    auto* format = formatManager.findFormatForFileExtension(output.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail("unsupported output format: " + output.getFileName());
+
+    // Keep the input bit depth where the output format allows it (FLAC stops at 24)
+    auto bitDepths = format->getPossibleBitDepths();
+    int bitsPerSample = static_cast<int>(reader->bitsPerSample);
+    if (!bitDepths.contains(bitsPerSample))
+        bitsPerSample = bitDepths.isEmpty() ? 24 : bitDepths[bitDepths.size() - 1];
+
+    output.deleteFile();
+    auto stream = output.createOutputStream();
+    if (stream == nullptr)
+        return juce::Result::fail("could not write " + output.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        stream.get(), reader->sampleRate, reader->numChannels, bitsPerSample, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("could not create a " + format->getFormatName() + " writer for "
+                                  + output.getFullPathName());
+
+    stream.release();  // Owned by the writer now
+
+    return processFile(*reader, writer.get(), input.getFullPathName());
+}
+
+juce::Result FileRenderer::analyzeFile(const juce::File& input)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+        return juce::Result::fail("could not open " + input.getFullPathName());
+
+    return processFile(*reader, nullptr, input.getFullPathName());
+}
+
+juce::Result FileRenderer::processFile(juce::AudioFormatReader& reader, juce::AudioFormatWriter* writer,
+                                       const juce::String& inputName)
+{
+    const int numChannels = static_cast<int>(reader.numChannels);
+
+    // Settings go in before reset() so the file starts without gain ramps or
+    // an oversampling crossfade
+    prepareFor(reader.sampleRate, numChannels);
+    settings.applyTo(engine);
+    engine.reset();
+    fileStats.clear();
+    engine.getStageProfiler().collect();  // Drop anything left from the previous file
+
+    // Drop the first `latency` output samples and flush the tail with silence,
+    // so the render lines up with the input sample for sample
+    const juce::int64 totalSamples = reader.lengthInSamples;
+    int samplesToSkip = engine.getLatencyInSamples();
+    juce::int64 readPosition = 0;
+    juce::int64 samplesWritten = 0;
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+
+    while (samplesWritten < totalSamples)
+    {
+        // Full blocks every time - past the end of the input they are zero padded
+        buffer.clear();
+        const int numToRead = static_cast<int>(juce::jlimit<juce::int64>(0, blockSize, totalSamples - readPosition));
+        if (numToRead > 0 && !reader.read(&buffer, 0, numToRead, readPosition, true, true))
+            return juce::Result::fail("read error in " + inputName);
+        readPosition += numToRead;
+
+        engine.process(buffer);
+        dsp::CurveLookup::serviceRequests();  // Curve tables the block asked for (not a realtime thread)
+
+        // Meter the input, not the silence flushing the latency
+        if (numToRead > 0)
+            fileStats.merge(engine.getLastClipStats());
+
+        const int skipped = juce::jmin(samplesToSkip, blockSize);
+        samplesToSkip -= skipped;
+
+        const int numToWrite = static_cast<int>(juce::jmin<juce::int64>(blockSize - skipped, totalSamples - samplesWritten));
+        if (writer != nullptr && numToWrite > 0 && !writer->writeFromAudioSampleBuffer(buffer, skipped, numToWrite))
+            return juce::Result::fail("write error for " + inputName);
+        samplesWritten += numToWrite;
+    }
+
+    fileTimings = engine.getStageProfiler().collect();
+    return juce::Result::ok();
+}
+
+} // namespace render
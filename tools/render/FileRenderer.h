@@ -0,0 +1,51 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "RenderSettings.h"
+
+namespace render {
+
+// Streams audio files through one ClipperEngine, block by block, without a
+// plugin host. Output keeps the input's sample rate, channel count, format and
+// bit depth, and is latency compensated so it lines up with the input.
+//
+// One FileRenderer per thread: the engine is reused across files and only
+// re-prepared when the sample rate or channel count changes. numThreads adds
+// engine worker threads for the oversampling filters of each file.
+class FileRenderer
+{
+public:
+    static constexpr int defaultBlockSize = 4096;
+
+    explicit FileRenderer(const RenderSettings& settings, int blockSize = defaultBlockSize, int numThreads = 0);
+
+    juce::Result renderFile(const juce::File& input, const juce::File& output);
+
+    // Runs the engine over the file without writing anything, for metering
+    juce::Result analyzeFile(const juce::File& input);
+
+    // Gain-reduction statistics of the last rendered or analyzed file
+    const dsp::ClipStats& getLastFileStats() const { return fileStats; }
+
+    // Per-stage engine timings of the last file, latency flush included. Empty
+    // unless built with GUILLOTINE_PROFILE_STAGES
+    const dsp::ProcessTimings& getLastFileTimings() const { return fileTimings; }
+
+private:
+    void prepareFor(double sampleRate, int numChannels);
+    juce::Result processFile(juce::AudioFormatReader& reader, juce::AudioFormatWriter* writer,
+                             const juce::String& inputName);
+
+    RenderSettings settings;
+    int blockSize;
+    juce::AudioFormatManager formatManager;
+
+    dsp::ClipperEngine engine;
+    double preparedSampleRate = 0.0;
+    int preparedChannels = 0;
+    dsp::ClipStats fileStats;
+    dsp::ProcessTimings fileTimings;
+};
+
+} // namespace render
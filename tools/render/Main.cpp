@@ -0,0 +1,236 @@
+// guillotine_render - offline ClipperEngine renderer
+//
+// Usage:
+//   guillotine_render [options] input.wav [more inputs...]
+//
+// Options:
+//   -p, --params FILE      JSON parameter file (see RenderSettings.h)
+//   -o, --output-dir DIR   Where renders go (default: next to each input)
+//   -s, --suffix TEXT      Appended to output file names (default: _guillotine)
+//   -b, --block-size N     Samples per engine block (default: 4096)
+//   -j, --jobs N           Files rendered in parallel (default: one per core)
+//   -t, --threads N        Extra threads per file for the oversampling filters
+//                          (default: the cores left over when there are fewer files)
+//   -a, --analyze          Only report gain-reduction statistics, write nothing
+//       --profile          Report per-stage engine timings and DSP load per file
+//                          (needs a build with -DGUILLOTINE_PROFILE_STAGES=ON)
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FileRenderer.h"
+
+namespace {
+
+struct Options
+{
+    render::RenderSettings settings;
+    juce::Array<juce::File> inputs;
+    juce::File outputDirectory;
+    juce::String suffix = "_guillotine";
+    int blockSize = render::FileRenderer::defaultBlockSize;
+    int jobs = static_cast<int>(std::thread::hardware_concurrency());
+    int threads = -1;  // Spare cores per file
+    bool analyzeOnly = false;
+    bool profile = false;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: guillotine_render [options] input [more inputs...]\n"
+                 "  -p, --params FILE      JSON parameter file\n"
+                 "  -o, --output-dir DIR   Output directory (default: next to each input)\n"
+                 "  -s, --suffix TEXT      Output file name suffix (default: _guillotine)\n"
+                 "  -b, --block-size N     Samples per engine block (default: 4096)\n"
+                 "  -j, --jobs N           Files rendered in parallel (default: one per core)\n"
+                 "  -t, --threads N        Extra threads per file (default: spare cores)\n"
+                 "  -a, --analyze          Only report gain-reduction statistics, write nothing\n"
+                 "      --profile          Report per-stage timings and DSP load per file\n";
+}
+
+juce::Result parseArguments(const juce::StringArray& args, Options& options)
+{
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        auto takeValue = [&]() { return args[++i]; };
+
+        if ((arg == "-p" || arg == "--params") && hasValue)
+        {
+            const auto result = render::RenderSettings::fromFile(
+                juce::File::getCurrentWorkingDirectory().getChildFile(takeValue()), options.settings);
+            if (result.failed())
+                return result;
+        }
+        else if ((arg == "-o" || arg == "--output-dir") && hasValue)
+        {
+            options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(takeValue());
+        }
+        else if ((arg == "-s" || arg == "--suffix") && hasValue)
+        {
+            options.suffix = takeValue();
+        }
+        else if ((arg == "-b" || arg == "--block-size") && hasValue)
+        {
+            options.blockSize = takeValue().getIntValue();
+            if (options.blockSize <= 0)
+                return juce::Result::fail("block size must be positive");
+        }
+        else if ((arg == "-j" || arg == "--jobs") && hasValue)
+        {
+            options.jobs = takeValue().getIntValue();
+            if (options.jobs <= 0)
+                return juce::Result::fail("job count must be positive");
+        }
+        else if ((arg == "-t" || arg == "--threads") && hasValue)
+        {
+            options.threads = takeValue().getIntValue();
+            if (options.threads < 0)
+                return juce::Result::fail("thread count must not be negative");
+        }
+        else if (arg == "-a" || arg == "--analyze")
+        {
+            options.analyzeOnly = true;
+        }
+        else if (arg == "--profile")
+        {
+            if constexpr (!dsp::StageProfiler::enabled)
+                return juce::Result::fail("--profile needs a build with -DGUILLOTINE_PROFILE_STAGES=ON");
+            options.profile = true;
+        }
+        else if (arg.startsWith("-"))
+        {
+            return juce::Result::fail("unknown or incomplete option: " + arg);
+        }
+        else
+        {
+            options.inputs.add(juce::File::getCurrentWorkingDirectory().getChildFile(arg));
+        }
+    }
+
+    if (options.inputs.isEmpty())
+        return juce::Result::fail("no input files");
+
+    return juce::Result::ok();
+}
+
+juce::File outputFileFor(const juce::File& input, const Options& options)
+{
+    const auto directory = (options.outputDirectory != juce::File()) ? options.outputDirectory
+                                                                      : input.getParentDirectory();
+    return directory.getChildFile(input.getFileNameWithoutExtension() + options.suffix + input.getFileExtension());
+}
+
+juce::String describeStats(const dsp::ClipStats& stats)
+{
+    return "clip " + juce::String(stats.getClipPercentage(), 2) + "%, max GR "
+           + juce::String(stats.maxGainReductionDb, 2) + " dB, skipped "
+           + juce::String(static_cast<juce::int64>(stats.skippedBlocks)) + "/"
+           + juce::String(static_cast<juce::int64>(stats.blocks)) + " blocks";
+}
+
+// One line per stage: mean and slowest block, then the whole block and DSP load
+juce::String describeTimings(const dsp::ProcessTimings& timings)
+{
+    const auto describe = [&timings](const char* name, const dsp::ProcessTimings::Stage& stage)
+    {
+        return "  " + juce::String(name).paddedRight(' ', 12)
+               + juce::String(timings.getAverageMicroseconds(stage), 1) + " us avg, "
+               + juce::String(static_cast<double>(stage.maxNanoseconds) / 1000.0, 1) + " us max\n";
+    };
+
+    juce::String text;
+    for (int i = 0; i < dsp::ProcessTimings::kNumStages; ++i)
+    {
+        const auto stage = static_cast<dsp::ProcessStage>(i);
+        text << describe(dsp::getStageName(stage), timings[stage]);
+    }
+    text << describe("block", timings.block);
+    text << "  DSP load " << juce::String(timings.getLoadPercent(), 2) << "% (max "
+         << juce::String(timings.maxLoadPercent, 2) << "%) over "
+         << juce::String(static_cast<juce::int64>(timings.blocks)) << " blocks\n";
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    if (args.isEmpty() || args.contains("-h") || args.contains("--help"))
+    {
+        printUsage();
+        return args.isEmpty() ? 1 : 0;
+    }
+
+    Options options;
+    const auto parsed = parseArguments(args, options);
+    if (parsed.failed())
+    {
+        std::cerr << "guillotine_render: " << parsed.getErrorMessage() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    if (!options.analyzeOnly && options.outputDirectory != juce::File() && !options.outputDirectory.createDirectory())
+    {
+        std::cerr << "guillotine_render: could not create " << options.outputDirectory.getFullPathName() << "\n";
+        return 1;
+    }
+
+    // One renderer (and so one engine) per worker; workers pull files off a shared index
+    const int numWorkers = juce::jlimit(1, options.inputs.size(), options.jobs);
+
+    // Cores the file workers leave idle go to the engines' channel partitions
+    const int numCores = juce::jmax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int threadsPerFile = (options.threads >= 0) ? options.threads : juce::jmax(0, numCores / numWorkers - 1);
+    std::atomic<int> nextInput { 0 };
+    std::atomic<int> numFailed { 0 };
+    std::mutex printLock;
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.emplace_back([&]()
+        {
+            render::FileRenderer renderer(options.settings, options.blockSize, threadsPerFile);
+
+            for (int index = nextInput++; index < options.inputs.size(); index = nextInput++)
+            {
+                const auto& input = options.inputs.getReference(index);
+                const auto output = outputFileFor(input, options);
+                const auto result = options.analyzeOnly ? renderer.analyzeFile(input)
+                                                        : renderer.renderFile(input, output);
+
+                std::lock_guard<std::mutex> lock(printLock);
+                if (result.wasOk())
+                {
+                    std::cout << input.getFileName();
+                    if (!options.analyzeOnly)
+                        std::cout << " -> " << output.getFullPathName();
+                    std::cout << " (" << describeStats(renderer.getLastFileStats()) << ")\n";
+                    if (options.profile)
+                        std::cout << describeTimings(renderer.getLastFileTimings());
+                }
+                else
+                {
+                    std::cerr << input.getFileName() << ": " << result.getErrorMessage() << "\n";
+                    ++numFailed;
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return numFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,184 @@
+#include "RenderSettings.h"
+
+namespace render {
+
+namespace {
+
+// Same labels as the plugin's AudioParameterChoice lists
+const juce::StringArray& curveLabels()
+{
+    static const juce::StringArray labels { "Hard", "Quintic", "Cubic", "Tanh", "Arctan", "Knee", "T2" };
+    return labels;
+}
+
+const juce::StringArray& oversamplingLabels()
+{
+    static const juce::StringArray labels { "1x", "2x", "4x", "8x", "16x", "32x" };
+    return labels;
+}
+
+const juce::StringArray& filterTypeLabels()
+{
+    static const juce::StringArray labels { "Minimum Phase", "Linear Phase", "Low Latency" };
+    return labels;
+}
+
+const juce::StringArray& oversamplingEngineLabels()
+{
+    static const juce::StringArray labels { "JUCE", "Polyphase Allpass" };
+    return labels;
+}
+
+const juce::StringArray& filterQualityLabels()
+{
+    static const juce::StringArray labels { "High", "Efficient" };
+    return labels;
+}
+
+const juce::StringArray& antialiasingLabels()
+{
+    static const juce::StringArray labels { "Off", "ADAA 1st Order", "ADAA 2nd Order" };
+    return labels;
+}
+
+const juce::StringArray& curveEvaluationLabels()
+{
+    static const juce::StringArray labels { "Approximation", "Lookup Table" };
+    return labels;
+}
+
+const juce::StringArray& channelModeLabels()
+{
+    static const juce::StringArray labels { "L/R", "M/S" };
+    return labels;
+}
+
+const juce::StringArray& ceilingModeLabels()
+{
+    static const juce::StringArray labels { "Sample Peak", "True Peak" };
+    return labels;
+}
+
+juce::Result readFloat(const juce::var& object, const char* name, float minValue, float maxValue, float& value)
+{
+    const auto property = object.getProperty(name, {});
+    if (property.isVoid())
+        return juce::Result::ok();
+
+    if (!property.isDouble() && !property.isInt() && !property.isInt64())
+        return juce::Result::fail(juce::String(name) + ": expected a number");
+
+    value = juce::jlimit(minValue, maxValue, static_cast<float>(property));
+    return juce::Result::ok();
+}
+
+juce::Result readBool(const juce::var& object, const char* name, bool& value)
+{
+    const auto property = object.getProperty(name, {});
+    if (property.isVoid())
+        return juce::Result::ok();
+
+    if (!property.isBool() && !property.isInt())
+        return juce::Result::fail(juce::String(name) + ": expected true or false");
+
+    value = static_cast<bool>(property);
+    return juce::Result::ok();
+}
+
+juce::Result readChoice(const juce::var& object, const char* name, const juce::StringArray& labels, int& value)
+{
+    const auto property = object.getProperty(name, {});
+    if (property.isVoid())
+        return juce::Result::ok();
+
+    int index = -1;
+    if (property.isString())
+        index = labels.indexOf(property.toString(), true);
+    else if (property.isInt() || property.isInt64())
+        index = static_cast<int>(property);
+
+    if (index < 0 || index >= labels.size())
+        return juce::Result::fail(juce::String(name) + ": expected one of " + labels.joinIntoString(", ")
+                                  + " or an index");
+
+    value = index;
+    return juce::Result::ok();
+}
+
+} // namespace
+
+juce::Result RenderSettings::fromJson(const juce::String& json, RenderSettings& settings)
+{
+    juce::var parsed;
+    const auto parseResult = juce::JSON::parse(json, parsed);
+    if (parseResult.failed())
+        return parseResult;
+
+    if (!parsed.isObject())
+        return juce::Result::fail("parameter file must contain a JSON object");
+
+    // Ranges mirror the plugin's NormalisableRanges
+    const juce::Result results[] = {
+        readFloat(parsed, "inputGain", -24.0f, 24.0f, settings.inputGain),
+        readFloat(parsed, "outputGain", -24.0f, 24.0f, settings.outputGain),
+        readFloat(parsed, "ceiling", -60.0f, 0.0f, settings.ceiling),
+        readChoice(parsed, "curve", curveLabels(), settings.curve),
+        readFloat(parsed, "curveExponent", 1.0f, 4.0f, settings.curveExponent),
+        readChoice(parsed, "oversampling", oversamplingLabels(), settings.oversampling),
+        readChoice(parsed, "filterType", filterTypeLabels(), settings.filterType),
+        readChoice(parsed, "oversamplingEngine", oversamplingEngineLabels(), settings.oversamplingEngine),
+        readChoice(parsed, "filterQuality", filterQualityLabels(), settings.filterQuality),
+        readBool(parsed, "autoOversampling", settings.autoOversampling),
+        readChoice(parsed, "antialiasing", antialiasingLabels(), settings.antialiasing),
+        readChoice(parsed, "curveEvaluation", curveEvaluationLabels(), settings.curveEvaluation),
+        readChoice(parsed, "channelMode", channelModeLabels(), settings.channelMode),
+        readBool(parsed, "stereoLink", settings.stereoLink),
+        readBool(parsed, "deltaMonitor", settings.deltaMonitor),
+        readBool(parsed, "bypassClipper", settings.bypassClipper),
+        readBool(parsed, "enforceCeiling", settings.enforceCeiling),
+        readChoice(parsed, "ceilingMode", ceilingModeLabels(), settings.ceilingMode),
+    };
+
+    for (const auto& result : results)
+        if (result.failed())
+            return result;
+
+    return juce::Result::ok();
+}
+
+juce::Result RenderSettings::fromFile(const juce::File& file, RenderSettings& settings)
+{
+    if (!file.existsAsFile())
+        return juce::Result::fail("parameter file not found: " + file.getFullPathName());
+
+    const auto result = fromJson(file.loadFileAsString(), settings);
+    if (result.failed())
+        return juce::Result::fail(file.getFileName() + ": " + result.getErrorMessage());
+
+    return result;
+}
+
+void RenderSettings::applyTo(dsp::ClipperEngine& engine) const
+{
+    // Same mapping as GuillotineProcessor::updateParameterSnapshot
+    engine.setInputGain(inputGain);
+    engine.setOutputGain(outputGain);
+    engine.setCurve(curve);
+    engine.setCurveExponent(curveExponent);
+    engine.setCeiling(ceiling);
+    engine.setOversamplingFactor(oversampling);
+    engine.setFilterType(filterType);
+    engine.setOversamplingEngine(oversamplingEngine == 1);
+    engine.setEfficientFilters(filterQuality == 1);
+    engine.setAutoOversampling(autoOversampling);
+    engine.setAntialiasing(antialiasing);
+    engine.setCurveTable(curveEvaluation == 1);
+    engine.setChannelMode(channelMode == 1);
+    engine.setStereoLink(stereoLink);
+    engine.setDeltaMonitor(deltaMonitor);
+    engine.setBypass(bypassClipper);
+    engine.setEnforceCeiling(enforceCeiling);
+    engine.setTruePeakMode(ceilingMode == 1);
+}
+
+} // namespace render
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include "dsp/ClipperEngine.h"
+
+namespace render {
+
+// Engine parameters for an offline render. Field names, ranges and choice
+// labels match the plugin's APVTS parameter IDs, so a parameter file reads
+// like a plugin state:
+//
+//   { "inputGain": 6.0, "ceiling": -1.0, "curve": "Tanh", "oversampling": "8x",
+//     "filterType": "Linear Phase", "ceilingMode": "True Peak" }
+//
+// Choices accept either the label or the index. Unlike the plugin, the clipper
+// is not bypassed by default.
+struct RenderSettings
+{
+    float inputGain = 0.0f;        // dB
+    float outputGain = 0.0f;       // dB
+    float ceiling = 0.0f;          // dB
+    int curve = 0;                 // 0=Hard ... 6=T2
+    float curveExponent = 4.0f;
+    int oversampling = 2;          // 0=1x ... 5=32x
+    int filterType = 0;            // 0=Minimum Phase, 1=Linear Phase, 2=Low Latency
+    int oversamplingEngine = 0;    // 0=JUCE, 1=Polyphase Allpass
+    int filterQuality = 0;         // 0=High, 1=Efficient
+    bool autoOversampling = false;
+    int antialiasing = 0;          // 0=Off, 1=ADAA 1st Order, 2=ADAA 2nd Order
+    int curveEvaluation = 0;       // 0=Approximation, 1=Lookup Table
+    int channelMode = 0;           // 0=L/R, 1=M/S
+    bool stereoLink = true;
+    bool deltaMonitor = false;
+    bool bypassClipper = false;
+    bool enforceCeiling = true;
+    int ceilingMode = 0;           // 0=Sample Peak, 1=True Peak
+
+    // Parses a JSON object, leaving unspecified fields at their defaults
+    static juce::Result fromJson(const juce::String& json, RenderSettings& settings);
+    static juce::Result fromFile(const juce::File& file, RenderSettings& settings);
+
+    void applyTo(dsp::ClipperEngine& engine) const;
+};
+
+} // namespace render
@@ -0,0 +1,45 @@
+// Timing Overlay Component
+// DSP load and per-stage process() timings, shown only by profiling builds
+// (GUILLOTINE_PROFILE_STAGES) - main.js loads it on the first processTimings event
+
+import { loadStyles } from '../../lib/component-loader.js';
+
+export class TimingOverlay {
+  static stylesLoaded = false;
+
+  constructor(container) {
+    this.container = container;
+    this.ready = this.init();
+  }
+
+  async init() {
+    if (!TimingOverlay.stylesLoaded) {
+      await loadStyles('components/display/timing-overlay.css');
+      TimingOverlay.stylesLoaded = true;
+    }
+
+    const template = document.createElement('template');
+    template.innerHTML = `
+      <div class="timing-overlay">
+        <div class="timing-overlay__load"></div>
+        <table class="timing-overlay__stages"></table>
+      </div>
+    `;
+
+    this.element = template.content.querySelector('.timing-overlay');
+    this.loadElement = this.element.querySelector('.timing-overlay__load');
+    this.stagesElement = this.element.querySelector('.timing-overlay__stages');
+    this.container.appendChild(this.element);
+  }
+
+  // timings: { load, maxLoad, blockAverageUs, blockMaxUs, stages: [{ name, averageUs, maxUs }] }
+  update(timings) {
+    this.loadElement.textContent =
+      `DSP ${timings.load.toFixed(1)}% (max ${timings.maxLoad.toFixed(1)}%)  ` +
+      `block ${timings.blockAverageUs.toFixed(0)}/${timings.blockMaxUs.toFixed(0)} us`;
+
+    this.stagesElement.innerHTML = timings.stages
+      .map((s) => `<tr><td>${s.name}</td><td>${s.averageUs.toFixed(1)}</td><td>${s.maxUs.toFixed(1)}</td></tr>`)
+      .join('');
+  }
+}
@@ -20,3 +20,40 @@ export async function loadStyles(path) {
 
   styleCache.set(path, true);
 }
+
+// Stand-in for a view whose module is loaded later. Method calls and property
+// assignments made before it loads are queued and replayed in order on the
+// real instance, so callers can use it right away. `ready` resolves once the
+// real view is constructed and ready.
+export function lazyView(load) {
+  let instance = null;
+  const pending = [];
+
+  const ready = load().then(async (view) => {
+    await view.ready;
+    for (const op of pending) {
+      if (op.set) view[op.key] = op.value;
+      else view[op.key](...op.args);
+    }
+    pending.length = 0;
+    instance = view;
+    return view;
+  });
+
+  return new Proxy({}, {
+    get(_, key) {
+      if (key === 'ready') return ready;
+      if (key === 'then' || typeof key === 'symbol') return undefined;
+      if (instance) {
+        const value = instance[key];
+        return typeof value === 'function' ? value.bind(instance) : value;
+      }
+      return (...args) => { pending.push({ key, args }); };
+    },
+    set(_, key, value) {
+      if (instance) instance[key] = value;
+      else pending.push({ set: true, key, value });
+      return true;
+    }
+  });
+}
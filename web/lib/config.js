@@ -38,4 +38,7 @@ export const DISPLAY_CONFIG = {
 export const DEFAULT_MIN_DB = DISPLAY_CONFIG.defaultMinDb;
 export const MAX_CEILING_DB = DISPLAY_CONFIG.maxCeilingDb;
 export const DISPLAY_DB_RANGE = DISPLAY_CONFIG.rangeDb;  // Always 60 (full range)
+
+// Envelope history length (matches GuillotineProcessor::envelopeBufferSize)
+export const ENVELOPE_HISTORY_SIZE = 400;
 export { SCALE_PRESETS };
@@ -70,6 +70,25 @@ export function registerCallback(name, callback) {
     window[name] = callback;
 }
 
+// Envelope frames from C++ (only the points produced since the last push)
+// Payload: { count, frames } where frames is base64 of interleaved float32
+// [preClip, postClip, threshold] x count
+export function onEnvelopeFrames(callback) {
+    window.__JUCE__.backend.addEventListener("envelopeFrames", (payload) => {
+        const binary = atob(payload.frames);
+        const bytes = new Uint8Array(binary.length);
+        for (let i = 0; i < binary.length; i++) {
+            bytes[i] = binary.charCodeAt(i);
+        }
+        callback(new Float32Array(bytes.buffer), payload.count);
+    });
+}
+
+// Per-stage DSP timings - only sent by builds with GUILLOTINE_PROFILE_STAGES
+export function onProcessTimings(callback) {
+    window.__JUCE__.backend.addEventListener("processTimings", callback);
+}
+
 // Delta monitor helpers - syncs UI delta mode with C++ param
 export function setDeltaMonitor(enabled) {
     const state = sliderStates.deltaMonitor;
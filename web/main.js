@@ -1,12 +1,12 @@
 // Guillotine Plugin - Main Entry Point
 // Phase 2: Microscope view with waveform and draggable threshold
 
-import { DISPLAY_DB_RANGE, DEFAULT_MIN_DB } from './lib/config.js';
+import { DISPLAY_DB_RANGE, DEFAULT_MIN_DB, ENVELOPE_HISTORY_SIZE } from './lib/config.js';
 import { TEXT } from './lib/utils.js';
 import { Guillotine } from './components/views/guillotine.js';
-import { Microscope } from './components/views/microscope.js';
 import { BloodPool } from './components/display/blood-pool.js';
 import { Knob } from './components/controls/knob.js';
+import { lazyView } from './lib/component-loader.js';
 import { Lever } from './components/controls/lever.js';
 import {
   setParameterNormalized,
@@ -14,7 +14,8 @@ import {
   onParameterChange,
   parameterDragStarted,
   parameterDragEnded,
-  registerCallback,
+  onEnvelopeFrames,
+  onProcessTimings,
   setDeltaMonitor,
   onDeltaMonitorChange,
   setBypassClipper,
@@ -112,7 +113,16 @@ class GuillotineApp {
     this.guillotine = new Guillotine(this.guillotineContainer);
     this.lever = new Lever(this.guillotineContainer);
     this.bloodPool = new BloodPool(this.guillotineContainer);
-    this.microscope = new Microscope(this.microscopeContainer);
+
+    // Microscope is fetched only after the primary controls are up; calls made
+    // before then are queued by the lazy view
+    let loadSecondaryViews;
+    const primaryReady = new Promise((resolve) => { loadSecondaryViews = resolve; });
+    this.microscope = lazyView(async () => {
+      await primaryReady;
+      const { Microscope } = await import('./components/views/microscope.js');
+      return new Microscope(this.microscopeContainer);
+    });
 
     // Blade knob (stepped: Hard, Quintic, Cubic, Tanh, Arctan, Knee, T2) - LEFT
     this.curveKnob = new Knob(this.mainKnobsContainer, {
@@ -214,12 +224,11 @@ class GuillotineApp {
       wrapperClass: 'knob-wrapper--side'
     }));
 
-    // Wait for all components to initialize
+    // Wait for the primary components to initialize
     await Promise.all([
       this.guillotine.ready,
       this.lever.ready,
       this.bloodPool.ready,
-      this.microscope.ready,
       this.thresholdKnob.ready,
       this.curveKnob.ready,
       this.curveExponentKnob.ready,
@@ -227,6 +236,7 @@ class GuillotineApp {
       this.inputGainKnob.ready,
       this.outputGainKnob.ready
     ]);
+    loadSecondaryViews();
 
     // Start with exponent knob disabled (only enable for T²)
     this.curveExponentKnob.setDisabled(true);
@@ -339,9 +349,34 @@ class GuillotineApp {
       this.setBypass(bypassed);
     });
 
-    // Register envelope data callback (from C++ timer)
-    registerCallback('updateEnvelope', (data) => {
-      this.microscope.updateData(data);
+    // Envelope history ring, appended to as C++ pushes new frames
+    this.envelope = {
+      preClip: new Float32Array(ENVELOPE_HISTORY_SIZE),
+      postClip: new Float32Array(ENVELOPE_HISTORY_SIZE),
+      thresholds: new Float32Array(ENVELOPE_HISTORY_SIZE),
+      writePos: 0
+    };
+    this.microscope.updateData(this.envelope);
+
+    onEnvelopeFrames((frames, count) => {
+      const env = this.envelope;
+      for (let i = 0; i < count; i++) {
+        env.preClip[env.writePos] = frames[i * 3];
+        env.postClip[env.writePos] = frames[i * 3 + 1];
+        env.thresholds[env.writePos] = frames[i * 3 + 2];
+        env.writePos = (env.writePos + 1) % ENVELOPE_HISTORY_SIZE;
+      }
+    });
+
+    // Profiling builds only: the overlay is fetched on the first timings event
+    onProcessTimings((timings) => {
+      if (!this.timingOverlay) {
+        this.timingOverlay = lazyView(async () => {
+          const { TimingOverlay } = await import('./components/display/timing-overlay.js');
+          return new TimingOverlay(document.body);
+        });
+      }
+      this.timingOverlay.update(timings);
     });
 
     // Initialize all UI state from C++ parameter values